@@ -0,0 +1,325 @@
+#include "GdbCommandQueue.h"
+#include "SeerUtl.h"
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QProcess>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QDebug>
+#include <algorithm>
+
+static QLoggingCategory LC("seer.gdbcommandqueue");
+
+GdbCommandQueue::GdbCommandQueue (GdbMonitor* monitor, QObject* parent) : QObject(parent) {
+
+    _monitor = monitor;
+    _depth   = 0;
+    _timeout = 30000;
+
+    _timer.setSingleShot(true);
+
+    QObject::connect(&_timer, &QTimer::timeout, this, &GdbCommandQueue::handleTimeout);
+}
+
+GdbCommandQueue::~GdbCommandQueue () {
+}
+
+int GdbCommandQueue::send (const QString& command) {
+
+    return send(command, 0, GdbMiRecordHandler());
+}
+
+int GdbCommandQueue::send (const QString& command, QObject* receiver, GdbMiRecordHandler completion, int timeout) {
+
+    Command c;
+
+    c.hasCompletion = receiver != 0 && completion;
+    c.receiver      = receiver;
+    c.completion    = completion;
+    c.timeout       = timeout < 0 ? _timeout : timeout;
+
+    // Keep the command's own token. Otherwise give it one.
+    int i = 0;
+
+    while (i < command.size() && command[i].isDigit()) {
+        i++;
+    }
+
+    if (i > 0) {
+        c.token   = command.left(i).toInt();
+        c.command = command;
+    }else{
+        c.token   = Seer::createID();
+        c.command = QString::number(c.token) + command;
+
+        _monitor->stripToken(c.token);
+    }
+
+    c.name = command.mid(i).section(' ', 0, 0, QString::SectionSkipEmpty);
+
+    // Wait in line if the pipe is full, or others are already waiting.
+    if (_depth > 0 && (_inFlight.size() >= _depth || _waiting.isEmpty() == false)) {
+
+        _waiting.enqueue(c);
+
+        qCDebug(LC) << "Waiting" << c.command << "in flight" << _inFlight.size() << "waiting" << _waiting.size();
+
+        return c.token;
+    }
+
+    write(c);
+
+    return c.token;
+}
+
+void GdbCommandQueue::sendBatch (const QStringList& commands, QObject* receiver, GdbMiBatchHandler completion, int timeout) {
+
+    struct Batch {
+        QVector<GdbMiRecord>    records;
+        int                     remaining;
+    };
+
+    if (commands.isEmpty()) {
+        return;
+    }
+
+    QSharedPointer<Batch> batch(new Batch);
+
+    batch->records.resize(commands.size());
+    batch->remaining = commands.size();
+
+    // Collect the results. The last one in hands them all over.
+    for (int i=0; i<commands.size(); i++) {
+
+        send(commands[i], receiver, [batch, i, completion](const GdbMiRecord& record) {
+
+            batch->records[i] = record;
+            batch->remaining--;
+
+            if (batch->remaining == 0) {
+                completion(batch->records);
+            }
+
+            return true;
+
+        }, timeout);
+    }
+}
+
+void GdbCommandQueue::setDepth (int depth) {
+
+    _depth = depth;
+
+    writeWaiting();
+}
+
+int GdbCommandQueue::depth () const {
+
+    return _depth;
+}
+
+void GdbCommandQueue::setTimeout (int milliseconds) {
+
+    _timeout = milliseconds;
+}
+
+int GdbCommandQueue::timeout () const {
+
+    return _timeout;
+}
+
+int GdbCommandQueue::inFlight () const {
+
+    return _inFlight.size();
+}
+
+int GdbCommandQueue::waiting () const {
+
+    return _waiting.size();
+}
+
+void GdbCommandQueue::clear () {
+
+    // gdb is gone. Nobody is going to answer these.
+    for (const Command& c : _inFlight) {
+        _monitor->removeTokenHandler(c.token, this);
+    }
+
+    _inFlight.clear();
+    _waiting.clear();
+    _timer.stop();
+}
+
+QStringList GdbCommandQueue::latencyStats () const {
+
+    QStringList names = _latency.keys();
+    QStringList lines;
+
+    std::sort(names.begin(), names.end());
+
+    for (const auto& name : names) {
+
+        Latency l = _latency.value(name);
+
+        double avg = l.count > 0 ? (double)l.total / (double)l.count / 1000000.0 : 0.0;
+        double max = (double)l.max / 1000000.0;
+
+        lines << QString("%1 count %2 avg %3 ms max %4 ms timeouts %5").arg(name).arg(l.count).arg(avg, 0, 'f', 2).arg(max, 0, 'f', 2).arg(l.timeouts);
+    }
+
+    return lines;
+}
+
+void GdbCommandQueue::resetLatencyStats () {
+
+    _latency.clear();
+}
+
+void GdbCommandQueue::handleTimeout () {
+
+    // Take the expired ones out first. A completion may send more commands.
+    QList<Command> expired;
+
+    for (int i=0; i<_inFlight.size(); ) {
+
+        const Command& c = _inFlight[i];
+
+        if (c.timeout > 0 && c.timer.hasExpired(c.timeout)) {
+            expired.append(_inFlight.takeAt(i));
+        }else{
+            i++;
+        }
+    }
+
+    for (Command& c : expired) {
+
+        qCWarning(LC) << "No result for" << c.command << "after" << c.timeout << "ms";
+
+        Latency& l = _latency[c.name];
+        l.timeouts++;
+
+        release(c.token);
+
+        if (c.hasCompletion && c.receiver.isNull() == false) {
+            c.completion(GdbMiRecord());
+        }
+    }
+
+    writeWaiting();
+    startTimer();
+}
+
+void GdbCommandQueue::write (Command& command) {
+
+    // The monitor hands the result to us by token. Once per token, some widgets reuse theirs.
+    bool registered = false;
+
+    for (const Command& c : _inFlight) {
+        if (c.token == command.token) {
+            registered = true;
+            break;
+        }
+    }
+
+    if (registered == false) {
+        _monitor->addTokenHandler(command.token, this, &GdbCommandQueue::handleResult);
+    }
+
+    qCDebug(LC) << "Writing" << command.command << "in flight" << _inFlight.size();
+
+    command.timer.start();
+
+    _monitor->process()->write((command.command + "\n").toUtf8());
+    _monitor->commandSent(command.token);
+
+    _inFlight.append(command);
+
+    startTimer();
+}
+
+void GdbCommandQueue::writeWaiting () {
+
+    while (_waiting.isEmpty() == false && (_depth == 0 || _inFlight.size() < _depth)) {
+
+        Command c = _waiting.dequeue();
+
+        write(c);
+    }
+}
+
+bool GdbCommandQueue::handleResult (const GdbMiRecord& record) {
+
+    // gdb answers in order. The first one in flight with this token is the one.
+    for (int i=0; i<_inFlight.size(); i++) {
+
+        if (_inFlight[i].token != record.token()) {
+            continue;
+        }
+
+        Command c = _inFlight.takeAt(i);
+
+        bool consumed = false;
+
+        complete(c, record, &consumed);
+
+        writeWaiting();
+        startTimer();
+
+        return consumed;
+    }
+
+    return false;
+}
+
+void GdbCommandQueue::complete (Command& command, const GdbMiRecord& record, bool* consumed) {
+
+    qint64 ns = command.timer.nsecsElapsed();
+
+    Latency& l = _latency[command.name];
+    l.count++;
+    l.total += ns;
+    l.max    = qMax(l.max, ns);
+
+    qCDebug(LC) << "Result for" << command.command << "in" << ns / 1000000.0 << "ms";
+
+    release(command.token);
+
+    if (command.hasCompletion && command.receiver.isNull() == false) {
+        *consumed = command.completion(record);
+    }
+}
+
+void GdbCommandQueue::release (int token) {
+
+    for (const Command& c : _inFlight) {
+        if (c.token == token) {
+            return;
+        }
+    }
+
+    _monitor->removeTokenHandler(token, this);
+}
+
+void GdbCommandQueue::startTimer () {
+
+    qint64 next = -1;
+
+    for (const Command& c : _inFlight) {
+
+        if (c.timeout <= 0) {
+            continue;
+        }
+
+        qint64 remaining = qMax((qint64)0, (qint64)c.timeout - c.timer.elapsed());
+
+        if (next < 0 || remaining < next) {
+            next = remaining;
+        }
+    }
+
+    if (next < 0) {
+        _timer.stop();
+        return;
+    }
+
+    _timer.start((int)next);
+}
+
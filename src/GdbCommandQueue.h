@@ -0,0 +1,118 @@
+#pragma once
+
+#include "GdbMonitor.h"
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QPointer>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QQueue>
+#include <QtCore/QTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QVector>
+#include <functional>
+
+//
+// Completion for a batch of commands. The result records, in the order the commands were given.
+//
+typedef std::function<void (const QVector<GdbMiRecord>& records)> GdbMiBatchHandler;
+
+//
+// Writes commands to gdb and tracks each one until its result record comes back.
+//
+// Every command goes out with a token. A command that has one of its own
+// ("12-data-evaluate-expression ...") keeps it. Others get a fresh one from
+// Seer::createID(). GdbMonitor takes that one off the record's text again, so
+// widgets that still match on text see what they always did.
+//
+// A command can have a completion. It is handed the result record (^done, ^error, ...)
+// and returns true if it consumed it, like a GdbMonitor handler. If the result doesn't
+// come within the timeout, the completion is handed an invalid GdbMiRecord and the late
+// result is broadcast as usual.
+//
+//     queue->send("-thread-list-ids", widget, &SeerThreadIdsBrowserWidget::handleRecord);
+//
+// A batch of commands is pipelined and has one completion, called once the last result
+// is in. A command that timed out has an invalid record in its place.
+//
+// At most depth() commands are in flight. The rest wait their turn, in order.
+// A depth of 0 is no limit. The time from write to result is kept per command.
+//
+
+class GdbCommandQueue : public QObject {
+
+    Q_OBJECT
+
+    public:
+        explicit GdbCommandQueue (GdbMonitor* monitor, QObject* parent = 0);
+       ~GdbCommandQueue ();
+
+        int                             send                            (const QString& command);
+        int                             send                            (const QString& command, QObject* receiver, GdbMiRecordHandler completion, int timeout = -1);
+
+        template <typename T>
+        int                             send                            (const QString& command, T* receiver, bool (T::*method)(const GdbMiRecord&), int timeout = -1) {
+            return send(command, receiver, [receiver, method](const GdbMiRecord& record) { return (receiver->*method)(record); }, timeout);
+        }
+
+        void                            sendBatch                       (const QStringList& commands, QObject* receiver, GdbMiBatchHandler completion, int timeout = -1);
+
+        template <typename T>
+        void                            sendBatch                       (const QStringList& commands, T* receiver, void (T::*method)(const QVector<GdbMiRecord>&), int timeout = -1) {
+            sendBatch(commands, receiver, [receiver, method](const QVector<GdbMiRecord>& records) { (receiver->*method)(records); }, timeout);
+        }
+
+        void                            setDepth                        (int depth);
+        int                             depth                           () const;
+        void                            setTimeout                      (int milliseconds);
+        int                             timeout                         () const;
+
+        int                             inFlight                        () const;
+        int                             waiting                         () const;
+        void                            clear                           ();
+
+        // One line per command name. Count, average, max and timeouts.
+        QStringList                     latencyStats                    () const;
+        void                            resetLatencyStats               ();
+
+    private slots:
+        void                            handleTimeout                   ();
+
+    private:
+        struct Command {
+            int                         token;
+            QString                     command;
+            QString                     name;
+            bool                        hasCompletion;
+            QPointer<QObject>           receiver;
+            GdbMiRecordHandler          completion;
+            int                         timeout;
+            QElapsedTimer               timer;
+        };
+
+        struct Latency {
+            Latency () : count(0), total(0), max(0), timeouts(0) {}
+
+            quint64                     count;
+            qint64                      total;
+            qint64                      max;
+            quint64                     timeouts;
+        };
+
+        void                            write                           (Command& command);
+        void                            writeWaiting                    ();
+        bool                            handleResult                    (const GdbMiRecord& record);
+        void                            complete                        (Command& command, const GdbMiRecord& record, bool* consumed);
+        void                            release                         (int token);
+        void                            startTimer                      ();
+
+        GdbMonitor*                     _monitor;
+        QQueue<Command>                 _waiting;
+        QList<Command>                  _inFlight;
+        QHash<QString,Latency>          _latency;
+        QTimer                          _timer;
+        int                             _depth;
+        int                             _timeout;
+};
+
@@ -0,0 +1,885 @@
+#include "GdbMiParser.h"
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QDebug>
+#include <string.h>
+#include <climits>
+
+static QLoggingCategory LC("seer.gdbmiparser");
+
+//
+// The recursive descent parser. It walks the buffer exactly once and appends
+// nodes to the node table. Children of a tuple or list are chained through
+// 'nextSibling', so nothing has to be moved once a node is created.
+//
+// MI grammar (from the gdb manual):
+//
+//     result-record  : [token] "^" result-class ( "," result )*
+//     async-record   : [token] ( "*" | "+" | "=" ) async-class ( "," result )*
+//     stream-record  : ( "~" | "@" | "&" ) c-string
+//     result         : variable "=" value
+//     value          : const | tuple | list
+//     tuple          : "{}" | "{" result ( "," result )* "}"
+//     list           : "[]" | "[" value ( "," value )* "]" | "[" result ( "," result )* "]"
+//
+
+namespace {
+
+    class MiParser {
+
+        public:
+            MiParser (const char* buffer, int length, QVector<GdbMiNode>& nodes) : _buffer(buffer), _length(length), _pos(0), _nodes(nodes) {
+            }
+
+            int pos () const {
+                return _pos;
+            }
+
+            void setPos (int pos) {
+                _pos = pos;
+            }
+
+            int newNode (int type, int nameStart, int nameLength, int start) {
+
+                GdbMiNode node;
+                node.type        = type;
+                node.nameStart   = nameStart;
+                node.nameLength  = nameLength;
+                node.start       = start;
+                node.length      = 0;
+                node.firstChild  = -1;
+                node.nextSibling = -1;
+                node.childCount  = 0;
+
+                _nodes.append(node);
+
+                return _nodes.size() - 1;
+            }
+
+            // Parse a c-string. _pos is at the opening quote.
+            int parseConst (int nameStart, int nameLength) {
+
+                int start = _pos + 1;
+                int i     = start;
+
+                while (i < _length) {
+
+                    char c = _buffer[i];
+
+                    if (c == '\\') {
+                        i += 2;
+                        continue;
+                    }
+
+                    if (c == '"') {
+                        break;
+                    }
+
+                    i++;
+                }
+
+                if (i >= _length) { // No closing quote.
+                    return -1;
+                }
+
+                int n = newNode(GdbMiValue::Const, nameStart, nameLength, start);
+                _nodes[n].length = i - start;
+
+                _pos = i + 1; // Past the closing quote.
+
+                return n;
+            }
+
+            // Parse a bare word. Not part of the grammar but some replies have them.
+            int parseBare (int nameStart, int nameLength) {
+
+                int start = _pos;
+                int i     = start;
+
+                while (i < _length && _buffer[i] != ',' && _buffer[i] != '}' && _buffer[i] != ']') {
+                    i++;
+                }
+
+                int n = newNode(GdbMiValue::Const, nameStart, nameLength, start);
+                _nodes[n].length = i - start;
+
+                _pos = i;
+
+                return n;
+            }
+
+            // Parse a tuple or a list. _pos is at the opening bracket.
+            int parseContainer (int nameStart, int nameLength) {
+
+                char open  = _buffer[_pos];
+                char close = (open == '{') ? '}' : ']';
+                int  type  = (open == '{') ? GdbMiValue::Tuple : GdbMiValue::List;
+
+                _pos++;
+
+                int n         = newNode(type, nameStart, nameLength, _pos);
+                int lastChild = -1;
+                int count     = 0;
+
+                if (_pos < _length && _buffer[_pos] == close) {
+                    _nodes[n].length = 0;
+                    _pos++;
+                    return n;
+                }
+
+                while (_pos < _length) {
+
+                    int child = -1;
+                    char c    = _buffer[_pos];
+
+                    // A list can hold plain values or results. A tuple only holds results.
+                    if (type == GdbMiValue::List && (c == '"' || c == '{' || c == '[')) {
+                        child = parseValue(-1, 0);
+                    }else{
+                        child = parseResult();
+                    }
+
+                    if (child < 0) {
+                        return -1;
+                    }
+
+                    if (lastChild < 0) {
+                        _nodes[n].firstChild = child;
+                    }else{
+                        _nodes[lastChild].nextSibling = child;
+                    }
+
+                    lastChild = child;
+                    count++;
+
+                    if (_pos >= _length) {
+                        return -1;
+                    }
+
+                    if (_buffer[_pos] == ',') {
+                        _pos++;
+                        continue;
+                    }
+
+                    if (_buffer[_pos] == close) {
+                        break;
+                    }
+
+                    return -1; // Garbage.
+                }
+
+                if (_pos >= _length) {
+                    return -1;
+                }
+
+                _nodes[n].length     = _pos - _nodes[n].start;
+                _nodes[n].childCount = count;
+
+                _pos++; // Past the closing bracket.
+
+                return n;
+            }
+
+            int parseValue (int nameStart, int nameLength) {
+
+                if (_pos >= _length) {
+                    return -1;
+                }
+
+                char c = _buffer[_pos];
+
+                if (c == '"') {
+                    return parseConst(nameStart, nameLength);
+                }
+
+                if (c == '{' || c == '[') {
+                    return parseContainer(nameStart, nameLength);
+                }
+
+                return parseBare(nameStart, nameLength);
+            }
+
+            // Parse 'variable=value'.
+            int parseResult () {
+
+                // Older gdbs (MI2) output breakpoint locations as nameless tuples
+                // next to 'bkpt={...}'. Accept a nameless value here too.
+                if (_pos < _length && (_buffer[_pos] == '"' || _buffer[_pos] == '{' || _buffer[_pos] == '[')) {
+                    return parseValue(-1, 0);
+                }
+
+                int nameStart = _pos;
+
+                while (_pos < _length && _buffer[_pos] != '=') {
+
+                    char c = _buffer[_pos];
+
+                    if (c == ',' || c == '{' || c == '}' || c == '[' || c == ']' || c == '"') {
+                        return -1;
+                    }
+
+                    _pos++;
+                }
+
+                if (_pos >= _length) {
+                    return -1;
+                }
+
+                int nameLength = _pos - nameStart;
+
+                _pos++; // Past the '='.
+
+                return parseValue(nameStart, nameLength);
+            }
+
+            // Parse 'result ( "," result )*' up to the end of the buffer into a tuple.
+            int parseResults (int start) {
+
+                int n         = newNode(GdbMiValue::Tuple, -1, 0, start);
+                int lastChild = -1;
+                int count     = 0;
+
+                _pos = start;
+
+                while (_pos < _length) {
+
+                    int child = parseResult();
+
+                    if (child < 0) {
+                        return -1;
+                    }
+
+                    if (lastChild < 0) {
+                        _nodes[n].firstChild = child;
+                    }else{
+                        _nodes[lastChild].nextSibling = child;
+                    }
+
+                    lastChild = child;
+                    count++;
+
+                    if (_pos < _length && _buffer[_pos] == ',') {
+                        _pos++;
+                        continue;
+                    }
+
+                    if (_pos < _length) {
+                        return -1; // Garbage at the end.
+                    }
+                }
+
+                _nodes[n].length     = _length - start;
+                _nodes[n].childCount = count;
+
+                return n;
+            }
+
+        private:
+            const char*             _buffer;
+            int                     _length;
+            int                     _pos;
+            QVector<GdbMiNode>&     _nodes;
+    };
+}
+
+//
+// GdbMiValue
+//
+
+GdbMiValue::const_iterator::const_iterator (const QSharedPointer<const GdbMiData>& data, int index) : _data(data), _index(index) {
+}
+
+GdbMiValue GdbMiValue::const_iterator::operator* () const {
+    return GdbMiValue(_data, _index);
+}
+
+GdbMiValue::const_iterator& GdbMiValue::const_iterator::operator++ () {
+
+    if (_index >= 0) {
+        _index = _data->nodes[_index].nextSibling;
+    }
+
+    return *this;
+}
+
+bool GdbMiValue::const_iterator::operator== (const const_iterator& other) const {
+    return _index == other._index;
+}
+
+bool GdbMiValue::const_iterator::operator!= (const const_iterator& other) const {
+    return _index != other._index;
+}
+
+GdbMiValue::GdbMiValue () : _index(-1) {
+}
+
+GdbMiValue::GdbMiValue (const QSharedPointer<const GdbMiData>& data, int index) : _data(data), _index(index) {
+}
+
+const GdbMiNode* GdbMiValue::node () const {
+
+    if (_data.isNull() || _index < 0) {
+        return nullptr;
+    }
+
+    return &_data->nodes[_index];
+}
+
+GdbMiValue::Type GdbMiValue::type () const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr) {
+        return GdbMiValue::Invalid;
+    }
+
+    return (GdbMiValue::Type)n->type;
+}
+
+bool GdbMiValue::isValid () const {
+    return type() != GdbMiValue::Invalid;
+}
+
+bool GdbMiValue::isConst () const {
+    return type() == GdbMiValue::Const;
+}
+
+bool GdbMiValue::isTuple () const {
+    return type() == GdbMiValue::Tuple;
+}
+
+bool GdbMiValue::isList () const {
+    return type() == GdbMiValue::List;
+}
+
+QString GdbMiValue::name () const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr || n->nameStart < 0) {
+        return QString();
+    }
+
+    return QString::fromLatin1(_data->buffer.constData() + n->nameStart, n->nameLength);
+}
+
+bool GdbMiValue::hasName (const char* name) const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr || n->nameStart < 0) {
+        return false;
+    }
+
+    int len = (int)strlen(name);
+
+    if (len != n->nameLength) {
+        return false;
+    }
+
+    return memcmp(_data->buffer.constData() + n->nameStart, name, len) == 0;
+}
+
+int GdbMiValue::size () const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr) {
+        return 0;
+    }
+
+    return n->childCount;
+}
+
+bool GdbMiValue::isEmpty () const {
+    return size() == 0;
+}
+
+GdbMiValue GdbMiValue::at (int i) const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr || i < 0 || i >= n->childCount) {
+        return GdbMiValue();
+    }
+
+    int c = n->firstChild;
+
+    while (i > 0 && c >= 0) {
+        c = _data->nodes[c].nextSibling;
+        i--;
+    }
+
+    return GdbMiValue(_data, c);
+}
+
+GdbMiValue GdbMiValue::value (const char* name) const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr) {
+        return GdbMiValue();
+    }
+
+    int         len    = (int)strlen(name);
+    const char* buffer = _data->buffer.constData();
+
+    for (int c = n->firstChild; c >= 0; c = _data->nodes[c].nextSibling) {
+
+        const GdbMiNode& child = _data->nodes[c];
+
+        if (child.nameLength == len && memcmp(buffer + child.nameStart, name, len) == 0) {
+            return GdbMiValue(_data, c);
+        }
+    }
+
+    return GdbMiValue();
+}
+
+GdbMiValue GdbMiValue::operator[] (const char* name) const {
+    return value(name);
+}
+
+bool GdbMiValue::contains (const char* name) const {
+    return value(name).isValid();
+}
+
+GdbMiValue GdbMiValue::firstChild () const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr) {
+        return GdbMiValue();
+    }
+
+    return GdbMiValue(_data, n->firstChild);
+}
+
+GdbMiValue GdbMiValue::nextSibling () const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr) {
+        return GdbMiValue();
+    }
+
+    return GdbMiValue(_data, n->nextSibling);
+}
+
+GdbMiValue::const_iterator GdbMiValue::begin () const {
+
+    const GdbMiNode* n = node();
+
+    return const_iterator(_data, n ? n->firstChild : -1);
+}
+
+GdbMiValue::const_iterator GdbMiValue::end () const {
+    return const_iterator(_data, -1);
+}
+
+QString GdbMiValue::toString () const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr) {
+        return QString();
+    }
+
+    const char* str = _data->buffer.constData() + n->start;
+
+    // Tuples and lists are returned as their raw text.
+    if (n->type != GdbMiValue::Const) {
+        return QString::fromUtf8(str, n->length);
+    }
+
+    // Fast path. Nothing to unescape.
+    if (memchr(str, '\\', n->length) == nullptr) {
+        return QString::fromUtf8(str, n->length);
+    }
+
+    return QString::fromUtf8(GdbMiParser::unescape(str, n->length));
+}
+
+QString GdbMiValue::toString (const QString& defaultValue) const {
+
+    if (isValid() == false) {
+        return defaultValue;
+    }
+
+    return toString();
+}
+
+QStringList GdbMiValue::toStringList () const {
+
+    QStringList list;
+
+    for (const GdbMiValue& v : *this) {
+        list.append(v.toString());
+    }
+
+    return list;
+}
+
+QByteArray GdbMiValue::toByteArray () const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr) {
+        return QByteArray();
+    }
+
+    const char* str = _data->buffer.constData() + n->start;
+
+    if (n->type != GdbMiValue::Const) {
+        return QByteArray(str, n->length);
+    }
+
+    return GdbMiParser::unescape(str, n->length);
+}
+
+QString GdbMiValue::rawText () const {
+
+    // Same text as Seer::parseFirst(text, "name=", '"', '"', false) would return.
+    const GdbMiNode* n = node();
+
+    if (n == nullptr) {
+        return QString();
+    }
+
+    return QString::fromUtf8(_data->buffer.constData() + n->start, n->length);
+}
+
+const char* GdbMiValue::rawData () const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr) {
+        return "";
+    }
+
+    return _data->buffer.constData() + n->start;
+}
+
+int GdbMiValue::rawLength () const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr) {
+        return 0;
+    }
+
+    return n->length;
+}
+
+int GdbMiValue::toInt (bool* ok, int base) const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr || n->type != GdbMiValue::Const) {
+        if (ok) {
+            *ok = false;
+        }
+        return 0;
+    }
+
+    // No copy. Just a view on the buffer.
+    return QByteArray::fromRawData(_data->buffer.constData() + n->start, n->length).toInt(ok, base);
+}
+
+qulonglong GdbMiValue::toULongLong (bool* ok, int base) const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr || n->type != GdbMiValue::Const) {
+        if (ok) {
+            *ok = false;
+        }
+        return 0;
+    }
+
+    return QByteArray::fromRawData(_data->buffer.constData() + n->start, n->length).toULongLong(ok, base);
+}
+
+bool GdbMiValue::equals (const char* str) const {
+
+    const GdbMiNode* n = node();
+
+    if (n == nullptr) {
+        return false;
+    }
+
+    int len = (int)strlen(str);
+
+    if (len != n->length) {
+        return false;
+    }
+
+    return memcmp(_data->buffer.constData() + n->start, str, len) == 0;
+}
+
+//
+// GdbMiRecord
+//
+
+GdbMiRecord::GdbMiRecord () : _recordType(GdbMiRecord::UnknownRecord), _token(-1), _classStart(0), _classLength(0), _root(-1), _valid(false) {
+}
+
+bool GdbMiRecord::isValid () const {
+    return _valid;
+}
+
+bool GdbMiRecord::isStream () const {
+    return _recordType == ConsoleStreamRecord || _recordType == TargetStreamRecord || _recordType == LogStreamRecord;
+}
+
+bool GdbMiRecord::isAsync () const {
+    return _recordType == ExecAsyncRecord || _recordType == StatusAsyncRecord || _recordType == NotifyAsyncRecord;
+}
+
+GdbMiRecord::RecordType GdbMiRecord::recordType () const {
+    return _recordType;
+}
+
+bool GdbMiRecord::hasToken () const {
+    return _token >= 0;
+}
+
+int GdbMiRecord::token () const {
+    return _token;
+}
+
+QString GdbMiRecord::recordClass () const {
+
+    if (_data.isNull()) {
+        return QString();
+    }
+
+    return QString::fromLatin1(_data->buffer.constData() + _classStart, _classLength);
+}
+
+bool GdbMiRecord::isRecordClass (const char* recordClass) const {
+
+    if (_data.isNull()) {
+        return false;
+    }
+
+    int len = (int)strlen(recordClass);
+
+    if (len != _classLength) {
+        return false;
+    }
+
+    return memcmp(_data->buffer.constData() + _classStart, recordClass, len) == 0;
+}
+
+GdbMiValue GdbMiRecord::results () const {
+
+    if (_data.isNull()) {
+        return GdbMiValue();
+    }
+
+    return GdbMiValue(_data, _root);
+}
+
+GdbMiValue GdbMiRecord::value (const char* name) const {
+    return results().value(name);
+}
+
+GdbMiValue GdbMiRecord::operator[] (const char* name) const {
+    return value(name);
+}
+
+QString GdbMiRecord::streamText () const {
+
+    if (isStream() == false) {
+        return QString();
+    }
+
+    return results().toString();
+}
+
+const QByteArray& GdbMiRecord::buffer () const {
+
+    static const QByteArray empty;
+
+    if (_data.isNull()) {
+        return empty;
+    }
+
+    return _data->buffer;
+}
+
+QString GdbMiRecord::text () const {
+    return QString::fromUtf8(buffer());
+}
+
+//
+// GdbMiParser
+//
+
+GdbMiRecord GdbMiParser::parse (const QByteArray& line) {
+
+    QSharedPointer<GdbMiData> data = QSharedPointer<GdbMiData>::create();
+
+    data->buffer = line;
+
+    return parseRecord(data);
+}
+
+GdbMiRecord GdbMiParser::parse (const QByteArray& chunk, int start, int length) {
+
+    QSharedPointer<GdbMiData> data = QSharedPointer<GdbMiData>::create();
+
+    // Don't copy the record out of the chunk. Refer to it in place and keep
+    // the chunk alive for as long as the record is.
+    data->chunk  = chunk;
+    data->buffer = QByteArray::fromRawData(data->chunk.constData() + start, length);
+
+    return parseRecord(data);
+}
+
+GdbMiRecord GdbMiParser::parseRecord (const QSharedPointer<GdbMiData>& data) {
+
+    GdbMiRecord record;
+
+    record._data = data;
+
+    const char* buffer = record._data->buffer.constData();
+    int         length = record._data->buffer.size();
+    int         pos    = 0;
+
+    // Rough guess at the number of nodes. Saves a few reallocations on big replies.
+    record._data->nodes.reserve(8 + length / 24);
+
+    // Optional token.
+    if (pos < length && buffer[pos] >= '0' && buffer[pos] <= '9') {
+
+        qint64 token = 0;
+
+        // A token too big for an int is read past, but the record doesn't get one.
+        while (pos < length && buffer[pos] >= '0' && buffer[pos] <= '9') {
+
+            if (token <= INT_MAX) {
+                token = token * 10 + (buffer[pos] - '0');
+            }
+
+            pos++;
+        }
+
+        if (token <= INT_MAX) {
+            record._token = (int)token;
+        }
+    }
+
+    if (pos >= length) {
+        return record;
+    }
+
+    char c = buffer[pos];
+
+    if (c != '^' && c != '*' && c != '+' && c != '=' && c != '~' && c != '@' && c != '&') {
+        return record;
+    }
+
+    record._recordType = (GdbMiRecord::RecordType)c;
+    pos++;
+
+    MiParser parser(buffer, length, record._data->nodes);
+
+    // Stream records are a single c-string.
+    if (record.isStream()) {
+
+        if (pos >= length || buffer[pos] != '"') {
+            return record;
+        }
+
+        parser.setPos(pos);
+
+        record._root  = parser.parseConst(-1, 0);
+        record._valid = record._root >= 0;
+
+        return record;
+    }
+
+    // Result and async records. Get the class then the list of results.
+    record._classStart = pos;
+
+    while (pos < length && buffer[pos] != ',') {
+        pos++;
+    }
+
+    record._classLength = pos - record._classStart;
+
+    if (pos < length) {
+        pos++; // Past the ','.
+    }
+
+    record._root  = parser.parseResults(pos);
+    record._valid = record._root >= 0;
+
+    if (record._valid == false) {
+        qCWarning(LC) << "Can't parse MI record:" << QByteArray(buffer, qMin(length, 200));
+    }
+
+    return record;
+}
+
+GdbMiRecord GdbMiParser::parse (const QString& line) {
+    return parse(line.toUtf8());
+}
+
+QByteArray GdbMiParser::unescape (const char* str, int length) {
+
+    // Remove the c-string escaping gdb puts on const values.
+    //
+    //     \"Hello\\n\"     =>  "Hello\n"
+    //     \302\251         =>  the UTF-8 bytes 0xc2 0xa9
+    //
+    QByteArray result;
+    result.reserve(length);
+
+    for (int i=0; i<length; i++) {
+
+        char c = str[i];
+
+        if (c != '\\' || i+1 >= length) {
+            result.append(c);
+            continue;
+        }
+
+        i++;
+        c = str[i];
+
+        switch (c) {
+            case 'n':  result.append('\n'); break;
+            case 't':  result.append('\t'); break;
+            case 'r':  result.append('\r'); break;
+            case 'f':  result.append('\f'); break;
+            case 'v':  result.append('\v'); break;
+            case 'a':  result.append('\a'); break;
+            case 'b':  result.append('\b'); break;
+            case 'e':  result.append('\033'); break;
+
+            case '0': case '1': case '2': case '3':
+            case '4': case '5': case '6': case '7':
+            {
+                int value = 0;
+                int n     = 0;
+
+                while (n < 3 && i < length && str[i] >= '0' && str[i] <= '7') {
+                    value = value * 8 + (str[i] - '0');
+                    i++;
+                    n++;
+                }
+
+                i--; // The loop increments it again.
+
+                result.append((char)value);
+                break;
+            }
+
+            default:   result.append(c); break; // \" \\ and anything else.
+        }
+    }
+
+    return result;
+}
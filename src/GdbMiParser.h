@@ -0,0 +1,169 @@
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QByteArray>
+#include <QtCore/QVector>
+#include <QtCore/QSharedPointer>
+
+//
+// Single pass parser for GDB/MI output records.
+//
+// A line like:
+//
+//     12^done,threads=[{id="1",target-id="Thread 0x7ffff7fbd740",frame={level="0",func="main"}}],current-thread-id="1"
+//
+// is parsed once into a flat tree of tuple/list/const nodes. The nodes only hold
+// offsets into the record's buffer, so no strings are created until a value
+// is actually asked for.
+//
+//     GdbMiRecord record = GdbMiParser::parse(line);
+//
+//     for (const GdbMiValue& thread : record["threads"]) {
+//         QString id   = thread["id"].toString();
+//         QString func = thread["frame"]["func"].toString();
+//     }
+//
+// Values and records are cheap to copy. They share the buffer and the node table.
+//
+
+struct GdbMiNode {
+    int                             type;
+    int                             nameStart;
+    int                             nameLength;
+    int                             start;
+    int                             length;
+    int                             firstChild;
+    int                             nextSibling;
+    int                             childCount;
+};
+
+struct GdbMiData {
+    QByteArray                      buffer;     // The record's text. May refer into 'chunk'.
+    QByteArray                      chunk;      // The read chunk the record was framed in, if any.
+    QVector<GdbMiNode>              nodes;
+};
+
+class GdbMiValue {
+
+    public:
+        enum Type {
+            Invalid = 0,
+            Const   = 1,
+            Tuple   = 2,
+            List    = 3
+        };
+
+        class const_iterator {
+            public:
+                const_iterator (const QSharedPointer<const GdbMiData>& data, int index);
+
+                GdbMiValue                  operator*                       () const;
+                const_iterator&             operator++                      ();
+                bool                        operator==                      (const const_iterator& other) const;
+                bool                        operator!=                      (const const_iterator& other) const;
+
+            private:
+                QSharedPointer<const GdbMiData> _data;
+                int                             _index;
+        };
+
+        GdbMiValue ();
+        GdbMiValue (const QSharedPointer<const GdbMiData>& data, int index);
+
+        GdbMiValue::Type                type                            () const;
+        bool                            isValid                         () const;
+        bool                            isConst                         () const;
+        bool                            isTuple                         () const;
+        bool                            isList                          () const;
+
+        QString                         name                            () const;
+        bool                            hasName                         (const char* name) const;
+
+        int                             size                            () const;
+        bool                            isEmpty                         () const;
+        GdbMiValue                      at                              (int i) const;
+        GdbMiValue                      value                           (const char* name) const;
+        GdbMiValue                      operator[]                      (const char* name) const;
+        bool                            contains                        (const char* name) const;
+        GdbMiValue                      firstChild                      () const;
+        GdbMiValue                      nextSibling                     () const;
+        const_iterator                  begin                           () const;
+        const_iterator                  end                             () const;
+
+        QString                         toString                        () const;
+        QString                         toString                        (const QString& defaultValue) const;
+        QStringList                     toStringList                    () const;
+        QByteArray                      toByteArray                     () const;
+        QString                         rawText                         () const;
+        const char*                     rawData                         () const;
+        int                             rawLength                       () const;
+        int                             toInt                           (bool* ok = nullptr, int base = 10) const;
+        qulonglong                      toULongLong                     (bool* ok = nullptr, int base = 10) const;
+        bool                            equals                          (const char* str) const;
+
+    private:
+        const GdbMiNode*                node                            () const;
+
+        QSharedPointer<const GdbMiData> _data;
+        int                             _index;
+};
+
+class GdbMiRecord {
+
+    public:
+        enum RecordType {
+            UnknownRecord       = 0,
+            ResultRecord        = '^',
+            ExecAsyncRecord     = '*',
+            StatusAsyncRecord   = '+',
+            NotifyAsyncRecord   = '=',
+            ConsoleStreamRecord = '~',
+            TargetStreamRecord  = '@',
+            LogStreamRecord     = '&'
+        };
+
+        GdbMiRecord ();
+
+        bool                            isValid                         () const;
+        bool                            isStream                        () const;
+        bool                            isAsync                         () const;
+        GdbMiRecord::RecordType         recordType                      () const;
+        bool                            hasToken                        () const;
+        int                             token                           () const;
+        QString                         recordClass                     () const;
+        bool                            isRecordClass                   (const char* recordClass) const;
+
+        GdbMiValue                      results                         () const;
+        GdbMiValue                      value                           (const char* name) const;
+        GdbMiValue                      operator[]                      (const char* name) const;
+        QString                         streamText                      () const;
+
+        const QByteArray&               buffer                          () const;
+        QString                         text                            () const;
+
+    private:
+        friend class GdbMiParser;
+
+        QSharedPointer<GdbMiData>       _data;
+        RecordType                      _recordType;
+        int                             _token;
+        int                             _classStart;
+        int                             _classLength;
+        int                             _root;
+        bool                            _valid;
+};
+
+class GdbMiParser {
+
+    public:
+        static GdbMiRecord              parse                           (const QByteArray& line);
+        static GdbMiRecord              parse                           (const QString& line);
+        static GdbMiRecord              parse                           (const QByteArray& chunk, int start, int length);
+
+        static QByteArray               unescape                        (const char* str, int length);
+
+    private:
+        static GdbMiRecord              parseRecord                     (const QSharedPointer<GdbMiData>& data);
+};
+
@@ -0,0 +1,150 @@
+#include "GdbMiReader.h"
+#include <QtCore/QDebug>
+#include <string.h>
+
+GdbMiReader::GdbMiReader (int chunkSize) {
+
+    _chunkSize = chunkSize;
+    _start     = 0;
+    _end       = 0;
+    _bytesRead = 0;
+}
+
+qint64 GdbMiReader::read (QIODevice* device) {
+
+    qint64 total = 0;
+
+    // Take everything that is there in as few reads as possible.
+    while (device->bytesAvailable() > 0) {
+
+        qint64 available = device->bytesAvailable();
+        char*  ptr       = reserve(available);
+        qint64 n         = device->read(ptr, available);
+
+        if (n <= 0) {
+            break;
+        }
+
+        _end       += (int)n;
+        _bytesRead += n;
+        total      += n;
+    }
+
+    return total;
+}
+
+qint64 GdbMiReader::append (const char* data, qint64 size) {
+
+    char* ptr = reserve(size);
+
+    memcpy(ptr, data, size);
+
+    _end       += (int)size;
+    _bytesRead += size;
+
+    return size;
+}
+
+bool GdbMiReader::next (int* start, int* length) {
+
+    if (_start >= _end) {
+        return false;
+    }
+
+    const char* base = _chunk.constData();
+    const char* nl   = (const char*)memchr(base + _start, '\n', _end - _start);
+
+    // Only part of a record so far. Wait for the rest.
+    if (nl == 0) {
+        return false;
+    }
+
+    int s = _start;
+    int l = (int)(nl - base) - s;
+
+    // Lose the RETURN of a RETURN+NEWLINE.
+    if (l > 0 && base[s+l-1] == '\r') {
+        l--;
+    }
+
+    _start = (int)(nl - base) + 1;
+
+    *start  = s;
+    *length = l;
+
+    return true;
+}
+
+const QByteArray& GdbMiReader::chunk () const {
+    return _chunk;
+}
+
+int GdbMiReader::pending () const {
+    return _end - _start;
+}
+
+qint64 GdbMiReader::bytesRead () const {
+    return _bytesRead;
+}
+
+void GdbMiReader::clear () {
+
+    _chunk  = QByteArray();
+    _spare  = QByteArray();
+    _start  = 0;
+    _end    = 0;
+}
+
+//
+// Return a place to write 'size' more bytes after the unframed data.
+//
+char* GdbMiReader::reserve (qint64 size) {
+
+    int carry = _end - _start;
+
+    // Nobody refers to the current chunk. It can be written to.
+    if (_chunk.isDetached()) {
+
+        // Nothing left to frame. Start over at the beginning.
+        if (carry == 0) {
+            _start = 0;
+            _end   = 0;
+        }
+
+        // Room at the end?
+        if (_end + size <= _chunk.size()) {
+            return _chunk.data() + _end;
+        }
+
+        // Room if the partial record is moved to the front?
+        if (carry + size <= _chunk.size()) {
+            memmove(_chunk.data(), _chunk.constData() + _start, carry);
+            _start = 0;
+            _end   = carry;
+            return _chunk.data() + _end;
+        }
+    }
+
+    // Switch chunks. Use the spare one if it is free and big enough.
+    QByteArray chunk;
+
+    if (_spare.isDetached() && _spare.size() >= carry + size) {
+        chunk.swap(_spare);
+    }else{
+        chunk = QByteArray((int)qMax<qint64>(carry + size, _chunkSize), Qt::Uninitialized);
+    }
+
+    // Carry over the partial record.
+    if (carry > 0) {
+        memcpy(chunk.data(), _chunk.constData() + _start, carry);
+    }
+
+    _spare.swap(_chunk);
+    _chunk.swap(chunk);
+
+    _start = 0;
+    _end   = carry;
+
+    return _chunk.data() + _end;
+}
+
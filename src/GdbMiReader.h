@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QIODevice>
+
+//
+// Reads gdb's MI output in big chunks and frames the records in place.
+//
+// Everything the device has available is read into the current chunk with a
+// single read. Records are then found with memchr() and handed out as
+// (start, length) offsets into chunk(). Nothing is converted to a QString.
+//
+//     reader.read(process);
+//
+//     while (reader.next(&start, &length)) {
+//         GdbMiRecord record = GdbMiParser::parse(reader.chunk(), start, length);
+//     }
+//
+// Records parsed this way share the chunk instead of copying out of it. A chunk
+// is only written to again once no record refers to it. Otherwise a fresh chunk
+// is started and the partial record at the end of the old one is carried over.
+// The two chunks take turns, like the halves of a ring buffer.
+//
+
+class GdbMiReader {
+
+    public:
+        GdbMiReader (int chunkSize = 256 * 1024);
+
+        qint64                          read                            (QIODevice* device);
+        qint64                          append                          (const char* data, qint64 size);
+        bool                            next                            (int* start, int* length);
+        const QByteArray&               chunk                           () const;
+        int                             pending                         () const;
+        qint64                          bytesRead                       () const;
+        void                            clear                           ();
+
+    private:
+        char*                           reserve                         (qint64 size);
+
+        QByteArray                      _chunk;
+        QByteArray                      _spare;
+        int                             _chunkSize;
+        int                             _start;
+        int                             _end;
+        qint64                          _bytesRead;
+};
+
@@ -8,7 +8,12 @@
 static QLoggingCategory LC("seer.gdbmonitor");
 
 GdbMonitor::GdbMonitor (QObject* parent) : QObject(parent) {
-    _process = 0;
+    _process         = 0;
+    _pendingCommands = 0;
+    _commandCount    = 0;
+    _recordCount     = 0;
+    _deliveredCount  = 0;
+    _consumedCount   = 0;
 }
 
 GdbMonitor::~GdbMonitor () {
@@ -65,57 +70,55 @@ void GdbMonitor::handleReadyReadStandardOutput () {
 
     QProcess* p = (QProcess*)sender();
 
-    // Read a line at a time.
-    while (p->canReadLine()) {
+    // Read all that is there in one go.
+    qint64 n = _reader.read(p);
 
-        QByteArray buf = p->readLine();
+    qCDebug(LC) << "Read" << n << "bytes";
 
-        // Chop off trailing RETURN character.
-        if (buf[buf.size()-1] == '\n') {
-            buf.chop(1);
-        }
+    // Frame the records in place. Only whole lines are returned.
+    int start  = 0;
+    int length = 0;
 
-        if (buf.size() == 0) { // Ignore empty lines.
+    while (_reader.next(&start, &length)) {
+
+        if (length == 0) { // Ignore empty lines.
             continue;
         }
 
-        // Convert to a string.
-        QString text(buf);
+        GdbMiRecord record = GdbMiParser::parse(_reader.chunk(), start, length);
 
-        //qDebug() << "Read buffer" << buf.size() << (int)buf[buf.size()-1] << text;
-        qCDebug(LC) << text;
+        qCDebug(LC) << record.buffer();
 
-        // Start broadcasting it around.
-        emit allTextOutput(text);
+        dispatch(record, QString());
 
-        if (text[0] == '~') {
-            emit tildeTextOutput(text);
-        }else if (text[0] == '=') {
-            emit equalTextOutput(text);
-        }else if (text[0] == '*') {
-            emit astrixTextOutput(text);
-        }else if (text[0] == '^') {
-            emit caretTextOutput(text);
-        }else if (text[0] == '&') {
-            emit ampersandTextOutput(text);
-        }else if (text[0] == '@') {
-            emit atsignTextOutput(text);
-        }else if (text.contains(QRegularExpression("^([0-9]+)\\~"))) {
-            emit tildeTextOutput(text);
-        }else if (text.contains(QRegularExpression("^([0-9]+)\\="))) {
-            emit equalTextOutput(text);
-        }else if (text.contains(QRegularExpression("^([0-9]+)\\*"))) {
-            emit astrixTextOutput(text);
-        }else if (text.contains(QRegularExpression("^([0-9]+)\\^"))) {
-            emit caretTextOutput(text);
-        }else if (text.contains(QRegularExpression("^([0-9]+)\\&"))) {
-            emit ampersandTextOutput(text);
-        }else{
-            emit textOutput(text);
+        // Every command gets exactly one result record. gdb answers in order, so a
+        // cancelled command's result comes before that of a later one with its token.
+        if (record.recordType() == GdbMiRecord::ResultRecord) {
+
+            int token = record.token();
+
+            if (_cancelledTokens.contains(token)) {
+
+                if (--_cancelledTokens[token] == 0) {
+                    _cancelledTokens.remove(token);
+                }
+
+            }else if (_pendingTokens.contains(token)) {
+
+                if (--_pendingTokens[token] == 0) {
+                    _pendingTokens.remove(token);
+                }
+
+                _pendingCommands--;
+
+                if (_pendingCommands == 0) {
+                    emit commandsFinished();
+                }
+            }
         }
     }
 
-    qCDebug(LC) << "Finished reading stdout";
+    qCDebug(LC) << "Finished reading stdout. records" << _recordCount << "delivered" << _deliveredCount << "consumed" << _consumedCount;
 }
 
 void GdbMonitor::handleTextOutput (QString text) {
@@ -123,35 +126,324 @@ void GdbMonitor::handleTextOutput (QString text) {
     qCDebug(LC) << "Ready to handle text output";
     qCDebug(LC) << text;
 
-    emit allTextOutput(text);
-
-    if (text[0] == '~') {
-        emit tildeTextOutput(text);
-    }else if (text[0] == '=') {
-        emit equalTextOutput(text);
-    }else if (text[0] == '*') {
-        emit astrixTextOutput(text);
-    }else if (text[0] == '^') {
-        emit caretTextOutput(text);
-    }else if (text[0] == '&') {
-        emit ampersandTextOutput(text);
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\~"))) {
-        emit tildeTextOutput(text);
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\="))) {
-        emit equalTextOutput(text);
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\*"))) {
-        emit astrixTextOutput(text);
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^"))) {
-        emit caretTextOutput(text);
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\&"))) {
-        emit ampersandTextOutput(text);
-    }else{
-        emit textOutput(text);
-    }
+    dispatch(GdbMiParser::parse(text.toUtf8()), text);
 
     qCDebug(LC) << "Finished handling text output";
 }
 
+//
+// The record stays UTF-8 until something that wants text is connected.
+//
+static const QString& recordText (const GdbMiRecord& record, QString& text) {
+
+    if (text.isNull()) {
+        text = record.text();
+    }
+
+    return text;
+}
+
+//
+// The text of a record without its token.
+//
+static QString strippedText (const GdbMiRecord& record) {
+
+    const QByteArray& buffer = record.buffer();
+
+    int i = 0;
+
+    while (i < buffer.size() && buffer[i] >= '0' && buffer[i] <= '9') {
+        i++;
+    }
+
+    return QString::fromUtf8(buffer.constData() + i, buffer.size() - i);
+}
+
+void GdbMonitor::dispatch (const GdbMiRecord& record, QString text) {
+
+    _recordCount++;
+
+    // The token is Seer's own. Nobody matching on text expects it.
+    if (record.hasToken() && _strippedTokens.contains(record.token())) {
+
+        text = strippedText(record);
+
+        if (record.recordType() == GdbMiRecord::ResultRecord) {
+            _strippedTokens.remove(record.token());
+        }
+    }
+
+    int n = receivers(SIGNAL(allTextOutput(QString)));
+
+    if (n > 0) {
+        emit allTextOutput(recordText(record, text));
+        _deliveredCount += n;
+    }
+
+    // Give it to the subscriber that asked for it. If it was consumed, it is
+    // only passed on to the logs.
+    if (route(record)) {
+
+        n = receivers(SIGNAL(routedTextOutput(QString)));
+
+        if (n > 0) {
+            emit routedTextOutput(recordText(record, text));
+            _deliveredCount += n;
+        }
+
+        return;
+    }
+
+    // Otherwise, start broadcasting it around.
+    broadcast(record, text);
+}
+
+bool GdbMonitor::route (const GdbMiRecord& record) {
+
+    bool consumed = false;
+
+    // Result records are routed by the token of the command that caused them.
+    if (record.recordType() == GdbMiRecord::ResultRecord && record.hasToken() && _tokenHandlers.contains(record.token())) {
+
+        // Take a copy. A handler may add or remove handlers.
+        QList<Handler> handlers = _tokenHandlers.values(record.token());
+
+        for (const auto& h : handlers) {
+
+            if (h.receiver.isNull()) {
+                continue;
+            }
+
+            _deliveredCount++;
+
+            if (h.handler(record)) {
+                _consumedCount++;
+                consumed = true;
+            }
+        }
+    }
+
+    // Async records are routed by their class.
+    if (record.isAsync() && _classHandlers.size() > 0) {
+
+        QVector<ClassHandler> handlers;
+
+        for (const auto& h : _classHandlers) {
+            if (h.recordType == record.recordType() && record.isRecordClass(h.recordClass.constData())) {
+                handlers.push_back(h);
+            }
+        }
+
+        for (const auto& h : handlers) {
+
+            if (h.receiver.isNull()) {
+                continue;
+            }
+
+            _deliveredCount++;
+
+            if (h.handler(record)) {
+                _consumedCount++;
+                consumed = true;
+            }
+        }
+    }
+
+    return consumed;
+}
+
+void GdbMonitor::broadcast (const GdbMiRecord& record, QString& text) {
+
+    switch (record.recordType()) {
+
+        case GdbMiRecord::ConsoleStreamRecord:
+            if (int n = receivers(SIGNAL(tildeTextOutput(QString)))) {
+                emit tildeTextOutput(recordText(record, text));
+                _deliveredCount += n;
+            }
+            break;
+
+        case GdbMiRecord::NotifyAsyncRecord:
+            if (int n = receivers(SIGNAL(equalTextOutput(QString)))) {
+                emit equalTextOutput(recordText(record, text));
+                _deliveredCount += n;
+            }
+            break;
+
+        case GdbMiRecord::ExecAsyncRecord:
+            if (int n = receivers(SIGNAL(astrixTextOutput(QString)))) {
+                emit astrixTextOutput(recordText(record, text));
+                _deliveredCount += n;
+            }
+            break;
+
+        case GdbMiRecord::ResultRecord:
+            if (int n = receivers(SIGNAL(caretTextOutput(QString)))) {
+                emit caretTextOutput(recordText(record, text));
+                _deliveredCount += n;
+            }
+            break;
+
+        case GdbMiRecord::LogStreamRecord:
+            if (int n = receivers(SIGNAL(ampersandTextOutput(QString)))) {
+                emit ampersandTextOutput(recordText(record, text));
+                _deliveredCount += n;
+            }
+            break;
+
+        case GdbMiRecord::TargetStreamRecord:
+            if (int n = receivers(SIGNAL(atsignTextOutput(QString)))) {
+                emit atsignTextOutput(recordText(record, text));
+                _deliveredCount += n;
+            }
+            break;
+
+        default:
+            if (int n = receivers(SIGNAL(textOutput(QString)))) {
+                emit textOutput(recordText(record, text));
+                _deliveredCount += n;
+            }
+            break;
+    }
+}
+
+void GdbMonitor::addTokenHandler (int token, QObject* receiver, GdbMiRecordHandler handler) {
+
+    Handler h;
+    h.receiver = receiver;
+    h.handler  = handler;
+
+    _tokenHandlers.insert(token, h);
+
+    watchReceiver(receiver);
+}
+
+void GdbMonitor::removeTokenHandler (int token) {
+
+    _tokenHandlers.remove(token);
+}
+
+void GdbMonitor::removeTokenHandler (int token, QObject* receiver) {
+
+    auto it = _tokenHandlers.find(token);
+
+    while (it != _tokenHandlers.end() && it.key() == token) {
+        if (it.value().receiver == receiver || it.value().receiver.isNull()) {
+            it = _tokenHandlers.erase(it);
+        }else{
+            ++it;
+        }
+    }
+}
+
+void GdbMonitor::stripToken (int token) {
+
+    _strippedTokens.insert(token);
+}
+
+void GdbMonitor::addRecordClassHandler (GdbMiRecord::RecordType recordType, const char* recordClass, QObject* receiver, GdbMiRecordHandler handler) {
+
+    ClassHandler h;
+    h.recordType  = recordType;
+    h.recordClass = recordClass;
+    h.receiver    = receiver;
+    h.handler     = handler;
+
+    _classHandlers.push_back(h);
+
+    watchReceiver(receiver);
+}
+
+void GdbMonitor::removeHandlers (QObject* receiver) {
+
+    auto it = _tokenHandlers.begin();
+
+    while (it != _tokenHandlers.end()) {
+        if (it.value().receiver == receiver || it.value().receiver.isNull()) {
+            it = _tokenHandlers.erase(it);
+        }else{
+            ++it;
+        }
+    }
+
+    for (int i=_classHandlers.size()-1; i>=0; i--) {
+        if (_classHandlers[i].receiver == receiver || _classHandlers[i].receiver.isNull()) {
+            _classHandlers.remove(i);
+        }
+    }
+}
+
+void GdbMonitor::watchReceiver (QObject* receiver) {
+
+    if (receiver == 0 || _receivers.contains(receiver)) {
+        return;
+    }
+
+    _receivers.push_back(receiver);
+
+    QObject::connect(receiver, &QObject::destroyed, this, &GdbMonitor::handleReceiverDestroyed);
+}
+
+void GdbMonitor::handleReceiverDestroyed (QObject* receiver) {
+
+    _receivers.removeAll(receiver);
+
+    removeHandlers(receiver);
+}
+
+void GdbMonitor::commandSent (int token) {
+
+    _pendingTokens[token]++;
+    _pendingCommands++;
+    _commandCount++;
+}
+
+int GdbMonitor::pendingCommands () const {
+    return _pendingCommands;
+}
+
+void GdbMonitor::cancelPendingCommands () {
+
+    // Their results may still come. Don't count them against later commands.
+    for (auto i=_pendingTokens.constBegin(); i!=_pendingTokens.constEnd(); ++i) {
+        _cancelledTokens[i.key()] += i.value();
+    }
+
+    _pendingTokens.clear();
+    _pendingCommands = 0;
+}
+
+void GdbMonitor::clearPendingCommands () {
+
+    // Nothing more is coming back (gdb is gone).
+    _pendingTokens.clear();
+    _cancelledTokens.clear();
+    _pendingCommands = 0;
+}
+
+quint64 GdbMonitor::commandCount () const {
+    return _commandCount;
+}
+
+quint64 GdbMonitor::recordCount () const {
+    return _recordCount;
+}
+
+quint64 GdbMonitor::deliveredCount () const {
+    return _deliveredCount;
+}
+
+quint64 GdbMonitor::consumedCount () const {
+    return _consumedCount;
+}
+
+void GdbMonitor::resetCounters () {
+
+    _recordCount    = 0;
+    _deliveredCount = 0;
+    _consumedCount  = 0;
+}
+
 void GdbMonitor::handleStarted() {
 
     qCDebug(LC);
@@ -1,8 +1,22 @@
 #ifndef GdbMonitor_H
 #define GdbMonitor_H
 
+#include "GdbMiParser.h"
+#include "GdbMiReader.h"
 #include <QtCore/QObject>
 #include <QtCore/QtCore>
+#include <QtCore/QPointer>
+#include <QtCore/QMultiHash>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QVector>
+#include <functional>
+
+//
+// Handler for a routed MI record. Return true if the record was consumed.
+// A consumed record is not broadcast on the xxxTextOutput signals.
+//
+typedef std::function<bool (const GdbMiRecord& record)> GdbMiRecordHandler;
 
 class GdbMonitor : public QObject {
 
@@ -15,6 +29,46 @@ class GdbMonitor : public QObject {
         void            setProcess                      (QProcess* process);
         QProcess*       process                         ();
 
+        // Route result records with 'token' to 'handler'. The handler is removed when 'receiver' is destroyed.
+        void            addTokenHandler                 (int token, QObject* receiver, GdbMiRecordHandler handler);
+        void            removeTokenHandler              (int token);
+        void            removeTokenHandler              (int token, QObject* receiver);
+
+        // Seer put 'token' on a command that was sent without one. Take it off the
+        // text of the records it comes back on ("12^done" -> "^done").
+        void            stripToken                      (int token);
+
+        // Route async records of a class ('*' "stopped", '=' "breakpoint-created", ...) to 'handler'.
+        void            addRecordClassHandler           (GdbMiRecord::RecordType recordType, const char* recordClass, QObject* receiver, GdbMiRecordHandler handler);
+
+        template <typename T>
+        void            addTokenHandler                 (int token, T* receiver, bool (T::*method)(const GdbMiRecord&)) {
+            addTokenHandler(token, receiver, [receiver, method](const GdbMiRecord& record) { return (receiver->*method)(record); });
+        }
+
+        template <typename T>
+        void            addRecordClassHandler           (GdbMiRecord::RecordType recordType, const char* recordClass, T* receiver, bool (T::*method)(const GdbMiRecord&)) {
+            addRecordClassHandler(recordType, recordClass, receiver, [receiver, method](const GdbMiRecord& record) { return (receiver->*method)(record); });
+        }
+
+        void            removeHandlers                  (QObject* receiver);
+
+        // Commands written to gdb that have not had their result record yet, by token.
+        // 'commandsFinished' is emitted when the last one gets its result record.
+        // Cancelled commands aren't waited for. Their results are ignored when they come.
+        void            commandSent                     (int token);
+        int             pendingCommands                 () const;
+        void            cancelPendingCommands           ();
+        void            clearPendingCommands            ();
+        quint64         commandCount                    () const;
+
+        // Counters. 'delivered' is the number of times a record was handed to a handler or
+        // a connected slot. 'consumed' is the number of times a handler said the record was its.
+        quint64         recordCount                     () const;
+        quint64         deliveredCount                  () const;
+        quint64         consumedCount                   () const;
+        void            resetCounters                   ();
+
     signals:
         void            allTextOutput                   (const QString& text);
         void            tildeTextOutput                 (const QString& text);
@@ -24,6 +78,8 @@ class GdbMonitor : public QObject {
         void            ampersandTextOutput             (const QString& text);
         void            atsignTextOutput                (const QString& text);
         void            textOutput                      (const QString& text);
+        void            routedTextOutput                (const QString& text);
+        void            commandsFinished                ();
 
     public slots:
         void            handleErrorOccurred             (QProcess::ProcessError error);
@@ -34,8 +90,40 @@ class GdbMonitor : public QObject {
         void            handleStateChanged              (QProcess::ProcessState newState);
         void            handleTextOutput                (QString text);
 
+    private slots:
+        void            handleReceiverDestroyed         (QObject* receiver);
+
     private:
-        QProcess*       _process;
+        struct Handler {
+            QPointer<QObject>               receiver;
+            GdbMiRecordHandler              handler;
+        };
+
+        struct ClassHandler {
+            GdbMiRecord::RecordType         recordType;
+            QByteArray                      recordClass;
+            QPointer<QObject>               receiver;
+            GdbMiRecordHandler              handler;
+        };
+
+        void            dispatch                        (const GdbMiRecord& record, QString text);
+        bool            route                           (const GdbMiRecord& record);
+        void            broadcast                       (const GdbMiRecord& record, QString& text);
+        void            watchReceiver                   (QObject* receiver);
+
+        QProcess*                           _process;
+        GdbMiReader                         _reader;
+        QMultiHash<int,Handler>             _tokenHandlers;
+        QVector<ClassHandler>               _classHandlers;
+        QList<QObject*>                     _receivers;
+        QSet<int>                           _strippedTokens;
+        QHash<int,int>                      _pendingTokens;     // Token, commands in flight with it.
+        QHash<int,int>                      _cancelledTokens;   // Token, results still to ignore.
+        int                                 _pendingCommands;
+        quint64                             _commandCount;
+        quint64                             _recordCount;
+        quint64                             _deliveredCount;
+        quint64                             _consumedCount;
 };
 
 #endif
@@ -6,6 +6,7 @@
 #include <QtGui/QImageWriter>
 #include <QtGui/QPainter>
 #include <QtCore/QDebug>
+#include <cstring>
 #include <QtPrintSupport/QPrintDialog>
 
 //
@@ -91,6 +92,38 @@ void QImageViewer::setImage (const QImage& image) {
     zoomReset();
 }
 
+void QImageViewer::updateImage (const QImage& image, int firstRow, int lastRow) {
+
+    // Not the same kind of image. Start over.
+    if (_image.isNull() || image.size() != _image.size() || image.format() != _image.format()) {
+        setImage(image);
+        return;
+    }
+
+    firstRow = qMax(firstRow, 0);
+    lastRow  = qMin(lastRow,  _image.height() - 1);
+
+    if (firstRow > lastRow) {
+        return;
+    }
+
+    // Copy in just the rows that changed. The zoom and scroll position stay as they are.
+    int bytes = qMin(image.bytesPerLine(), _image.bytesPerLine());
+
+    for (int y=firstRow; y<=lastRow; y++) {
+        memcpy(_image.scanLine(y), image.constScanLine(y), bytes);
+    }
+
+    QPixmap pixmap = _imageLabel->pixmap(Qt::ReturnByValue);
+
+    QPainter painter(&pixmap);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.drawImage(QPoint(0, firstRow), _image, QRect(0, firstRow, _image.width(), lastRow - firstRow + 1));
+    painter.end();
+
+    _imageLabel->setPixmap(pixmap);
+}
+
 const QImage& QImageViewer::image () const {
 
     return _image;
@@ -19,6 +19,7 @@ class QImageViewer : public QWidget {
         bool                    saveFile                (const QString& file);
         bool                    saveFileDialog          (const QString& file);
         void                    setImage                (const QImage& image);
+        void                    updateImage             (const QImage& image, int firstRow, int lastRow);
         const QImage&           image                   () const;
         void                    setText                 (const QString& text);
 
@@ -1,5 +1,6 @@
 #include "QZoomChartView.h"
 #include <QtGui/QMouseEvent>
+#include <QtGui/QResizeEvent>
 #include <QtGui/QGuiApplication>
 #include <QtWidgets/QApplication>
 #include <QtCore/QDebug>
@@ -8,16 +9,33 @@
 
 QZoomChartView::QZoomChartView (QWidget* parent) : QChartView(parent) {
 
-    _isDragging = false;
-
-    setRubberBand(QChartView::RectangleRubberBand);
+    init();
 }
 
 QZoomChartView::QZoomChartView (QChart* chart, QWidget* parent) : QChartView(chart, parent) {
 
+    init();
+}
+
+void QZoomChartView::init () {
+
     _isDragging = false;
 
     setRubberBand(QChartView::RectangleRubberBand);
+
+    // A drag or a spin of the wheel is many small changes. Tell about them once.
+    _viewChangedTimer = new QTimer(this);
+    _viewChangedTimer->setSingleShot(true);
+    _viewChangedTimer->setInterval(30);
+
+    QObject::connect(_viewChangedTimer, &QTimer::timeout,    this, &QZoomChartView::viewChanged);
+}
+
+void QZoomChartView::scheduleViewChanged () {
+
+    if (_viewChangedTimer->isActive() == false) {
+        _viewChangedTimer->start();
+    }
 }
 
 void QZoomChartView::printView () {
@@ -84,6 +102,8 @@ void QZoomChartView::mouseMoveEvent (QMouseEvent* event) {
 
             _lastMousePos = event->pos();
 
+            scheduleViewChanged();
+
             event->accept();
         }
     }
@@ -99,6 +119,9 @@ void QZoomChartView::mouseReleaseEvent (QMouseEvent* event) {
     }
 
     QChartView::mouseReleaseEvent(event);
+
+    // The rubber band may have zoomed.
+    scheduleViewChanged();
 }
 
 void QZoomChartView::wheelEvent (QWheelEvent* event) {
@@ -112,6 +135,8 @@ void QZoomChartView::wheelEvent (QWheelEvent* event) {
 
     event->accept();
 
+    scheduleViewChanged();
+
     QChartView::wheelEvent(event);
 }
 
@@ -163,8 +188,10 @@ void QZoomChartView::keyPressEvent (QKeyEvent* event) {
             break;
         default:
             QGraphicsView::keyPressEvent(event);
-            break;
+            return;
     }
+
+    scheduleViewChanged();
 }
 
 void QZoomChartView::enterEvent (QEvent* event) {
@@ -178,3 +205,10 @@ void QZoomChartView::leaveEvent (QEvent* event) {
     Q_UNUSED(event);
 }
 
+void QZoomChartView::resizeEvent (QResizeEvent* event) {
+
+    QChartView::resizeEvent(event);
+
+    scheduleViewChanged();
+}
+
@@ -4,6 +4,7 @@
 #include <QtCharts/QChartView>
 #include <QtWidgets/QRubberBand>
 #include <QtCore/QPointF>
+#include <QtCore/QTimer>
 
 #if QT_VERSION < 0x060000
 using namespace QtCharts;
@@ -11,10 +12,16 @@ using namespace QtCharts;
 
 class QZoomChartView : public QChartView {
 
+    Q_OBJECT
+
     public:
         QZoomChartView (QWidget* parent = 0);
         QZoomChartView (QChart* chart, QWidget* parent = 0);
 
+    signals:
+        // The view was zoomed, panned, or resized. Sent once things settle.
+        void                    viewChanged                 ();
+
     public slots:
         void                    printView                   ();
 
@@ -27,8 +34,13 @@ class QZoomChartView : public QChartView {
         void                    keyPressEvent               (QKeyEvent*   event);
         void                    enterEvent                  (QEvent*      event);
         void                    leaveEvent                  (QEvent*      event);
+        void                    resizeEvent                 (QResizeEvent* event);
 
     private:
+        void                    init                        ();
+        void                    scheduleViewChanged         ();
+
+        QTimer*                 _viewChangedTimer;
         bool                    _isDragging;
         QPointF                 _lastMousePos;
         Qt::KeyboardModifiers   _keyboardModifiers;
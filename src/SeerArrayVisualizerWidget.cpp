@@ -5,6 +5,7 @@
 #include <QtCharts/QLineSeries>
 #include <QtCharts/QSplineSeries>
 #include <QtCharts/QScatterSeries>
+#include <QtCharts/QValueAxis>
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QToolTip>
@@ -16,18 +17,173 @@
 #include <QtCore/QSettings>
 #include <QtCore/QDebug>
 #include <QtGlobal>
+#include <cmath>
+
+//
+// Big arrays are decimated to the width of the chart before they're plotted.
+// Spline series are smoothed curves, which QtCharts is slow to draw, so they get fewer.
+//
+static const int SplineMaxPoints = 1000;
+
+//
+// Min/max decimation of elements [first,last]. Each pixel wide bucket keeps its
+// smallest and largest value, in the order they come. Peaks are never lost.
+//
+template <typename PointAt>
+static void decimateMinMax (int first, int last, int buckets, bool valueIsY, PointAt pointAt, QVector<QPointF>& points) {
+
+    int count = last - first + 1;
+
+    if (count <= 0) {
+        return;
+    }
+
+    // Few enough to plot them all.
+    if (count <= buckets * 2) {
+
+        for (int i=first; i<=last; i++) {
+            points.append(pointAt(i));
+        }
+
+        return;
+    }
+
+    for (int b=0; b<buckets; b++) {
+
+        int start = first + (int)((qint64)count * b / buckets);
+        int end   = first + (int)((qint64)count * (b+1) / buckets);
+
+        if (start >= end) {
+            continue;
+        }
+
+        QPointF minPoint = pointAt(start);
+        QPointF maxPoint = minPoint;
+        int     minIndex = start;
+        int     maxIndex = start;
+
+        for (int i=start+1; i<end; i++) {
+
+            QPointF p = pointAt(i);
+            double  v = valueIsY ? p.y() : p.x();
+
+            if (v < (valueIsY ? minPoint.y() : minPoint.x())) {
+                minPoint = p;
+                minIndex = i;
+            }
+
+            if (v > (valueIsY ? maxPoint.y() : maxPoint.x())) {
+                maxPoint = p;
+                maxIndex = i;
+            }
+        }
+
+        if (minIndex == maxIndex) {
+            points.append(minPoint);
+        }else if (minIndex < maxIndex) {
+            points.append(minPoint);
+            points.append(maxPoint);
+        }else{
+            points.append(maxPoint);
+            points.append(minPoint);
+        }
+    }
+}
+
+//
+// Largest-Triangle-Three-Buckets decimation of elements [first,last] down to 'threshold'
+// points. Keeps the shape of the curve. Used for splines and for X/Y pairs.
+//
+template <typename PointAt>
+static void decimateLttb (int first, int last, int threshold, PointAt pointAt, QVector<QPointF>& points) {
+
+    int count = last - first + 1;
+
+    if (count <= 0) {
+        return;
+    }
+
+    if (threshold < 3 || count <= threshold) {
+
+        for (int i=first; i<=last; i++) {
+            points.append(pointAt(i));
+        }
+
+        return;
+    }
+
+    double bucketSize = (double)(count - 2) / (threshold - 2);
+    int    a          = first;
+
+    points.append(pointAt(first));
+
+    for (int b=0; b<threshold-2; b++) {
+
+        // The average of the next bucket is the third point of the triangle.
+        int nextStart = first + 1 + (int)((b+1) * bucketSize);
+        int nextEnd   = qMin(first + 1 + (int)((b+2) * bucketSize), last + 1);
+
+        double avgX = 0.0;
+        double avgY = 0.0;
+
+        if (nextStart >= nextEnd) {
+            nextStart = last;
+            nextEnd   = last + 1;
+        }
+
+        for (int i=nextStart; i<nextEnd; i++) {
+            QPointF p = pointAt(i);
+            avgX += p.x();
+            avgY += p.y();
+        }
+
+        avgX /= (nextEnd - nextStart);
+        avgY /= (nextEnd - nextStart);
+
+        // Keep the point of this bucket that makes the largest triangle.
+        int     start    = first + 1 + (int)(b * bucketSize);
+        int     end      = first + 1 + (int)((b+1) * bucketSize);
+        QPointF pa       = pointAt(a);
+        double  maxArea  = -1.0;
+        int     maxIndex = start;
+
+        for (int i=start; i<end; i++) {
+
+            QPointF p    = pointAt(i);
+            double  area = qAbs((pa.x() - avgX) * (p.y() - pa.y()) - (pa.x() - p.x()) * (avgY - pa.y()));
+
+            if (area > maxArea) {
+                maxArea  = area;
+                maxIndex = i;
+            }
+        }
+
+        points.append(pointAt(maxIndex));
+
+        a = maxIndex;
+    }
+
+    points.append(pointAt(last));
+}
 
 SeerArrayVisualizerWidget::SeerArrayVisualizerWidget (QWidget* parent) : QWidget(parent) {
 
     // Init variables.
     _aVariableId = Seer::createID(); // Create two id's for queries.
-    _aMemoryId   = Seer::createID();
+    _bVariableId = Seer::createID();
 
-    _bVariableId = Seer::createID(); // Create two id's for queries.
-    _bMemoryId   = Seer::createID();
+    _aSeries         = 0;
+    _bSeries         = 0;
+    _readFailed      = false;
+    _aPartialUpdate  = false;
+    _bPartialUpdate  = false;
 
-    _aSeries     = 0;
-    _bSeries     = 0;
+    // Big arrays are read in chunks. The table and chart are redone once a second while they come in.
+    _aMemoryReader = new SeerMemoryReader(this);
+    _aMemoryReader->setUpdateInterval(1000);
+
+    _bMemoryReader = new SeerMemoryReader(this);
+    _bMemoryReader->setUpdateInterval(1000);
 
     // Set up UI.
     setupUi(this);
@@ -48,6 +204,8 @@ SeerArrayVisualizerWidget::SeerArrayVisualizerWidget (QWidget* parent) : QWidget
     arrayTableWidget->setBAxis(bAxisComboBox->currentText());
 
     lineRadioButton->setChecked(true);
+    readProgressBar->hide();
+    cancelToolButton->hide();
 
     aArrayDisplayFormatComboBox->setCurrentIndex(0);
     bArrayDisplayFormatComboBox->setCurrentIndex(0);
@@ -86,13 +244,32 @@ SeerArrayVisualizerWidget::SeerArrayVisualizerWidget (QWidget* parent) : QWidget
     QObject::connect(aAxisComboBox,                 QOverload<int>::of(&QComboBox::currentIndexChanged),       this,            &SeerArrayVisualizerWidget::handleaAxisComboBox);
     QObject::connect(bAxisComboBox,                 QOverload<int>::of(&QComboBox::currentIndexChanged),       this,            &SeerArrayVisualizerWidget::handlebAxisComboBox);
 
-    QObject::connect(arrayTableWidget,              &SeerArrayWidget::dataChanged,                             this,            &SeerArrayVisualizerWidget::handleDataChanged);
+    QObject::connect(arrayTableWidget,              &SeerArrayWidget::arrayChanged,                            this,            &SeerArrayVisualizerWidget::handleDataChanged);
     QObject::connect(splitter,                      &QSplitter::splitterMoved,                                 this,            &SeerArrayVisualizerWidget::handleSplitterMoved);
     QObject::connect(titleLineEdit,                 &QLineEdit::returnPressed,                                 this,            &SeerArrayVisualizerWidget::handleTitleLineEdit);
     QObject::connect(pointsCheckBox,                &QCheckBox::clicked,                                       this,            &SeerArrayVisualizerWidget::handlePointsCheckBox);
     QObject::connect(labelsCheckBox,                &QCheckBox::clicked,                                       this,            &SeerArrayVisualizerWidget::handleLabelsCheckBox);
     QObject::connect(lineTypeButtonGroup,           QOverload<int>::of(&QButtonGroup::idClicked),              this,            &SeerArrayVisualizerWidget::handleLineTypeButtonGroup);
     QObject::connect(printPushButton,               &QPushButton::clicked,                                     arrayChartView,  &QZoomChartView::printView);
+    QObject::connect(cancelToolButton,              &QToolButton::clicked,                                     this,            &SeerArrayVisualizerWidget::handleCancelButton);
+    QObject::connect(arrayChartView,                &QZoomChartView::viewChanged,                              this,            &SeerArrayVisualizerWidget::handleChartViewChanged);
+    QObject::connect(autoRefreshCheckBox,           &QCheckBox::toggled,                                       this,            &SeerArrayVisualizerWidget::handleAutoRefreshChanged);
+    QObject::connect(refreshIntervalSpinBox,        QOverload<int>::of(&QSpinBox::valueChanged),               this,            &SeerArrayVisualizerWidget::handleAutoRefreshChanged);
+
+    QObject::connect(_aMemoryReader,                &SeerMemoryReader::readMemory,                             this,            &SeerArrayVisualizerWidget::evaluateMemoryExpression);
+    QObject::connect(_aMemoryReader,                &SeerMemoryReader::updated,                                this,            &SeerArrayVisualizerWidget::handleaMemoryUpdated);
+    QObject::connect(_aMemoryReader,                &SeerMemoryReader::chunkFailed,                            this,            &SeerArrayVisualizerWidget::handleChunkFailed);
+    QObject::connect(_aMemoryReader,                &SeerMemoryReader::progress,                               this,            &SeerArrayVisualizerWidget::handleReadProgress);
+    QObject::connect(_aMemoryReader,                &SeerMemoryReader::finished,                               this,            &SeerArrayVisualizerWidget::handleReadProgress);
+    QObject::connect(_aMemoryReader,                &SeerMemoryReader::changed,                                this,            &SeerArrayVisualizerWidget::handleaMemoryChanged);
+    QObject::connect(_aMemoryReader,                &SeerMemoryReader::refreshStarted,                         this,            &SeerArrayVisualizerWidget::handleaRefreshStarted);
+    QObject::connect(_bMemoryReader,                &SeerMemoryReader::readMemory,                             this,            &SeerArrayVisualizerWidget::evaluateMemoryExpression);
+    QObject::connect(_bMemoryReader,                &SeerMemoryReader::updated,                                this,            &SeerArrayVisualizerWidget::handlebMemoryUpdated);
+    QObject::connect(_bMemoryReader,                &SeerMemoryReader::chunkFailed,                            this,            &SeerArrayVisualizerWidget::handleChunkFailed);
+    QObject::connect(_bMemoryReader,                &SeerMemoryReader::progress,                               this,            &SeerArrayVisualizerWidget::handleReadProgress);
+    QObject::connect(_bMemoryReader,                &SeerMemoryReader::finished,                               this,            &SeerArrayVisualizerWidget::handleReadProgress);
+    QObject::connect(_bMemoryReader,                &SeerMemoryReader::changed,                                this,            &SeerArrayVisualizerWidget::handlebMemoryChanged);
+    QObject::connect(_bMemoryReader,                &SeerMemoryReader::refreshStarted,                         this,            &SeerArrayVisualizerWidget::handlebRefreshStarted);
 
     // Restore window settings.
     readSettings();
@@ -289,7 +466,7 @@ void SeerArrayVisualizerWidget::handleText (const QString& text) {
 
     //qDebug() << text;
 
-    if (text.contains(QRegularExpression("^([0-9]+)\\^done,value="))) {
+    if (Seer::matchRecord(text, "^done,value=")) {
 
         // 11^done,value="1"
         // 11^done,value="0x7fffffffd538"
@@ -303,7 +480,7 @@ void SeerArrayVisualizerWidget::handleText (const QString& text) {
 
             // Look for an address in the value.
             if (address == "") {
-                QRegularExpression      re("0[xX][0-9a-fA-F]+");
+                QRegularExpression      re = Seer::regex("0[xX][0-9a-fA-F]+");
                 QRegularExpressionMatch match = re.match(value_text);
 
                 if (match.hasMatch()) {
@@ -313,7 +490,7 @@ void SeerArrayVisualizerWidget::handleText (const QString& text) {
 
             // Look for a number in the value.
             if (address == "") {
-                QRegularExpression      re("[0-9]+");
+                QRegularExpression      re = Seer::regex("[0-9]+");
                 QRegularExpressionMatch match = re.match(value_text);
 
                 if (match.hasMatch()) {
@@ -332,7 +509,7 @@ void SeerArrayVisualizerWidget::handleText (const QString& text) {
 
             // Look for an address in the value.
             if (address == "") {
-                QRegularExpression      re("0[xX][0-9a-fA-F]+");
+                QRegularExpression      re = Seer::regex("0[xX][0-9a-fA-F]+");
                 QRegularExpressionMatch match = re.match(value_text);
 
                 if (match.hasMatch()) {
@@ -342,7 +519,7 @@ void SeerArrayVisualizerWidget::handleText (const QString& text) {
 
             // Look for a number in the value.
             if (address == "") {
-                QRegularExpression      re("[0-9]+");
+                QRegularExpression      re = Seer::regex("[0-9]+");
                 QRegularExpressionMatch match = re.match(value_text);
 
                 if (match.hasMatch()) {
@@ -354,186 +531,260 @@ void SeerArrayVisualizerWidget::handleText (const QString& text) {
             setBVariableAddress(address);
         }
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,memory="))) {
+    }else if (Seer::matchRecord(text, "^error,msg=")) {
 
-        // 3^done,memory=[{begin="0x0000000000613e70",offset="0x0000000000000000",end="0x0000000000613e71",contents="00"}]
-        // 4^done,memory=[{begin="0x0000000000613e70",offset="0x0000000000000000",end="0x0000000000613ed4",contents="000000000000000000000000"}]
+        // 12^error,msg="No symbol \"return\" in current context."
+        // 13^error,msg="No symbol \"cout\" in current context."
+        // 3^error,msg="Unable to read memory."
 
         QString id_text = text.section('^', 0,0);
 
-        if (id_text.toInt() == _aMemoryId) {
-
-            QString memory_text = Seer::parseFirst(text, "memory=", '[', ']', false);
+        if (id_text.toInt() == _aVariableId) {
+            aVariableAddressLineEdit->setText( Seer::filterEscapes(Seer::parseFirst(text, "msg=", '"', '"', false)) );
+        }
 
-            QStringList range_list = Seer::parse(memory_text, "", '{', '}', false);
+        if (id_text.toInt() == _bVariableId) {
+            bVariableAddressLineEdit->setText( Seer::filterEscapes(Seer::parseFirst(text, "msg=", '"', '"', false)) );
+        }
 
-            // Loop through the memory ranges.
-            for ( const auto& range_text : range_list  ) {
+    // At a stopping point, refresh.
+    }else if (text.startsWith("*stopped,reason=\"")) {
 
-                QString contents_text = Seer::parseFirst(range_text, "contents=", '"', '"', false);
+        if (autoRefreshCheckBox->isChecked()) {
+            autoRefresh();
+        }
 
-                // Convert hex string to byte array.
-                QByteArray array;
+    }else{
+        // Ignore anything else.
+    }
+}
 
-                for (int i = 0; i<contents_text.size(); i += 2) {
-                    QString num = contents_text.mid(i, 2);
-                    bool ok = false;
-                    array.push_back(num.toInt(&ok, 16));
-                    Q_ASSERT(ok);
-                }
+void SeerArrayVisualizerWidget::handleaRefreshButton () {
 
-                // Give the byte array to the hex widget.
-                bool ok;
-                arrayTableWidget->setAData(arrayTableWidget->aLabel(), new SeerArrayWidget::DataStorageArray(array));
-
-                if (aArrayOffsetLineEdit->text() != "") {
-                    arrayTableWidget->setAAddressOffset(aArrayOffsetLineEdit->text().toULong(&ok));
-                    if (ok == false) {
-                        qWarning() << "Invalid string for address offset." << aArrayOffsetLineEdit->text();
-                    }
-                }else{
-                    arrayTableWidget->setAAddressOffset(0);
-                }
+    if (aVariableNameLineEdit->text() == "") {
+        return;
+    }
 
-                if (aArrayStrideLineEdit->text() != "") {
-                    arrayTableWidget->setAAddressStride(aArrayStrideLineEdit->text().toULong(&ok));
-                    if (ok == false) {
-                        qWarning() << "Invalid string for address stride." << aArrayStrideLineEdit->text();
-                    }
-                }else{
-                    arrayTableWidget->setAAddressStride(1);
-                }
+    if (aVariableAddressLineEdit->text() == "") {
+        return;
+    }
 
-                break; // Take just the first range for now.
-            }
-        }
+    if (aVariableAddressLineEdit->text() == "not an address") {
+        return;
+    }
 
-        if (id_text.toInt() == _bMemoryId) {
+    int bytes = aArrayLengthLineEdit->text().toInt() * Seer::typeBytes(aArrayDisplayFormatComboBox->currentText());
 
-            QString memory_text = Seer::parseFirst(text, "memory=", '[', ']', false);
+    //qDebug() << aVariableAddressLineEdit->text() << aArrayLengthLineEdit->text() << aArrayDisplayFormatComboBox->currentText() << bytes;
 
-            QStringList range_list = Seer::parse(memory_text, "", '{', '}', false);
+    _readFailed     = false;
+    _aPartialUpdate = false;
 
-            // Loop through the memory ranges.
-            for ( const auto& range_text : range_list  ) {
+    _aMemoryReader->read(aVariableAddressLineEdit->text(), bytes);
+}
 
-                QString contents_text = Seer::parseFirst(range_text, "contents=", '"', '"', false);
+void SeerArrayVisualizerWidget::handlebRefreshButton () {
 
-                // Convert hex string to byte array.
-                QByteArray array;
+    if (bVariableNameLineEdit->text() == "") {
+        return;
+    }
 
-                for (int i = 0; i<contents_text.size(); i += 2) {
-                    QString num = contents_text.mid(i, 2);
-                    bool ok = false;
-                    array.push_back(num.toInt(&ok, 16));
-                    Q_ASSERT(ok);
-                }
+    if (bVariableAddressLineEdit->text() == "") {
+        return;
+    }
 
-                // Give the byte array to the hex widget.
-                bool ok;
-                arrayTableWidget->setBData(arrayTableWidget->bLabel(), new SeerArrayWidget::DataStorageArray(array));
-
-                if (bArrayOffsetLineEdit->text() != "") {
-                    arrayTableWidget->setBAddressOffset(bArrayOffsetLineEdit->text().toULong(&ok));
-                    if (ok == false) {
-                        qWarning() << "Invalid string for address offset." << bArrayOffsetLineEdit->text();
-                    }
-                }else{
-                    arrayTableWidget->setBAddressOffset(0);
-                }
+    if (bVariableAddressLineEdit->text() == "not an address") {
+        return;
+    }
 
-                if (bArrayStrideLineEdit->text() != "") {
-                    arrayTableWidget->setBAddressStride(bArrayStrideLineEdit->text().toULong(&ok));
-                    if (ok == false) {
-                        qWarning() << "Invalid string for address stride." << bArrayStrideLineEdit->text();
-                    }
-                }else{
-                    arrayTableWidget->setBAddressStride(1);
-                }
+    int bytes = bArrayLengthLineEdit->text().toInt() * Seer::typeBytes(bArrayDisplayFormatComboBox->currentText());
 
-                break; // Take just the first range for now.
-            }
-        }
+    //qDebug() << bVariableAddressLineEdit->text() << bArrayLengthLineEdit->text() << bArrayDisplayFormatComboBox->currentText() << bytes;
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
+    _readFailed     = false;
+    _bPartialUpdate = false;
 
-        // 12^error,msg="No symbol \"return\" in current context."
-        // 13^error,msg="No symbol \"cout\" in current context."
-        // 3^error,msg="Unable to read memory."
+    _bMemoryReader->read(bVariableAddressLineEdit->text(), bytes);
+}
 
-        QString id_text = text.section('^', 0,0);
+void SeerArrayVisualizerWidget::handleaMemoryUpdated () {
 
-        if (id_text.toInt() == _aVariableId) {
-            aVariableAddressLineEdit->setText( Seer::filterEscapes(Seer::parseFirst(text, "msg=", '"', '"', false)) );
-        }
+    // A refresh has patched the array widget in place. Just redo the chart's points.
+    if (_aPartialUpdate) {
+        handleChartViewChanged();
+        return;
+    }
 
-        if (id_text.toInt() == _aMemoryId) {
-            // Display the error message.
-            QString msg_text = Seer::parseFirst(text, "msg=", false);
+    // Give the bytes read so far to the array widget.
+    bool ok;
+    arrayTableWidget->setAData(arrayTableWidget->aLabel(), new SeerArrayWidget::DataStorageArray(_aMemoryReader->data()));
 
-            if (msg_text != "") {
-                QMessageBox::warning(this, "Error.", Seer::filterEscapes(msg_text));
-            }
+    if (aArrayOffsetLineEdit->text() != "") {
+        arrayTableWidget->setAAddressOffset(aArrayOffsetLineEdit->text().toULong(&ok));
+        if (ok == false) {
+            qWarning() << "Invalid string for address offset." << aArrayOffsetLineEdit->text();
         }
+    }else{
+        arrayTableWidget->setAAddressOffset(0);
+    }
 
-        if (id_text.toInt() == _bVariableId) {
-            bVariableAddressLineEdit->setText( Seer::filterEscapes(Seer::parseFirst(text, "msg=", '"', '"', false)) );
+    if (aArrayStrideLineEdit->text() != "") {
+        arrayTableWidget->setAAddressStride(aArrayStrideLineEdit->text().toULong(&ok));
+        if (ok == false) {
+            qWarning() << "Invalid string for address stride." << aArrayStrideLineEdit->text();
         }
+    }else{
+        arrayTableWidget->setAAddressStride(1);
+    }
+}
 
-        if (id_text.toInt() == _bMemoryId) {
-            // Display the error message.
-            QString msg_text = Seer::parseFirst(text, "msg=", false);
+void SeerArrayVisualizerWidget::handlebMemoryUpdated () {
 
-            if (msg_text != "") {
-                QMessageBox::warning(this, "Error.", Seer::filterEscapes(msg_text));
-            }
+    // A refresh has patched the array widget in place. Just redo the chart's points.
+    if (_bPartialUpdate) {
+        handleChartViewChanged();
+        return;
+    }
+
+    // Give the bytes read so far to the array widget.
+    bool ok;
+    arrayTableWidget->setBData(arrayTableWidget->bLabel(), new SeerArrayWidget::DataStorageArray(_bMemoryReader->data()));
+
+    if (bArrayOffsetLineEdit->text() != "") {
+        arrayTableWidget->setBAddressOffset(bArrayOffsetLineEdit->text().toULong(&ok));
+        if (ok == false) {
+            qWarning() << "Invalid string for address offset." << bArrayOffsetLineEdit->text();
         }
+    }else{
+        arrayTableWidget->setBAddressOffset(0);
+    }
 
+    if (bArrayStrideLineEdit->text() != "") {
+        arrayTableWidget->setBAddressStride(bArrayStrideLineEdit->text().toULong(&ok));
+        if (ok == false) {
+            qWarning() << "Invalid string for address stride." << bArrayStrideLineEdit->text();
+        }
     }else{
-        // Ignore anything else.
+        arrayTableWidget->setBAddressStride(1);
     }
 }
 
-void SeerArrayVisualizerWidget::handleaRefreshButton () {
+void SeerArrayVisualizerWidget::handleaMemoryChanged (int position, int length) {
 
-    if (aVariableNameLineEdit->text() == "") {
+    if (_aPartialUpdate == false) {
         return;
     }
 
-    if (aVariableAddressLineEdit->text() == "") {
+    arrayTableWidget->updateAData(position, _aMemoryReader->data().constData() + position, length);
+}
+
+void SeerArrayVisualizerWidget::handlebMemoryChanged (int position, int length) {
+
+    if (_bPartialUpdate == false) {
         return;
     }
 
-    if (aVariableAddressLineEdit->text() == "not an address") {
-        return;
+    arrayTableWidget->updateBData(position, _bMemoryReader->data().constData() + position, length);
+}
+
+void SeerArrayVisualizerWidget::handleaRefreshStarted () {
+
+    // The array widget keeps its data. Only the elements that change are redone.
+    _aPartialUpdate = true;
+
+    arrayTableWidget->clearChanged();
+}
+
+void SeerArrayVisualizerWidget::handlebRefreshStarted () {
+
+    // The array widget keeps its data. Only the elements that change are redone.
+    _bPartialUpdate = true;
+
+    arrayTableWidget->clearChanged();
+}
+
+void SeerArrayVisualizerWidget::autoRefresh () {
+
+    // An array that's still the same memory is read again, and just what changed is redone.
+    // Otherwise it's read fresh.
+    int abytes = aArrayLengthLineEdit->text().toInt() * Seer::typeBytes(aArrayDisplayFormatComboBox->currentText());
+    int bbytes = bArrayLengthLineEdit->text().toInt() * Seer::typeBytes(bArrayDisplayFormatComboBox->currentText());
+
+    if (_aMemoryReader->address() != "" && _aMemoryReader->address() == aVariableAddressLineEdit->text() && _aMemoryReader->count() == abytes) {
+        _aMemoryReader->refresh();
+    }else{
+        handleaRefreshButton();
     }
 
-    int bytes = aArrayLengthLineEdit->text().toInt() * Seer::typeBytes(aArrayDisplayFormatComboBox->currentText());
+    if (_bMemoryReader->address() != "" && _bMemoryReader->address() == bVariableAddressLineEdit->text() && _bMemoryReader->count() == bbytes) {
+        _bMemoryReader->refresh();
+    }else{
+        handlebRefreshButton();
+    }
+}
+
+void SeerArrayVisualizerWidget::handleAutoRefreshChanged () {
 
-    //qDebug() << _aMemoryId << aVariableAddressLineEdit->text() << aArrayLengthLineEdit->text() << aArrayDisplayFormatComboBox->currentText() << bytes;
+    // Besides each stop, refresh every so often if there's an interval.
+    int interval = autoRefreshCheckBox->isChecked() ? refreshIntervalSpinBox->value() : 0;
 
-    emit evaluateMemoryExpression(_aMemoryId, aVariableAddressLineEdit->text(), bytes);
+    _aMemoryReader->setRefreshInterval(interval);
+    _bMemoryReader->setRefreshInterval(interval);
 }
 
-void SeerArrayVisualizerWidget::handlebRefreshButton () {
+void SeerArrayVisualizerWidget::handleChunkFailed (int position, int length, QString message) {
 
-    if (bVariableNameLineEdit->text() == "") {
+    Q_UNUSED(position);
+    Q_UNUSED(length);
+
+    // A refresh keeps what was there. Don't pop up a message on each one.
+    if (_aMemoryReader->isRefreshing() || _bMemoryReader->isRefreshing()) {
         return;
     }
 
-    if (bVariableAddressLineEdit->text() == "") {
-        return;
+    // Just one message per read. The parts that couldn't be read are 0.
+    if (_readFailed == false && message != "") {
+        _readFailed = true;
+        QMessageBox::warning(this, "Error.", message);
     }
+}
 
-    if (bVariableAddressLineEdit->text() == "not an address") {
+void SeerArrayVisualizerWidget::handleReadProgress () {
+
+    // One progress bar for both arrays.
+    qint64 done  = 0;
+    qint64 count = 0;
+
+    if (_aMemoryReader->isReading()) {
+        done  += _aMemoryReader->bytesDone();
+        count += _aMemoryReader->count();
+    }
+
+    if (_bMemoryReader->isReading()) {
+        done  += _bMemoryReader->bytesDone();
+        count += _bMemoryReader->count();
+    }
+
+    // Nothing left, or small reads that come in at once.
+    if (done >= count) {
+        readProgressBar->hide();
+        cancelToolButton->hide();
         return;
     }
 
-    int bytes = bArrayLengthLineEdit->text().toInt() * Seer::typeBytes(bArrayDisplayFormatComboBox->currentText());
+    // Keep the range in an int.
+    readProgressBar->setMaximum(1000);
+    readProgressBar->setValue((int)(done * 1000 / count));
+    readProgressBar->show();
+    cancelToolButton->show();
+}
+
+void SeerArrayVisualizerWidget::handleCancelButton () {
 
-    //qDebug() << _bMemoryId << bVariableAddressLineEdit->text() << bArrayLengthLineEdit->text() << bArrayDisplayFormatComboBox->currentText() << bytes;
+    _aMemoryReader->cancel();
+    _bMemoryReader->cancel();
 
-    emit evaluateMemoryExpression(_bMemoryId, bVariableAddressLineEdit->text(), bytes);
+    handleReadProgress();
 }
 
 void SeerArrayVisualizerWidget::handleHelpButton () {
@@ -644,6 +895,8 @@ void SeerArrayVisualizerWidget::handleDataChanged () {
         _aSeries = 0;
     }
 
+    _aSeriesValues = SeriesValues();
+
     if (_bSeries) {
         arrayChartView->chart()->removeSeries(_bSeries);
         arrayChartView->chart()->update();
@@ -651,6 +904,8 @@ void SeerArrayVisualizerWidget::handleDataChanged () {
         _bSeries = 0;
     }
 
+    _bSeriesValues = SeriesValues();
+
     // If only the first array is defined, create a series for it.
     // Handle the X and Y axis.
     if (arrayTableWidget->aSize() > 0 && arrayTableWidget->bSize() == 0) {
@@ -676,51 +931,31 @@ void SeerArrayVisualizerWidget::handleDataChanged () {
         // Plot one series using the two arrays as an X and as a Y.
         }else{
 
-            if (scatterRadioButton->isChecked()) {
-
-                QScatterSeries* scatter = new QScatterSeries;
-                scatter->setMarkerShape(QScatterSeries::MarkerShapeRectangle);
-                scatter->setMarkerSize(7);
-                _aSeries = scatter;
-
-            }else if (lineRadioButton->isChecked()) {
+            _aSeries = newSeries();
 
-                QLineSeries* line = new QLineSeries;
-                _aSeries = line;
-
-            }else if (splineRadioButton->isChecked()) {
-
-                QSplineSeries* line  = new QSplineSeries;
-                _aSeries = line;
-
-            }else{
-                qWarning() << "Invalid line type.";
+            if (_aSeries == 0) {
                 return;
             }
 
-            _aSeries->setPointsVisible(false);
-            _aSeries->setPointLabelsVisible(false);
-            _aSeries->setPointLabelsClipping(true);
-
             const QVector<double>& xvalues = arrayTableWidget->aArrayValues();
             const QVector<double>& yvalues = arrayTableWidget->bArrayValues();
 
             if (arrayTableWidget->aAxis() == "Y" && arrayTableWidget->bAxis() == "X") {
 
-                for (int i = 0; i < std::min(xvalues.size(),yvalues.size()); ++i) {
-                    _aSeries->append(xvalues[i], yvalues[i]);
-                }
+                _aSeriesValues.xs = &xvalues;
+                _aSeriesValues.ys = &yvalues;
 
             }else if (arrayTableWidget->aAxis() == "X" && arrayTableWidget->bAxis() == "Y") {
 
-                for (int i = 0; i < std::min(xvalues.size(),yvalues.size()); ++i) {
-                    _aSeries->append(yvalues[i], xvalues[i]);
-                }
+                _aSeriesValues.xs = &yvalues;
+                _aSeriesValues.ys = &xvalues;
 
             }else{
                 qWarning() << "Invalid axis type of '" << arrayTableWidget->aAxis() << "'. Not 'X' or 'Y'.";
             }
 
+            _aSeries->replace(seriesPoints(_aSeries, _aSeriesValues));
+
             _aSeries->setName(aVariableName() + "/" + bVariableName());
             _aSeries->setName(QString("%1:%2:%3 | %4:%5:%6")
                                       .arg(arrayTableWidget->aLabel()).arg(arrayTableWidget->aAddressOffset()).arg(arrayTableWidget->aAddressStride())
@@ -838,99 +1073,161 @@ void SeerArrayVisualizerWidget::handleLineTypeButtonGroup () {
 
 void SeerArrayVisualizerWidget::createASeries() {
 
-    if (scatterRadioButton->isChecked()) {
-
-        QScatterSeries* scatter = new QScatterSeries;
-        scatter->setMarkerShape(QScatterSeries::MarkerShapeRectangle);
-        scatter->setMarkerSize(7);
-        _aSeries = scatter;
-
-    }else if (lineRadioButton->isChecked()) {
-
-        QLineSeries* line = new QLineSeries;
-        _aSeries = line;
+    _aSeries = newSeries();
 
-    }else if (splineRadioButton->isChecked()) {
-
-        QSplineSeries* line  = new QSplineSeries;
-        _aSeries = line;
-
-    }else{
-        qWarning() << "Invalid line type.";
+    if (_aSeries == 0) {
         return;
     }
 
-    _aSeries->setPointsVisible(false);
-    _aSeries->setPointLabelsVisible(false);
-    _aSeries->setPointLabelsClipping(true);
-
     const QVector<double>& values = arrayTableWidget->aArrayValues();
 
     if (arrayTableWidget->aAxis() == "Y") {
 
-        for (int i = 0; i < values.size(); ++i) {
-            _aSeries->append(i, values[i]);
-        }
+        _aSeriesValues.ys = &values;
 
     }else if (arrayTableWidget->aAxis() == "X") {
 
-        for (int i = 0; i < values.size(); ++i) {
-            _aSeries->append(values[i], i);
-        }
+        _aSeriesValues.xs = &values;
 
     }else{
         qWarning() << "Invalid axis type of '" << arrayTableWidget->aAxis() << "'. Not 'X' or 'Y'.";
     }
 
+    _aSeries->replace(seriesPoints(_aSeries, _aSeriesValues));
     _aSeries->setName(QString("%1:%2:%3").arg(arrayTableWidget->aLabel()).arg(arrayTableWidget->aAddressOffset()).arg(arrayTableWidget->aAddressStride()));
 }
 
 void SeerArrayVisualizerWidget::createBSeries() {
 
+    _bSeries = newSeries();
+
+    if (_bSeries == 0) {
+        return;
+    }
+
+    const QVector<double>& values = arrayTableWidget->bArrayValues();
+
+    if (arrayTableWidget->bAxis() == "Y") {
+
+        _bSeriesValues.ys = &values;
+
+    }else if (arrayTableWidget->bAxis() == "X") {
+
+        _bSeriesValues.xs = &values;
+
+    }else{
+        qWarning() << "Invalid axis type of '" << arrayTableWidget->bAxis() << "'. Not 'X' or 'Y'.";
+    }
+
+    _bSeries->replace(seriesPoints(_bSeries, _bSeriesValues));
+    _bSeries->setName(QString("%1:%2:%3").arg(arrayTableWidget->bLabel()).arg(arrayTableWidget->bAddressOffset()).arg(arrayTableWidget->bAddressStride()));
+}
+
+QXYSeries* SeerArrayVisualizerWidget::newSeries () {
+
+    QXYSeries* series = 0;
+
     if (scatterRadioButton->isChecked()) {
 
         QScatterSeries* scatter = new QScatterSeries;
         scatter->setMarkerShape(QScatterSeries::MarkerShapeRectangle);
         scatter->setMarkerSize(7);
-        _bSeries = scatter;
+        series = scatter;
 
     }else if (lineRadioButton->isChecked()) {
 
         QLineSeries* line = new QLineSeries;
-        _bSeries = line;
+        series = line;
 
     }else if (splineRadioButton->isChecked()) {
 
         QSplineSeries* line  = new QSplineSeries;
-        _bSeries = line;
+        series = line;
 
     }else{
         qWarning() << "Invalid line type.";
-        return;
+        return 0;
     }
 
-    _bSeries->setPointsVisible(false);
-    _bSeries->setPointLabelsVisible(false);
-    _bSeries->setPointLabelsClipping(true);
+    series->setPointsVisible(false);
+    series->setPointLabelsVisible(false);
+    series->setPointLabelsClipping(true);
 
-    const QVector<double>& values = arrayTableWidget->bArrayValues();
+    return series;
+}
 
-    if (arrayTableWidget->bAxis() == "Y") {
+QVector<QPointF> SeerArrayVisualizerWidget::seriesPoints (QXYSeries* series, const SeriesValues& values) const {
 
-        for (int i = 0; i < values.size(); ++i) {
-            _bSeries->append(i, values[i]);
-        }
+    QVector<QPointF> points;
 
-    }else if (arrayTableWidget->bAxis() == "X") {
+    // One bucket per pixel of the plot.
+    QChart* chart   = arrayChartView->chart();
+    int     buckets = qMax(100, (int)chart->plotArea().width());
+    bool    spline  = (qobject_cast<QSplineSeries*>(series) != 0);
+
+    // X/Y pairs. There's no order to zoom into, so decimate all of them.
+    if (values.xs && values.ys) {
+
+        const double* xs    = values.xs->constData();
+        const double* ys    = values.ys->constData();
+        int           count = qMin(values.xs->size(), values.ys->size());
+
+        points.reserve(qMin(count, buckets * 2));
+
+        decimateLttb(0, count-1, spline ? qMin(buckets, SplineMaxPoints) : buckets * 2, [xs, ys](int i) { return QPointF(xs[i], ys[i]); }, points);
 
-        for (int i = 0; i < values.size(); ++i) {
-            _bSeries->append(values[i], i);
+        return points;
+    }
+
+    // One array against its index. Decimate just the part that can be seen.
+    bool                   valueIsY = (values.ys != 0);
+    const QVector<double>* vector   = valueIsY ? values.ys : values.xs;
+
+    if (vector == 0 || vector->size() == 0) {
+        return points;
+    }
+
+    const double*          v        = vector->constData();
+    int                    count    = vector->size();
+    int                    first    = 0;
+    int                    last     = count - 1;
+
+    // The index is on the X axis for Y values, and the other way around.
+    QList<QAbstractAxis*> axes = chart->axes(valueIsY ? Qt::Horizontal : Qt::Vertical, series);
+
+    if (axes.size() > 0) {
+
+        QValueAxis* axis = qobject_cast<QValueAxis*>(axes.first());
+
+        if (axis) {
+            // One element past each edge, so lines run off the sides.
+            first = qBound(0, (int)std::floor(axis->min()) - 1, count - 1);
+            last  = qBound(0, (int)std::ceil(axis->max())  + 1, count - 1);
         }
+    }
+
+    points.reserve(qMin(last - first + 1, buckets * 2));
 
+    auto pointAt = [v, valueIsY](int i) { return valueIsY ? QPointF(i, v[i]) : QPointF(v[i], i); };
+
+    if (spline) {
+        decimateLttb(first, last, qMin(buckets, SplineMaxPoints), pointAt, points);
     }else{
-        qWarning() << "Invalid axis type of '" << arrayTableWidget->bAxis() << "'. Not 'X' or 'Y'.";
+        decimateMinMax(first, last, buckets, valueIsY, pointAt, points);
     }
 
-    _bSeries->setName(QString("%1:%2:%3").arg(arrayTableWidget->bLabel()).arg(arrayTableWidget->bAddressOffset()).arg(arrayTableWidget->bAddressStride()));
+    return points;
 }
 
+void SeerArrayVisualizerWidget::handleChartViewChanged () {
+
+    // Redo the decimation for the part of the arrays that can now be seen.
+    // Replacing the points leaves the axes alone.
+    if (_aSeries) {
+        _aSeries->replace(seriesPoints(_aSeries, _aSeriesValues));
+    }
+
+    if (_bSeries) {
+        _bSeries->replace(seriesPoints(_bSeries, _bSeriesValues));
+    }
+}
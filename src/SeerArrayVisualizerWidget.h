@@ -2,6 +2,9 @@
 
 #include <QtCharts/QXYSeries>
 #include <QtWidgets/QWidget>
+#include <QtCore/QVector>
+#include <QtCore/QPointF>
+#include "SeerMemoryReader.h"
 #include "ui_SeerArrayVisualizerWidget.h"
 
 class SeerArrayVisualizerWidget : public QWidget, protected Ui::SeerArrayVisualizerWidgetForm {
@@ -24,7 +27,7 @@ class SeerArrayVisualizerWidget : public QWidget, protected Ui::SeerArrayVisuali
 
     signals:
         void                evaluateVariableExpression          (int expressionid, QString expression);
-        void                evaluateMemoryExpression            (int expressionid, QString address, int count);
+        void                evaluateMemoryExpression            (SeerMemoryReader* reader, int expressionid, QString address, int count);
 
     public slots:
         void                handleText                          (const QString& text);
@@ -46,21 +49,52 @@ class SeerArrayVisualizerWidget : public QWidget, protected Ui::SeerArrayVisuali
         void                handlePointsCheckBox                ();
         void                handleLabelsCheckBox                ();
         void                handleLineTypeButtonGroup           ();
+        void                handleaMemoryUpdated                ();
+        void                handlebMemoryUpdated                ();
+        void                handleChunkFailed                   (int position, int length, QString message);
+        void                handleReadProgress                  ();
+        void                handleCancelButton                  ();
+        void                handleChartViewChanged              ();
+        void                handleaMemoryChanged                (int position, int length);
+        void                handlebMemoryChanged                (int position, int length);
+        void                handleaRefreshStarted               ();
+        void                handlebRefreshStarted               ();
+        void                handleAutoRefreshChanged            ();
 
     protected:
+        void                autoRefresh                         ();
         void                writeSettings                       ();
         void                readSettings                        ();
         void                resizeEvent                         (QResizeEvent* event);
 
     private:
+        //
+        // The full values behind a series. They're the array widget's, which
+        // updates them in place. A null 'xs' (or 'ys') means the element index
+        // is used for that axis.
+        //
+        struct SeriesValues {
+            SeriesValues() : xs(0), ys(0) {}
+
+            const QVector<double>*  xs;
+            const QVector<double>*  ys;
+        };
+
         void                createASeries                       ();
         void                createBSeries                       ();
+        QXYSeries*          newSeries                           ();
+        QVector<QPointF>    seriesPoints                        (QXYSeries* series, const SeriesValues& values) const;
 
         QXYSeries*          _aSeries;
         QXYSeries*          _bSeries;
+        SeriesValues        _aSeriesValues;
+        SeriesValues        _bSeriesValues;
         int                 _aVariableId;
         int                 _bVariableId;
-        int                 _aMemoryId;
-        int                 _bMemoryId;
+        SeerMemoryReader*   _aMemoryReader;
+        SeerMemoryReader*   _bMemoryReader;
+        bool                _readFailed;
+        bool                _aPartialUpdate;
+        bool                _bPartialUpdate;
 };
 
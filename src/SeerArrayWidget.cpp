@@ -1,10 +1,26 @@
 #include "SeerArrayWidget.h"
 #include "SeerUtl.h"
 #include <QtWidgets/QHeaderView>
+#include <QtGui/QColor>
 #include <QtCore/QDebug>
 #include <stdexcept>
+#include <cstring>
+#include <climits>
 
-SeerArrayWidget::SeerArrayWidget(QWidget* parent) : QTableWidget(parent) {
+//
+// Read an element of type T. The bytes may not be aligned for T.
+//
+template <typename T>
+static inline T elementAt (const char* p) {
+
+    T v;
+
+    memcpy(&v, p, sizeof(T));
+
+    return v;
+}
+
+SeerArrayWidget::SeerArrayWidget(QWidget* parent) : QTableView(parent) {
 
     QFont font;
     font.setFamily("monospace [Consolas]");
@@ -17,6 +33,20 @@ SeerArrayWidget::SeerArrayWidget(QWidget* parent) : QTableWidget(parent) {
 
     horizontalHeader()->setDefaultAlignment(Qt::AlignRight);
 
+    // All rows are the same height. Saves the view from measuring a million of them.
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    verticalHeader()->setDefaultSectionSize(fontMetrics().height() + 4);
+
+    _rowCount           = 0;
+    _aColumnId          = -1;
+    _bColumnId          = -1;
+    _aArrayValuesValid  = false;
+    _bArrayValuesValid  = false;
+
+    _model = new SeerArrayWidgetModel(this);
+
+    setModel(_model);
+
     _aData           = 0;
     _aAxis           = "Y";
     _aArrayMode      = SeerArrayWidget::UnknownArrayMode;
@@ -163,6 +193,12 @@ QString SeerArrayWidget::aArrayModeString () const {
 
 const QVector<double>& SeerArrayWidget::aArrayValues () const {
 
+    // Made when first asked for, not on every refresh.
+    if (_aArrayValuesValid == false) {
+        fillValues(aView(), _aArrayValues);
+        _aArrayValuesValid = true;
+    }
+
     return _aArrayValues;
 }
 
@@ -278,6 +314,12 @@ QString SeerArrayWidget::bArrayModeString () const {
 
 const QVector<double>& SeerArrayWidget::bArrayValues () const {
 
+    // Made when first asked for, not on every refresh.
+    if (_bArrayValuesValid == false) {
+        fillValues(bView(), _bArrayValues);
+        _bArrayValuesValid = true;
+    }
+
     return _bArrayValues;
 }
 
@@ -308,287 +350,392 @@ void SeerArrayWidget::setBData(const QString& label, SeerArrayWidget::DataStorag
     create();
 }
 
-void SeerArrayWidget::create () {
-
-    // Clear the table. We're going to recreate it.
-    clear();
-    setRowCount(0);
-
-    if (_aData && _bData) {
-
-        setColumnCount(2);
+void SeerArrayWidget::updateAData (int position, const char* bytes, int length) {
 
-        _aColumnId = 0;
-        _bColumnId = 1;
-
-    }else if (_aData) {
+    if (_aData == 0) {
+        return;
+    }
 
-        setColumnCount(1);
+    _aData->setData(position, bytes, length);
 
-        _aColumnId = 0;
-        _bColumnId = -1;
+    // Only the elements that overlap the bytes are redone.
+    ElementView view = aView();
+    int         first;
+    int         last;
 
-    }else if (_bData) {
-
-        setColumnCount(1);
+    if (elementRange(view, aElementSize(), aAddressOffset(), position, length, &first, &last) == false) {
+        return;
+    }
 
-        _aColumnId = -1;
-        _bColumnId = 0;
+    for (int i=first; i<=last; i++) {
 
-    }else{
-        setColumnCount(0);
+        _aChanged.setBit(i);
 
-        _aColumnId = -1;
-        _bColumnId = -1;
+        if (_aArrayValuesValid) {
+            _aArrayValues[i] = elementValue(view, i);
+        }
     }
 
-    // Clear the values.
-    _aArrayValues.resize(0);
-    _bArrayValues.resize(0);
+    _model->rowsChanged(_aColumnId, first, last);
+}
 
-    // If there's no data, do nothing.
-    if (!_aData && !_bData) {
-        emit dataChanged();
-        return;
-    }
+void SeerArrayWidget::updateBData (int position, const char* bytes, int length) {
 
-    if (aElementSize() < 1 && bElementSize() < 1) {
-        emit dataChanged();
+    if (_bData == 0) {
         return;
     }
 
-    if (_aData) {
-
-        //qDebug() << "_aData" << aElementSize() << aAddressOffset() << aAddressStride() << _aData->size();
+    _bData->setData(position, bytes, length);
 
-        setHorizontalHeaderItem(_aColumnId, new QTableWidgetItem(QString("%1:%2:%3").arg(aLabel()).arg(aAddressOffset()).arg(aAddressStride())));
+    // Only the elements that overlap the bytes are redone.
+    ElementView view = bView();
+    int         first;
+    int         last;
 
-        int row = 0;
+    if (elementRange(view, bElementSize(), bAddressOffset(), position, length, &first, &last) == false) {
+        return;
+    }
 
-        for (int i=aElementSize()*aAddressOffset(); i<_aData->size(); i+=aElementSize()*aAddressStride()) {
+    for (int i=first; i<=last; i++) {
 
-            // Add new row if we need to. Set its label.
-            if (row == rowCount()) {
+        _bChanged.setBit(i);
 
-                //qDebug() << "Adding row" << row << "for _aData";
+        if (_bArrayValuesValid) {
+            _bArrayValues[i] = elementValue(view, i);
+        }
+    }
 
-                insertRow(rowCount());
+    _model->rowsChanged(_bColumnId, first, last);
+}
 
-                QTableWidgetItem* rowHeaderitem = new QTableWidgetItem(QString::number(row));
-                rowHeaderitem->setTextAlignment(Qt::AlignRight|Qt::AlignVCenter);
+void SeerArrayWidget::clearChanged () {
 
-                setVerticalHeaderItem(row, rowHeaderitem);
-            }
+    if (_aChanged.count(true) == 0 && _bChanged.count(true) == 0) {
+        return;
+    }
 
-            QTableWidgetItem* item = new QTableWidgetItem;
-            item->setTextAlignment(Qt::AlignRight|Qt::AlignVCenter);
+    _aChanged.fill(false);
+    _bChanged.fill(false);
 
-            QByteArray element = _aData->getData(i, aElementSize());
+    if (_aColumnId >= 0) {
+        _model->rowsChanged(_aColumnId, 0, _rowCount-1);
+    }
 
-            double val = 0.0;
+    if (_bColumnId >= 0) {
+        _model->rowsChanged(_bColumnId, 0, _rowCount-1);
+    }
+}
 
-            if (aArrayMode() == SeerArrayWidget::Int16ArrayMode) {
+bool SeerArrayWidget::elementChanged (int column, int row) const {
 
-                short v = *reinterpret_cast<short*>(element.data());
+    if (column == _aColumnId) {
+        return row >= 0 && row < _aChanged.size() && _aChanged.testBit(row);
+    }
 
-                val = v;
+    if (column == _bColumnId) {
+        return row >= 0 && row < _bChanged.size() && _bChanged.testBit(row);
+    }
 
-                item->setText(QString::number(v));
+    return false;
+}
 
-            }else if (aArrayMode() == SeerArrayWidget::UInt16ArrayMode) {
+void SeerArrayWidget::create () {
 
-                unsigned short v = *reinterpret_cast<unsigned short*>(element.data());
+    // Nothing is formatted here. The model asks for the cells that are painted.
+    if (_aData && _bData) {
 
-                val = v;
+        _aColumnId = 0;
+        _bColumnId = 1;
 
-                item->setText(QString::number(v));
+    }else if (_aData) {
 
-            }else if (aArrayMode() == SeerArrayWidget::Int32ArrayMode) {
+        _aColumnId = 0;
+        _bColumnId = -1;
 
-                int v = *reinterpret_cast<int*>(element.data());
+    }else if (_bData) {
 
-                val = v;
+        _aColumnId = -1;
+        _bColumnId = 0;
 
-                item->setText(QString::number(v));
+    }else{
 
-            }else if (aArrayMode() == SeerArrayWidget::UInt32ArrayMode) {
+        _aColumnId = -1;
+        _bColumnId = -1;
+    }
 
-                unsigned int v = *reinterpret_cast<unsigned int*>(element.data());
+    _rowCount = qMax(aView().count, bView().count);
 
-                val = v;
+    // The values for the chart are redone when they're asked for.
+    _aArrayValues.resize(0);
+    _bArrayValues.resize(0);
+    _aArrayValuesValid = false;
+    _bArrayValuesValid = false;
 
-                item->setText(QString::number(v));
+    _aChanged = QBitArray(aView().count);
+    _bChanged = QBitArray(bView().count);
 
-            }else if (aArrayMode() == SeerArrayWidget::Int64ArrayMode) {
+    _model->reset();
 
-                long v = *reinterpret_cast<long*>(element.data());
+    emit arrayChanged();
+}
 
-                val = v;
+int SeerArrayWidget::arrayRowCount () const {
 
-                item->setText(QString::number(v));
+    return _rowCount;
+}
 
-            }else if (aArrayMode() == SeerArrayWidget::UInt64ArrayMode) {
+int SeerArrayWidget::aColumn () const {
 
-                unsigned long v = *reinterpret_cast<unsigned long*>(element.data());
+    return _aColumnId;
+}
 
-                val = v;
+int SeerArrayWidget::bColumn () const {
 
-                item->setText(QString::number(v));
+    return _bColumnId;
+}
 
-            }else if (aArrayMode() == SeerArrayWidget::Float32ArrayMode) {
+QString SeerArrayWidget::elementText (int column, int row) const {
 
-                float v = *reinterpret_cast<float*>(element.data());
+    if (column == _aColumnId) {
+        return elementText(aView(), row);
+    }
 
-                val = v;
+    if (column == _bColumnId) {
+        return elementText(bView(), row);
+    }
 
-                item->setText(QString::number(v));
+    return QString();
+}
 
-            }else if (aArrayMode() == SeerArrayWidget::Float64ArrayMode) {
+SeerArrayWidget::ElementView SeerArrayWidget::aView () const {
 
-                double v = *reinterpret_cast<double*>(element.data());
+    return makeView(_aData, aArrayMode(), aElementSize(), aAddressOffset(), aAddressStride());
+}
 
-                val = v;
+SeerArrayWidget::ElementView SeerArrayWidget::bView () const {
 
-                item->setText(QString::number(v));
+    return makeView(_bData, bArrayMode(), bElementSize(), bAddressOffset(), bAddressStride());
+}
 
-            }else{
-                qWarning() << "Unknown data type.";
+SeerArrayWidget::ElementView SeerArrayWidget::makeView (DataStorage* data, SeerArrayWidget::ArrayMode mode, unsigned long elementSize, unsigned long offset, unsigned long stride) {
 
-                val = 0.0;
-            }
+    ElementView view;
 
-            //qDebug() << "Adding item" << row << 0 << "for _aData";
+    view.data  = 0;
+    view.count = 0;
+    view.step  = 0;
+    view.mode  = mode;
 
-            setItem(row, _aColumnId, item);
+    if (data == 0 || elementSize < 1 || data->constData() == 0) {
+        return view;
+    }
 
-            _aArrayValues.push_back(val);
+    quint64 size  = data->size();
+    quint64 start = (quint64)elementSize * offset;
+    quint64 step  = (quint64)elementSize * stride;
 
-            row++;
-        }
+    // Only whole elements.
+    if (start + elementSize > size || step > (quint64)INT_MAX) {
+        return view;
     }
 
-    if (_bData) {
-
-        //qDebug() << "_bData" << bElementSize() << bAddressOffset() << bAddressStride() << _bData->size();
+    view.data  = data->constData() + start;
+    view.step  = (int)step;
+    view.count = (int)((size - start - elementSize) / step + 1);
 
-        setHorizontalHeaderItem(_bColumnId, new QTableWidgetItem(QString("%1:%2:%3").arg(bLabel()).arg(bAddressOffset()).arg(bAddressStride())));
+    return view;
+}
 
-        int row = 0;
+double SeerArrayWidget::elementValue (const ElementView& view, int i) {
 
-        for (int i=bElementSize()*bAddressOffset(); i<_bData->size(); i+=bElementSize()*bAddressStride()) {
+    const char* p = view.data + (qint64)i * view.step;
 
-            // Add new row if we need to. Set its label.
-            if (row == rowCount()) {
+    switch (view.mode) {
+        case SeerArrayWidget::Int16ArrayMode:   return elementAt<qint16>(p);
+        case SeerArrayWidget::UInt16ArrayMode:  return elementAt<quint16>(p);
+        case SeerArrayWidget::Int32ArrayMode:   return elementAt<qint32>(p);
+        case SeerArrayWidget::UInt32ArrayMode:  return elementAt<quint32>(p);
+        case SeerArrayWidget::Int64ArrayMode:   return elementAt<qint64>(p);
+        case SeerArrayWidget::UInt64ArrayMode:  return elementAt<quint64>(p);
+        case SeerArrayWidget::Float32ArrayMode: return elementAt<float>(p);
+        case SeerArrayWidget::Float64ArrayMode: return elementAt<double>(p);
+        default:                                return 0.0;
+    }
+}
 
-                //qDebug() << "Adding row" << row << "for _bData";
+QString SeerArrayWidget::elementText (const ElementView& view, int i) {
 
-                insertRow(rowCount());
+    if (i < 0 || i >= view.count) {
+        return QString();
+    }
 
-                QTableWidgetItem* rowHeaderitem = new QTableWidgetItem(QString::number(row));
-                rowHeaderitem->setTextAlignment(Qt::AlignRight|Qt::AlignVCenter);
+    const char* p = view.data + (qint64)i * view.step;
+
+    // Format the element as its own type, so 64 bit integers aren't rounded through a double.
+    switch (view.mode) {
+        case SeerArrayWidget::Int16ArrayMode:   return QString::number(elementAt<qint16>(p));
+        case SeerArrayWidget::UInt16ArrayMode:  return QString::number(elementAt<quint16>(p));
+        case SeerArrayWidget::Int32ArrayMode:   return QString::number(elementAt<qint32>(p));
+        case SeerArrayWidget::UInt32ArrayMode:  return QString::number(elementAt<quint32>(p));
+        case SeerArrayWidget::Int64ArrayMode:   return QString::number(elementAt<qint64>(p));
+        case SeerArrayWidget::UInt64ArrayMode:  return QString::number(elementAt<quint64>(p));
+        case SeerArrayWidget::Float32ArrayMode: return QString::number(elementAt<float>(p));
+        case SeerArrayWidget::Float64ArrayMode: return QString::number(elementAt<double>(p));
+        default:                                return QString();
+    }
+}
 
-                setVerticalHeaderItem(row, rowHeaderitem);
-            }
+void SeerArrayWidget::fillValues (const ElementView& view, QVector<double>& values) {
 
-            QTableWidgetItem* item = new QTableWidgetItem;
-            item->setTextAlignment(Qt::AlignRight|Qt::AlignVCenter);
+    values.resize(view.count);
 
-            QByteArray element = _bData->getData(i, bElementSize());
+    double* out = values.data();
 
-            double val = 0.0;
+    for (int i=0; i<view.count; i++) {
+        out[i] = elementValue(view, i);
+    }
+}
 
-            if (bArrayMode() == SeerArrayWidget::Int16ArrayMode) {
+bool SeerArrayWidget::elementRange (const ElementView& view, unsigned long elementSize, unsigned long offset, int position, int length, int* first, int* last) {
 
-                short v = *reinterpret_cast<short*>(element.data());
+    if (view.count < 1 || view.step < 1 || length < 1) {
+        return false;
+    }
 
-                val = v;
+    // Element 'i' is the bytes [start + i*step, start + i*step + elementSize).
+    qint64 start = (qint64)elementSize * offset;
+    qint64 lo    = (qint64)position - start - (qint64)elementSize + 1;
+    qint64 hi    = (qint64)position + length - 1 - start;
 
-                item->setText(QString::number(v));
+    if (hi < 0) {
+        return false;
+    }
 
-            }else if (bArrayMode() == SeerArrayWidget::UInt16ArrayMode) {
+    qint64 i0 = lo <= 0 ? 0 : (lo + view.step - 1) / view.step;
+    qint64 i1 = qMin(hi / view.step, (qint64)view.count - 1);
 
-                unsigned short v = *reinterpret_cast<unsigned short*>(element.data());
+    if (i0 > i1) {
+        return false;
+    }
 
-                val = v;
+    *first = (int)i0;
+    *last  = (int)i1;
 
-                item->setText(QString::number(v));
+    return true;
+}
 
-            }else if (bArrayMode() == SeerArrayWidget::Int32ArrayMode) {
+SeerArrayWidget::DataStorageArray::DataStorageArray(const QByteArray& arr) {
+    _data = arr;
+}
 
-                int v = *reinterpret_cast<int*>(element.data());
+QByteArray SeerArrayWidget::DataStorageArray::getData(int position, int length) {
+    return _data.mid(position, length);
+}
 
-                val = v;
+const char* SeerArrayWidget::DataStorageArray::constData() {
+    return _data.constData();
+}
 
-                item->setText(QString::number(v));
+void SeerArrayWidget::DataStorageArray::setData(int position, const char* bytes, int length) {
 
-            }else if (bArrayMode() == SeerArrayWidget::UInt32ArrayMode) {
+    if (position < 0 || position >= _data.size()) {
+        return;
+    }
 
-                unsigned int v = *reinterpret_cast<unsigned int*>(element.data());
+    memcpy(_data.data() + position, bytes, qMin(length, _data.size() - position));
+}
 
-                val = v;
+int SeerArrayWidget::DataStorageArray::size() {
+    return _data.size();
+}
 
-                item->setText(QString::number(v));
 
-            }else if (bArrayMode() == SeerArrayWidget::Int64ArrayMode) {
+SeerArrayWidgetModel::SeerArrayWidgetModel(SeerArrayWidget* arrayWidget) : QAbstractTableModel(arrayWidget) {
 
-                long v = *reinterpret_cast<long*>(element.data());
+    _arrayWidget = arrayWidget;
+}
 
-                val = v;
+int SeerArrayWidgetModel::rowCount (const QModelIndex& parent) const {
 
-                item->setText(QString::number(v));
+    if (parent.isValid()) {
+        return 0;
+    }
 
-            }else if (bArrayMode() == SeerArrayWidget::UInt64ArrayMode) {
+    return _arrayWidget->arrayRowCount();
+}
 
-                unsigned long v = *reinterpret_cast<unsigned long*>(element.data());
+int SeerArrayWidgetModel::columnCount (const QModelIndex& parent) const {
 
-                val = v;
+    if (parent.isValid()) {
+        return 0;
+    }
 
-                item->setText(QString::number(v));
+    return (_arrayWidget->aColumn() >= 0 ? 1 : 0) + (_arrayWidget->bColumn() >= 0 ? 1 : 0);
+}
 
-            }else if (bArrayMode() == SeerArrayWidget::Float32ArrayMode) {
+QVariant SeerArrayWidgetModel::data (const QModelIndex& index, int role) const {
 
-                float v = *reinterpret_cast<float*>(element.data());
+    if (index.isValid() == false) {
+        return QVariant();
+    }
 
-                val = v;
+    if (role == Qt::DisplayRole) {
+        return _arrayWidget->elementText(index.column(), index.row());
+    }
 
-                item->setText(QString::number(v));
+    if (role == Qt::TextAlignmentRole) {
+        return int(Qt::AlignRight|Qt::AlignVCenter);
+    }
 
-            }else if (bArrayMode() == SeerArrayWidget::Float64ArrayMode) {
+    // Changed by the last refresh.
+    if (role == Qt::BackgroundRole && _arrayWidget->elementChanged(index.column(), index.row())) {
+        return QColor(255, 225, 140);
+    }
 
-                double v = *reinterpret_cast<double*>(element.data());
+    return QVariant();
+}
 
-                val = v;
+QVariant SeerArrayWidgetModel::headerData (int section, Qt::Orientation orientation, int role) const {
 
-                item->setText(QString::number(v));
+    if (orientation == Qt::Vertical) {
 
-            }else{
-                qWarning() << "Unknown data type.";
+        if (role == Qt::DisplayRole) {
+            return QString::number(section);
+        }
 
-                val = 0.0;
-            }
+        if (role == Qt::TextAlignmentRole) {
+            return int(Qt::AlignRight|Qt::AlignVCenter);
+        }
 
-            //qDebug() << "Adding item" << row << 0 << "for _bData";
+        return QVariant();
+    }
 
-            setItem(row, _bColumnId, item);
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
 
-            _bArrayValues.push_back(val);
+    if (section == _arrayWidget->aColumn()) {
+        return QString("%1:%2:%3").arg(_arrayWidget->aLabel()).arg(_arrayWidget->aAddressOffset()).arg(_arrayWidget->aAddressStride());
+    }
 
-            row++;
-        }
+    if (section == _arrayWidget->bColumn()) {
+        return QString("%1:%2:%3").arg(_arrayWidget->bLabel()).arg(_arrayWidget->bAddressOffset()).arg(_arrayWidget->bAddressStride());
     }
 
-    emit dataChanged();
+    return QVariant();
 }
 
-SeerArrayWidget::DataStorageArray::DataStorageArray(const QByteArray& arr) {
-    _data = arr;
-}
+void SeerArrayWidgetModel::reset () {
 
-QByteArray SeerArrayWidget::DataStorageArray::getData(int position, int length) {
-    return _data.mid(position, length);
+    beginResetModel();
+    endResetModel();
 }
 
-int SeerArrayWidget::DataStorageArray::size() {
-    return _data.size();
-}
+void SeerArrayWidgetModel::rowsChanged (int column, int firstRow, int lastRow) {
 
+    if (column < 0 || firstRow > lastRow) {
+        return;
+    }
+
+    emit dataChanged(index(firstRow, column), index(lastRow, column));
+}
@@ -1,10 +1,36 @@
 #pragma once
 
-#include <QtWidgets/QTableWidget>
+#include <QtWidgets/QTableView>
+#include <QtCore/QAbstractTableModel>
 #include <QtCore/QByteArray>
 #include <QtCore/QVector>
+#include <QtCore/QBitArray>
 
-class SeerArrayWidget: public QTableWidget {
+class SeerArrayWidget;
+
+//
+// The table's model. Cells are formatted from the array bytes when they are painted.
+//
+class SeerArrayWidgetModel: public QAbstractTableModel {
+
+    Q_OBJECT
+
+    public:
+        SeerArrayWidgetModel(SeerArrayWidget* arrayWidget);
+
+        int                         rowCount                (const QModelIndex& parent = QModelIndex()) const override;
+        int                         columnCount             (const QModelIndex& parent = QModelIndex()) const override;
+        QVariant                    data                    (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        QVariant                    headerData              (int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+        void                        reset                   ();
+        void                        rowsChanged             (int column, int firstRow, int lastRow);
+
+    private:
+        SeerArrayWidget*            _arrayWidget;
+};
+
+class SeerArrayWidget: public QTableView {
 
     Q_OBJECT
 
@@ -13,6 +39,8 @@ class SeerArrayWidget: public QTableWidget {
             public:
                 virtual ~DataStorage() {};
                 virtual QByteArray getData(int position, int length) = 0;
+                virtual const char* constData() = 0;
+                virtual void setData(int position, const char* bytes, int length) = 0;
                 virtual int size() = 0;
         };
 
@@ -20,6 +48,8 @@ class SeerArrayWidget: public QTableWidget {
             public:
                 DataStorageArray(const QByteArray& arr);
                 virtual QByteArray getData(int position, int length);
+                virtual const char* constData();
+                virtual void setData(int position, const char* bytes, int length);
                 virtual int size();
             private:
                 QByteArray _data;
@@ -41,6 +71,11 @@ class SeerArrayWidget: public QTableWidget {
        ~SeerArrayWidget();
 
         int                         elementsPerLine         () const;
+        int                         arrayRowCount           () const;
+        int                         aColumn                 () const;
+        int                         bColumn                 () const;
+        QString                     elementText             (int column, int row) const;
+        bool                        elementChanged          (int column, int row) const;
 
         const QString&              aAxis                   () const;
         void                        setAAxis                (const QString& axis);
@@ -74,16 +109,39 @@ class SeerArrayWidget: public QTableWidget {
 
 
     signals:
-        void                        dataChanged             ();
+        void                        arrayChanged            ();
 
     public slots:
         void                        setAData                (const QString& label, DataStorage* pData);
         void                        setBData                (const QString& label, DataStorage* pData);
+        void                        updateAData             (int position, const char* bytes, int length);
+        void                        updateBData             (int position, const char* bytes, int length);
+        void                        clearChanged            ();
 
     protected:
 
     private:
+        //
+        // A typed view of one array. Element 'i' starts at 'data + i*step'.
+        //
+        struct ElementView {
+            const char*                 data;
+            int                         count;
+            int                         step;
+            SeerArrayWidget::ArrayMode  mode;
+        };
+
         void                        create                  ();
+        ElementView                 aView                   () const;
+        ElementView                 bView                   () const;
+        static ElementView          makeView                (DataStorage* data, SeerArrayWidget::ArrayMode mode, unsigned long elementSize, unsigned long offset, unsigned long stride);
+        static double               elementValue            (const ElementView& view, int i);
+        static QString              elementText             (const ElementView& view, int i);
+        static void                 fillValues              (const ElementView& view, QVector<double>& values);
+        static bool                 elementRange            (const ElementView& view, unsigned long elementSize, unsigned long offset, int position, int length, int* first, int* last);
+
+        SeerArrayWidgetModel*       _model;
+        int                         _rowCount;
 
         QString                     _aAxis;
         QString                     _aLabel;
@@ -92,7 +150,9 @@ class SeerArrayWidget: public QTableWidget {
         unsigned long               _aAddressOffset;
         unsigned long               _aAddressStride;
         SeerArrayWidget::ArrayMode  _aArrayMode;
-        QVector<double>             _aArrayValues;
+        mutable QVector<double>     _aArrayValues;
+        mutable bool                _aArrayValuesValid;
+        QBitArray                   _aChanged;
 
         QString                     _bAxis;
         QString                     _bLabel;
@@ -101,6 +161,8 @@ class SeerArrayWidget: public QTableWidget {
         unsigned long               _bAddressOffset;
         unsigned long               _bAddressStride;
         SeerArrayWidget::ArrayMode  _bArrayMode;
-        QVector<double>             _bArrayValues;
+        mutable QVector<double>     _bArrayValues;
+        mutable bool                _bArrayValuesValid;
+        QBitArray                   _bChanged;
 };
 
@@ -1,16 +1,16 @@
 #include "SeerConsoleWidget.h"
-#include <QtWidgets/QPlainTextEdit>
 #include <QtWidgets/QCheckBox>
+#include <QtWidgets/QToolButton>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QFontDialog>
 #include <QtWidgets/QMessageBox>
-#include <QtWidgets/QScrollBar>
 #include <QtPrintSupport/QPrinter>
 #include <QtPrintSupport/QPrintDialog>
 #include <QtGui/QFont>
 #include <QtGui/QIcon>
-#include <QtCore/QTextStream>
+#include <QtGui/QTextDocument>
 #include <QtCore/QSettings>
+#include <QtCore/QLocale>
 #include <QtCore/QDebug>
 #include <unistd.h>
 #include <stdlib.h>
@@ -18,6 +18,18 @@
 #include <termios.h>
 #include <sys/ioctl.h>
 
+namespace {
+
+    // A scroll line count of 0 used to mean unlimited. The console keeps this many.
+    const int MaximumScrollLines = 1000000;
+
+    // Read this much from the tty before letting the event loop have a turn.
+    const int MaximumReadPerWake = 4 * 1024 * 1024;
+
+    // Lines are drawn at most once a frame.
+    const int FlushInterval      = 16;
+}
+
 SeerConsoleWidget::SeerConsoleWidget (QWidget* parent) : QWidget(parent) {
 
     // Init variables.
@@ -25,6 +37,7 @@ SeerConsoleWidget::SeerConsoleWidget (QWidget* parent) : QWidget(parent) {
     _ptsFD         = -1;
     _ptsListener   = 0;
     _mode          = "normal";
+    _bytesRead     = 0;
 
     // Set up UI.
     setupUi(this);
@@ -39,13 +52,17 @@ SeerConsoleWidget::SeerConsoleWidget (QWidget* parent) : QWidget(parent) {
     font.setFixedPitch(true);
     font.setStyleHint(QFont::TypeWriter);
 
-    textEdit->setReadOnly(true);
-    textEdit->setTextInteractionFlags(textEdit->textInteractionFlags() | Qt::TextSelectableByKeyboard); // Show cursor
-    textEdit->setFont(font);
-    textEdit->setLineWrapMode(QPlainTextEdit::NoWrap); // No wrap
+    logView->setFont(font);
+    logView->setWrapEnabled(false);                 // No wrap
+    logView->setFlushInterval(FlushInterval);
+    logView->setPlaceholderText("[program output text]");
     wrapTextCheckBox->setCheckState(Qt::Unchecked); // No wrap
 
-    _cursor = QTextCursor(textEdit->document());
+    searchTextLineEdit->enableReturnPressedOnClear();
+
+    // Update the throughput and dropped line counts once a second.
+    _statsTimer.setInterval(1000);
+    _statsClock.start();
 
     // Create psuedo terminal for console.
     createConsole();
@@ -54,12 +71,18 @@ SeerConsoleWidget::SeerConsoleWidget (QWidget* parent) : QWidget(parent) {
     setMode("normal");
 
     // Connect things.
-    QObject::connect(clearButton,       &QPushButton::clicked,      this,  &SeerConsoleWidget::handleClearButton);
-    QObject::connect(printButton,       &QPushButton::clicked,      this,  &SeerConsoleWidget::handlePrintButton);
-    QObject::connect(saveButton,        &QPushButton::clicked,      this,  &SeerConsoleWidget::handleSaveButton);
-    QObject::connect(fontButton,        &QPushButton::clicked,      this,  &SeerConsoleWidget::handleFontButton);
-    QObject::connect(wrapTextCheckBox,  &QCheckBox::clicked,        this,  &SeerConsoleWidget::handleWrapTextCheckBox);
-    QObject::connect(stdinLineEdit,     &QLineEdit::returnPressed,  this,  &SeerConsoleWidget::handleStdinLineEdit);
+    QObject::connect(clearButton,           &QPushButton::clicked,      this,  &SeerConsoleWidget::handleClearButton);
+    QObject::connect(printButton,           &QPushButton::clicked,      this,  &SeerConsoleWidget::handlePrintButton);
+    QObject::connect(saveButton,            &QPushButton::clicked,      this,  &SeerConsoleWidget::handleSaveButton);
+    QObject::connect(fontButton,            &QPushButton::clicked,      this,  &SeerConsoleWidget::handleFontButton);
+    QObject::connect(wrapTextCheckBox,      &QCheckBox::clicked,        this,  &SeerConsoleWidget::handleWrapTextCheckBox);
+    QObject::connect(stdinLineEdit,         &QLineEdit::returnPressed,  this,  &SeerConsoleWidget::handleStdinLineEdit);
+    QObject::connect(searchTextLineEdit,    &QLineEdit::returnPressed,  this,  &SeerConsoleWidget::handleSearchTextLineEdit);
+    QObject::connect(searchDownToolButton,  &QToolButton::clicked,      this,  &SeerConsoleWidget::handleSearchDownToolButton);
+    QObject::connect(searchUpToolButton,    &QToolButton::clicked,      this,  &SeerConsoleWidget::handleSearchUpToolButton);
+    QObject::connect(&_statsTimer,          &QTimer::timeout,           this,  &SeerConsoleWidget::handleStatsTimer);
+
+    _statsTimer.start();
 
     // Restore window settings.
     readSettings();
@@ -76,44 +99,8 @@ const QString& SeerConsoleWidget::ttyDeviceName () const {
 
 void SeerConsoleWidget::handleText (const char* buffer, int count) {
 
-    // parse off lines
-    const char* start = buffer;
-
-    while (count > 0) {
-
-        int len = 0;
-
-        while (count > 0 && start[len] != '\n' && start[len] != '\r') {
-            --count;
-            ++len;
-        }
-
-        if (len > 0) {
-            QString str = QString::fromLatin1(start, len);
-            // replace text in the last line
-            // this selection is non-empty only after a '\r' that was not
-            // followed by a '\n'
-            _cursor.movePosition(QTextCursor::Right, QTextCursor::KeepAnchor, len);
-            _cursor.insertText(str);
-            start += len;
-            len = 0;
-        }
-
-        if (count > 0 && *start == '\r') {
-            ++start;
-            --count;
-            _cursor.movePosition(QTextCursor::StartOfLine);
-        }
-
-        if (count > 0 && *start == '\n') {
-            ++start;
-            --count;
-            _cursor.movePosition(QTextCursor::End);
-            _cursor.insertText(QString('\n'));
-        }
-
-        textEdit->verticalScrollBar()->setValue(textEdit->verticalScrollBar()->maximum());
-    }
+    // The view splits the lines and handles '\r'. It's drawn on its next frame.
+    logView->appendText(QString::fromLatin1(buffer, count));
 }
 
 void SeerConsoleWidget::handleChangeWindowTitle (QString title) {
@@ -126,8 +113,9 @@ void SeerConsoleWidget::handleChangeWindowTitle (QString title) {
 }
 
 void SeerConsoleWidget::handleClearButton () {
-    textEdit->clear();
-    _cursor.movePosition(QTextCursor::End);
+    logView->clear();
+
+    handleStatsTimer();
 }
 
 void SeerConsoleWidget::handlePrintButton () {
@@ -140,9 +128,12 @@ void SeerConsoleWidget::handlePrintButton () {
         return;
     }
 
-    QTextDocument* document = textEdit->document();
+    // The lines that are kept.
+    QTextDocument document;
+    document.setDefaultFont(logView->font());
+    document.setPlainText(logView->toPlainText());
 
-    document->print(&printer);
+    document.print(&printer);
 }
 
 void SeerConsoleWidget::handleSaveButton () {
@@ -171,10 +162,7 @@ void SeerConsoleWidget::handleSaveButton () {
 
     QFile file(files[0]);
 
-    if (file.open(QIODevice::ReadWrite)) {
-        QTextStream stream(&file);
-        stream << textEdit->toPlainText();
-        file.flush();
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate) && logView->write(&file)) {
         file.close();
 
     }else{
@@ -187,13 +175,13 @@ void SeerConsoleWidget::handleFontButton () {
 
     bool ok;
 
-    QFont font = QFontDialog::getFont(&ok, textEdit->font(), this, "Seer - Select Console Font", QFontDialog::DontUseNativeDialog|QFontDialog::MonospacedFonts);
+    QFont font = QFontDialog::getFont(&ok, logView->font(), this, "Seer - Select Console Font", QFontDialog::DontUseNativeDialog|QFontDialog::MonospacedFonts);
 
     if (ok == false) {
         return;
     }
 
-    textEdit->setFont(font);
+    logView->setFont(font);
 
     writeSettings();
 }
@@ -201,9 +189,9 @@ void SeerConsoleWidget::handleFontButton () {
 void SeerConsoleWidget::handleWrapTextCheckBox () {
 
     if (wrapTextCheckBox->checkState() == Qt::Unchecked) {
-        textEdit->setLineWrapMode(QPlainTextEdit::NoWrap);       // No wrap
+        logView->setWrapEnabled(false);     // No wrap
     }else{
-        textEdit->setLineWrapMode(QPlainTextEdit::WidgetWidth);  // Wrap at end of widget
+        logView->setWrapEnabled(true);      // Wrap at end of widget
     }
 }
 
@@ -234,6 +222,33 @@ void SeerConsoleWidget::handleStdinLineEdit () {
     fsync(_ptsFD);
 }
 
+void SeerConsoleWidget::handleSearchTextLineEdit () {
+
+    handleSearchDownToolButton();
+}
+
+void SeerConsoleWidget::handleSearchDownToolButton () {
+
+    QString str = searchTextLineEdit->text();
+
+    if (str == "") {
+        return;
+    }
+
+    logView->find(str, false, matchCaseCheckBox->isChecked() ? Qt::CaseSensitive : Qt::CaseInsensitive);
+}
+
+void SeerConsoleWidget::handleSearchUpToolButton () {
+
+    QString str = searchTextLineEdit->text();
+
+    if (str == "") {
+        return;
+    }
+
+    logView->find(str, true, matchCaseCheckBox->isChecked() ? Qt::CaseSensitive : Qt::CaseInsensitive);
+}
+
 void SeerConsoleWidget::handleConsoleOutput (int socketfd) {
 
     if (_ptsFD < 0) {
@@ -242,12 +257,27 @@ void SeerConsoleWidget::handleConsoleOutput (int socketfd) {
 
     Q_UNUSED(socketfd);
 
-    char buffer[1024];
+    //
+    // Empty the tty, so the program doesn't block on a full one. What's read is only
+    // queued. The console draws it on its next frame, however much there was. After a
+    // few MB, let the event loop have a turn. The notifier fires again if there's more.
+    //
+    char buffer[64 * 1024];
+
+    int total = 0;
 
-    while (1) {
-        int n = read(_ptsFD, buffer, sizeof(buffer));
+    while (total < MaximumReadPerWake) {
+        ssize_t n = read(_ptsFD, buffer, sizeof(buffer));
+
+        if (n == 0) {
+            break;
+        }
 
         if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
             if (errno == EAGAIN) {
                 break;
             }
@@ -263,8 +293,21 @@ void SeerConsoleWidget::handleConsoleOutput (int socketfd) {
         }
 
         handleText(buffer, n);
-        break;
+
+        total += n;
     }
+
+    _bytesRead += total;
+}
+
+void SeerConsoleWidget::handleStatsTimer () {
+
+    qint64 msecs = qMax(qint64(1), _statsClock.restart());
+    qint64 rate  = qint64(_bytesRead * 1000 / msecs);
+
+    _bytesRead = 0;
+
+    statsLabel->setText(QString("%1/s, %2 dropped").arg(QLocale().formattedDataSize(rate)).arg(logView->droppedLineCount()));
 }
 
 void SeerConsoleWidget::createConsole () {
@@ -313,7 +356,7 @@ void SeerConsoleWidget::createConsole () {
     // Save the device name.
     _ttyDeviceName = ptsname(_ptsFD);
 
-    // Set maximum blocks to 0 (unlimited).
+    // Set maximum lines to 0 (the most the console keeps).
     // The createConsole can be followed with a setScrollLines() call.
     setScrollLines(0);
 }
@@ -354,12 +397,21 @@ void SeerConsoleWidget::deleteConsole () {
 
 void SeerConsoleWidget::setScrollLines (int count) {
 
-    textEdit->setMaximumBlockCount(count);
+    // The scrollback is always bounded. 0 gets the most it keeps.
+    if (count <= 0) {
+        count = MaximumScrollLines;
+    }
+
+    logView->setMaximumLineCount(count);
 }
 
 int SeerConsoleWidget::scrollLines () const {
 
-    return textEdit->maximumBlockCount();
+    if (logView->maximumLineCount() == MaximumScrollLines) {
+        return 0;
+    }
+
+    return logView->maximumLineCount();
 }
 
 void SeerConsoleWidget::setMode (const QString& mode) {
@@ -410,7 +462,7 @@ void SeerConsoleWidget::writeSettings() {
 
     settings.beginGroup("consolewindow"); {
         settings.setValue("size", size());
-        settings.setValue("font", textEdit->font().toString());
+        settings.setValue("font", logView->font().toString());
     }settings.endGroup();
 
     //qDebug() << size();
@@ -430,7 +482,7 @@ void SeerConsoleWidget::readSettings() {
             f = QFont("monospace", 10);
         }
 
-        textEdit->setFont(f);
+        logView->setFont(f);
 
     } settings.endGroup();
 
@@ -1,10 +1,11 @@
 #pragma once
 
 #include <QtWidgets/QWidget>
-#include <QtGui/QTextCursor>
 #include <QtGui/QResizeEvent>
 #include <QtCore/QString>
 #include <QtCore/QSocketNotifier>
+#include <QtCore/QTimer>
+#include <QtCore/QElapsedTimer>
 #include "ui_SeerConsoleWidget.h"
 
 class SeerConsoleWidget : public QWidget, protected Ui::SeerConsoleWidgetForm {
@@ -35,7 +36,11 @@ class SeerConsoleWidget : public QWidget, protected Ui::SeerConsoleWidgetForm {
         void                handleFontButton            ();
         void                handleWrapTextCheckBox      ();
         void                handleStdinLineEdit         ();
+        void                handleSearchTextLineEdit    ();
+        void                handleSearchDownToolButton  ();
+        void                handleSearchUpToolButton    ();
         void                handleConsoleOutput         (int socketfd);
+        void                handleStatsTimer            ();
 
     protected:
         void                handleText                  (const char* buffer, int count);
@@ -47,9 +52,11 @@ class SeerConsoleWidget : public QWidget, protected Ui::SeerConsoleWidgetForm {
 
     private:
         QString             _mode;
-        QTextCursor         _cursor;
         QString             _ttyDeviceName;
         int                 _ptsFD;
         QSocketNotifier*    _ptsListener;
+        quint64             _bytesRead;         // Since the last stats update.
+        QTimer              _statsTimer;
+        QElapsedTimer       _statsClock;
 };
 
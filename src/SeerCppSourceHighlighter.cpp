@@ -1,7 +1,207 @@
 #include "SeerCppSourceHighlighter.h"
+#include <QtGui/QTextBlock>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QDebug>
+#include <mutex>
+#include <cstring>
+
+namespace {
+
+    // List from the kdbg debugger. Plus Qt's.
+    const char* const keywords[] = {
+        "alignas",      "alignof",      "and",              "and_eq",       "asm",          "auto",
+        "bitand",       "bitor",        "bool",             "break",        "case",         "catch",
+        "char",         "char16_t",     "char32_t",         "class",        "compl",        "const",
+        "const_cast",   "constexpr",    "continue",         "decltype",     "default",      "delete",
+        "do",           "double",       "dynamic_cast",     "else",         "enum",         "explicit",
+        "export",       "extern",       "false",            "float",        "for",          "friend",
+        "goto",         "if",           "inline",           "int",          "long",         "mutable",
+        "namespace",    "new",          "noexcept",         "not",          "not_eq",       "nullptr",
+        "operator",     "or",           "or_eq",            "private",      "protected",    "public",
+        "register",     "reinterpret_cast", "return",       "short",        "signed",       "sizeof",
+        "static",       "static_assert", "static_cast",     "struct",       "switch",       "template",
+        "this",         "thread_local", "throw",            "true",         "try",          "typedef",
+        "typeid",       "typename",     "union",            "unsigned",     "using",        "virtual",
+        "void",         "volatile",     "wchar_t",          "while",        "xor",          "xor_eq",
+        "slots",        "signals"
+    };
+
+    enum {
+        KeywordTableSize = 1024,    // A power of 2.
+        KeywordMaxLength = 16
+    };
+
+    //
+    // A perfect hash of the keywords. The seed is searched for, once, so that no
+    // two keywords land in the same slot. A lookup is one hash and one compare.
+    //
+    struct KeywordTable {
+        quint32         seed;
+        const char*     words[KeywordTableSize];
+        int             lengths[KeywordTableSize];
+    };
+
+    template <typename CharType>
+    inline quint32 keywordHash (const CharType* word, int length, quint32 seed) {
+
+        quint32 h = seed ^ (quint32)length;
+
+        for (int i=0; i<length; i++) {
+            h = h * 31u + (quint32)word[i];
+        }
+
+        h ^= h >> 15;
+        h *= 0x2c1b3c6du;
+        h ^= h >> 12;
+
+        return h & (KeywordTableSize - 1);
+    }
+
+    const KeywordTable& keywordTable () {
+
+        static KeywordTable   table;
+        static std::once_flag flag;
+
+        std::call_once(flag, []() {
+
+            for (quint32 seed=1; ; seed++) {
+
+                memset(table.words, 0, sizeof(table.words));
+
+                bool perfect = true;
+
+                for (const char* keyword : keywords) {
+
+                    int      length = (int)strlen(keyword);
+                    quint32  slot   = keywordHash(keyword, length, seed);
+
+                    if (table.words[slot]) {
+                        perfect = false;
+                        break;
+                    }
+
+                    table.words[slot]   = keyword;
+                    table.lengths[slot] = length;
+                }
+
+                if (perfect) {
+                    table.seed = seed;
+                    break;
+                }
+            }
+        });
+
+        return table;
+    }
+
+    inline bool isIdentifierStart (QChar c) {
+
+        ushort u = c.unicode();
+
+        return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || u == '_' || (u >= 0x80 && c.isLetter());
+    }
+
+    inline bool isIdentifierChar (QChar c) {
+
+        ushort u = c.unicode();
+
+        return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9') || u == '_' || (u >= 0x80 && c.isLetterOrNumber());
+    }
+
+    inline bool isDigit (QChar c) {
+
+        return c.unicode() >= '0' && c.unicode() <= '9';
+    }
+
+    //
+    // Same as the old "\bQ[A-Za-z]+\b" rule. QString, QTextDocument, ...
+    //
+    inline bool isClassName (const QChar* word, int length) {
+
+        if (length < 2 || word[0] != QLatin1Char('Q')) {
+            return false;
+        }
+
+        for (int i=1; i<length; i++) {
+
+            ushort u = word[i].unicode();
+
+            if ((u >= 'a' && u <= 'z') == false && (u >= 'A' && u <= 'Z') == false) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline bool isWord (const QChar* word, int length, const char* text) {
+
+        int i = 0;
+
+        for (; i<length && text[i] != '\0'; i++) {
+            if (word[i].unicode() != (ushort)text[i]) {
+                return false;
+            }
+        }
+
+        return i == length && text[i] == '\0';
+    }
+
+    inline bool isStringPrefix (const QChar* word, int length) {
+
+        return isWord(word, length, "L") || isWord(word, length, "u") || isWord(word, length, "U") || isWord(word, length, "u8");
+    }
+
+    inline bool isRawStringPrefix (const QChar* word, int length) {
+
+        return isWord(word, length, "R") || isWord(word, length, "LR") || isWord(word, length, "uR") || isWord(word, length, "UR") || isWord(word, length, "u8R");
+    }
+
+    //
+    // Find the end of a string or character literal that starts at 'start' (just past the quote).
+    // Returns the position after the closing quote, or the end of the line. 'continued' is set if
+    // the line ends with a '\', so the string goes on to the next line.
+    //
+    int scanQuoted (const QChar* s, int n, int start, QChar quote, bool* continued) {
+
+        *continued = false;
+
+        for (int i=start; i<n; i++) {
+
+            if (s[i] == QLatin1Char('\\')) {
+
+                if (i + 1 >= n) {
+                    *continued = true;
+                    return n;
+                }
+
+                i++;
+
+            }else if (s[i] == quote) {
+                return i + 1;
+            }
+        }
+
+        return n;
+    }
+}
 
 SeerCppSourceHighlighter::SeerCppSourceHighlighter (QTextDocument* parent) : QSyntaxHighlighter(parent) {
 
+    _formatting   = true;
+    _deferring    = false;
+    _visibleFirst = 0;
+    _visibleLast  = -1;
+    _nextPending  = 0;
+
+    // Raw strings with no delimiter, R"(...)", are the usual ones.
+    _rawDelimiters.append("");
+
+    _pendingTimer = new QTimer(this);
+    _pendingTimer->setInterval(0);
+
+    QObject::connect(_pendingTimer, &QTimer::timeout,    this, &SeerCppSourceHighlighter::handlePendingTimer);
+
     // Set to default formats.
     setHighlighterSettings(SeerHighlighterSettings::populateForCPP(""));
 }
@@ -21,130 +221,362 @@ void SeerCppSourceHighlighter::setHighlighterSettings (const SeerHighlighterSett
     _singleLineCommentFormat = _highlighterSettings.get("Comment");
     _multiLineCommentFormat  = _highlighterSettings.get("Multiline Comment");
     _keywordFormat           = _highlighterSettings.get("Keyword");
+}
 
+void SeerCppSourceHighlighter::rehighlightVisibleFirst (int firstBlock, int lastBlock) {
 
-    /* List from QT example.
-    const QString keywordPatterns[] = {
-        QStringLiteral("\\bchar\\b"),     QStringLiteral("\\bclass\\b"),     QStringLiteral("\\bconst\\b"),
-        QStringLiteral("\\bdouble\\b"),   QStringLiteral("\\benum\\b"),      QStringLiteral("\\bexplicit\\b"),
-        QStringLiteral("\\bfriend\\b"),   QStringLiteral("\\binline\\b"),    QStringLiteral("\\bint\\b"),
-        QStringLiteral("\\blong\\b"),     QStringLiteral("\\bnamespace\\b"), QStringLiteral("\\boperator\\b"),
-        QStringLiteral("\\bprivate\\b"),  QStringLiteral("\\bprotected\\b"), QStringLiteral("\\bpublic\\b"),
-        QStringLiteral("\\bshort\\b"),    QStringLiteral("\\bsignals\\b"),   QStringLiteral("\\bsigned\\b"),
-        QStringLiteral("\\bslots\\b"),    QStringLiteral("\\bstatic\\b"),    QStringLiteral("\\bstruct\\b"),
-        QStringLiteral("\\btemplate\\b"), QStringLiteral("\\btypedef\\b"),   QStringLiteral("\\btypename\\b"),
-        QStringLiteral("\\bunion\\b"),    QStringLiteral("\\bunsigned\\b"),  QStringLiteral("\\bvirtual\\b"),
-        QStringLiteral("\\bvoid\\b"),     QStringLiteral("\\bvolatile\\b"),  QStringLiteral("\\bbool\\b")
-    };
-    */
-
-    // List from the kdbg debugger.
-    const QString keywordPatterns[] = {
-        QStringLiteral("\\balignas\\b"),    QStringLiteral("\\balignof\\b"),            QStringLiteral("\\band\\b"),
-        QStringLiteral("\\band_eq\\b"),     QStringLiteral("\\basm\\b"),                QStringLiteral("\\bauto\\b"),
-        QStringLiteral("\\bbitand\\b"),     QStringLiteral("\\bbitor\\b"),              QStringLiteral("\\bbool\\b"),
-        QStringLiteral("\\bbreak\\b"),      QStringLiteral("\\bcase\\b"),               QStringLiteral("\\bcatch\\b"),
-        QStringLiteral("\\bchar\\b"),       QStringLiteral("\\bchar16_t\\b"),           QStringLiteral("\\bchar32_t\\b"),
-        QStringLiteral("\\bclass\\b"),      QStringLiteral("\\bcompl\\b"),              QStringLiteral("\\bconst\\b"),
-        QStringLiteral("\\bconst_cast\\b"), QStringLiteral("\\bconstexpr\\b"),          QStringLiteral("\\bcontinue\\b"),
-        QStringLiteral("\\bdecltype\\b"),   QStringLiteral("\\bdefault\\b"),            QStringLiteral("\\bdelete\\b"),
-        QStringLiteral("\\bdo\\b"),         QStringLiteral("\\bdouble\\b"),             QStringLiteral("\\bdynamic_cast\\b"),
-        QStringLiteral("\\belse\\b"),       QStringLiteral("\\benum\\b"),               QStringLiteral("\\bexplicit\\b"),
-        QStringLiteral("\\bexport\\b"),     QStringLiteral("\\bextern\\b"),             QStringLiteral("\\bfalse\\b"),
-        QStringLiteral("\\bfloat\\b"),      QStringLiteral("\\bfor\\b"),                QStringLiteral("\\bfriend\\b"),
-        QStringLiteral("\\bgoto\\b"),       QStringLiteral("\\bif\\b"),                 QStringLiteral("\\binline\\b"),
-        QStringLiteral("\\bint\\b"),        QStringLiteral("\\blong\\b"),               QStringLiteral("\\bmutable\\b"),
-        QStringLiteral("\\bnamespace\\b"),  QStringLiteral("\\bnew\\b"),                QStringLiteral("\\bnoexcept\\b"),
-        QStringLiteral("\\bnot\\b"),        QStringLiteral("\\bnot_eq\\b"),             QStringLiteral("\\bnullptr\\b"),
-        QStringLiteral("\\boperator\\b"),   QStringLiteral("\\bor\\b"),                 QStringLiteral("\\bor_eq\\b"),
-        QStringLiteral("\\bprivate\\b"),    QStringLiteral("\\bprotected\\b"),          QStringLiteral("\\bpublic\\b"),
-        QStringLiteral("\\bregister\\b"),   QStringLiteral("\\breinterpret_cast\\b"),   QStringLiteral("\\breturn\\b"),
-        QStringLiteral("\\bshort\\b"),      QStringLiteral("\\bsigned\\b"),             QStringLiteral("\\bsizeof\\b"),
-        QStringLiteral("\\bstatic\\b"),     QStringLiteral("\\bstatic_assert\\b"),      QStringLiteral("\\bstatic_cast\\b"),
-        QStringLiteral("\\bstruct\\b"),     QStringLiteral("\\bswitch\\b"),             QStringLiteral("\\btemplate\\b"),
-        QStringLiteral("\\bthis\\b"),       QStringLiteral("\\bthread_local\\b"),       QStringLiteral("\\bthrow\\b"),
-        QStringLiteral("\\btrue\\b"),       QStringLiteral("\\btry\\b"),                QStringLiteral("\\btypedef\\b"),
-        QStringLiteral("\\btypeid\\b"),     QStringLiteral("\\btypename\\b"),           QStringLiteral("\\bunion\\b"),
-        QStringLiteral("\\bunsigned\\b"),   QStringLiteral("\\busing\\b"),              QStringLiteral("\\bvirtual\\b"),
-        QStringLiteral("\\bvoid\\b"),       QStringLiteral("\\bvolatile\\b"),           QStringLiteral("\\bwchar_t\\b"),
-        QStringLiteral("\\bwhile\\b"),      QStringLiteral("\\bxor\\b"),                QStringLiteral("\\bxor_eq\\b"),
-        QStringLiteral("\\bslots\\b"),      QStringLiteral("\\bsignals\\b")
-    };
+    _pendingTimer->stop();
+
+    if (document() == 0) {
+        return;
+    }
+
+    // Every block gets its state now. Only the ones that can be seen are formatted.
+    // The others are remembered and done by the timer.
+    _pending      = QBitArray(document()->blockCount());
+    _nextPending  = 0;
+    _visibleFirst = firstBlock;
+    _visibleLast  = lastBlock;
+    _deferring    = true;
+
+    rehighlight();
+
+    _deferring    = false;
+
+    if (hasPendingBlocks()) {
+        _pendingTimer->start();
+    }
+}
+
+void SeerCppSourceHighlighter::highlightBlocks (int firstBlock, int lastBlock) {
+
+    if (document() == 0 || hasPendingBlocks() == false) {
+        return;
+    }
+
+    firstBlock = qMax(firstBlock, 0);
+    lastBlock  = qMin(lastBlock, _pending.size() - 1);
+
+    for (int i=firstBlock; i<=lastBlock; i++) {
 
-    _highlightingRules.clear(); // Clear old rules.
+        if (_pending.testBit(i)) {
+            _pending.clearBit(i);
+            rehighlightBlock(document()->findBlockByNumber(i));
+        }
+    }
+}
 
-    HighlightingRule rule;
+bool SeerCppSourceHighlighter::hasPendingBlocks () const {
 
-    for (const QString& pattern : keywordPatterns) {
+    return _nextPending < _pending.size();
+}
 
-        rule.pattern = QRegularExpression(pattern);
-        rule.format  = _keywordFormat;
+void SeerCppSourceHighlighter::handlePendingTimer () {
 
-        _highlightingRules.append(rule);
+    // The document went away, or changed under us.
+    if (document() == 0 || document()->blockCount() != _pending.size()) {
+        _pending.clear();
+        _pendingTimer->stop();
+        return;
     }
 
-    // Set class format and expression.
-    rule.pattern = QRegularExpression(QStringLiteral("\\bQ[A-Za-z]+\\b"));
-    rule.format = _classFormat;
-    _highlightingRules.append(rule);
+    // Do a slice, then let events in.
+    QElapsedTimer timer;
+    timer.start();
 
-    // Set quote format and expression.
-    rule.pattern = QRegularExpression(QStringLiteral("\".*\""));
-    rule.format = _quotationFormat;
-    _highlightingRules.append(rule);
+    while (_nextPending < _pending.size() && timer.elapsed() < 10) {
 
-    // Set function format and expression.
-    rule.pattern = QRegularExpression(QStringLiteral("\\b[A-Za-z0-9_]+(?=\\()"));
-    rule.format = _functionFormat;
-    _highlightingRules.append(rule);
+        if (_pending.testBit(_nextPending)) {
+            _pending.clearBit(_nextPending);
+            rehighlightBlock(document()->findBlockByNumber(_nextPending));
+        }
 
-    // Set single line comment format and expression.
-    rule.pattern = QRegularExpression(QStringLiteral("//[^\n]*"));
-    rule.format  = _singleLineCommentFormat;
-    _highlightingRules.append(rule);
+        _nextPending++;
+    }
 
-    // Set multi-line comment expression. Format is defined later.
-    _commentStartExpression = QRegularExpression(QStringLiteral("/\\*"));
-    _commentEndExpression   = QRegularExpression(QStringLiteral("\\*/"));
+    if (hasPendingBlocks() == false) {
+        _pending.clear();
+        _nextPending = 0;
+        _pendingTimer->stop();
+    }
+}
+
+bool SeerCppSourceHighlighter::isKeyword (const QChar* word, int length) {
+
+    if (length < 2 || length > KeywordMaxLength) {
+        return false;
+    }
+
+    const KeywordTable& table = keywordTable();
+
+    const ushort* w    = (const ushort*)word;
+    quint32       slot = keywordHash(w, length, table.seed);
+
+    if (table.words[slot] == 0 || table.lengths[slot] != length) {
+        return false;
+    }
+
+    return isWord(word, length, table.words[slot]);
 }
 
 void SeerCppSourceHighlighter::highlightBlock (const QString& text) {
 
-    for (const HighlightingRule& rule : qAsConst(_highlightingRules)) {
+    // Outside of what can be seen, just work out the state. The format is done later.
+    _formatting = true;
+
+    if (_deferring) {
+
+        int block = currentBlock().blockNumber();
+
+        if ((block < _visibleFirst || block > _visibleLast) && block < _pending.size()) {
+            _pending.setBit(block);
+            _formatting = false;
+        }
+    }
+
+    setCurrentBlockState(highlightLine(text, previousBlockState()));
+
+    _formatting = true;
+}
+
+void SeerCppSourceHighlighter::applyFormat (int start, int count, const QTextCharFormat& format) {
+
+    if (_formatting && count > 0) {
+        setFormat(start, count, format);
+    }
+}
+
+int SeerCppSourceHighlighter::highlightLine (const QString& text, int state) {
+
+    const QChar* s = text.constData();
+    int          n = text.size();
+    int          i = 0;
+
+    if (state < 0) {
+        state = NormalState;
+    }
+
+    // Finish what the line before started.
+    switch (state & 0xff) {
 
-        QRegularExpressionMatchIterator matchIterator = rule.pattern.globalMatch(text);
+        case CommentState: {
 
-        while (matchIterator.hasNext()) {
-            QRegularExpressionMatch match = matchIterator.next();
-            setFormat(match.capturedStart(), match.capturedLength(), rule.format);
+            int end = text.indexOf(QLatin1String("*/"));
+
+            if (end < 0) {
+                applyFormat(0, n, _multiLineCommentFormat);
+                return CommentState;
+            }
+
+            i = end + 2;
+
+            applyFormat(0, i, _multiLineCommentFormat);
+            break;
+        }
+
+        case StringState: {
+
+            bool continued;
+
+            i = scanQuoted(s, n, 0, QLatin1Char('"'), &continued);
+
+            applyFormat(0, i, _quotationFormat);
+
+            if (continued) {
+                return StringState;
+            }
+            break;
+        }
+
+        case LineCommentState:
+
+            applyFormat(0, n, _singleLineCommentFormat);
+
+            return text.endsWith(QLatin1Char('\\')) ? LineCommentState : NormalState;
+
+        case RawStringState: {
+
+            QString close = ")" + _rawDelimiters.value(state >> 8) + "\"";
+            int     end   = text.indexOf(close);
+
+            if (end < 0) {
+                applyFormat(0, n, _quotationFormat);
+                return state;
+            }
+
+            i = end + close.size();
+
+            applyFormat(0, i, _quotationFormat);
+            break;
         }
+
+        default:
+            break;
     }
 
-    setCurrentBlockState(0);
+    // The rest of the line. Things are skipped over a token at a time.
+    while (i < n) {
+
+        QChar c = s[i];
+
+        if (c == QLatin1Char('/') && i + 1 < n && s[i+1] == QLatin1Char('/')) {
+
+            applyFormat(i, n - i, _singleLineCommentFormat);
+
+            return text.endsWith(QLatin1Char('\\')) ? LineCommentState : NormalState;
+        }
+
+        if (c == QLatin1Char('/') && i + 1 < n && s[i+1] == QLatin1Char('*')) {
+
+            int end = text.indexOf(QLatin1String("*/"), i + 2);
+
+            if (end < 0) {
+                applyFormat(i, n - i, _multiLineCommentFormat);
+                return CommentState;
+            }
+
+            applyFormat(i, end + 2 - i, _multiLineCommentFormat);
+
+            i = end + 2;
+            continue;
+        }
+
+        if (c == QLatin1Char('"') || c == QLatin1Char('\'')) {
+
+            bool continued;
+            int  end = scanQuoted(s, n, i + 1, c, &continued);
+
+            applyFormat(i, end - i, _quotationFormat);
+
+            if (continued && c == QLatin1Char('"')) {
+                return StringState;
+            }
+
+            i = end;
+            continue;
+        }
+
+        // Numbers, so 0x1f and 1e10 aren't taken for words. Digit separators too (1'000).
+        if (isDigit(c)) {
+
+            int end = i + 1;
+
+            while (end < n && (isIdentifierChar(s[end]) || s[end] == QLatin1Char('.') || s[end] == QLatin1Char('\''))) {
+                end++;
+            }
+
+            i = end;
+            continue;
+        }
+
+        if (isIdentifierStart(c)) {
+
+            int end = i + 1;
+
+            while (end < n && isIdentifierChar(s[end])) {
+                end++;
+            }
+
+            const QChar* word   = s + i;
+            int          length = end - i;
+
+            // R"delim(...)delim", with a prefix or not.
+            if (end < n && s[end] == QLatin1Char('"') && isRawStringPrefix(word, length)) {
+
+                int rawState = NormalState;
+                int rawEnd   = rawString(text, i, end + 1, &rawState);
+
+                if (rawEnd >= 0) {
 
-    int startIndex = 0;
+                    applyFormat(i, rawEnd - i, _quotationFormat);
 
-    if (previousBlockState() != 1) {
-        startIndex = text.indexOf(_commentStartExpression);
+                    if (rawState != NormalState) {
+                        return rawState;
+                    }
+
+                    i = rawEnd;
+                    continue;
+                }
+            }
+
+            // L"...", u8"...", ... The prefix goes with the string.
+            if (end < n && (s[end] == QLatin1Char('"') || s[end] == QLatin1Char('\'')) && isStringPrefix(word, length)) {
+
+                bool continued;
+                int  stringEnd = scanQuoted(s, n, end + 1, s[end], &continued);
+
+                applyFormat(i, stringEnd - i, _quotationFormat);
+
+                if (continued && s[end] == QLatin1Char('"')) {
+                    return StringState;
+                }
+
+                i = stringEnd;
+                continue;
+            }
+
+            if (isKeyword(word, length)) {
+                applyFormat(i, length, _keywordFormat);
+            }else if (end < n && s[end] == QLatin1Char('(')) {
+                applyFormat(i, length, _functionFormat);
+            }else if (isClassName(word, length)) {
+                applyFormat(i, length, _classFormat);
+            }
+
+            i = end;
+            continue;
+        }
+
+        i++;
     }
 
-    while (startIndex >= 0) {
+    return NormalState;
+}
+
+int SeerCppSourceHighlighter::rawString (const QString& text, int start, int delimiterStart, int* state) {
 
-        QRegularExpressionMatch match = _commentEndExpression.match(text, startIndex);
+    // The delimiter is up to 16 characters before the '('. No spaces, parentheses, or backslashes.
+    int open = -1;
 
-        int endIndex      = match.capturedStart();
-        int commentLength = 0;
+    for (int i=delimiterStart; i<text.size() && i<=delimiterStart+16; i++) {
 
-        if (endIndex == -1) {
-            setCurrentBlockState(1);
-            commentLength = text.length() - startIndex;
+        QChar c = text[i];
 
-        }else{
-            commentLength = endIndex - startIndex + match.capturedLength();
+        if (c == QLatin1Char('(')) {
+            open = i;
+            break;
         }
 
-        setFormat(startIndex, commentLength, _multiLineCommentFormat);
-        startIndex = text.indexOf(_commentStartExpression, startIndex + commentLength);
+        if (c == QLatin1Char(')') || c == QLatin1Char('\\') || c.isSpace()) {
+            break;
+        }
+    }
+
+    // Not a raw string after all.
+    if (open < 0) {
+        return -1;
+    }
+
+    QString delimiter = text.mid(delimiterStart, open - delimiterStart);
+    QString close     = ")" + delimiter + "\"";
+    int     end       = text.indexOf(close, open + 1);
+
+    *state = NormalState;
+
+    if (end >= 0) {
+        return end + close.size();
+    }
+
+    // It goes on to the next lines. The state says which delimiter ends it.
+    int id = _rawDelimiters.indexOf(delimiter);
+
+    if (id < 0) {
+        id = _rawDelimiters.size();
+        _rawDelimiters.append(delimiter);
     }
+
+    *state = RawStringState | (id << 8);
+
+    return text.size();
 }
 
@@ -6,8 +6,19 @@
 #include <QtGui/QTextDocument>
 #include <QtGui/QTextCharFormat>
 #include <QtCore/QString>
-#include <QtCore/QRegularExpression>
-#include <QtCore/QVector>
+#include <QtCore/QStringList>
+#include <QtCore/QBitArray>
+#include <QtCore/QTimer>
+
+//
+// C++ highlighter. Each line is lexed once, left to right. Keywords are looked up
+// in a perfect hash table. Block comments, strings continued with a '\', and raw
+// strings carry over to the next line in the block state.
+//
+// rehighlightVisibleFirst() formats just the blocks that can be seen. The rest get
+// their state right away, but are formatted a bit at a time in the background.
+// highlightBlocks() formats some of those now. The ones scrolled to, say.
+//
 
 class SeerCppSourceHighlighter : public QSyntaxHighlighter {
 
@@ -19,19 +30,30 @@ class SeerCppSourceHighlighter : public QSyntaxHighlighter {
         const SeerHighlighterSettings&  highlighterSettings             ();
         void                            setHighlighterSettings          (const SeerHighlighterSettings& settings);
 
+        void                            rehighlightVisibleFirst         (int firstBlock, int lastBlock);
+        void                            highlightBlocks                 (int firstBlock, int lastBlock);
+        bool                            hasPendingBlocks                () const;
+
+        static bool                     isKeyword                       (const QChar* word, int length);
+
     protected:
         void                            highlightBlock                  (const QString& text) override;
 
+    private slots:
+        void                            handlePendingTimer              ();
+
     private:
-        struct HighlightingRule {
-            QRegularExpression pattern;
-            QTextCharFormat    format;
+        enum State {
+            NormalState         = 0,
+            CommentState        = 1,
+            StringState         = 2,
+            LineCommentState    = 3,
+            RawStringState      = 4
         };
 
-        QVector<HighlightingRule>       _highlightingRules;
-
-        QRegularExpression              _commentStartExpression;
-        QRegularExpression              _commentEndExpression;
+        int                             highlightLine                   (const QString& text, int state);
+        int                             rawString                       (const QString& text, int start, int delimiterStart, int* state);
+        void                            applyFormat                     (int start, int count, const QTextCharFormat& format);
 
         SeerHighlighterSettings         _highlighterSettings;
         QTextCharFormat                 _keywordFormat;
@@ -40,5 +62,14 @@ class SeerCppSourceHighlighter : public QSyntaxHighlighter {
         QTextCharFormat                 _multiLineCommentFormat;
         QTextCharFormat                 _quotationFormat;
         QTextCharFormat                 _functionFormat;
+
+        QStringList                     _rawDelimiters;
+        bool                            _formatting;
+        bool                            _deferring;
+        int                             _visibleFirst;
+        int                             _visibleLast;
+        QBitArray                       _pending;
+        int                             _nextPending;
+        QTimer*                         _pendingTimer;
 };
 
@@ -22,6 +22,7 @@ SeerEditorManagerWidget::SeerEditorManagerWidget (QWidget* parent) : QWidget(par
     _editorHighlighterEnabled  = true;
     _editorKeySettings         = SeerKeySettings::populate();                 // Default key settings.
     _editorTabSize             = 4;
+    _sourceResolver            = 0;
     _assemblyWidget            = 0;
     _keepAssemblyTabOnTop      = true;
     _showAddressColumn         = true;
@@ -333,6 +334,10 @@ void SeerEditorManagerWidget::setEditorAlternateDirectories (const QStringList a
 
     _editorAlternateDirectories = alternateDirectories;
 
+    if (_sourceResolver) {
+        _sourceResolver->setAlternateDirectories(_editorAlternateDirectories);
+    }
+
     SeerEditorManagerEntries::iterator b = beginEntry();
     SeerEditorManagerEntries::iterator e = endEntry();
 
@@ -392,6 +397,34 @@ int SeerEditorManagerWidget::editorTabSize () const {
     return _editorTabSize;
 }
 
+void SeerEditorManagerWidget::setSourceResolver (SeerSourceResolver* resolver) {
+
+    _sourceResolver = resolver;
+
+    if (_sourceResolver) {
+        _sourceResolver->setAlternateDirectories(_editorAlternateDirectories);
+    }
+
+    SeerEditorManagerEntries::iterator b = beginEntry();
+    SeerEditorManagerEntries::iterator e = endEntry();
+
+    while (b != e) {
+        b->widget->sourceArea()->setSourceResolver(_sourceResolver);
+        b++;
+    }
+
+    SeerEditorWidgetAssembly* assemblyWidget = assemblyWidgetTab();
+
+    if (assemblyWidget) {
+        assemblyWidget->assemblyArea()->setSourceResolver(_sourceResolver);
+    }
+}
+
+SeerSourceResolver* SeerEditorManagerWidget::sourceResolver () const {
+
+    return _sourceResolver;
+}
+
 void SeerEditorManagerWidget::handleText (const QString& text) {
 
     if (text.startsWith("*stopped")) {
@@ -616,7 +649,7 @@ void SeerEditorManagerWidget::handleText (const QString& text) {
             b++;
         }
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,value="))) {
+    }else if (Seer::matchRecord(text, "^done,value=")) {
 
         // 10^done,value="1"
         // 11^done,value="0x7fffffffd538"
@@ -634,7 +667,7 @@ void SeerEditorManagerWidget::handleText (const QString& text) {
             assemblyWidget->handleText(text);
         }
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
+    }else if (Seer::matchRecord(text, "^error,msg=")) {
 
         // 12^error,msg="No symbol \"return\" in current context."
         // 13^error,msg="No symbol \"cout\" in current context."
@@ -792,6 +825,7 @@ SeerEditorWidgetSource* SeerEditorManagerWidget::createEditorWidgetTab (const QS
     editorWidget->sourceArea()->setHighlighterSettings(editorHighlighterSettings());
     editorWidget->sourceArea()->setHighlighterEnabled(editorHighlighterEnabled());
     editorWidget->sourceArea()->setAlternateDirectories(editorAlternateDirectories());
+    editorWidget->sourceArea()->setSourceResolver(sourceResolver());
     editorWidget->setKeySettings(editorKeySettings());
 
     // Set the tooltip for the tab.
@@ -851,6 +885,7 @@ SeerEditorWidgetSource* SeerEditorManagerWidget::createEditorWidgetTab (const QS
     editorWidget->sourceArea()->setHighlighterSettings(editorHighlighterSettings());
     editorWidget->sourceArea()->setHighlighterEnabled(editorHighlighterEnabled());
     editorWidget->sourceArea()->setAlternateDirectories(editorAlternateDirectories());
+    editorWidget->sourceArea()->setSourceResolver(sourceResolver());
     editorWidget->setKeySettings(editorKeySettings());
 
     // Set the tooltip for the tab.
@@ -946,6 +981,7 @@ SeerEditorWidgetAssembly* SeerEditorManagerWidget::createAssemblyWidgetTab () {
     assemblyWidget->assemblyArea()->setEditorTabSize(editorTabSize());
     assemblyWidget->assemblyArea()->setHighlighterSettings(editorHighlighterSettings());
     assemblyWidget->assemblyArea()->setHighlighterEnabled(editorHighlighterEnabled());
+    assemblyWidget->assemblyArea()->setSourceResolver(sourceResolver());
 
     assemblyWidget->setShowAddressColumn(assemblyShowAddressColumn());
     assemblyWidget->setShowOffsetColumn(assemblyShowOffsetColumn());
@@ -1093,6 +1129,10 @@ void SeerEditorManagerWidget::handleAddAlternateDirectory (QString path) {
     // Add the new path to our list.
     _editorAlternateDirectories << path;
 
+    if (_sourceResolver) {
+        _sourceResolver->setAlternateDirectories(_editorAlternateDirectories);
+    }
+
     // Update any open editors. Future editors will get the updated list normally.
     SeerEditorManagerEntries::iterator b = beginEntry();
     SeerEditorManagerEntries::iterator e = endEntry();
@@ -4,6 +4,7 @@
 #include "SeerEditorManagerEntry.h"
 #include "SeerHighlighterSettings.h"
 #include "SeerKeySettings.h"
+#include "SeerSourceResolver.h"
 #include <QtGui/QFont>
 #include <QtWidgets/QWidget>
 #include <QtCore/QMap>
@@ -61,6 +62,8 @@ class SeerEditorManagerWidget : public QWidget, protected Ui::SeerEditorManagerW
         const SeerKeySettings&                          editorKeySettings                   () const;
         void                                            setEditorTabSize                    (int spaces);
         int                                             editorTabSize                       () const;
+        void                                            setSourceResolver                   (SeerSourceResolver* resolver);
+        SeerSourceResolver*                             sourceResolver                      () const;
 
     public slots:
         void                                            handleText                          (const QString& text);
@@ -133,6 +136,7 @@ class SeerEditorManagerWidget : public QWidget, protected Ui::SeerEditorManagerW
         QStringList                                     _editorIgnoreDirectories;
         SeerKeySettings                                 _editorKeySettings;
         int                                             _editorTabSize;
+        SeerSourceResolver*                             _sourceResolver;
         SeerEditorWidgetAssembly*                       _assemblyWidget;
         int                                             _assemblyIndex;
         bool                                            _keepAssemblyTabOnTop;
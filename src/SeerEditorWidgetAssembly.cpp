@@ -304,7 +304,7 @@ void SeerEditorWidgetAssembly::handleText (const QString& text) {
 
         return;
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,value="))) {
+    }else if (Seer::matchRecord(text, "^done,value=")) {
 
         QString id_text    = text.section('^', 0,0);
         QString value_text = Seer::parseFirst(text, "value=", '"', '"', false);
@@ -324,7 +324,7 @@ void SeerEditorWidgetAssembly::handleText (const QString& text) {
             return;
         }
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
+    }else if (Seer::matchRecord(text, "^error,msg=")) {
 
         QString id_text  = text.section('^', 0,0);
         QString msg_text = Seer::parseFirst(text, "value=", '"', '"', false);
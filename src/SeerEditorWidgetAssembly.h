@@ -3,6 +3,8 @@
 #include "SeerCppSourceHighlighter.h"
 #include "SeerKeySettings.h"
 #include "SeerPlainTextEdit.h"
+#include "SeerSourceResolver.h"
+#include "SeerSourceCache.h"
 #include <QtGui/QShortcut>
 #include <QtGui/QPaintEvent>
 #include <QtGui/QResizeEvent>
@@ -16,6 +18,7 @@
 #include <QtCore/QStringList>
 #include <QtCore/QVector>
 #include <QtCore/QMap>
+#include <QtCore/QHash>
 
 class SeerEditorWidgetAssemblyLineNumberArea;
 class SeerEditorWidgetAssemblyOffsetArea;
@@ -93,6 +96,8 @@ class SeerEditorWidgetAssemblyArea : public SeerPlainTextEdit {
         bool                                        highlighterEnabled                  () const;
 
         QString                                     sourceForLine                       (const QString& fullname, const QString& file, int line);
+        void                                        setSourceResolver                   (SeerSourceResolver* resolver);
+        SeerSourceResolver*                         sourceResolver                      () const;
 
         void                                        setEditorFont                       (const QFont& font);
         const QFont&                                editorFont                          () const;
@@ -168,10 +173,9 @@ class SeerEditorWidgetAssemblyArea : public SeerPlainTextEdit {
         // Text from asm_insns command.
         QString                                     _asm_insns_text;
 
-        // Source lines for assembly file.
-        QStringList                                 _fileLines;
-        QString                                     _fileFullname;
-        QString                                     _fileName;
+        // Source files for assembly file. Just for the current disassembly, so each is looked up once.
+        QHash<QString,SeerSourceLinesPtr>           _sourceLines;
+        SeerSourceResolver*                         _sourceResolver;
 
         int                                         _sourceTabSize;
 };
@@ -39,6 +39,7 @@ SeerEditorWidgetAssemblyArea::SeerEditorWidgetAssemblyArea(QWidget* parent) : Se
     _enableMiniMapArea    = false;
     _enableSourceLines    = false;
     _sourceTabSize        = 4;
+    _sourceResolver       = 0;
 
     _addressLineMap.clear();
     _offsetLineMap.clear();
@@ -208,6 +209,9 @@ void SeerEditorWidgetAssemblyArea::updateTextArea () {
     // Clear 'source line' selections.
     _sourceLinesExtraSelections.clear();
 
+    // Look the source files up again. They may have changed since the last time.
+    _sourceLines.clear();
+
     // Get the list of source and assembly lines.
     QString asm_insns_text = Seer::parseFirst(_asm_insns_text, "asm_insns=", '[', ']', false);
 
@@ -1489,34 +1493,48 @@ bool SeerEditorWidgetAssemblyArea::highlighterEnabled () const {
 
 QString SeerEditorWidgetAssemblyArea::sourceForLine (const QString& fullname, const QString& file, int line) {
 
-    // A new file?  Zap the previously cached file.
-    if (fullname != _fileFullname || file != _fileName) {
-        _fileLines    = QStringList();
-        _fileFullname = "";
-        _fileName     = "";
-    }
+    //
+    // Inlined code jumps between files a lot. Each file is looked up once per disassembly.
+    // Its lines come from the shared line index, so the file is only read the first time.
+    //
+    QString key = fullname + '\n' + file;
 
-    // Nothing in cache?  Open the file and read it.
-    if (_fileFullname == "" || _fileName == "") {
-        _fileFullname = fullname;
-        _fileName     = file;
+    QHash<QString,SeerSourceLinesPtr>::const_iterator i = _sourceLines.constFind(key);
 
-        bool f = Seer::readFile(_fileFullname, _fileLines);
-        if (f == false) {
-            qDebug() << "Can't read:" << _fileFullname;
+    if (i == _sourceLines.constEnd()) {
+
+        // Look for it where the source editors would.
+        QString filename = fullname;
+
+        if (_sourceResolver) {
+            filename = _sourceResolver->findFile(file, fullname);
         }
-    }
 
-    // Return the requested line.
-    // 'line' is 1 based. We want it to be 0 based.
+        SeerSourceLinesPtr lines = SeerSourceCache::lines(filename);
+
+        if (lines.isNull()) {
+            qDebug() << "Can't read:" << fullname;
+        }
 
-    line --;
+        i = _sourceLines.insert(key, lines);
+    }
 
-    if (line < 0 || line >= _fileLines.size()) {
+    // Return the requested line. 'line' is 1 based.
+    if (i.value().isNull()) {
         return "";
     }
 
-    return _fileLines[line];
+    return i.value()->line(line);
+}
+
+void SeerEditorWidgetAssemblyArea::setSourceResolver (SeerSourceResolver* resolver) {
+
+    _sourceResolver = resolver;
+}
+
+SeerSourceResolver* SeerEditorWidgetAssemblyArea::sourceResolver () const {
+
+    return _sourceResolver;
 }
 
 void SeerEditorWidgetAssemblyArea::setEditorFont (const QFont& font) {
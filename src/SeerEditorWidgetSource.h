@@ -3,6 +3,7 @@
 #include "SeerCppSourceHighlighter.h"
 #include "SeerKeySettings.h"
 #include "SeerPlainTextEdit.h"
+#include "SeerSourceResolver.h"
 #include <QShortcut>
 #include <QtWidgets/QWidget>
 #include <QtGui/QPaintEvent>
@@ -60,6 +61,8 @@ class SeerEditorWidgetSourceArea : public SeerPlainTextEdit {
         void                                        setAlternateDirectories             (const QStringList& alternateDirectories);
         const QStringList&                          alternateDirectories                () const;
         QString                                     findFile                            (const QString& file, const QString& fullname, const QString& alternateDirectory, const QStringList& alternateDirectories);
+        void                                        setSourceResolver                   (SeerSourceResolver* resolver);
+        SeerSourceResolver*                         sourceResolver                      () const;
 
         void                                        setCurrentLine                      (int lineno);
         void                                        scrollToLine                        (int lineno);
@@ -135,13 +138,17 @@ class SeerEditorWidgetSourceArea : public SeerPlainTextEdit {
         void                                        updateLineNumberArea                (const QRect& rect, int dy);
         void                                        updateBreakPointArea                (const QRect& rect, int dy);
         void                                        updateMiniMapArea                   (const QRect& rect, int dy);
+        void                                        highlightVisibleBlocks              ();
 
     private:
+        void                                        rehighlight                         ();
+
         QString                                     _fullname;
         QString                                     _file;
         QString                                     _alternateDirectory;
         QStringList                                 _alternateDirectories;
         QFileSystemWatcher*                         _fileWatcher;
+        SeerSourceResolver*                         _sourceResolver;
 
         bool                                        _enableLineNumberArea;
         bool                                        _enableBreakPointArea;
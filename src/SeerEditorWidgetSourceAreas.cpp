@@ -3,6 +3,7 @@
 #include "SeerBreakpointCreateDialog.h"
 #include "SeerPrintpointCreateDialog.h"
 #include "SeerUtl.h"
+#include "SeerSourceCache.h"
 #include <QtGui/QColor>
 #include <QtGui/QPainter>
 #include <QtGui/QTextBlock>
@@ -32,6 +33,7 @@
 SeerEditorWidgetSourceArea::SeerEditorWidgetSourceArea(QWidget* parent) : SeerPlainTextEdit(parent) {
 
     _fileWatcher                = 0;
+    _sourceResolver             = 0;
     _enableLineNumberArea       = false;
     _enableBreakPointArea       = false;
     _enableMiniMapArea          = false;
@@ -64,6 +66,7 @@ SeerEditorWidgetSourceArea::SeerEditorWidgetSourceArea(QWidget* parent) : SeerPl
     QObject::connect(this, &SeerEditorWidgetSourceArea::updateRequest,                      this, &SeerEditorWidgetSourceArea::updateBreakPointArea);
     QObject::connect(this, &SeerEditorWidgetSourceArea::updateRequest,                      this, &SeerEditorWidgetSourceArea::updateMiniMapArea);
     QObject::connect(this, &SeerEditorWidgetSourceArea::highlighterSettingsChanged,         this, &SeerEditorWidgetSourceArea::handleHighlighterSettingsChanged);
+    QObject::connect(verticalScrollBar(), &QScrollBar::valueChanged,                         this, &SeerEditorWidgetSourceArea::highlightVisibleBlocks);
 
     setCurrentLine(0);
 
@@ -631,11 +634,10 @@ void SeerEditorWidgetSourceArea::open (const QString& fullname, const QString& f
         return;
     }
 
-    QFile inputFile(filename);
-
-    inputFile.open(QIODevice::ReadOnly);
+    // Read the file. Mapped, decoded and tab expanded in one go. Or from the cache, if it hasn't changed.
+    QString text;
 
-    if (!inputFile.isOpen()) {
+    if (SeerSourceCache::readSource(filename, editorTabSize(), text) == false) {
 
         QMessageBox::critical(this, "Can't read source file.",  "Can't read : " + filename + "\nThe file is there but can't be opened.");
 
@@ -644,24 +646,6 @@ void SeerEditorWidgetSourceArea::open (const QString& fullname, const QString& f
         return;
     }
 
-    // Read the file.
-    QTextStream stream(&inputFile);
-
-    QString line = stream.readLine();
-    QString text;
-
-    while (!line.isNull()) {
-
-        // Expand tabs
-        line = Seer::expandTabs(line, editorTabSize(), false);
-
-        // Build up text for file.
-        text += line + "\n";
-
-        // Read next line, if available.
-        line = stream.readLine();
-    };
-
     // Put the contents in the editor.
     openText(text, _fullname);
 
@@ -674,6 +658,11 @@ void SeerEditorWidgetSourceArea::open (const QString& fullname, const QString& f
 
 void SeerEditorWidgetSourceArea::openText (const QString& text, const QString& file) {
 
+    // Remove the old syntax highlighter first. Otherwise it highlights all of the new text.
+    if (_sourceHighlighter) {
+        delete _sourceHighlighter; _sourceHighlighter = 0;
+    }
+
     // Put the contents in the editor.
     setPlainText(text);
 
@@ -683,25 +672,48 @@ void SeerEditorWidgetSourceArea::openText (const QString& text, const QString& f
     setTextCursor(cursor);
 
     // Add a syntax highlighter for C++ files.
-    if (_sourceHighlighter) {
-        delete _sourceHighlighter; _sourceHighlighter = 0;
-    }
-
     QRegularExpression cpp_re("(?:" + _sourceHighlighterSettings.sourceSuffixes() + ")$");
     if (file.contains(cpp_re)) {
         _sourceHighlighter = new SeerCppSourceHighlighter(0);
 
+        _sourceHighlighter->setHighlighterSettings(_sourceHighlighterSettings);
+
         if (highlighterEnabled()) {
             _sourceHighlighter->setDocument(document());
         }else{
             _sourceHighlighter->setDocument(0);
         }
 
-        _sourceHighlighter->setHighlighterSettings(_sourceHighlighterSettings);
-        _sourceHighlighter->rehighlight();
+        rehighlight();
     }
 }
 
+void SeerEditorWidgetSourceArea::rehighlight () {
+
+    if (_sourceHighlighter == 0) {
+        return;
+    }
+
+    // The blocks that can be seen are done now. The rest in the background.
+    int firstBlock = firstVisibleBlock().blockNumber();
+    int lastBlock  = firstBlock + viewport()->height() / qMax(1, fontMetrics().height()) + 1;
+
+    _sourceHighlighter->rehighlightVisibleFirst(firstBlock, lastBlock);
+}
+
+void SeerEditorWidgetSourceArea::highlightVisibleBlocks () {
+
+    if (_sourceHighlighter == 0 || _sourceHighlighter->hasPendingBlocks() == false) {
+        return;
+    }
+
+    // Scrolled to blocks the background highlighting hasn't got to yet.
+    int firstBlock = firstVisibleBlock().blockNumber();
+    int lastBlock  = cursorForPosition(QPoint(0, viewport()->height() - 1)).blockNumber();
+
+    _sourceHighlighter->highlightBlocks(firstBlock, lastBlock);
+}
+
 void SeerEditorWidgetSourceArea::reload () {
 
     // Open the same file again.
@@ -778,6 +790,16 @@ const QStringList& SeerEditorWidgetSourceArea::alternateDirectories () const {
     return _alternateDirectories;
 }
 
+void SeerEditorWidgetSourceArea::setSourceResolver (SeerSourceResolver* resolver) {
+
+    _sourceResolver = resolver;
+}
+
+SeerSourceResolver* SeerEditorWidgetSourceArea::sourceResolver () const {
+
+    return _sourceResolver;
+}
+
 QString SeerEditorWidgetSourceArea::findFile (const QString& file, const QString& fullname, const QString& alternateDirectory, const QStringList& alternateDirectories) {
 
     //
@@ -800,6 +822,11 @@ QString SeerEditorWidgetSourceArea::findFile (const QString& file, const QString
     // One note about 'fullname'. This is the path that gdb knows of. Gdb extracts the path
     // from the debug information in the executable when it was compiled and linked.
     //
+    // The shared resolver does the same search, but from its index and cache.
+    //
+    if (_sourceResolver) {
+        return _sourceResolver->findFile(file, fullname, alternateDirectory, alternateDirectories);
+    }
 
     // Use 'alternateDirectory', if provided.
     if (alternateDirectory != "") {
@@ -1707,7 +1734,7 @@ void SeerEditorWidgetSourceArea::handleText (const QString& text) {
 
         return;
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,value="))) {
+    }else if (Seer::matchRecord(text, "^done,value=")) {
 
         // 10^done,value="1"
         // 11^done,value="0x7fffffffd538"
@@ -1728,7 +1755,7 @@ void SeerEditorWidgetSourceArea::handleText (const QString& text) {
 
         return;
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
+    }else if (Seer::matchRecord(text, "^error,msg=")) {
 
         // 12^error,msg="No symbol \"return\" in current context."
         // 13^error,msg="No symbol \"cout\" in current context."
@@ -1779,7 +1806,8 @@ void SeerEditorWidgetSourceArea::handleHighlighterSettingsChanged () {
         }
 
         _sourceHighlighter->setHighlighterSettings(highlighterSettings());
-        _sourceHighlighter->rehighlight();
+
+        rehighlight();
     }
 
     // Note. The margins are automatically updated by their own paint events.
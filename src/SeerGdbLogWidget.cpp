@@ -5,6 +5,10 @@
 #include <QtCore/QDebug>
 
 SeerGdbLogWidget::SeerGdbLogWidget (QWidget* parent) : SeerLogWidget(parent) {
+
+    addRecordClass('~', "Console output");
+    addRecordClass('&', "Log output");
+    addRecordClass('@', "Target output");
 }
 
 SeerGdbLogWidget::~SeerGdbLogWidget () {
@@ -92,14 +96,20 @@ void SeerGdbLogWidget::processText (const QString& text) {
     str.replace("\\n", "");
 
     // Write the string to the log.
-    textEdit->append(str);
+    QChar recordClass = text.front();
+
+    if (recordClass != '~' && recordClass != '&' && recordClass != '@') {
+        recordClass = QChar();
+    }
+
+    logView->appendLine(str, recordClass);
 
     // If there is breakpoint message (via a manual command), ask
     // for the breakpoint list to be refreshed.
     //
     // Breakpoint 2 at 0x403a40: file explorer.cpp, line 78.
     //
-    if (str.contains(QRegularExpression("^Breakpoint ([0-9]+) at (0[xX][0-9a-fA-F]+): file (.*\\,) (line) ([0-9]+)"))) {
+    if (str.contains(Seer::regex("^Breakpoint ([0-9]+) at (0[xX][0-9a-fA-F]+): file (.*\\,) (line) ([0-9]+)"))) {
         emit refreshBreakpointsList();
     }
 }
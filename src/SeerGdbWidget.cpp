@@ -44,7 +44,10 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     _executablePid                      = 0;
 
     _gdbMonitor                         = 0;
+    _gdbCommandQueue                    = 0;
     _gdbProcess                         = 0;
+    _refreshScheduler                   = 0;
+    _sourceResolver                     = 0;
     _consoleWidget                      = 0;
     _breakpointsBrowserWidget           = 0;
     _watchpointsBrowserWidget           = 0;
@@ -131,6 +134,9 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     _gdbMonitor = new GdbMonitor(this);
     _gdbMonitor->setProcess(_gdbProcess);
 
+    // Create the queue the commands go out through.
+    _gdbCommandQueue = new GdbCommandQueue(_gdbMonitor, this);
+
     // Restore tab ordering.
     readLogsSettings();
 
@@ -152,6 +158,7 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::equalTextOutput,                                                               _seerOutputLog,                                                 &SeerSeerLogWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               _seerOutputLog,                                                 &SeerSeerLogWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::astrixTextOutput,                                                              _seerOutputLog,                                                 &SeerSeerLogWidget::handleText);
+    QObject::connect(_gdbMonitor,                                               &GdbMonitor::routedTextOutput,                                                              _seerOutputLog,                                                 &SeerSeerLogWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::astrixTextOutput,                                                              editorManagerWidget,                                            &SeerEditorManagerWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               editorManagerWidget,                                            &SeerEditorManagerWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               sourceLibraryManagerWidget->sourceBrowserWidget(),              &SeerSourceBrowserWidget::handleText);
@@ -172,8 +179,6 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               variableManagerWidget->variableTrackerBrowserWidget(),          &SeerVariableTrackerBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               variableManagerWidget->variableLoggerBrowserWidget(),           &SeerVariableLoggerBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::astrixTextOutput,                                                              _watchpointsBrowserWidget,                                      &SeerWatchpointsBrowserWidget::handleText);
-    QObject::connect(_gdbMonitor,                                               &GdbMonitor::astrixTextOutput,                                                              this,                                                           &SeerGdbWidget::handleText);
-    QObject::connect(_gdbMonitor,                                               &GdbMonitor::equalTextOutput,                                                               this,                                                           &SeerGdbWidget::handleText);
 
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               threadManagerWidget->threadFramesBrowserWidget(),               &SeerThreadFramesBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::equalTextOutput,                                                               threadManagerWidget->threadFramesBrowserWidget(),               &SeerThreadFramesBrowserWidget::handleText);
@@ -183,6 +188,11 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::equalTextOutput,                                                               threadManagerWidget->threadGroupsBrowserWidget(),               &SeerThreadGroupsBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               threadManagerWidget->adaTasksBrowserWidget(),                   &SeerAdaTasksBrowserWidget::handleText);
 
+    // Records routed to this widget by the monitor instead of being broadcast.
+    _gdbMonitor->addRecordClassHandler(GdbMiRecord::ExecAsyncRecord,   "stopped",              this, &SeerGdbWidget::handleStoppedRecord);
+    _gdbMonitor->addRecordClassHandler(GdbMiRecord::NotifyAsyncRecord, "breakpoint-created",   this, &SeerGdbWidget::handleBreakpointCreatedRecord);
+    _gdbMonitor->addRecordClassHandler(GdbMiRecord::NotifyAsyncRecord, "thread-group-started", this, &SeerGdbWidget::handleThreadGroupStartedRecord);
+
     QObject::connect(editorManagerWidget,                                       &SeerEditorManagerWidget::refreshBreakpointsList,                                           this,                                                           &SeerGdbWidget::handleGdbGenericpointList);
     QObject::connect(editorManagerWidget,                                       &SeerEditorManagerWidget::refreshStackFrames,                                               this,                                                           &SeerGdbWidget::handleGdbStackListFrames);
     QObject::connect(editorManagerWidget,                                       &SeerEditorManagerWidget::insertBreakpoint,                                                 this,                                                           &SeerGdbWidget::handleGdbBreakpointInsert);
@@ -248,6 +258,8 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(variableManagerWidget->variableLoggerBrowserWidget(),      &SeerVariableLoggerBrowserWidget::addStructVisualize,                                       this,                                                           &SeerGdbWidget::handleGdbVarAddExpression);
     QObject::connect(variableManagerWidget->registerValuesBrowserWidget(),      &SeerRegisterValuesBrowserWidget::refreshRegisterNames,                                     this,                                                           &SeerGdbWidget::handleGdbRegisterListNames);
     QObject::connect(variableManagerWidget->registerValuesBrowserWidget(),      &SeerRegisterValuesBrowserWidget::refreshRegisterValues,                                    this,                                                           &SeerGdbWidget::handleGdbRegisterListValues);
+    QObject::connect(variableManagerWidget->registerValuesBrowserWidget(),      &SeerRegisterValuesBrowserWidget::refreshChangedRegisters,                                  this,                                                           &SeerGdbWidget::handleGdbRegisterListChanged);
+    QObject::connect(variableManagerWidget->registerValuesBrowserWidget(),      &SeerRegisterValuesBrowserWidget::refreshSelectedRegisterValues,                            this,                                                           &SeerGdbWidget::handleGdbRegisterListSelectedValues);
     QObject::connect(variableManagerWidget->registerValuesBrowserWidget(),      &SeerRegisterValuesBrowserWidget::setRegisterValue,                                         this,                                                           &SeerGdbWidget::handleGdbRegisterSetValue);
 
     QObject::connect(threadManagerWidget->threadFramesBrowserWidget(),          &SeerThreadFramesBrowserWidget::refreshThreadIds,                                           this,                                                           &SeerGdbWidget::handleGdbThreadListIds);
@@ -319,19 +331,30 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(_printpointsBrowserWidget,                                 &SeerPrintpointsBrowserWidget::addBreakpointCondition,                                      this,                                                           &SeerGdbWidget::handleGdbBreakpointCondition);
     QObject::connect(_printpointsBrowserWidget,                                 &SeerPrintpointsBrowserWidget::addBreakpointIgnore,                                         this,                                                           &SeerGdbWidget::handleGdbBreakpointIgnore);
 
-    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       stackManagerWidget->stackFramesBrowserWidget(),                 &SeerStackFramesBrowserWidget::handleStoppingPointReached);
-    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       stackManagerWidget->stackLocalsBrowserWidget(),                 &SeerStackLocalsBrowserWidget::handleStoppingPointReached);
-    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       stackManagerWidget->stackArgumentsBrowserWidget(),              &SeerStackArgumentsBrowserWidget::handleStoppingPointReached);
-    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       threadManagerWidget->threadFramesBrowserWidget(),               &SeerThreadFramesBrowserWidget::handleStoppingPointReached);
-    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       threadManagerWidget->threadIdsBrowserWidget(),                  &SeerThreadIdsBrowserWidget::handleStoppingPointReached);
-    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       threadManagerWidget->adaTasksBrowserWidget(),                   &SeerAdaTasksBrowserWidget::handleStoppingPointReached);
-    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       variableManagerWidget->registerValuesBrowserWidget(),           &SeerRegisterValuesBrowserWidget::handleStoppingPointReached);
-    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       variableManagerWidget->variableTrackerBrowserWidget(),          &SeerVariableTrackerBrowserWidget::handleStoppingPointReached);
-    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       _breakpointsBrowserWidget,                                      &SeerBreakpointsBrowserWidget::handleStoppingPointReached);
-    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       _watchpointsBrowserWidget,                                      &SeerWatchpointsBrowserWidget::handleStoppingPointReached);
-    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       _catchpointsBrowserWidget,                                      &SeerCatchpointsBrowserWidget::handleStoppingPointReached);
-    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       _printpointsBrowserWidget,                                      &SeerPrintpointsBrowserWidget::handleStoppingPointReached);
-    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       stackManagerWidget,                                             &SeerStackManagerWidget::handleStoppingPointReached);
+    // Finds source files. Shared by the source editors, the assembly view, and the source browser.
+    _sourceResolver = new SeerSourceResolver(this);
+
+    editorManagerWidget->setSourceResolver(_sourceResolver);
+    sourceLibraryManagerWidget->sourceBrowserWidget()->setSourceResolver(_sourceResolver);
+
+    // Refresh the views on a stop. Visible ones first, in this order.
+    _refreshScheduler = new SeerRefreshScheduler(_gdbMonitor, this);
+    _refreshScheduler->addView(stackManagerWidget->stackFramesBrowserWidget(),          &SeerStackFramesBrowserWidget::handleStoppingPointReached);
+    _refreshScheduler->addView(stackManagerWidget->stackLocalsBrowserWidget(),          &SeerStackLocalsBrowserWidget::handleStoppingPointReached);
+    _refreshScheduler->addView(stackManagerWidget->stackArgumentsBrowserWidget(),       &SeerStackArgumentsBrowserWidget::handleStoppingPointReached);
+    _refreshScheduler->addView(stackManagerWidget,                                      &SeerStackManagerWidget::handleStoppingPointReached);
+    _refreshScheduler->addView(threadManagerWidget->threadFramesBrowserWidget(),        &SeerThreadFramesBrowserWidget::handleStoppingPointReached);
+    _refreshScheduler->addView(threadManagerWidget->threadIdsBrowserWidget(),           &SeerThreadIdsBrowserWidget::handleStoppingPointReached);
+    _refreshScheduler->addView(threadManagerWidget->adaTasksBrowserWidget(),            &SeerAdaTasksBrowserWidget::handleStoppingPointReached);
+    _refreshScheduler->addView(variableManagerWidget->registerValuesBrowserWidget(),    &SeerRegisterValuesBrowserWidget::handleStoppingPointReached);
+    _refreshScheduler->addView(variableManagerWidget->variableTrackerBrowserWidget(),   &SeerVariableTrackerBrowserWidget::handleStoppingPointReached);
+    _refreshScheduler->addView(_breakpointsBrowserWidget,                               &SeerBreakpointsBrowserWidget::handleStoppingPointReached);
+    _refreshScheduler->addView(_watchpointsBrowserWidget,                               &SeerWatchpointsBrowserWidget::handleStoppingPointReached);
+    _refreshScheduler->addView(_catchpointsBrowserWidget,                               &SeerCatchpointsBrowserWidget::handleStoppingPointReached);
+    _refreshScheduler->addView(_printpointsBrowserWidget,                               &SeerPrintpointsBrowserWidget::handleStoppingPointReached);
+
+    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       _refreshScheduler,                                              &SeerRefreshScheduler::handleStoppingPointReached);
+    QObject::connect(_refreshScheduler,                                         &SeerRefreshScheduler::logText,                                                             _seerOutputLog,                                                 &SeerSeerLogWidget::handleText);
     QObject::connect(this,                                                      &SeerGdbWidget::assemblyConfigChanged,                                                      editorManagerWidget,                                            &SeerEditorManagerWidget::handleAssemblyConfigChanged);
 
     QObject::connect(leftCenterRightSplitter,                                   &QSplitter::splitterMoved,                                                                  this,                                                           &SeerGdbWidget::handleSplitterMoved);
@@ -371,6 +394,10 @@ GdbMonitor* SeerGdbWidget::gdbMonitor () {
     return _gdbMonitor;
 }
 
+GdbCommandQueue* SeerGdbWidget::gdbCommandQueue () {
+    return _gdbCommandQueue;
+}
+
 QProcess* SeerGdbWidget::gdbProcess () {
     return _gdbProcess;
 }
@@ -628,6 +655,26 @@ bool SeerGdbWidget::gdbEnablePrettyPrinting () const {
     return _gdbEnablePrettyPrinting;
 }
 
+void SeerGdbWidget::setGdbCommandDepth (int depth) {
+
+    _gdbCommandQueue->setDepth(depth);
+}
+
+int SeerGdbWidget::gdbCommandDepth () const {
+
+    return _gdbCommandQueue->depth();
+}
+
+void SeerGdbWidget::setGdbCommandTimeout (int milliseconds) {
+
+    _gdbCommandQueue->setTimeout(milliseconds);
+}
+
+int SeerGdbWidget::gdbCommandTimeout () const {
+
+    return _gdbCommandQueue->timeout();
+}
+
 void SeerGdbWidget::setGdbRecordMode(const QString& mode) {
 
     _gdbRecordMode = mode;
@@ -804,31 +851,36 @@ void SeerGdbWidget::readLogsSettings () {
     }
 }
 
-void SeerGdbWidget::handleText (const QString& text) {
+bool SeerGdbWidget::handleStoppedRecord (const GdbMiRecord& record) {
 
-    if (text.startsWith("*running,thread-id=\"all\"")) {
+    Q_UNUSED(record);
 
     // Probably a better way to handle all these types of stops.
-    }else if (text.startsWith("*stopped")) {
+    emit stoppingPointReached();
 
-        emit stoppingPointReached();
+    return false; // Others still want to see the '*stopped'.
+}
 
-    }else if (text.startsWith("=breakpoint-created,")) {
+bool SeerGdbWidget::handleBreakpointCreatedRecord (const GdbMiRecord& record) {
 
-        handleGdbGenericpointList();
+    Q_UNUSED(record);
 
-    }else if (text.startsWith("=thread-group-started,")) {
-        // =thread-group-started,id="i1",pid="30916"
+    handleGdbGenericpointList();
 
-        QString pid_text = Seer::parseFirst(text, "pid=", '"', '"', false);
+    return true; // Only we care about this one.
+}
 
-        //qDebug() << "Inferior pid = " << pid_text;
+bool SeerGdbWidget::handleThreadGroupStartedRecord (const GdbMiRecord& record) {
 
-        setExecutablePid(pid_text.toLong());
+    // =thread-group-started,id="i1",pid="30916"
 
-    }else{
-        // All other text is ignored by this widget.
-    }
+    QString pid_text = record["pid"].toString();
+
+    //qDebug() << "Inferior pid = " << pid_text;
+
+    setExecutablePid(pid_text.toLong());
+
+    return false; // The main window reports it too.
 }
 
 void SeerGdbWidget::handleManualCommandExecute () {
@@ -894,11 +946,44 @@ void SeerGdbWidget::handleGdbCommand (const QString& command) {
         return;
     }
 
-    QString str = command + "\n";    // Ensure there's a trailing RETURN.
+    // An empty line gets no result record. Nothing to track.
+    if (command.trimmed() == "") {
+        _gdbProcess->write("\n");
+        return;
+    }
 
-    QByteArray bytes = str.toUtf8(); // 8-bit Unicode Transformation Format
+    // The queue puts a token on it and writes it to gdb's stdin.
+    _gdbCommandQueue->send(command);
+}
 
-    _gdbProcess->write(bytes);       // Send the data into the stdin stream of the bash child process
+void SeerGdbWidget::handleGdbCommand (const QString& command, QObject* receiver, GdbMiRecordHandler completion) {
+
+    qCDebug(LC) << "Command=" << command;
+
+    if (_gdbProcess->state() == QProcess::NotRunning) {
+        QMessageBox::warning(this, "Seer",
+                                   QString("The executable has not been started yet or has already exited.\n\n") +
+                                   "(" + command + ")",
+                                   QMessageBox::Ok);
+        return;
+    }
+
+    _gdbCommandQueue->send(command, receiver, completion);
+}
+
+void SeerGdbWidget::handleGdbCommands (const QStringList& commands, QObject* receiver, GdbMiBatchHandler completion) {
+
+    qCDebug(LC) << "Commands=" << commands;
+
+    if (_gdbProcess->state() == QProcess::NotRunning) {
+        QMessageBox::warning(this, "Seer",
+                                   QString("The executable has not been started yet or has already exited.\n\n") +
+                                   "(" + commands.join("\n") + ")",
+                                   QMessageBox::Ok);
+        return;
+    }
+
+    _gdbCommandQueue->sendBatch(commands, receiver, completion);
 }
 
 void SeerGdbWidget::handleGdbExit () {
@@ -2184,7 +2269,7 @@ void SeerGdbWidget::handleGdbThreadListIds () {
         return;
     }
 
-    handleGdbCommand("-thread-list-ids");
+    handleGdbCommand("-thread-list-ids", threadManagerWidget->threadIdsBrowserWidget(), &SeerThreadIdsBrowserWidget::handleRecord);
 }
 
 void SeerGdbWidget::handleGdbThreadListGroups () {
@@ -2251,6 +2336,28 @@ void SeerGdbWidget::handleGdbRegisterListValues (QString fmt) {
     handleGdbCommand("-data-list-register-values " + fmt);
 }
 
+void SeerGdbWidget::handleGdbRegisterListChanged () {
+
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    handleGdbCommand("-data-list-changed-registers", variableManagerWidget->registerValuesBrowserWidget(), &SeerRegisterValuesBrowserWidget::handleChangedRegistersRecord);
+}
+
+void SeerGdbWidget::handleGdbRegisterListSelectedValues (QString fmt, QString numbers) {
+
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    if (fmt == "") {
+        fmt = "N";
+    }
+
+    handleGdbCommand("-data-list-register-values " + fmt + " " + numbers, variableManagerWidget->registerValuesBrowserWidget(), &SeerRegisterValuesBrowserWidget::handleRegisterValuesRecord);
+}
+
 void SeerGdbWidget::handleGdbRegisterSetValue (QString fmt, QString name, QString value) {
 
     if (executableLaunchMode() == "") {
@@ -2285,6 +2392,18 @@ void SeerGdbWidget::handleGdbVarObjCreate (int expressionid, QString expression)
     handleGdbCommand(str);
 }
 
+void SeerGdbWidget::handleGdbVarObjCreateFloating (int expressionid, QString expression) {
+
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    // Floating. gdb evaluates it again in the current frame on each -var-update.
+    QString str = QString("%1-var-create seer%1 \"@\" \"%2\"").arg(expressionid).arg(expression);
+
+    handleGdbCommand(str);
+}
+
 void SeerGdbWidget::handleGdbVarObjListChildren (int expressionid, QString objname) {
 
     if (executableLaunchMode() == "") {
@@ -2302,7 +2421,7 @@ void SeerGdbWidget::handleGdbVarObjUpdate (int expressionid, QString objname) {
         return;
     }
 
-    QString str = QString("%1-var-update --all-values \"%2\"").arg(expressionid).arg(objname);
+    QString str = QString("%1-var-update --simple-values \"%2\"").arg(expressionid).arg(objname);
 
     handleGdbCommand(str);
 }
@@ -2346,9 +2465,18 @@ void SeerGdbWidget::handleGdbDataListValues () {
         return;
     }
 
+    if (_dataExpressionId.size() == 0) {
+        return;
+    }
+
+    // Evaluate them all in one go. The tracker gets the values in one batch.
+    QStringList commands;
+
     for (int i=0; i<_dataExpressionId.size(); i++) {
-        handleGdbCommand(QString::number(_dataExpressionId[i]) + "-data-evaluate-expression \"" + _dataExpressionName[i] + "\"");
+        commands << QString::number(_dataExpressionId[i]) + "-data-evaluate-expression \"" + _dataExpressionName[i] + "\"";
     }
+
+    handleGdbCommands(commands, variableManagerWidget->variableTrackerBrowserWidget(), &SeerVariableTrackerBrowserWidget::handleRecords);
 }
 
 void SeerGdbWidget::handleGdbDataListExpressions () {
@@ -2524,6 +2652,10 @@ void SeerGdbWidget::handleGdbStructAddExpression (QString expression) {
     QObject::connect(w,            &SeerStructVisualizerWidget::addMemoryVisualize,          this, &SeerGdbWidget::handleGdbMemoryAddExpression);
     QObject::connect(w,            &SeerStructVisualizerWidget::addArrayVisualize,           this, &SeerGdbWidget::handleGdbArrayAddExpression);
     QObject::connect(w,            &SeerStructVisualizerWidget::addStructVisualize,          this, &SeerGdbWidget::handleGdbStructAddExpression);
+    QObject::connect(w,            &SeerStructVisualizerWidget::varObjCreate,                this, &SeerGdbWidget::handleGdbVarObjCreateFloating);
+    QObject::connect(w,            &SeerStructVisualizerWidget::varObjListChildren,          this, &SeerGdbWidget::handleGdbVarObjListChildren);
+    QObject::connect(w,            &SeerStructVisualizerWidget::varObjUpdate,                this, &SeerGdbWidget::handleGdbVarObjUpdate);
+    QObject::connect(w,            &SeerStructVisualizerWidget::varObjDelete,                this, &SeerGdbWidget::handleGdbVarObjDelete);
 
     // Tell the visualizer what variable to use.
     w->setVariableName(expression);
@@ -2574,13 +2706,16 @@ void SeerGdbWidget::handleGdbImageAddExpression (QString expression) {
     w->setVariableName(expression);
 }
 
-void SeerGdbWidget::handleGdbMemoryEvaluateExpression (int expressionid, QString address, int count) {
+void SeerGdbWidget::handleGdbMemoryEvaluateExpression (SeerMemoryReader* reader, int expressionid, QString address, int count) {
 
     if (executableLaunchMode() == "") {
         return;
     }
 
-    handleGdbCommand(QString::number(expressionid) + "-data-read-memory-bytes " + address + " " + QString::number(count));
+    // The reply goes straight to the reader, as a parsed record.
+    handleGdbCommand(QString::number(expressionid) + "-data-read-memory-bytes " + address + " " + QString::number(count), reader, [reader, expressionid](const GdbMiRecord& record) {
+        return reader->handleRecord(expressionid, record);
+    });
 }
 
 void SeerGdbWidget::handleGdbAsmEvaluateExpression (int expressionid, QString address, int count, int mode) {
@@ -2594,13 +2729,16 @@ void SeerGdbWidget::handleGdbAsmEvaluateExpression (int expressionid, QString ad
     handleGdbCommand(QString("%1-data-disassemble -s \"%2 - %3\" -e \"%4 + %5\" -- %6").arg(expressionid).arg(address).arg(0).arg(address).arg(count).arg(mode));
 }
 
-void SeerGdbWidget::handleGdbArrayEvaluateExpression (int expressionid, QString address, int count) {
+void SeerGdbWidget::handleGdbArrayEvaluateExpression (SeerMemoryReader* reader, int expressionid, QString address, int count) {
 
     if (executableLaunchMode() == "") {
         return;
     }
 
-    handleGdbCommand(QString::number(expressionid) + "-data-read-memory-bytes " + address + " " + QString::number(count));
+    // The reply goes straight to the reader, as a parsed record.
+    handleGdbCommand(QString::number(expressionid) + "-data-read-memory-bytes " + address + " " + QString::number(count), reader, [reader, expressionid](const GdbMiRecord& record) {
+        return reader->handleRecord(expressionid, record);
+    });
 }
 
 void SeerGdbWidget::handleGdbGetAssembly (QString address) {
@@ -2797,6 +2935,15 @@ void SeerGdbWidget::handleGdbProcessFinished (int exitCode, QProcess::ExitStatus
 
     //qDebug() << "Gdb process finished. Exit code =" << exitCode << "Exit status =" << exitStatus;
 
+    // Nothing more is coming back for the commands still in flight.
+    for (const auto& line : _gdbCommandQueue->latencyStats()) {
+        qCInfo(LC) << "Command latency:" << qPrintable(line);
+    }
+
+    _gdbCommandQueue->clear();
+    _gdbCommandQueue->resetLatencyStats();
+    _gdbMonitor->clearPendingCommands();
+
     // Warn if gdb exits only if we are in some kind of run mode.
     if (executableLaunchMode() != "") {
 
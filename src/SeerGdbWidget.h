@@ -10,12 +10,17 @@
 #include "SeerCatchpointsBrowserWidget.h"
 #include "SeerPrintpointsBrowserWidget.h"
 #include "GdbMonitor.h"
+#include "GdbCommandQueue.h"
+#include "SeerRefreshScheduler.h"
+#include "SeerSourceResolver.h"
 #include <QtCore/QProcess>
 #include <QtCore/QVector>
 #include <QtWidgets/QWidget>
 
 #include "ui_SeerGdbWidget.h"
 
+class SeerMemoryReader;
+
 class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
 
     Q_OBJECT
@@ -25,6 +30,7 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
        ~SeerGdbWidget ();
 
         GdbMonitor*                         gdbMonitor                          ();
+        GdbCommandQueue*                    gdbCommandQueue                     ();
         QProcess*                           gdbProcess                          ();
 
         void                                setExecutableName                   (const QString& executableName);
@@ -101,6 +107,12 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
         void                                setGdbEnablePrettyPrinting          (bool flag);
         bool                                gdbEnablePrettyPrinting             () const;
 
+        void                                setGdbCommandDepth                  (int depth);
+        int                                 gdbCommandDepth                     () const;
+
+        void                                setGdbCommandTimeout                (int milliseconds);
+        int                                 gdbCommandTimeout                   () const;
+
         void                                setGdbRecordMode                    (const QString& mode);
         QString                             gdbRecordMode                       () const;
 
@@ -208,12 +220,27 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
         // Printpoints
         void                                resetDprintf                        ();
 
+        // Send 'command' and hand its result record to 'completion'. See GdbCommandQueue.
+        void                                handleGdbCommand                    (const QString& command, QObject* receiver, GdbMiRecordHandler completion);
+
+        template <typename T>
+        void                                handleGdbCommand                    (const QString& command, T* receiver, bool (T::*method)(const GdbMiRecord&)) {
+            handleGdbCommand(command, receiver, [receiver, method](const GdbMiRecord& record) { return (receiver->*method)(record); });
+        }
+
+        // Send 'commands' as one batch. 'completion' gets all of the result records at once.
+        void                                handleGdbCommands                   (const QStringList& commands, QObject* receiver, GdbMiBatchHandler completion);
+
+        template <typename T>
+        void                                handleGdbCommands                   (const QStringList& commands, T* receiver, void (T::*method)(const QVector<GdbMiRecord>&)) {
+            handleGdbCommands(commands, receiver, [receiver, method](const QVector<GdbMiRecord>& records) { (receiver->*method)(records); });
+        }
+
     public slots:
         void                                handleLogsTabMoved                  (int from, int to);
         void                                handleLogsTabChanged                (int index);
         void                                handleRaiseMessageTab               ();
 
-        void                                handleText                          (const QString& text);
         void                                handleManualCommandExecute          ();
         void                                handleGdbCommand                    (const QString& command);
         void                                handleGdbExit                       ();
@@ -302,9 +329,12 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
         void                                handleGdbAdaListExceptions          ();
         void                                handleGdbRegisterListNames          ();
         void                                handleGdbRegisterListValues         (QString fmt);
+        void                                handleGdbRegisterListChanged        ();
+        void                                handleGdbRegisterListSelectedValues (QString fmt, QString numbers);
         void                                handleGdbRegisterSetValue           (QString fmt, QString name, QString value);
         void                                handleGdbDataEvaluateExpression     (int expressionid, QString expression);
         void                                handleGdbVarObjCreate               (int expressionid, QString expression);
+        void                                handleGdbVarObjCreateFloating       (int expressionid, QString expression);
         void                                handleGdbVarObjListChildren         (int expressionid, QString objname);
         void                                handleGdbVarObjUpdate               (int expressionid, QString objname);
         void                                handleGdbVarObjAssign               (int expressionid, QString objname, QString value);
@@ -319,9 +349,9 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
         void                                handleGdbStructAddExpression        (QString expression);
         void                                handleGdbVarAddExpression           (QString expression);
         void                                handleGdbImageAddExpression         (QString expression);
-        void                                handleGdbMemoryEvaluateExpression   (int expressionid, QString address, int count);
+        void                                handleGdbMemoryEvaluateExpression   (SeerMemoryReader* reader, int expressionid, QString address, int count);
         void                                handleGdbAsmEvaluateExpression      (int expressionid, QString address, int count, int mode);
-        void                                handleGdbArrayEvaluateExpression    (int expressionid, QString address, int count);
+        void                                handleGdbArrayEvaluateExpression    (SeerMemoryReader* reader, int expressionid, QString address, int count);
         void                                handleGdbGetAssembly                (QString address);
         void                                handleGdbGetSourceAndAssembly       (QString address);
         void                                handleGdbMemoryVisualizer           ();
@@ -353,6 +383,9 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
     protected:
         void                                writeLogsSettings                   ();
         void                                readLogsSettings                    ();
+        bool                                handleStoppedRecord                 (const GdbMiRecord& record);
+        bool                                handleBreakpointCreatedRecord       (const GdbMiRecord& record);
+        bool                                handleThreadGroupStartedRecord      (const GdbMiRecord& record);
 
     private:
         bool                                isGdbRuning                         () const;
@@ -421,8 +454,12 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
         SeerSeerLogWidget*                  _seerOutputLog;
 
         GdbMonitor*                         _gdbMonitor;
+        GdbCommandQueue*                    _gdbCommandQueue;
         QProcess*                           _gdbProcess;
 
+        SeerRefreshScheduler*               _refreshScheduler;
+        SeerSourceResolver*                 _sourceResolver;
+
         QVector<int>                        _dataExpressionId;
         QVector<QString>                    _dataExpressionName;
 };
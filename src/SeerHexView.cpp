@@ -0,0 +1,556 @@
+#include "SeerHexView.h"
+#include "SeerHexWidget.h"
+#include "SeerUtl.h"
+#include <QtWidgets/QScrollBar>
+#include <QtWidgets/QApplication>
+#include <QtGui/QPainter>
+#include <QtGui/QPaintEvent>
+#include <QtGui/QMouseEvent>
+#include <QtGui/QKeyEvent>
+#include <QtGui/QClipboard>
+#include <QtGui/QFontMetrics>
+#include <QtCore/QStringConverter>
+#include <QtCore/QDebug>
+
+SeerHexView::SeerHexView (QWidget* parent) : QAbstractScrollArea(parent) {
+
+    _hexWidget   = 0;
+    _currentByte = -1;
+    _anchorByte  = -1;
+    _hasChanged  = false;
+
+    setFocusPolicy(Qt::StrongFocus);
+
+    // Measure the font.
+    changeEvent(0);
+}
+
+SeerHexView::~SeerHexView () {
+}
+
+void SeerHexView::setHexWidget (SeerHexWidget* hexWidget) {
+
+    _hexWidget = hexWidget;
+
+    dataChanged();
+}
+
+int SeerHexView::rowCount () const {
+
+    if (_hexWidget == 0 || _hexWidget->data() == 0 || _hexWidget->bytesPerLine() < 1) {
+        return 0;
+    }
+
+    return (_hexWidget->data()->size() + _hexWidget->bytesPerLine() - 1) / _hexWidget->bytesPerLine();
+}
+
+QString SeerHexView::rowText (int row) const {
+
+    if (row < 0 || row >= rowCount()) {
+        return QString();
+    }
+
+    SeerHexWidget::DataStorage* data = _hexWidget->data();
+
+    int position = row * _hexWidget->bytesPerLine();
+    int length   = qMin(_hexWidget->bytesPerLine(), data->size() - position);
+
+    return formatRow(row, data->getData(position, length), 0, data->hasData(position, length));
+}
+
+int SeerHexView::currentByte () const {
+
+    return _currentByte;
+}
+
+void SeerHexView::setCurrentByte (int byte, bool extendSelection) {
+
+    if (_hexWidget == 0 || _hexWidget->data() == 0) {
+        byte = -1;
+    }else if (byte >= _hexWidget->data()->size()) {
+        byte = _hexWidget->data()->size() - 1;
+    }
+
+    if (byte < 0) {
+        byte = -1;
+    }
+
+    if (extendSelection == false || _anchorByte < 0) {
+        _anchorByte = byte;
+    }
+
+    if (byte != _currentByte) {
+        _currentByte = byte;
+
+        emit currentByteChanged(byte);
+    }
+
+    viewport()->update();
+}
+
+void SeerHexView::ensureByteVisible (int byte) {
+
+    if (byte < 0 || _hexWidget == 0) {
+        return;
+    }
+
+    int row         = byte / _hexWidget->bytesPerLine();
+    int firstRow    = verticalScrollBar()->value();
+    int visibleRows = qMax(1, viewport()->height() / _lineHeight);
+
+    if (row < firstRow) {
+        verticalScrollBar()->setValue(row);
+    }else if (row >= firstRow + visibleRows) {
+        verticalScrollBar()->setValue(row - visibleRows + 1);
+    }
+}
+
+void SeerHexView::dataChanged () {
+
+    // The data, or the way it's shown, has changed.
+    if (_currentByte >= 0 && (_hexWidget == 0 || _hexWidget->data() == 0 || _currentByte >= _hexWidget->data()->size())) {
+        _currentByte = -1;
+        _anchorByte  = -1;
+    }
+
+    updateScrollBars();
+
+    viewport()->update();
+}
+
+void SeerHexView::markChanged (int position, int length) {
+
+    // Some bytes were updated in place. Highlight them and repaint just their rows.
+    if (_hexWidget == 0 || _hexWidget->data() == 0 || length <= 0) {
+        return;
+    }
+
+    int size = _hexWidget->data()->size();
+
+    if (position < 0 || position >= size) {
+        return;
+    }
+
+    length = qMin(length, size - position);
+
+    if (_changed.size() != size) {
+        _changed.resize(size);
+    }
+
+    _changed.fill(true, position, position + length);
+    _hasChanged = true;
+
+    int bytesPerLine = _hexWidget->bytesPerLine();
+    int firstRow     = verticalScrollBar()->value();
+    int lastRow      = firstRow + viewport()->height() / _lineHeight;
+    int row0         = qMax(firstRow, position / bytesPerLine);
+    int row1         = qMin(lastRow,  (position + length - 1) / bytesPerLine);
+
+    if (row0 <= row1) {
+        viewport()->update(0, (row0 - firstRow) * _lineHeight, viewport()->width(), (row1 - row0 + 1) * _lineHeight);
+    }
+}
+
+void SeerHexView::clearChanged () {
+
+    if (_hasChanged == false) {
+        return;
+    }
+
+    _changed.fill(false);
+    _hasChanged = false;
+
+    viewport()->update();
+}
+
+void SeerHexView::copy () {
+
+    if (_currentByte < 0 || _hexWidget == 0) {
+        return;
+    }
+
+    // Copy the rows the selection touches.
+    int firstRow = qMin(_anchorByte, _currentByte) / _hexWidget->bytesPerLine();
+    int lastRow  = qMax(_anchorByte, _currentByte) / _hexWidget->bytesPerLine();
+
+    QString text;
+
+    for (int row=firstRow; row<=lastRow; row++) {
+        text += rowText(row);
+        text += '\n';
+    }
+
+    QClipboard* clipboard = QGuiApplication::clipboard();
+
+    clipboard->setText(text, QClipboard::Clipboard);
+    clipboard->setText(text, QClipboard::Selection);
+}
+
+void SeerHexView::paintEvent (QPaintEvent* event) {
+
+    Q_UNUSED(event);
+
+    QPainter painter(viewport());
+
+    painter.fillRect(viewport()->rect(), palette().base());
+
+    int rows = rowCount();
+
+    if (rows == 0) {
+        return;
+    }
+
+    SeerHexWidget::DataStorage* data = _hexWidget->data();
+
+    int bytesPerLine    = _hexWidget->bytesPerLine();
+    int hexCharsPerByte = _hexWidget->hexCharsPerByte();
+    int firstRow        = verticalScrollBar()->value();
+    int lastRow         = qMin(rows - 1, firstRow + viewport()->height() / _lineHeight);
+    int x               = -horizontalScrollBar()->value();
+
+    // Get just the bytes that are seen. Let paged storage know what we're looking at.
+    int position = firstRow * bytesPerLine;
+    int length   = qMin((lastRow + 1) * bytesPerLine, data->size()) - position;
+
+    data->fetchData(position, length);
+
+    QByteArray bytes = data->getData(position, length);
+
+    // The selection.
+    int selectStart = qMin(_anchorByte, _currentByte);
+    int selectEnd   = qMax(_anchorByte, _currentByte);
+
+    bool highlightText = (_hexWidget->charMode() == SeerHexWidget::AsciiCharMode || _hexWidget->charMode() == SeerHexWidget::EbcdicCharMode);
+
+    QColor highlight = palette().highlight().color();
+    QColor changed   = QColor(255, 225, 140);
+
+    bool   showChanged = _hasChanged && _changed.size() == data->size();
+
+    painter.setPen(palette().text().color());
+
+    for (int row=firstRow; row<=lastRow; row++) {
+
+        int y        = (row - firstRow) * _lineHeight;
+        int rowStart = row * bytesPerLine;
+        int rowBytes = qMin(bytesPerLine, data->size() - rowStart);
+
+        // Address background.
+        painter.fillRect(x, y, SeerHexWidget::HexFieldWidth * _charWidth, _lineHeight, Qt::lightGray);
+
+        // Bytes that changed in the last refresh.
+        if (showChanged) {
+
+            for (int b=0; b<rowBytes; b++) {
+
+                if (_changed.testBit(rowStart + b) == false) {
+                    continue;
+                }
+
+                painter.fillRect(x + (hexColumn() + b * hexCharsPerByte) * _charWidth, y, (hexCharsPerByte - 1) * _charWidth, _lineHeight, changed);
+
+                if (highlightText) {
+                    painter.fillRect(x + (textColumn() + b) * _charWidth, y, _charWidth, _lineHeight, changed);
+                }
+            }
+        }
+
+        // Selected bytes.
+        if (_currentByte >= 0 && selectStart < rowStart + rowBytes && selectEnd >= rowStart) {
+
+            int b0 = qMax(selectStart, rowStart) - rowStart;
+            int b1 = qMin(selectEnd, rowStart + rowBytes - 1) - rowStart;
+
+            for (int b=b0; b<=b1; b++) {
+
+                painter.fillRect(x + (hexColumn() + b * hexCharsPerByte) * _charWidth, y, (hexCharsPerByte - 1) * _charWidth, _lineHeight, highlight);
+
+                if (highlightText) {
+                    painter.fillRect(x + (textColumn() + b) * _charWidth, y, _charWidth, _lineHeight, highlight);
+                }
+            }
+        }
+
+        QString text = formatRow(row, bytes, rowStart - position, data->hasData(rowStart, rowBytes));
+
+        painter.drawText(x, y + _ascent, text);
+    }
+}
+
+void SeerHexView::resizeEvent (QResizeEvent* event) {
+
+    QAbstractScrollArea::resizeEvent(event);
+
+    updateScrollBars();
+}
+
+void SeerHexView::mousePressEvent (QMouseEvent* event) {
+
+    if (event->button() != Qt::LeftButton) {
+        QAbstractScrollArea::mousePressEvent(event);
+        return;
+    }
+
+    setCurrentByte(byteAt(event->pos()), event->modifiers().testFlag(Qt::ShiftModifier));
+}
+
+void SeerHexView::mouseMoveEvent (QMouseEvent* event) {
+
+    if (event->buttons().testFlag(Qt::LeftButton) == false) {
+        QAbstractScrollArea::mouseMoveEvent(event);
+        return;
+    }
+
+    int byte = byteAt(event->pos());
+
+    if (byte >= 0) {
+        setCurrentByte(byte, true);
+        ensureByteVisible(byte);
+    }
+}
+
+void SeerHexView::keyPressEvent (QKeyEvent* event) {
+
+    if (event->matches(QKeySequence::Copy)) {
+        copy();
+        return;
+    }
+
+    if (_hexWidget == 0 || _hexWidget->data() == 0) {
+        QAbstractScrollArea::keyPressEvent(event);
+        return;
+    }
+
+    // Nothing to move over.
+    if (_hexWidget->data()->size() == 0) {
+        QAbstractScrollArea::keyPressEvent(event);
+        return;
+    }
+
+    int  bytesPerLine = _hexWidget->bytesPerLine();
+    int  pageBytes    = qMax(1, viewport()->height() / _lineHeight) * bytesPerLine;
+    int  byte         = qMax(0, _currentByte);
+    bool extend       = event->modifiers().testFlag(Qt::ShiftModifier);
+
+    switch (event->key()) {
+        case Qt::Key_Left:      byte -= 1;                          break;
+        case Qt::Key_Right:     byte += 1;                          break;
+        case Qt::Key_Up:        byte -= bytesPerLine;               break;
+        case Qt::Key_Down:      byte += bytesPerLine;               break;
+        case Qt::Key_PageUp:    byte -= pageBytes;                  break;
+        case Qt::Key_PageDown:  byte += pageBytes;                  break;
+        case Qt::Key_Home:      byte  = 0;                          break;
+        case Qt::Key_End:       byte  = _hexWidget->data()->size(); break;
+        default:
+            QAbstractScrollArea::keyPressEvent(event);
+            return;
+    }
+
+    byte = qBound(0, byte, _hexWidget->data()->size() - 1);
+
+    setCurrentByte(byte, extend);
+    ensureByteVisible(byte);
+}
+
+void SeerHexView::changeEvent (QEvent* event) {
+
+    if (event) {
+        QAbstractScrollArea::changeEvent(event);
+
+        if (event->type() != QEvent::FontChange) {
+            return;
+        }
+    }
+
+    QFontMetrics metrics(font());
+
+    _charWidth  = metrics.horizontalAdvance(QLatin1Char('9'));
+    _lineHeight = metrics.height();
+    _ascent     = metrics.ascent();
+
+    viewport()->setFont(font());
+
+    updateScrollBars();
+}
+
+void SeerHexView::updateScrollBars () {
+
+    int visibleRows = qMax(1, viewport()->height() / _lineHeight);
+    int rows        = rowCount();
+
+    verticalScrollBar()->setRange(0, qMax(0, rows - visibleRows));
+    verticalScrollBar()->setPageStep(visibleRows);
+    verticalScrollBar()->setSingleStep(1);
+
+    int width = _hexWidget ? rowLength() * _charWidth : 0;
+
+    horizontalScrollBar()->setRange(0, qMax(0, width - viewport()->width()));
+    horizontalScrollBar()->setPageStep(viewport()->width());
+    horizontalScrollBar()->setSingleStep(_charWidth);
+}
+
+int SeerHexView::byteAt (const QPoint& pos) const {
+
+    if (rowCount() == 0) {
+        return -1;
+    }
+
+    int bytesPerLine    = _hexWidget->bytesPerLine();
+    int hexCharsPerByte = _hexWidget->hexCharsPerByte();
+    int row             = verticalScrollBar()->value() + pos.y() / _lineHeight;
+    int column          = (pos.x() + horizontalScrollBar()->value()) / _charWidth;
+    int b               = -1;
+
+    if (column >= hexColumn() && column < hexColumn() + bytesPerLine * hexCharsPerByte) {
+        b = (column - hexColumn()) / hexCharsPerByte;
+    }else if (column >= textColumn() && column < textColumn() + bytesPerLine) {
+        b = column - textColumn();
+    }
+
+    if (b < 0 || row >= rowCount()) {
+        return -1;
+    }
+
+    int byte = row * bytesPerLine + b;
+
+    if (byte >= _hexWidget->data()->size()) {
+        return -1;
+    }
+
+    return byte;
+}
+
+int SeerHexView::hexColumn () const {
+
+    return SeerHexWidget::HexFieldWidth + 1; // Address and a space.
+}
+
+int SeerHexView::textColumn () const {
+
+    return hexColumn() + _hexWidget->bytesPerLine() * _hexWidget->hexCharsPerByte() + 2; // '| '
+}
+
+int SeerHexView::rowLength () const {
+
+    return textColumn() + _hexWidget->bytesPerLine();
+}
+
+QString SeerHexView::formatRow (int row, const QByteArray& bytes, int offset, bool available) const {
+
+    static const char digits[] = "0123456789abcdef";
+
+    int bytesPerLine    = _hexWidget->bytesPerLine();
+    int hexCharsPerByte = _hexWidget->hexCharsPerByte();
+    int rowBytes        = qMin(bytesPerLine, bytes.size() - offset);
+
+    SeerHexWidget::MemoryMode memoryMode = _hexWidget->memoryMode();
+    SeerHexWidget::CharMode   charMode   = _hexWidget->charMode();
+
+    const unsigned char* in = (const unsigned char*)bytes.constData() + offset;
+
+    // Lay the row out in a buffer of the right size. Anything not written is a space.
+    QString text(textColumn(), QChar(' '));
+    QChar*  out = text.data();
+
+    // Address.
+    quint64 address = (quint64)row * bytesPerLine + _hexWidget->addressOffset();
+
+    out[0] = '0';
+    out[1] = 'x';
+
+    for (int i=SeerHexWidget::HexFieldWidth-1; i>=2; i--) {
+        out[i]    = QLatin1Char(digits[address & 0xf]);
+        address >>= 4;
+    }
+
+    // Values.
+    for (int b=0; b<rowBytes; b++) {
+
+        QChar*        cell = out + hexColumn() + b * hexCharsPerByte;
+        unsigned char ch   = in[b];
+
+        if (available == false) {
+            for (int i=0; i<hexCharsPerByte-1; i++) {
+                cell[i] = '?';
+            }
+            continue;
+        }
+
+        if (memoryMode == SeerHexWidget::OctalMemoryMode) {
+            cell[0] = QLatin1Char(digits[(ch >> 6) & 0x7]);
+            cell[1] = QLatin1Char(digits[(ch >> 3) & 0x7]);
+            cell[2] = QLatin1Char(digits[ch & 0x7]);
+
+        }else if (memoryMode == SeerHexWidget::BinaryMemoryMode) {
+            for (int i=0; i<8; i++) {
+                cell[i] = QLatin1Char(digits[(ch >> (7-i)) & 0x1]);
+            }
+
+        }else if (memoryMode == SeerHexWidget::DecimalMemoryMode) {
+            cell[2] = QLatin1Char(digits[ch % 10]);
+            if (ch >= 10) {
+                cell[1] = QLatin1Char(digits[(ch / 10) % 10]);
+            }
+            if (ch >= 100) {
+                cell[0] = QLatin1Char(digits[ch / 100]);
+            }
+
+        }else{
+            cell[0] = QLatin1Char(digits[ch >> 4]);
+            cell[1] = QLatin1Char(digits[ch & 0xf]);
+        }
+    }
+
+    // Vertical line.
+    out[textColumn()-2] = '|';
+
+    if (available == false) {
+        return text;
+    }
+
+    // Text.
+    if (charMode == SeerHexWidget::AsciiCharMode || charMode == SeerHexWidget::EbcdicCharMode) {
+
+        QString chars(rowBytes, QChar(' '));
+        QChar*  c = chars.data();
+
+        for (int b=0; b<rowBytes; b++) {
+            if (charMode == SeerHexWidget::AsciiCharMode) {
+                c[b] = QChar(Seer::ucharToAscii(in[b]));
+            }else{
+                c[b] = QChar(Seer::ebcdicToAscii(in[b]));
+            }
+        }
+
+        text += chars;
+
+    }else if (charMode == SeerHexWidget::Utf8Mode || charMode == SeerHexWidget::Utf16Mode || charMode == SeerHexWidget::Utf32Mode) {
+
+        QStringConverter::Encoding encoding = QStringConverter::Utf8;
+
+        if (charMode == SeerHexWidget::Utf16Mode) {
+            encoding = QStringConverter::Utf16;
+        }else if (charMode == SeerHexWidget::Utf32Mode) {
+            encoding = QStringConverter::Utf32;
+        }
+
+        auto toUtf16 = QStringDecoder(encoding, QStringConverter::Flag::ConvertInvalidToNull);
+
+        QString chars = toUtf16.decode(QByteArray::fromRawData((const char*)in, rowBytes));
+
+        // Filter out ascii control characters.
+        for (int b=0; b<chars.length(); b++) {
+            if (chars[b] == QChar(127) || chars[b] < QChar(32)) {
+                chars[b] = QChar::ReplacementCharacter;
+            }
+        }
+
+        text += chars.left(bytesPerLine);
+
+    }else{
+        // No 'text' string.
+    }
+
+    return text;
+}
+
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QtWidgets/QAbstractScrollArea>
+#include <QtCore/QString>
+#include <QtCore/QBitArray>
+
+class SeerHexWidget;
+
+//
+// Custom painted view of a SeerHexWidget's data.
+//
+// Only the rows that can be seen are formatted and drawn, so the size of
+// the data doesn't matter. Rows look like the old text version:
+//
+//     0x00007fffffffd530 2f 68 6f 6d 65 2f 75 73 65 72 2f 73 65 65 72 00 | /home/user/seer.
+//
+
+class SeerHexView : public QAbstractScrollArea {
+
+    Q_OBJECT
+
+    public:
+        explicit SeerHexView (QWidget* parent = 0);
+       ~SeerHexView ();
+
+        void                        setHexWidget                        (SeerHexWidget* hexWidget);
+
+        int                         rowCount                            () const;
+        QString                     rowText                             (int row) const;
+
+        int                         currentByte                         () const;
+        void                        setCurrentByte                      (int byte, bool extendSelection = false);
+        void                        ensureByteVisible                   (int byte);
+
+    signals:
+        void                        currentByteChanged                  (int byte);
+
+    public slots:
+        void                        dataChanged                         ();
+        void                        markChanged                         (int position, int length);
+        void                        clearChanged                        ();
+        void                        copy                                ();
+
+    protected:
+        void                        paintEvent                          (QPaintEvent* event);
+        void                        resizeEvent                         (QResizeEvent* event);
+        void                        mousePressEvent                     (QMouseEvent* event);
+        void                        mouseMoveEvent                      (QMouseEvent* event);
+        void                        keyPressEvent                       (QKeyEvent* event);
+        void                        changeEvent                         (QEvent* event);
+
+    private:
+        void                        updateScrollBars                    ();
+        int                         byteAt                              (const QPoint& pos) const;
+        int                         hexColumn                           () const;
+        int                         textColumn                          () const;
+        int                         rowLength                           () const;
+        QString                     formatRow                           (int row, const QByteArray& bytes, int offset, bool available) const;
+
+        SeerHexWidget*              _hexWidget;
+        int                         _charWidth;
+        int                         _lineHeight;
+        int                         _ascent;
+        int                         _currentByte;
+        int                         _anchorByte;
+        QBitArray                   _changed;
+        bool                        _hasChanged;
+};
+
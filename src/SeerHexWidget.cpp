@@ -1,15 +1,11 @@
 #include "SeerHexWidget.h"
+#include "SeerHexView.h"
 #include "SeerUtl.h"
-#include <QtGui/QPainter>
-#include <QtGui/QPaintEvent>
-#include <QtGui/QKeyEvent>
-#include <QtGui/QClipboard>
-#include <QtGui/QTextCursor>
-#include <QtGui/QTextBlock>
-#include <QtCore/QStringConverter>
 #include <QtCore/QSize>
+#include <QtCore/QTimer>
 #include <QtCore/QDebug>
 #include <stdexcept>
+#include <cstring>
 
 #define byteArrayToType( data, order, precision, type ) \
         QDataStream stream( data ); \
@@ -70,26 +66,28 @@ SeerHexWidget::SeerHexWidget(QWidget* parent) : QWidget(parent), _pdata(NULL) {
     font.setFixedPitch(true);
     font.setStyleHint(QFont::TypeWriter);
 
-    plainTextEdit->setFont(font);
-    plainTextEdit->setFocusPolicy(Qt::StrongFocus);
-    plainTextEdit->setTextInteractionFlags(Qt::TextSelectableByKeyboard|Qt::TextSelectableByMouse);
-    plainTextEdit->setWordWrapMode(QTextOption::NoWrap);
+    hexView->setFont(font);
 
-    _memoryMode    = SeerHexWidget::HexMemoryMode;
-    _charMode      = SeerHexWidget::AsciiCharMode;
-    _addressOffset = 0;
-    _charWidth     = plainTextEdit->fontMetrics().horizontalAdvance(QLatin1Char('9'));
-    _charHeight    = plainTextEdit->fontMetrics().height();
-    _gapAddrHex    = 10; // Gap between address and hex fields.
-    _gapHexAscii   = 16; // Gap between hex and ascii fields.
-    _highlightByte = -1;
+    _memoryMode      = SeerHexWidget::HexMemoryMode;
+    _charMode        = SeerHexWidget::AsciiCharMode;
+    _addressOffset   = 0;
+    _bytesPerLine    = 16;
+    _hexCharsPerByte = 3;
+    _hexCharsPerLine = _bytesPerLine * _hexCharsPerByte - 1;
+    _charWidth       = hexView->fontMetrics().horizontalAdvance(QLatin1Char('9'));
+    _charHeight      = hexView->fontMetrics().height();
+    _gapAddrHex      = 10; // Gap between address and hex fields.
+    _gapHexAscii     = 16; // Gap between hex and ascii fields.
+    _changesPending  = false;
+
+    hexView->setHexWidget(this);
 
     setBytesPerLine(16);
 
     // Connect things.
-    QObject::connect(plainTextEdit,                   &QPlainTextEdit::cursorPositionChanged,        this,  &SeerHexWidget::handleCursorPositionChanged);
-    QObject::connect(showAsLittleEndianCheckBox,      &QCheckBox::clicked,                           this,  &SeerHexWidget::handleCursorPositionChanged);
-    QObject::connect(showUnsignedFloatAsHexCheckBox,  &QCheckBox::clicked,                           this,  &SeerHexWidget::handleCursorPositionChanged);
+    QObject::connect(hexView,                         &SeerHexView::currentByteChanged,              this,  &SeerHexWidget::byteOffsetChanged);
+    QObject::connect(showAsLittleEndianCheckBox,      &QCheckBox::clicked,                           this,  &SeerHexWidget::handleShowAsChanged);
+    QObject::connect(showUnsignedFloatAsHexCheckBox,  &QCheckBox::clicked,                           this,  &SeerHexWidget::handleShowAsChanged);
     QObject::connect(this,                            &SeerHexWidget::byteOffsetChanged,             this,  &SeerHexWidget::handleByteOffsetChanged);
 }
 
@@ -143,7 +141,11 @@ int SeerHexWidget::hexCharsPerByte () const {
 }
 
 int SeerHexWidget::nLines () const {
-    return plainTextEdit->blockCount();
+    return hexView->rowCount();
+}
+
+int SeerHexWidget::charWidth () const {
+    return _charWidth;
 }
 
 int SeerHexWidget::gapAddrHex () const {
@@ -231,14 +233,22 @@ QString SeerHexWidget::charModeString () const {
     return "???";
 }
 
-QTextDocument* SeerHexWidget::document () {
+SeerHexWidget::DataStorage* SeerHexWidget::data () {
 
-    return plainTextEdit->document();
+    return _pdata;
 }
 
 QString SeerHexWidget::toPlainText () {
 
-    return plainTextEdit->toPlainText();
+    // Format all of the rows. Only done for saving and printing.
+    QString text;
+
+    for (int row=0; row<nLines(); row++) {
+        text += hexView->rowText(row);
+        text += '\n';
+    }
+
+    return text;
 }
 
 void SeerHexWidget::setData(SeerHexWidget::DataStorage* pData) {
@@ -249,34 +259,52 @@ void SeerHexWidget::setData(SeerHexWidget::DataStorage* pData) {
 
     _pdata = pData;
 
+    // Nothing has changed in the new data.
+    hexView->clearChanged();
+
     // Repaint the widget.
     create();
 }
 
-void SeerHexWidget::handleCursorPositionChanged () {
+void SeerHexWidget::dataChanged () {
 
-    // Get the current cursor position.
-    QTextCursor cursor = plainTextEdit->textCursor();
+    // More of the data is in. Show it.
+    hexView->dataChanged();
 
-    // Is it before the hex values? (address region)
-    if (cursor.positionInBlock() < SeerHexWidget::HexFieldWidth) {
-        emit byteOffsetChanged(-1);
-        return;
-    }
+    updateChecksum();
 
-    // Is is after the hex values? (ascii/utf/ebcdic region)
-    if (cursor.positionInBlock() > SeerHexWidget::HexFieldWidth + hexCharsPerLine()) {
-        emit byteOffsetChanged(-1);
-        return;
+    handleByteOffsetChanged(hexView->currentByte());
+}
+
+void SeerHexWidget::markChanged (int position, int length) {
+
+    // Part of the data was updated in place. Only its rows are repainted.
+    hexView->markChanged(position, length);
+
+    // The checksum and value fields are done once the changes stop coming in.
+    if (_changesPending == false) {
+        _changesPending = true;
+        QTimer::singleShot(0, this, &SeerHexWidget::handleChangesDone);
     }
+}
 
-    int line = cursor.blockNumber();
-    int col  = cursor.positionInBlock() - SeerHexWidget::HexFieldWidth;
-    int byte = (col / hexCharsPerByte()) + (line * bytesPerLine());
+void SeerHexWidget::clearChanged () {
 
-    _highlightByte = byte;
+    hexView->clearChanged();
+}
+
+void SeerHexWidget::handleChangesDone () {
+
+    _changesPending = false;
+
+    updateChecksum();
+
+    handleByteOffsetChanged(hexView->currentByte());
+}
+
+void SeerHexWidget::handleShowAsChanged () {
 
-    emit byteOffsetChanged(byte);
+    handleByteOffsetChanged(hexView->currentByte());
 }
 
 void SeerHexWidget::handleByteOffsetChanged (int byte) {
@@ -297,9 +325,6 @@ void SeerHexWidget::handleByteOffsetChanged (int byte) {
     lineEdit_13->setText("");
     lineEdit_14->setText("");
 
-    // Remove previous highlight.
-    plainTextEdit->setExtraSelections(QList<QTextEdit::ExtraSelection>());
-
     // Invalid byte number, do nothing.
     if (byte < 0) {
         return;
@@ -315,50 +340,10 @@ void SeerHexWidget::handleByteOffsetChanged (int byte) {
         return;
     }
 
-    // Calculate line and position in line.
-    int line = (byte / bytesPerLine());
-    int pos  = byte - (line * bytesPerLine());
-
-    int pos_s = SeerHexWidget::HexFieldWidth + (pos * hexCharsPerByte());
-    int pos_e = pos_s + hexCharsPerByte() - 1;
-
-    int pos_a = SeerHexWidget::HexFieldWidth + hexCharsPerLine() + pos + 4; // 4 == ' ' .... ' | '
-
-    // Highlight the text in the hex region and the ascii region.
-    QList<QTextEdit::ExtraSelection> extraSelections; {
-
-        // Get a cursor to the current line.
-        QTextBlock  block  = plainTextEdit->document()->findBlockByLineNumber(line);
-        QTextCursor cursor = QTextCursor(block);
-
-        // Highlight the current hex value.
-        cursor.movePosition(QTextCursor::StartOfLine, QTextCursor::MoveAnchor);
-        cursor.movePosition(QTextCursor::Right,       QTextCursor::MoveAnchor, pos_s);
-        cursor.movePosition(QTextCursor::Right,       QTextCursor::KeepAnchor, pos_e - pos_s + 1);
-
-        // Add it to the extra selections.
-        QTextEdit::ExtraSelection extra_byte;
-        extra_byte.format.setBackground(plainTextEdit->palette().highlight().color());
-        extra_byte.cursor = cursor;
-
-        extraSelections.append(extra_byte);
-
-        // Highlight the current ascii value.
-        // For Ascii and Ebcdic only. No UTF as it can be variable length encoding.
-        if (charMode() == SeerHexWidget::AsciiCharMode || charMode() == SeerHexWidget::EbcdicCharMode) {
-            cursor.movePosition(QTextCursor::StartOfLine, QTextCursor::MoveAnchor);
-            cursor.movePosition(QTextCursor::Right,       QTextCursor::MoveAnchor, pos_a);
-            cursor.movePosition(QTextCursor::Right,       QTextCursor::KeepAnchor, 1);
-
-            // Add it to the extra selections.
-            QTextEdit::ExtraSelection extra_ascii;
-            extra_ascii.format.setBackground(plainTextEdit->palette().highlight().color());
-            extra_ascii.cursor = cursor;
-
-            extraSelections.append(extra_ascii);
-        }
-
-    } plainTextEdit->setExtraSelections(extraSelections);
+    // Not fetched yet, do nothing.
+    if (_pdata->hasData(byte, 1) == false) {
+        return;
+    }
 
     // Set the endian default.
     QDataStream::ByteOrder byteOrder = QDataStream::BigEndian;
@@ -554,212 +539,190 @@ void SeerHexWidget::handleByteOffsetChanged (int byte) {
 
 void SeerHexWidget::create () {
 
-    // Ignore changing of cursor positions.
-    QObject::disconnect(plainTextEdit, &QPlainTextEdit::cursorPositionChanged,    this,  &SeerHexWidget::handleCursorPositionChanged);
+    // Nothing is formatted here. The view formats the rows it shows when it paints.
+    hexView->dataChanged();
 
-    // Clear the current document. We're going to recreate it.
-    plainTextEdit->clear();
+    updateChecksum();
+
+    handleByteOffsetChanged(hexView->currentByte());
+}
+
+void SeerHexWidget::updateChecksum () {
 
     // Clear the checksum.
     lineEdit_15->setText("");
 
-    // If there's no data, do nothing.
+    // If there's no data, or not all of it, do nothing.
     if (!_pdata) {
-        // Re-enable notification of changing of cursor positions.
-        QObject::connect(plainTextEdit, &QPlainTextEdit::cursorPositionChanged,   this,  &SeerHexWidget::handleCursorPositionChanged);
         return;
     }
 
-    // Convert the data to a 'text' string.
-    QString    textString = "";
-    QByteArray data       = _pdata->getData();
-
-    if (charMode() == SeerHexWidget::AsciiCharMode) {
-
-        for (int b=0; b<data.size(); b++) {
-
-            unsigned char ch = Seer::ucharToAscii(data[b]);
+    if (_pdata->hasData(0, _pdata->size()) == false) {
+        return;
+    }
 
-            textString.append(QChar(ch));
-        }
+    // Print checksum.
+    quint16 crc16    = qChecksum(_pdata->getData(), Qt::ChecksumIso3309);
+    QString crc16str = QString::number(crc16);
 
-    }else if (charMode() == SeerHexWidget::Utf8Mode) {
+    lineEdit_15->setText(crc16str);
+}
 
-        auto toUtf16 = QStringDecoder(QStringDecoder::Utf8, QStringConverter::Flag::ConvertInvalidToNull);
+bool SeerHexWidget::DataStorage::hasData(int position, int length) {
+    Q_UNUSED(position);
+    Q_UNUSED(length);
+    return true;
+}
 
-        textString = toUtf16.decode(data);
+void SeerHexWidget::DataStorage::fetchData(int position, int length) {
+    Q_UNUSED(position);
+    Q_UNUSED(length);
+}
 
-        // Filter out ascii control characters.
-        for (int b=0; b<textString.length(); b++) {
-            if (textString[b] == QChar(127) || textString[b] < QChar(32)) {
-                textString[b] = QChar::ReplacementCharacter;
-            }
-        }
+SeerHexWidget::DataStorageArray::DataStorageArray(const QByteArray& arr) {
+    _data = arr;
+}
 
-    }else if (charMode() == SeerHexWidget::Utf16Mode) {
+QByteArray SeerHexWidget::DataStorageArray::getData(int position, int length) {
+    return _data.mid(position, length);
+}
 
-        auto toUtf16 = QStringDecoder(QStringDecoder::Utf16, QStringConverter::Flag::ConvertInvalidToNull);
+QByteArray SeerHexWidget::DataStorageArray::getData() {
+    return _data;
+}
 
-        textString = toUtf16.decode(data);
+int SeerHexWidget::DataStorageArray::size() {
+    return _data.size();
+}
 
-        // Filter out ascii control characters.
-        for (int b=0; b<textString.length(); b++) {
-            if (textString[b] == QChar(127) || textString[b] < QChar(32)) {
-                textString[b] = QChar::ReplacementCharacter;
-            }
-        }
+SeerHexWidget::DataStoragePaged::DataStoragePaged(int size, int pageSize, Fetcher fetcher) {
+    _size         = qMax(0, size);
+    _pageSize     = qMax(1, pageSize);
+    _fetcher      = fetcher;
+    _lastPosition = -1;
+    _lastLength   = 0;
+    _pages.resize((_size + _pageSize - 1) / _pageSize);
+    _states.fill(PageEmpty, _pages.size());
+}
 
-    }else if (charMode() == SeerHexWidget::Utf32Mode) {
+QByteArray SeerHexWidget::DataStoragePaged::getData(int position, int length) {
 
-        auto toUtf16 = QStringDecoder(QStringDecoder::Utf32, QStringConverter::Flag::ConvertInvalidToNull);
+    if (position < 0 || position >= _size) {
+        return QByteArray();
+    }
 
-        textString = toUtf16.decode(data);
+    length = qMin(length, _size - position);
 
-        // Filter out ascii control characters.
-        for (int b=0; b<textString.length(); b++) {
-            if (textString[b] == QChar(127) || textString[b] < QChar(32)) {
-                textString[b] = QChar::ReplacementCharacter;
-            }
-        }
+    // Bytes of pages that aren't in are 0.
+    QByteArray bytes(length, 0);
 
-    }else if (charMode() == SeerHexWidget::EbcdicCharMode) {
+    int done = 0;
 
-        for (int b=0; b<data.size(); b++) {
+    while (done < length) {
 
-            unsigned char ch = Seer::ebcdicToAscii(data[b]);
+        int page   = (position + done) / _pageSize;
+        int offset = (position + done) % _pageSize;
+        int n      = qMin(length - done, _pageSize - offset);
 
-            textString.append(QChar(ch));
+        if (_states[page] == PageLoaded) {
+            memcpy(bytes.data() + done, _pages[page].constData() + offset, n);
         }
 
-    }else{
-        // No 'text' string.
+        done += n;
     }
 
-    // Set text formats.
-    QTextCharFormat defaultFormat = plainTextEdit->currentCharFormat();
-    QTextCharFormat grayFormat    = defaultFormat;
-    grayFormat.setBackground(QBrush(Qt::lightGray));
-    QTextCharFormat greenFormat   = defaultFormat;
-    greenFormat.setBackground(QBrush(Qt::green));
-
-    // Get a cursor
-    QTextCursor cursor(plainTextEdit->textCursor());
+    return bytes;
+}
 
-    cursor.movePosition(QTextCursor::Start);
+QByteArray SeerHexWidget::DataStoragePaged::getData() {
+    return getData(0, _size);
+}
 
-    // Go through the data, one byte at a time.
-    for (int i=0; i<data.size(); i+=bytesPerLine()) {
+int SeerHexWidget::DataStoragePaged::size() {
+    return _size;
+}
 
-        // Place a new hex address on the left side.
-        if (i % bytesPerLine() == 0) {
+bool SeerHexWidget::DataStoragePaged::hasData(int position, int length) {
 
-            QString address = QString("0x%1").arg(i + addressOffset(), SeerHexWidget::HexFieldWidth-2, 16, QChar('0')); // -2 to allow '0x'.
+    if (length <= 0) {
+        return true;
+    }
 
-            // Write adress to document.
-            cursor.insertText (address, grayFormat);
+    int first = qMax(0, position) / _pageSize;
+    int last  = qMin(_size - 1, position + length - 1) / _pageSize;
 
-            // Write spacer to document.
-            cursor.insertText (QString(" "), defaultFormat);
+    for (int page=first; page<=last; page++) {
+        if (_states[page] != PageLoaded) {
+            return false;
         }
+    }
 
-        // Print N bytes in their datatype value.
-        int b = 0;
-
-        for (b=0; b<bytesPerLine() && i+b < data.size(); b++) {
-
-            unsigned char ch = data[i+b];
-
-            QString val;
-
-            if (memoryMode() == SeerHexWidget::HexMemoryMode) {
-                val = QString("%1").arg(ushort(ch), int(2), int(16), QChar('0'));
-            }else if (memoryMode() == SeerHexWidget::OctalMemoryMode) {
-                val = QString("%1").arg(ushort(ch), int(3), int(8), QChar('0'));
-            }else if (memoryMode() == SeerHexWidget::BinaryMemoryMode) {
-                val = QString("%1").arg(ushort(ch), int(8), int(2), QChar('0'));
-            }else if (memoryMode() == SeerHexWidget::DecimalMemoryMode) {
-                val = QString("%1").arg(ushort(ch), int(3), int(10), QChar(' '));
-            }else{
-                val = "??";
-            }
+    return true;
+}
 
-            cursor.insertText (val, defaultFormat);
+void SeerHexWidget::DataStoragePaged::fetchData(int position, int length) {
 
-            // Write spacer to document.
-            cursor.insertText (QString(" "), defaultFormat);
-        }
+    if (length <= 0 || !_fetcher) {
+        return;
+    }
 
-        // Print N odd remainder bytes.
-        for (; b<bytesPerLine(); b++) {
+    // Failed pages are asked for again after a scroll. Not on each repaint, or a page
+    // that can't be read would be asked for over and over.
+    bool moved = position != _lastPosition || length != _lastLength;
 
-            QString val;
+    _lastPosition = position;
+    _lastLength   = length;
 
-            if (memoryMode() == SeerHexWidget::HexMemoryMode) {
-                val = "  ";
-            }else if (memoryMode() == SeerHexWidget::OctalMemoryMode) {
-                val = "   ";
-            }else if (memoryMode() == SeerHexWidget::BinaryMemoryMode) {
-                val = "        ";
-            }else if (memoryMode() == SeerHexWidget::DecimalMemoryMode) {
-                val = "   ";
-            }else{
-                val = "??";
-            }
+    int first = qMax(0, position) / _pageSize;
+    int last  = qMin(_size - 1, position + length - 1) / _pageSize;
 
-            // Write memory value to document
-            cursor.insertText (val, defaultFormat);
+    for (int page=first; page<=last; page++) {
 
-            // Write spacer to document.
-            cursor.insertText (QString(" "), defaultFormat);
+        if (_states[page] != PageEmpty && (_states[page] != PageFailed || moved == false)) {
+            continue;
         }
 
-        // Print vertical line.
-        // Write spacer to document.
-        cursor.insertText (QString("| "), defaultFormat);
+        _states[page] = PageRequested;
 
-        // Print N bytes of the 'text' string.
-        for (int b=0; b<bytesPerLine() && i+b < textString.length(); b++) {
+        int start = page * _pageSize;
 
-            QString val = textString[i+b];
+        _fetcher(start, qMin(_pageSize, _size - start));
+    }
+}
 
-            // Write display character to document.
-            cursor.insertText (val, defaultFormat);
-        }
+int SeerHexWidget::DataStoragePaged::pageSize() const {
+    return _pageSize;
+}
 
-        // Write eol to document.
-        QString eol("\n");
+char* SeerHexWidget::DataStoragePaged::pageBuffer(int position) {
 
-        cursor.insertText (eol, defaultFormat);
+    if (position < 0 || position >= _size) {
+        return 0;
     }
 
+    int page  = position / _pageSize;
+    int start = page * _pageSize;
 
-    // Print checksum.
-    {
-        quint16 crc16    = qChecksum(data, Qt::ChecksumIso3309);
-        QString crc16str = QString::number(crc16);
-
-        lineEdit_15->setText(crc16str);
+    if (_pages[page].size() == 0) {
+        _pages[page] = QByteArray(qMin(_pageSize, _size - start), 0);
     }
 
-    handleByteOffsetChanged(_highlightByte);
+    _states[page] = PageLoaded;
 
-    // Re-enable notification of changing of cursor positions.
-    QObject::connect(plainTextEdit, &QPlainTextEdit::cursorPositionChanged, this,  &SeerHexWidget::handleCursorPositionChanged);
+    return _pages[page].data();
 }
 
-SeerHexWidget::DataStorageArray::DataStorageArray(const QByteArray& arr) {
-    _data = arr;
-}
+void SeerHexWidget::DataStoragePaged::setPageFailed(int position) {
 
-QByteArray SeerHexWidget::DataStorageArray::getData(int position, int length) {
-    return _data.mid(position, length);
-}
+    if (position < 0 || position >= _size) {
+        return;
+    }
 
-QByteArray SeerHexWidget::DataStorageArray::getData() {
-    return _data;
-}
+    int page = position / _pageSize;
 
-int SeerHexWidget::DataStorageArray::size() {
-    return _data.size();
+    // A page that was read before keeps its bytes. Otherwise, fetchData() asks for it again later.
+    if (_states[page] != PageLoaded) {
+        _states[page] = PageFailed;
+    }
 }
 
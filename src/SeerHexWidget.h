@@ -1,7 +1,9 @@
 #pragma once
 
-#include <QtWidgets/QPlainTextEdit>
+#include <QtWidgets/QWidget>
 #include <QtCore/QByteArray>
+#include <QtCore/QVector>
+#include <functional>
 #include "ui_SeerHexWidget.h"
 
 //
@@ -23,6 +25,8 @@ class SeerHexWidget: public QWidget, protected Ui::SeerHexWidgetForm {
                 virtual QByteArray getData(int position, int length) = 0;
                 virtual QByteArray getData() = 0;
                 virtual int size() = 0;
+                virtual bool hasData(int position, int length);     // Are the bytes in the store yet?
+                virtual void fetchData(int position, int length);   // Ask for bytes that are about to be shown.
         };
 
         class DataStorageArray: public DataStorage {
@@ -35,6 +39,35 @@ class SeerHexWidget: public QWidget, protected Ui::SeerHexWidgetForm {
                 QByteArray _data;
         };
 
+        //
+        // Storage that is filled a page at a time, as the pages are looked at.
+        // 'fetcher' is called to ask for a page. The reply is decoded into pageBuffer().
+        // A page that failed is asked for again once the range looked at moves.
+        //
+        class DataStoragePaged: public DataStorage {
+            public:
+                typedef std::function<void (int position, int length)> Fetcher;
+
+                DataStoragePaged(int size, int pageSize, Fetcher fetcher);
+                virtual QByteArray getData(int position, int length);
+                virtual QByteArray getData();
+                virtual int size();
+                virtual bool hasData(int position, int length);
+                virtual void fetchData(int position, int length);
+                int pageSize() const;
+                char* pageBuffer(int position);
+                void setPageFailed(int position);
+            private:
+                enum PageState { PageEmpty = 0, PageRequested = 1, PageLoaded = 2, PageFailed = 3 };
+                int _size;
+                int _pageSize;
+                Fetcher _fetcher;
+                QVector<QByteArray> _pages;
+                QVector<char> _states;
+                int _lastPosition;
+                int _lastLength;
+        };
+
         enum MemoryMode {
             UnknownMemoryMode = 0,
             HexMemoryMode     = 1,
@@ -64,6 +97,7 @@ class SeerHexWidget: public QWidget, protected Ui::SeerHexWidgetForm {
         int                         hexCharsPerLine                     () const;
         int                         hexCharsPerByte                     () const;
         int                         nLines                              () const;
+        int                         charWidth                           () const;
         int                         gapAddrHex                          () const;
         int                         gapHexAscii                         () const;
         void                        setAddressOffset                    (unsigned long offset);
@@ -78,7 +112,7 @@ class SeerHexWidget: public QWidget, protected Ui::SeerHexWidgetForm {
         SeerHexWidget::CharMode     charMode                            () const;
         QString                     charModeString                      () const;
 
-        QTextDocument*              document                            ();
+        DataStorage*                data                                ();
         QString                     toPlainText                         ();
 
     signals:
@@ -86,20 +120,24 @@ class SeerHexWidget: public QWidget, protected Ui::SeerHexWidgetForm {
 
     public slots:
         void                        setData                             (DataStorage* pData);
+        void                        dataChanged                         ();
+        void                        markChanged                         (int position, int length);
+        void                        clearChanged                        ();
 
     protected:
 
     protected slots:
-        void                        handleCursorPositionChanged         ();
+        void                        handleShowAsChanged                 ();
         void                        handleByteOffsetChanged             (int byte);
+        void                        handleChangesDone                   ();
 
     private:
         void                        create                              ();
+        void                        updateChecksum                      ();
 
         DataStorage*                _pdata;
         int                         _charWidth;
         int                         _charHeight;
-        int                         _highlightByte;
 
         int                         _bytesPerLine;
         int                         _hexCharsPerLine;
@@ -110,5 +148,6 @@ class SeerHexWidget: public QWidget, protected Ui::SeerHexWidgetForm {
 
         SeerHexWidget::MemoryMode   _memoryMode;
         SeerHexWidget::CharMode     _charMode;
+        bool                        _changesPending;
 };
 
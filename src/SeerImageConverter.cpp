@@ -0,0 +1,690 @@
+#include "SeerImageConverter.h"
+#include <QtCore/QtGlobal>
+#include <QtCore/QDebug>
+#include <cstring>
+#include <cmath>
+#include <climits>
+
+//
+// SSE2 versions of the row conversions. SSE2 is always there on x86-64.
+//
+#if defined(__SSE2__) || defined(_M_X64)
+#define SEER_IMAGE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+    //
+    // Set SEER_IMAGE_SCALAR to use the plain versions.
+    //
+    bool useSse2 () {
+
+#if defined(SEER_IMAGE_SSE2)
+        static const bool sse2 = qEnvironmentVariableIsSet("SEER_IMAGE_SCALAR") == false;
+
+        return sse2;
+#else
+        return false;
+#endif
+    }
+
+    inline quint8 clampByte (int v) {
+
+        return (quint8)(v < 0 ? 0 : (v > 255 ? 255 : v));
+    }
+
+    //
+    // A value scaled to 0..255. NaN is 0.
+    //
+    inline quint8 scaleToByte (float v, float minimum, float scale) {
+
+        float x = (v - minimum) * scale;
+
+        if (x > 255.0f) {
+            return 255;
+        }
+
+        if (x >= 0.0f) {
+            return (quint8)lrintf(x);
+        }
+
+        return 0;
+    }
+
+    //
+    // BT.601, limited range.
+    //
+    inline quint32 yuvToArgb32 (int y, int u, int v) {
+
+        int c = (y - 16) * 298 + 128;
+        int d = u - 128;
+        int e = v - 128;
+
+        quint32 r = clampByte((c + 409 * e) >> 8);
+        quint32 g = clampByte((c - 100 * d - 208 * e) >> 8);
+        quint32 b = clampByte((c + 516 * d) >> 8);
+
+        return 0xff000000u | (r << 16) | (g << 8) | b;
+    }
+
+    void rgbaRowScalar (const quint8* p, quint32* out, int n) {
+
+        for (int x=0; x<n; x++, p+=4) {
+            out[x] = ((quint32)p[3] << 24) | ((quint32)p[0] << 16) | ((quint32)p[1] << 8) | p[2];
+        }
+    }
+
+    void rgbRowScalar (const quint8* p, quint32* out, int n) {
+
+        for (int x=0; x<n; x++, p+=3) {
+            out[x] = 0xff000000u | ((quint32)p[0] << 16) | ((quint32)p[1] << 8) | p[2];
+        }
+    }
+
+    void grayRowScalar (const quint8* p, quint32* out, int n) {
+
+        for (int x=0; x<n; x++) {
+            out[x] = 0xff000000u | (quint32)p[x] * 0x010101u;
+        }
+    }
+
+    void gray16RowScalar (const quint8* p, quint8* out, int n, float minimum, float scale) {
+
+        for (int x=0; x<n; x++) {
+
+            quint16 v;
+
+            memcpy(&v, p + x*2, 2);
+
+            out[x] = scaleToByte((float)v, minimum, scale);
+        }
+    }
+
+    void float32RowScalar (const quint8* p, quint8* out, int n, float minimum, float scale) {
+
+        for (int x=0; x<n; x++) {
+
+            float v;
+
+            memcpy(&v, p + x*4, 4);
+
+            out[x] = scaleToByte(v, minimum, scale);
+        }
+    }
+
+#if defined(SEER_IMAGE_SSE2)
+
+    //
+    // R,G,B,A bytes to B,G,R,A bytes (ARGB32 on little endian). 4 pixels at a time.
+    //
+    void rgbaRowSse2 (const quint8* p, quint32* out, int n) {
+
+        const __m128i rbMask = _mm_set1_epi32(0x00ff00ff);
+        const __m128i gaMask = _mm_set1_epi32((int)0xff00ff00);
+
+        int x = 0;
+
+        for (; x + 4 <= n; x += 4) {
+
+            __m128i v  = _mm_loadu_si128((const __m128i*)(p + x*4));
+            __m128i rb = _mm_and_si128(v, rbMask);
+            __m128i ga = _mm_and_si128(v, gaMask);
+
+            rb = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+
+            _mm_storeu_si128((__m128i*)(out + x), _mm_or_si128(ga, rb));
+        }
+
+        rgbaRowScalar(p + x*4, out + x, n - x);
+    }
+
+    //
+    // Gray bytes to opaque gray pixels. 16 pixels at a time.
+    //
+    void grayRowSse2 (const quint8* p, quint32* out, int n) {
+
+        const __m128i alpha = _mm_set1_epi8((char)0xff);
+
+        int x = 0;
+
+        for (; x + 16 <= n; x += 16) {
+
+            __m128i g    = _mm_loadu_si128((const __m128i*)(p + x));
+            __m128i gg0  = _mm_unpacklo_epi8(g, g);
+            __m128i gg1  = _mm_unpackhi_epi8(g, g);
+            __m128i ga0  = _mm_unpacklo_epi8(g, alpha);
+            __m128i ga1  = _mm_unpackhi_epi8(g, alpha);
+
+            _mm_storeu_si128((__m128i*)(out + x),      _mm_unpacklo_epi16(gg0, ga0));
+            _mm_storeu_si128((__m128i*)(out + x + 4),  _mm_unpackhi_epi16(gg0, ga0));
+            _mm_storeu_si128((__m128i*)(out + x + 8),  _mm_unpacklo_epi16(gg1, ga1));
+            _mm_storeu_si128((__m128i*)(out + x + 12), _mm_unpackhi_epi16(gg1, ga1));
+        }
+
+        grayRowScalar(p + x, out + x, n - x);
+    }
+
+    //
+    // Four vectors of values scaled to 0..255 and packed into 16 bytes. NaN is 0.
+    //
+    inline __m128i scaleToBytesSse2 (__m128 v0, __m128 v1, __m128 v2, __m128 v3, __m128 minimum, __m128 scale) {
+
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 top  = _mm_set1_ps(255.0f);
+
+        // max() gives its second operand when the first is NaN.
+        v0 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(v0, minimum), scale), zero), top);
+        v1 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(v1, minimum), scale), zero), top);
+        v2 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(v2, minimum), scale), zero), top);
+        v3 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(v3, minimum), scale), zero), top);
+
+        __m128i lo = _mm_packs_epi32(_mm_cvtps_epi32(v0), _mm_cvtps_epi32(v1));
+        __m128i hi = _mm_packs_epi32(_mm_cvtps_epi32(v2), _mm_cvtps_epi32(v3));
+
+        return _mm_packus_epi16(lo, hi);
+    }
+
+    void gray16RowSse2 (const quint8* p, quint8* out, int n, float minimum, float scale) {
+
+        const __m128  vmin  = _mm_set1_ps(minimum);
+        const __m128  vscl  = _mm_set1_ps(scale);
+        const __m128i zero  = _mm_setzero_si128();
+
+        int x = 0;
+
+        for (; x + 16 <= n; x += 16) {
+
+            __m128i a = _mm_loadu_si128((const __m128i*)(p + x*2));
+            __m128i b = _mm_loadu_si128((const __m128i*)(p + x*2 + 16));
+
+            __m128 v0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(a, zero));
+            __m128 v1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(a, zero));
+            __m128 v2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(b, zero));
+            __m128 v3 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(b, zero));
+
+            _mm_storeu_si128((__m128i*)(out + x), scaleToBytesSse2(v0, v1, v2, v3, vmin, vscl));
+        }
+
+        gray16RowScalar(p + x*2, out + x, n - x, minimum, scale);
+    }
+
+    void float32RowSse2 (const quint8* p, quint8* out, int n, float minimum, float scale) {
+
+        const __m128 vmin = _mm_set1_ps(minimum);
+        const __m128 vscl = _mm_set1_ps(scale);
+
+        int x = 0;
+
+        for (; x + 16 <= n; x += 16) {
+
+            const float* f = (const float*)(p + x*4);
+
+            __m128 v0 = _mm_loadu_ps(f);
+            __m128 v1 = _mm_loadu_ps(f + 4);
+            __m128 v2 = _mm_loadu_ps(f + 8);
+            __m128 v3 = _mm_loadu_ps(f + 12);
+
+            _mm_storeu_si128((__m128i*)(out + x), scaleToBytesSse2(v0, v1, v2, v3, vmin, vscl));
+        }
+
+        float32RowScalar(p + x*4, out + x, n - x, minimum, scale);
+    }
+#endif
+
+    void rgbaRow (const quint8* p, quint32* out, int n) {
+#if defined(SEER_IMAGE_SSE2)
+        if (useSse2()) {
+            rgbaRowSse2(p, out, n);
+            return;
+        }
+#endif
+        rgbaRowScalar(p, out, n);
+    }
+
+    void grayRow (const quint8* p, quint32* out, int n) {
+#if defined(SEER_IMAGE_SSE2)
+        if (useSse2()) {
+            grayRowSse2(p, out, n);
+            return;
+        }
+#endif
+        grayRowScalar(p, out, n);
+    }
+
+    void gray16Row (const quint8* p, quint8* out, int n, float minimum, float scale) {
+#if defined(SEER_IMAGE_SSE2)
+        if (useSse2()) {
+            gray16RowSse2(p, out, n, minimum, scale);
+            return;
+        }
+#endif
+        gray16RowScalar(p, out, n, minimum, scale);
+    }
+
+    void float32Row (const quint8* p, quint8* out, int n, float minimum, float scale) {
+#if defined(SEER_IMAGE_SSE2)
+        if (useSse2()) {
+            float32RowSse2(p, out, n, minimum, scale);
+            return;
+        }
+#endif
+        float32RowScalar(p, out, n, minimum, scale);
+    }
+
+    //
+    // A row of Y, with U and V for every second pixel. 'uvStep' is 2 for NV12's U,V pairs.
+    //
+    void yuvRow (const quint8* y, const quint8* u, const quint8* v, int uvStep, quint32* out, int n) {
+
+        for (int x=0; x<n; x++) {
+
+            int c = (x / 2) * uvStep;
+
+            out[x] = yuvToArgb32(y[x], u[c], v[c]);
+        }
+    }
+}
+
+SeerImageConverter::SeerImageConverter () {
+
+    _format  = UnknownFormat;
+    _width   = 0;
+    _height  = 0;
+    _stride  = 0;
+    _minimum = 0.0f;
+    _maximum = 0.0f;
+}
+
+SeerImageConverter::~SeerImageConverter () {
+}
+
+QStringList SeerImageConverter::formatNames () {
+
+    return QStringList() << "RGBA8888" << "RGB888" << "Gray8" << "Gray16" << "Float32" << "NV12" << "YUV420";
+}
+
+SeerImageConverter::PixelFormat SeerImageConverter::formatFromName (const QString& name) {
+
+    if (name == "RGBA8888") {
+        return RGBA8888;
+    }else if (name == "RGB888") {
+        return RGB888;
+    }else if (name == "Gray8") {
+        return Gray8;
+    }else if (name == "Gray16") {
+        return Gray16;
+    }else if (name == "Float32") {
+        return Float32;
+    }else if (name == "NV12") {
+        return NV12;
+    }else if (name == "YUV420") {
+        return YUV420;
+    }
+
+    return UnknownFormat;
+}
+
+int SeerImageConverter::bytesPerPixel (PixelFormat format) {
+
+    // For the planar formats, it's the Y plane.
+    switch (format) {
+        case RGBA8888:  return 4;
+        case RGB888:    return 3;
+        case Gray8:     return 1;
+        case Gray16:    return 2;
+        case Float32:   return 4;
+        case NV12:      return 1;
+        case YUV420:    return 1;
+        default:        return 0;
+    }
+}
+
+bool SeerImageConverter::setLayout (PixelFormat format, int width, int height, int stride) {
+
+    _format  = UnknownFormat;
+    _width   = 0;
+    _height  = 0;
+    _stride  = 0;
+    _minimum = 0.0f;
+    _maximum = 0.0f;
+
+    qint64 rowBytes = (qint64)width * bytesPerPixel(format);
+
+    if (rowBytes <= 0 || height < 1) {
+        return false;
+    }
+
+    if (stride == 0) {
+        stride = rowBytes;
+    }
+
+    // Rows can't overlap.
+    if (stride < rowBytes) {
+        return false;
+    }
+
+    _format = format;
+    _width  = width;
+    _height = height;
+    _stride = stride;
+
+    // Memory is read with an int count.
+    if (bytesNeeded() > INT_MAX) {
+        _format = UnknownFormat;
+        return false;
+    }
+
+    return true;
+}
+
+bool SeerImageConverter::isValid () const {
+
+    return _format != UnknownFormat;
+}
+
+SeerImageConverter::PixelFormat SeerImageConverter::format () const {
+
+    return _format;
+}
+
+int SeerImageConverter::width () const {
+
+    return _width;
+}
+
+int SeerImageConverter::height () const {
+
+    return _height;
+}
+
+int SeerImageConverter::stride () const {
+
+    return (int)_stride;
+}
+
+qint64 SeerImageConverter::chromaStride () const {
+
+    int chromaWidth = (_width + 1) / 2;
+
+    if (_format == NV12) {
+        return qMax(_stride, (qint64)chromaWidth * 2);
+    }
+
+    return qMax((_stride + 1) / 2, (qint64)chromaWidth);
+}
+
+qint64 SeerImageConverter::uPlane () const {
+
+    return _stride * _height;
+}
+
+qint64 SeerImageConverter::vPlane () const {
+
+    if (_format == NV12) {
+        return uPlane() + 1;
+    }
+
+    return uPlane() + chromaStride() * ((_height + 1) / 2);
+}
+
+qint64 SeerImageConverter::bytesNeeded () const {
+
+    // Up to the last byte used. Not the padding after the last row.
+    int chromaWidth  = (_width + 1) / 2;
+    int chromaHeight = (_height + 1) / 2;
+
+    switch (_format) {
+        case NV12:      return uPlane() + chromaStride() * (chromaHeight - 1) + chromaWidth * 2;
+        case YUV420:    return vPlane() + chromaStride() * (chromaHeight - 1) + chromaWidth;
+        case UnknownFormat: return 0;
+        default:        return _stride * (_height - 1) + (qint64)_width * bytesPerPixel(_format);
+    }
+}
+
+bool SeerImageConverter::rowsForBytes (qint64 position, qint64 length, int* firstRow, int* lastRow) const {
+
+    if (isValid() == false || length < 1) {
+        return false;
+    }
+
+    qint64 end   = position + length;
+    int    first = INT_MAX;
+    int    last  = -1;
+
+    // The image rows a plane's bytes are in. A chroma row covers two image rows.
+    auto plane = [&](qint64 offset, qint64 stride, int rows, int scale) {
+
+        qint64 a = qMax(position, offset);
+        qint64 b = qMin(end, offset + stride * rows);
+
+        if (a >= b) {
+            return;
+        }
+
+        int r0 = (int)((a - offset) / stride);
+        int r1 = (int)((b - 1 - offset) / stride);
+
+        first = qMin(first, r0 * scale);
+        last  = qMax(last,  r1 * scale + scale - 1);
+    };
+
+    plane(0, _stride, _height, 1);
+
+    if (_format == NV12) {
+        plane(uPlane(), chromaStride(), (_height + 1) / 2, 2);
+    }else if (_format == YUV420) {
+        plane(uPlane(), chromaStride(), (_height + 1) / 2, 2);
+        plane(vPlane(), chromaStride(), (_height + 1) / 2, 2);
+    }
+
+    if (last < first) {
+        return false;
+    }
+
+    *firstRow = first;
+    *lastRow  = qMin(last, _height - 1);
+
+    return true;
+}
+
+QImage SeerImageConverter::convert (const char* data, qint64 size) {
+
+    if (isValid() == false || data == 0 || size < bytesNeeded()) {
+        return QImage();
+    }
+
+    if (isNormalized()) {
+        findRange(data, &_minimum, &_maximum);
+    }
+
+    QImage image(_width, _height, QImage::Format_ARGB32);
+
+    if (image.isNull()) {
+        qWarning() << "Can't make a" << _width << "x" << _height << "image.";
+        return image;
+    }
+
+    for (int y=0; y<_height; y++) {
+        convertRow(data, y, (quint32*)image.scanLine(y));
+    }
+
+    return image;
+}
+
+bool SeerImageConverter::convertRows (const char* data, qint64 size, QImage& image, int* firstRow, int* lastRow) {
+
+    if (isValid() == false || data == 0 || size < bytesNeeded()) {
+        return false;
+    }
+
+    // Not an image of ours. Do it all.
+    if (image.width() != _width || image.height() != _height || image.format() != QImage::Format_ARGB32) {
+
+        image     = convert(data, size);
+        *firstRow = 0;
+        *lastRow  = _height - 1;
+
+        return image.isNull() == false;
+    }
+
+    // A new min/max changes every pixel.
+    if (isNormalized()) {
+
+        float minimum;
+        float maximum;
+
+        findRange(data, &minimum, &maximum);
+
+        if (minimum != _minimum || maximum != _maximum) {
+            _minimum  = minimum;
+            _maximum  = maximum;
+            *firstRow = 0;
+            *lastRow  = _height - 1;
+        }
+    }
+
+    int first = qMax(*firstRow, 0);
+    int last  = qMin(*lastRow,  _height - 1);
+
+    for (int y=first; y<=last; y++) {
+        convertRow(data, y, (quint32*)image.scanLine(y));
+    }
+
+    return true;
+}
+
+bool SeerImageConverter::isNormalized () const {
+
+    return _format == Gray16 || _format == Float32;
+}
+
+double SeerImageConverter::minimum () const {
+
+    return _minimum;
+}
+
+double SeerImageConverter::maximum () const {
+
+    return _maximum;
+}
+
+const char* SeerImageConverter::method () {
+
+    return useSse2() ? "sse2" : "scalar";
+}
+
+void SeerImageConverter::findRange (const char* data, float* minimum, float* maximum) const {
+
+    bool  found = false;
+    float lo    = 0.0f;
+    float hi    = 0.0f;
+
+    for (int y=0; y<_height; y++) {
+
+        const char* p = data + y * _stride;
+
+        if (_format == Gray16) {
+
+            quint16 rlo = 0xffff;
+            quint16 rhi = 0;
+
+            for (int x=0; x<_width; x++) {
+
+                quint16 v;
+
+                memcpy(&v, p + x*2, 2);
+
+                rlo = qMin(rlo, v);
+                rhi = qMax(rhi, v);
+            }
+
+            lo    = found ? qMin(lo, (float)rlo) : (float)rlo;
+            hi    = found ? qMax(hi, (float)rhi) : (float)rhi;
+            found = true;
+
+        }else if (_format == Float32) {
+
+            for (int x=0; x<_width; x++) {
+
+                float v;
+
+                memcpy(&v, p + x*4, 4);
+
+                // Holes in a depth map. They don't count.
+                if (std::isfinite(v) == false) {
+                    continue;
+                }
+
+                lo    = found ? qMin(lo, v) : v;
+                hi    = found ? qMax(hi, v) : v;
+                found = true;
+            }
+        }
+    }
+
+    *minimum = lo;
+    *maximum = hi;
+}
+
+void SeerImageConverter::convertRow (const char* data, int row, quint32* out) const {
+
+    const quint8* p     = (const quint8*)data + row * _stride;
+    float         scale = _maximum > _minimum ? 255.0f / (_maximum - _minimum) : 0.0f;
+
+    switch (_format) {
+
+        case RGBA8888:
+            rgbaRow(p, out, _width);
+            break;
+
+        case RGB888:
+            rgbRowScalar(p, out, _width);
+            break;
+
+        case Gray8:
+            grayRow(p, out, _width);
+            break;
+
+        case Gray16:
+        case Float32: {
+
+            // Scale to gray bytes, then to pixels.
+            if (_normalized.size() < _width) {
+                _normalized.resize(_width);
+            }
+
+            quint8* gray = (quint8*)_normalized.data();
+
+            if (_format == Gray16) {
+                gray16Row(p, gray, _width, _minimum, scale);
+            }else{
+                float32Row(p, gray, _width, _minimum, scale);
+            }
+
+            grayRow(gray, out, _width);
+            break;
+        }
+
+        case NV12: {
+
+            const quint8* uv = (const quint8*)data + uPlane() + (row / 2) * chromaStride();
+
+            yuvRow(p, uv, uv + 1, 2, out, _width);
+            break;
+        }
+
+        case YUV420: {
+
+            const quint8* u = (const quint8*)data + uPlane() + (row / 2) * chromaStride();
+            const quint8* v = (const quint8*)data + vPlane() + (row / 2) * chromaStride();
+
+            yuvRow(p, u, v, 1, out, _width);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QtGui/QImage>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+//
+// Turns the bytes of an image in the program's memory into a QImage (ARGB32).
+//
+// Rows can be padded. 'stride' is the bytes from one row to the next (of the
+// Y plane for the planar formats). 0 means the rows are packed.
+//
+//     RGBA8888    4 bytes a pixel. R, G, B, A.
+//     RGB888      3 bytes a pixel. R, G, B.
+//     Gray8       1 byte a pixel.
+//     Gray16      2 bytes a pixel. Scaled from its min/max to 0..255.
+//     Float32     4 bytes a pixel (a depth map, say). Scaled from its min/max to 0..255.
+//                 NaNs and infinities are left out of the min/max. NaNs are black.
+//     NV12        A Y plane, then a plane of U,V pairs at half the width and height.
+//     YUV420      A Y plane, then a U plane and a V plane at half the width and height.
+//
+// The YUV formats are BT.601, limited range.
+//
+//     SeerImageConverter converter;
+//
+//     converter.setLayout(SeerImageConverter::NV12, 1280, 720, 1536);
+//
+//     read converter.bytesNeeded() bytes ...
+//
+//     QImage image = converter.convert(bytes, size);
+//
+
+class SeerImageConverter {
+
+    public:
+        enum PixelFormat {
+            UnknownFormat   = 0,
+            RGBA8888        = 1,
+            RGB888          = 2,
+            Gray8           = 3,
+            Gray16          = 4,
+            Float32         = 5,
+            NV12            = 6,
+            YUV420          = 7
+        };
+
+        SeerImageConverter ();
+       ~SeerImageConverter ();
+
+        static QStringList          formatNames                 ();
+        static PixelFormat          formatFromName              (const QString& name);
+        static int                  bytesPerPixel               (PixelFormat format);
+
+        bool                        setLayout                   (PixelFormat format, int width, int height, int stride = 0);
+        bool                        isValid                     () const;
+        PixelFormat                 format                      () const;
+        int                         width                       () const;
+        int                         height                      () const;
+        int                         stride                      () const;
+        qint64                      bytesNeeded                 () const;
+        bool                        rowsForBytes                (qint64 position, qint64 length, int* firstRow, int* lastRow) const;
+
+        QImage                      convert                     (const char* data, qint64 size);
+        bool                        convertRows                 (const char* data, qint64 size, QImage& image, int* firstRow, int* lastRow);
+
+        bool                        isNormalized                () const;
+        double                      minimum                     () const;
+        double                      maximum                     () const;
+
+        static const char*          method                      ();
+
+    private:
+        void                        findRange                   (const char* data, float* minimum, float* maximum) const;
+        void                        convertRow                  (const char* data, int row, quint32* out) const;
+        qint64                      chromaStride                () const;
+        qint64                      uPlane                      () const;
+        qint64                      vPlane                      () const;
+
+        PixelFormat                 _format;
+        int                         _width;
+        int                         _height;
+        qint64                      _stride;
+        float                       _minimum;
+        float                       _maximum;
+        mutable QByteArray          _normalized;
+};
+
@@ -14,13 +14,15 @@ SeerImageVisualizerWidget::SeerImageVisualizerWidget (QWidget* parent) : QWidget
 
     // Init variables.
     _variableId = Seer::createID(); // Create two id's for queries.
-    _memoryId   = Seer::createID();
     _formatName = "";
-    _format     = QImage::Format_Invalid;
     _width      = 0;
     _height     = 0;
     _bytes      = 0;
 
+    _partialUpdate   = false;
+    _changedFirstRow = -1;
+    _changedLastRow  = -1;
+
     // Set up UI.
     setupUi(this);
 
@@ -31,6 +33,12 @@ SeerImageVisualizerWidget::SeerImageVisualizerWidget (QWidget* parent) : QWidget
 
     widthLineEdit->setValidator(new QIntValidator(1, 9999999, this));
     heightLineEdit->setValidator(new QIntValidator(1, 9999999, this));
+    strideLineEdit->setValidator(new QIntValidator(0, 999999999, this));
+    readProgressBar->hide();
+    cancelToolButton->hide();
+
+    // Big images are read in chunks. What's in so far is shown as they come in.
+    _memoryReader = new SeerMemoryReader(this);
 
     // Connect things.
     QObject::connect(refreshToolButton,             &QToolButton::clicked,                                     this,  &SeerImageVisualizerWidget::handleRefreshButton);
@@ -38,9 +46,21 @@ SeerImageVisualizerWidget::SeerImageVisualizerWidget (QWidget* parent) : QWidget
     QObject::connect(variableNameLineEdit,          &QLineEdit::returnPressed,                                 this,  &SeerImageVisualizerWidget::handleVariableNameLineEdit);
     QObject::connect(widthLineEdit,                 &QLineEdit::returnPressed,                                 this,  &SeerImageVisualizerWidget::handleRefreshButton);
     QObject::connect(heightLineEdit,                &QLineEdit::returnPressed,                                 this,  &SeerImageVisualizerWidget::handleRefreshButton);
+    QObject::connect(strideLineEdit,                &QLineEdit::returnPressed,                                 this,  &SeerImageVisualizerWidget::handleRefreshButton);
     QObject::connect(formatComboBox,                QOverload<int>::of(&QComboBox::currentIndexChanged),       this,  &SeerImageVisualizerWidget::handleFormatComboBox);
     QObject::connect(printToolButton,               &QToolButton::clicked,                                     this,  &SeerImageVisualizerWidget::handlePrintButton);
     QObject::connect(saveToolButton,                &QToolButton::clicked,                                     this,  &SeerImageVisualizerWidget::handleSaveButton);
+    QObject::connect(autoRefreshCheckBox,           &QCheckBox::toggled,                                       this,  &SeerImageVisualizerWidget::handleAutoRefreshChanged);
+    QObject::connect(refreshIntervalSpinBox,        QOverload<int>::of(&QSpinBox::valueChanged),               this,  &SeerImageVisualizerWidget::handleAutoRefreshChanged);
+    QObject::connect(cancelToolButton,              &QToolButton::clicked,                                     _memoryReader,  &SeerMemoryReader::cancel);
+    QObject::connect(cancelToolButton,              &QToolButton::clicked,                                     this,  &SeerImageVisualizerWidget::handleReadFinished);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::readMemory,                             this,  &SeerImageVisualizerWidget::evaluateMemoryExpression);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::updated,                                this,  &SeerImageVisualizerWidget::handleReadUpdated);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::chunkFailed,                            this,  &SeerImageVisualizerWidget::handleChunkFailed);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::progress,                               this,  &SeerImageVisualizerWidget::handleReadProgress);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::finished,                               this,  &SeerImageVisualizerWidget::handleReadFinished);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::refreshStarted,                         this,  &SeerImageVisualizerWidget::handleRefreshStarted);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::changed,                                this,  &SeerImageVisualizerWidget::handleMemoryChanged);
 
     // Restore window settings.
     readSettings();
@@ -111,6 +131,10 @@ void SeerImageVisualizerWidget::setVariableAddress (const QString& address) {
         }
     }
 
+    // Stop any read for the old address.
+    _memoryReader->cancel();
+    handleReadFinished();
+
     imageViewer->setImage(QImage());
 
     // Show results immediately.
@@ -130,7 +154,7 @@ void SeerImageVisualizerWidget::handleText (const QString& text) {
 
     //qDebug() << text;
 
-    if (text.contains(QRegularExpression("^([0-9]+)\\^done,value="))) {
+    if (Seer::matchRecord(text, "^done,value=")) {
 
         // 10^done,value="1"
         // 11^done,value="0x7fffffffd538"
@@ -144,44 +168,7 @@ void SeerImageVisualizerWidget::handleText (const QString& text) {
             setVariableAddress(words.first());
         }
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,memory="))) {
-
-        // 3^done,memory=[{begin="0x0000000000613e70",offset="0x0000000000000000",end="0x0000000000613e71",contents="00"}]
-        // 4^done,memory=[{begin="0x0000000000613e70",offset="0x0000000000000000",end="0x0000000000613ed4",contents="000000000000000000000000"}]
-
-        QString id_text = text.section('^', 0,0);
-
-        if (id_text.toInt() == _memoryId) {
-
-            //qDebug() << text;
-
-            QString memory_text = Seer::parseFirst(text, "memory=", '[', ']', false);
-
-            QStringList range_list = Seer::parse(memory_text, "", '{', '}', false);
-
-            // Loop through the memory ranges.
-            for ( const auto& range_text : range_list  ) {
-
-                QString contents_text = Seer::parseFirst(range_text, "contents=", '"', '"', false);
-
-                // Convert hex string to byte array.
-                QByteArray array;
-
-                for (int i = 0; i<contents_text.size(); i += 2) {
-                    QString num = contents_text.mid(i, 2);
-                    bool ok = false;
-                    array.push_back(num.toInt(&ok, 16));
-                    Q_ASSERT(ok);
-                }
-
-                // Create the image.
-                handleCreateImage(array);
-
-                break; // Take just the first range for now.
-            }
-        }
-
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
+    }else if (Seer::matchRecord(text, "^error,msg=")) {
 
         // 12^error,msg="No symbol \"return\" in current context."
         // 13^error,msg="No symbol \"cout\" in current context."
@@ -193,20 +180,11 @@ void SeerImageVisualizerWidget::handleText (const QString& text) {
             variableAddressLineEdit->setText( Seer::filterEscapes(Seer::parseFirst(text, "msg=", '"', '"', false)) );
         }
 
-        if (id_text.toInt() == _memoryId) {
-            // Display the error message.
-            QString msg_text = Seer::parseFirst(text, "msg=", false);
-
-            if (msg_text != "") {
-                QMessageBox::warning(this, "Error.", Seer::filterEscapes(msg_text));
-            }
-        }
-
     // At a stopping point, refresh.
     }else if (text.startsWith("*stopped,reason=\"")) {
 
         if (autoRefreshCheckBox->isChecked()) {
-            handleRefreshButton();
+            autoRefresh();
         }
 
     }else{
@@ -252,40 +230,49 @@ void SeerImageVisualizerWidget::handleRefreshButton () {
     // Get image format.
     QString format = formatComboBox->currentText();
 
-    // Validate the image dimensions vs. the data size.
+    // Padded rows? Blank means they're not.
+    int stride = strideLineEdit->text().toInt();
+
+    // Work out how much memory the layout needs.
     _formatName = "";
-    _format     = QImage::Format_Invalid;
     _width      = w;
     _height     = h;
     _bytes      = 0;
+    _image      = QImage();
 
-    if (format == "RGBA8888") {
+    SeerImageConverter::PixelFormat pixelFormat = SeerImageConverter::formatFromName(format);
 
-        _formatName = format;
-        _format     = QImage::Format_RGBA8888;
-        _bytes      = _width * _height * 4;
-
-    }else if (format == "RGB888") {
+    // Unknown format.
+    if (pixelFormat == SeerImageConverter::UnknownFormat) {
+        messageLineEdit->setText("Unknown image format of '" + format + ".");
+        return;
+    }
 
-        _formatName = format;
-        _format     = QImage::Format_RGB888;
-        _bytes      = _width * _height * 3;
+    if (_converter.setLayout(pixelFormat, w, h, stride) == false) {
+        messageLineEdit->setText(QString("The '%1' image (%2x%3) can't have a stride of %4 bytes.").arg(format).arg(w).arg(h).arg(stride));
+        return;
     }
 
-    // Unknown format.
-    if (_bytes <= 0) {
+    // Just the bytes the layout uses. Not the padding after the last row.
+    _formatName = format;
+    _bytes      = (int)_converter.bytesNeeded();
 
-        _formatName = "";
-        _format     = QImage::Format_Invalid;
-        _width      = w;
-        _height     = h;
-        _bytes      = 0;
+    _readMessage   = "";
+    _partialUpdate = false;
 
-        messageLineEdit->setText("Unknown image format of '" + format + ".");
+    _memoryReader->read(variableAddressLineEdit->text(), _bytes);
+}
+
+void SeerImageVisualizerWidget::autoRefresh () {
+
+    // Something else is being looked at now. Read it fresh.
+    if (_bytes == 0 || _memoryReader->address() != variableAddressLineEdit->text() || _memoryReader->count() != _bytes || imageViewer->image().isNull()) {
+        handleRefreshButton();
         return;
     }
 
-    emit evaluateMemoryExpression(_memoryId, variableAddressLineEdit->text(), _bytes);
+    // Same memory. Read it again and redraw just the rows that changed.
+    _memoryReader->refresh();
 }
 
 void SeerImageVisualizerWidget::handleHelpButton () {
@@ -328,10 +315,6 @@ void SeerImageVisualizerWidget::handleCreateImage (const QByteArray& array) {
         return;
     }
 
-    if (_format == QImage::Format_Invalid) {
-        return;
-    }
-
     // Data is not large enough for requested image dimensions.
     if (_bytes > array.size()) {
         messageLineEdit->setText(QString("%1 memory bytes is not enough for the '%2' image (%3x%4). Need at least %5 bytes.").arg(array.size())
@@ -343,11 +326,121 @@ void SeerImageVisualizerWidget::handleCreateImage (const QByteArray& array) {
     }
 
     // Construct image.
-    QImage image = QImage((const uchar*)array.data(), _width, _height, _format);
+    QImage image = _converter.convert(array.constData(), array.size());
+
+    if (image.isNull()) {
+        messageLineEdit->setText(QString("Can't make the '%1' image (%2x%3).").arg(_formatName).arg(_width).arg(_height));
+        return;
+    }
+
+    // Say what was scaled to black and white.
+    if (_converter.isNormalized()) {
+        messageLineEdit->setText(QString("Values %1 to %2 are shown as black to white.").arg(_converter.minimum()).arg(_converter.maximum()));
+    }
+
+    // Kept for refreshes, which redo just the rows that change.
+    _image = image;
 
     imageViewer->setImage(image);
 }
 
+void SeerImageVisualizerWidget::handleReadUpdated () {
+
+    // A refresh. Redraw just the rows that changed, if any.
+    if (_partialUpdate) {
+
+        if (_changedFirstRow >= 0) {
+
+            const QByteArray& data = _memoryReader->data();
+
+            if (_converter.convertRows(data.constData(), data.size(), _image, &_changedFirstRow, &_changedLastRow)) {
+                imageViewer->updateImage(_image, _changedFirstRow, _changedLastRow);
+            }
+        }
+
+        _changedFirstRow = -1;
+        _changedLastRow  = -1;
+
+        return;
+    }
+
+    handleCreateImage(_memoryReader->data());
+
+    // Keep the first read error showing.
+    if (_readMessage != "") {
+        messageLineEdit->setText(_readMessage);
+    }
+}
+
+void SeerImageVisualizerWidget::handleChunkFailed (int position, int length, QString message) {
+
+    // Keep what was read before. The program may be running.
+    if (_partialUpdate) {
+        return;
+    }
+
+    // The parts that couldn't be read stay black.
+    if (_readMessage == "") {
+        _readMessage = QString("Can't read %1 bytes at offset %2. %3").arg(length).arg(position).arg(message);
+        messageLineEdit->setText(_readMessage);
+    }
+}
+
+void SeerImageVisualizerWidget::handleReadProgress (int done, int count) {
+
+    // Small reads come in at once. Don't flash the progress bar for them.
+    if (done >= count) {
+        return;
+    }
+
+    readProgressBar->setMaximum(count);
+    readProgressBar->setValue(done);
+    readProgressBar->show();
+    cancelToolButton->show();
+}
+
+void SeerImageVisualizerWidget::handleReadFinished () {
+
+    readProgressBar->hide();
+    cancelToolButton->hide();
+}
+
+void SeerImageVisualizerWidget::handleRefreshStarted () {
+
+    _partialUpdate   = true;
+    _changedFirstRow = -1;
+    _changedLastRow  = -1;
+}
+
+void SeerImageVisualizerWidget::handleMemoryChanged (int position, int length) {
+
+    // The rows the changed bytes are in. The planes of a YUV image each have some.
+    int firstRow;
+    int lastRow;
+
+    if (_converter.rowsForBytes(position, length, &firstRow, &lastRow) == false) {
+        return;
+    }
+
+    if (_changedFirstRow < 0) {
+        _changedFirstRow = firstRow;
+        _changedLastRow  = lastRow;
+    }else{
+        _changedFirstRow = qMin(_changedFirstRow, firstRow);
+        _changedLastRow  = qMax(_changedLastRow,  lastRow);
+    }
+}
+
+void SeerImageVisualizerWidget::handleAutoRefreshChanged () {
+
+    // Besides each stop, refresh every so often if there's an interval.
+    if (autoRefreshCheckBox->isChecked()) {
+        _memoryReader->setRefreshInterval(refreshIntervalSpinBox->value());
+    }else{
+        _memoryReader->setRefreshInterval(0);
+    }
+}
+
 void SeerImageVisualizerWidget::writeSettings() {
 
     QSettings settings;
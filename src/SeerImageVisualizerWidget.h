@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QtWidgets/QWidget>
+#include "SeerMemoryReader.h"
+#include "SeerImageConverter.h"
 #include "ui_SeerImageVisualizerWidget.h"
 
 class SeerImageVisualizerWidget : public QWidget, protected Ui::SeerImageVisualizerWidgetForm {
@@ -18,7 +20,7 @@ class SeerImageVisualizerWidget : public QWidget, protected Ui::SeerImageVisuali
 
     signals:
         void                evaluateVariableExpression          (int expressionid, QString expression);
-        void                evaluateMemoryExpression            (int expressionid, QString address, int count);
+        void                evaluateMemoryExpression            (SeerMemoryReader* reader, int expressionid, QString address, int count);
 
     public slots:
         void                handleText                          (const QString& text);
@@ -31,18 +33,31 @@ class SeerImageVisualizerWidget : public QWidget, protected Ui::SeerImageVisuali
         void                handlePrintButton                   ();
         void                handleSaveButton                    ();
         void                handleCreateImage                   (const QByteArray& array);
+        void                handleReadUpdated                   ();
+        void                handleChunkFailed                   (int position, int length, QString message);
+        void                handleReadProgress                  (int done, int count);
+        void                handleReadFinished                  ();
+        void                handleRefreshStarted                ();
+        void                handleMemoryChanged                 (int position, int length);
+        void                handleAutoRefreshChanged            ();
 
     protected:
+        void                autoRefresh                         ();
         void                writeSettings                       ();
         void                readSettings                        ();
         void                resizeEvent                         (QResizeEvent* event);
 
     private:
         int                 _variableId;
-        int                 _memoryId;
+        SeerMemoryReader*   _memoryReader;
+        QString             _readMessage;
+        bool                _partialUpdate;
+        int                 _changedFirstRow;
+        int                 _changedLastRow;
 
         QString             _formatName;
-        QImage::Format      _format;
+        SeerImageConverter  _converter;
+        QImage              _image;
         int                 _width;
         int                 _height;
         int                 _bytes;
@@ -0,0 +1,899 @@
+#include "SeerLogView.h"
+#include <QtWidgets/QScrollBar>
+#include <QtWidgets/QApplication>
+#include <QtGui/QPainter>
+#include <QtGui/QPaintEvent>
+#include <QtGui/QMouseEvent>
+#include <QtGui/QKeyEvent>
+#include <QtGui/QClipboard>
+#include <QtGui/QFontMetrics>
+#include <QtCore/QTemporaryFile>
+#include <QtCore/QByteArray>
+#include <QtCore/QStringMatcher>
+#include <QtCore/QDebug>
+#include <algorithm>
+
+namespace {
+
+    const int DefaultMaximumLineCount = 100000;
+    const int TabSize                 = 8;
+
+    // appendText() breaks a line that's longer than this. Output without newlines
+    // doesn't grow the unfinished line, or the work on it each frame, without end.
+    const int MaximumLineLength       = 64 * 1024;
+
+    //
+    // QPainter doesn't do tabs. Expand them to the next tab stop.
+    //
+    QString expandTabs (const QString& text) {
+
+        if (text.contains('\t') == false) {
+            return text;
+        }
+
+        QString expanded;
+        expanded.reserve(text.size() + TabSize * 4);
+
+        for (QChar c : text) {
+            if (c == '\t') {
+                expanded.append(QString(TabSize - expanded.size() % TabSize, ' '));
+            }else{
+                expanded.append(c);
+            }
+        }
+
+        return expanded;
+    }
+}
+
+SeerLogView::SeerLogView (QWidget* parent) : QAbstractScrollArea(parent) {
+
+    _maxLines       = DefaultMaximumLineCount;
+    _firstLine      = 0;
+    _nextLine       = 0;
+    _dropped        = 0;
+    _partialColumn  = 0;
+    _partialChanged = false;
+    _lastLineOpen   = false;
+    _rowsStart      = 0;
+    _history        = 0;
+    _wrap           = false;
+    _maxLength      = 0;
+    _currentLine    = -1;
+    _anchorLine     = -1;
+
+    setFocusPolicy(Qt::StrongFocus);
+
+    // Lines appended before control gets back to the event loop are added together.
+    _flushTimer.setSingleShot(true);
+    _flushTimer.setInterval(0);
+
+    QObject::connect(&_flushTimer, &QTimer::timeout, this, &SeerLogView::flush);
+
+    // Measure the font.
+    changeEvent(0);
+}
+
+SeerLogView::~SeerLogView () {
+
+    delete _history;
+}
+
+void SeerLogView::appendLine (const QString& text, QChar recordClass) {
+
+    Line line;
+    line.text        = expandTabs(text);
+    line.recordClass = recordClass;
+
+    addPending(line);
+
+    if (_flushTimer.isActive() == false) {
+        _flushTimer.start();
+    }
+}
+
+void SeerLogView::appendText (const QString& text) {
+
+    int start = 0;
+
+    while (start < text.size()) {
+
+        int end  = start;
+        int room = MaximumLineLength - _partialColumn;
+
+        while (end < text.size() && end - start < room && text[end] != '\n' && text[end] != '\r') {
+            end++;
+        }
+
+        // Write over what's there, after a '\r'.
+        if (end > start) {
+            _partial.replace(_partialColumn, end - start, text.mid(start, end - start));
+            _partialColumn += end - start;
+        }
+
+        if (end < text.size()) {
+
+            if (text[end] == '\r') {
+
+                end++;
+
+            }else{
+
+                // A '\n', or the line is too long. Then it carries on in the next one.
+                if (text[end] == '\n') {
+                    end++;
+                }
+
+                Line line;
+                line.text = expandTabs(_partial);
+
+                _partial.clear();
+
+                addPending(line);
+            }
+
+            _partialColumn = 0;
+        }
+
+        start = end;
+    }
+
+    _partialChanged = true;
+
+    if (_flushTimer.isActive() == false) {
+        _flushTimer.start();
+    }
+}
+
+void SeerLogView::clear () {
+
+    _flushTimer.stop();
+
+    _ring = QVector<Line>();
+    _pending.clear();
+    _partial.clear();
+    _rows.clear();
+
+    _firstLine      = 0;
+    _nextLine       = 0;
+    _dropped        = 0;
+    _partialColumn  = 0;
+    _partialChanged = false;
+    _lastLineOpen   = false;
+    _rowsStart      = 0;
+    _maxLength      = 0;
+    _currentLine    = -1;
+    _anchorLine     = -1;
+
+    if (_history) {
+        _history->resize(0);
+        _history->seek(0);
+    }
+
+    updateScrollBars();
+
+    viewport()->update();
+}
+
+QString SeerLogView::toPlainText () const {
+
+    // The lines that are shown.
+    QString text;
+
+    for (int row=0; row<rowCount(); row++) {
+        text += line(rowLine(row)).text;
+        text += '\n';
+    }
+
+    return text;
+}
+
+bool SeerLogView::write (QIODevice* device) {
+
+    // All of it. The history, then what's in the ring, whatever is hidden.
+    flush();
+
+    bool ok = true;
+
+    if (_history) {
+
+        _history->flush();
+        _history->seek(0);
+
+        QByteArray chunk;
+
+        while (ok && (chunk = _history->read(1024*1024)).isEmpty() == false) {
+            ok = (device->write(chunk) == chunk.size());
+        }
+
+        _history->seek(_history->size());
+    }
+
+    for (qint64 number=_firstLine; ok && number<_nextLine; number++) {
+
+        QByteArray bytes = line(number).text.toUtf8();
+        bytes += '\n';
+
+        ok = (device->write(bytes) == bytes.size());
+    }
+
+    return ok;
+}
+
+void SeerLogView::setMaximumLineCount (int count) {
+
+    count = qMax(1, count);
+
+    if (count == _maxLines) {
+        return;
+    }
+
+    flush();
+
+    // Keep the newest lines that fit.
+    qint64 first = qMax(_firstLine, _nextLine - count);
+
+    for (qint64 number=_firstLine; number<first; number++) {
+        if (_history) {
+            _history->write(line(number).text.toUtf8() + '\n');
+        }
+    }
+
+    // Number the lines that are kept from 0 again. The ring grows from there.
+    QVector<Line> ring;
+    ring.reserve(int(_nextLine - first));
+
+    for (qint64 number=first; number<_nextLine; number++) {
+        ring.append(line(number));
+    }
+
+    _ring.swap(ring);
+
+    for (qint64& number : _rows) {
+        number -= first;
+    }
+
+    if (_currentLine >= 0 && qMax(_anchorLine, _currentLine) >= first) {
+        _anchorLine  = qMax(qint64(0), _anchorLine  - first);
+        _currentLine = qMax(qint64(0), _currentLine - first);
+    }else{
+        _anchorLine  = -1;
+        _currentLine = -1;
+    }
+
+    _maxLines  = count;
+    _dropped  += first - _firstLine;
+    _nextLine -= first;
+    _firstLine = 0;
+
+    rebuildRows();
+}
+
+int SeerLogView::maximumLineCount () const {
+
+    return _maxLines;
+}
+
+int SeerLogView::lineCount () const {
+
+    return int(_nextLine - _firstLine);
+}
+
+quint64 SeerLogView::droppedLineCount () const {
+
+    return _dropped;
+}
+
+void SeerLogView::setFlushInterval (int msec) {
+
+    _flushTimer.setInterval(msec);
+}
+
+int SeerLogView::flushInterval () const {
+
+    return _flushTimer.interval();
+}
+
+bool SeerLogView::find (const QString& text, bool backward, Qt::CaseSensitivity cs) {
+
+    flush();
+
+    int rows = rowCount();
+
+    if (text == "" || rows == 0) {
+        return false;
+    }
+
+    // Start from the current line, or from an end if there isn't one.
+    int current = backward ? rows : -1;
+
+    if (_currentLine >= _firstLine) {
+
+        QVector<qint64>::const_iterator begin = _rows.constBegin() + _rowsStart;
+
+        current = std::lower_bound(begin, _rows.constEnd(), _currentLine) - begin;
+
+        // Hidden. 'current' is the row after it.
+        if ((current == rows || rowLine(current) != _currentLine) && backward == false) {
+            current--;
+        }
+    }
+
+    QStringMatcher matcher(text, cs);
+
+    for (int i=1; i<=rows; i++) {
+
+        int row    = ((current + (backward ? -i : i)) % rows + rows) % rows;
+        int column = matcher.indexIn(line(rowLine(row)).text);
+
+        if (column < 0) {
+            continue;
+        }
+
+        _anchorLine  = rowLine(row);
+        _currentLine = _anchorLine;
+
+        scrollToRow(row);
+
+        // And across, to the match.
+        if (_wrap == false) {
+
+            int x = column * _charWidth;
+
+            if (x < horizontalScrollBar()->value() || x + text.size() * _charWidth > horizontalScrollBar()->value() + viewport()->width()) {
+                horizontalScrollBar()->setValue(x - viewport()->width() / 4);
+            }
+        }
+
+        viewport()->update();
+
+        return true;
+    }
+
+    return false;
+}
+
+void SeerLogView::setHistoryEnabled (bool flag) {
+
+    if (flag == isHistoryEnabled()) {
+        return;
+    }
+
+    if (flag == false) {
+        delete _history;
+        _history = 0;
+        return;
+    }
+
+    _history = new QTemporaryFile;
+
+    if (_history->open() == false) {
+
+        qWarning() << "Can't create a history file for the log:" << _history->errorString();
+
+        delete _history;
+        _history = 0;
+    }
+}
+
+bool SeerLogView::isHistoryEnabled () const {
+
+    return _history != 0;
+}
+
+void SeerLogView::setClassVisible (QChar recordClass, bool flag) {
+
+    if (recordClass.isNull() || flag == isClassVisible(recordClass)) {
+        return;
+    }
+
+    if (flag) {
+        _hiddenClasses.remove(recordClass);
+    }else{
+        _hiddenClasses.append(recordClass);
+    }
+
+    rebuildRows();
+}
+
+bool SeerLogView::isClassVisible (QChar recordClass) const {
+
+    return recordClass.isNull() || _hiddenClasses.contains(recordClass) == false;
+}
+
+void SeerLogView::setWrapEnabled (bool flag) {
+
+    if (flag == _wrap) {
+        return;
+    }
+
+    bool follow = verticalScrollBar()->value() >= verticalScrollBar()->maximum();
+
+    _wrap = flag;
+
+    updateScrollBars();
+
+    if (follow) {
+        scrollToEnd();
+    }
+
+    viewport()->update();
+}
+
+bool SeerLogView::isWrapEnabled () const {
+
+    return _wrap;
+}
+
+void SeerLogView::setPlaceholderText (const QString& text) {
+
+    _placeholderText = text;
+
+    viewport()->update();
+}
+
+const QString& SeerLogView::placeholderText () const {
+
+    return _placeholderText;
+}
+
+void SeerLogView::scrollToEnd () {
+
+    verticalScrollBar()->setValue(verticalScrollBar()->maximum());
+}
+
+void SeerLogView::copy () {
+
+    if (_currentLine < 0) {
+        return;
+    }
+
+    // Copy the shown lines the selection covers.
+    qint64 first = qMax(qMin(_anchorLine, _currentLine), _firstLine);
+    qint64 last  = qMin(qMax(_anchorLine, _currentLine), _nextLine - 1);
+
+    QString text;
+
+    for (qint64 number=first; number<=last; number++) {
+
+        const Line& l = line(number);
+
+        if (isClassVisible(l.recordClass)) {
+            text += l.text;
+            text += '\n';
+        }
+    }
+
+    QClipboard* clipboard = QGuiApplication::clipboard();
+
+    clipboard->setText(text, QClipboard::Clipboard);
+    clipboard->setText(text, QClipboard::Selection);
+}
+
+void SeerLogView::selectAll () {
+
+    if (_nextLine == _firstLine) {
+        return;
+    }
+
+    _anchorLine  = _firstLine;
+    _currentLine = _nextLine - 1;
+
+    viewport()->update();
+}
+
+void SeerLogView::paintEvent (QPaintEvent* event) {
+
+    Q_UNUSED(event);
+
+    QPainter painter(viewport());
+
+    painter.fillRect(viewport()->rect(), palette().base());
+
+    int rows = rowCount();
+
+    if (rows == 0) {
+
+        if (_placeholderText != "") {
+            painter.setPen(palette().color(QPalette::Disabled, QPalette::Text));
+            painter.drawText(0, _ascent, _placeholderText);
+        }
+
+        return;
+    }
+
+    int    height      = viewport()->height();
+    int    cols        = columns();
+    int    firstColumn = horizontalScrollBar()->value() / _charWidth;
+    int    x           = -(horizontalScrollBar()->value() % _charWidth);
+    qint64 selectStart = qMin(_anchorLine, _currentLine);
+    qint64 selectEnd   = qMax(_anchorLine, _currentLine);
+    int    y           = 0;
+
+    for (int row=verticalScrollBar()->value(); row<rows && y<height; row++) {
+
+        qint64      number   = rowLine(row);
+        const Line& l        = line(number);
+        bool        selected = (_currentLine >= 0 && number >= selectStart && number <= selectEnd);
+
+        if (selected) {
+            painter.fillRect(0, y, viewport()->width(), qMin(lineRows(l) * _lineHeight, height - y), palette().highlight());
+            painter.setPen(palette().highlightedText().color());
+        }else{
+            painter.setPen(palette().text().color());
+        }
+
+        // Only the part of the line that can be seen is drawn. Lines can be very long.
+        if (_wrap) {
+
+            for (int r=0; r<lineRows(l) && y<height; r++) {
+                painter.drawText(0, y + _ascent, l.text.mid(r * cols, cols));
+                y += _lineHeight;
+            }
+
+        }else{
+            painter.drawText(x, y + _ascent, l.text.mid(firstColumn, cols + 2));
+            y += _lineHeight;
+        }
+    }
+}
+
+void SeerLogView::resizeEvent (QResizeEvent* event) {
+
+    bool follow = verticalScrollBar()->value() >= verticalScrollBar()->maximum();
+
+    QAbstractScrollArea::resizeEvent(event);
+
+    updateScrollBars();
+
+    if (follow) {
+        scrollToEnd();
+    }
+}
+
+void SeerLogView::mousePressEvent (QMouseEvent* event) {
+
+    if (event->button() != Qt::LeftButton) {
+        QAbstractScrollArea::mousePressEvent(event);
+        return;
+    }
+
+    setCurrentLine(lineAt(event->pos()), event->modifiers().testFlag(Qt::ShiftModifier));
+}
+
+void SeerLogView::mouseMoveEvent (QMouseEvent* event) {
+
+    if (event->buttons().testFlag(Qt::LeftButton) == false) {
+        QAbstractScrollArea::mouseMoveEvent(event);
+        return;
+    }
+
+    qint64 number = lineAt(event->pos());
+
+    if (number >= 0) {
+        setCurrentLine(number, true);
+    }
+}
+
+void SeerLogView::keyPressEvent (QKeyEvent* event) {
+
+    if (event->matches(QKeySequence::Copy)) {
+        copy();
+        return;
+    }
+
+    if (event->matches(QKeySequence::SelectAll)) {
+        selectAll();
+        return;
+    }
+
+    QScrollBar* scrollBar = verticalScrollBar();
+
+    switch (event->key()) {
+        case Qt::Key_Up:        scrollBar->triggerAction(QAbstractSlider::SliderSingleStepSub); break;
+        case Qt::Key_Down:      scrollBar->triggerAction(QAbstractSlider::SliderSingleStepAdd); break;
+        case Qt::Key_PageUp:    scrollBar->triggerAction(QAbstractSlider::SliderPageStepSub);   break;
+        case Qt::Key_PageDown:  scrollBar->triggerAction(QAbstractSlider::SliderPageStepAdd);   break;
+        case Qt::Key_Home:      scrollBar->triggerAction(QAbstractSlider::SliderToMinimum);     break;
+        case Qt::Key_End:       scrollBar->triggerAction(QAbstractSlider::SliderToMaximum);     break;
+        default:
+            QAbstractScrollArea::keyPressEvent(event);
+            return;
+    }
+}
+
+void SeerLogView::changeEvent (QEvent* event) {
+
+    if (event) {
+        QAbstractScrollArea::changeEvent(event);
+
+        if (event->type() != QEvent::FontChange) {
+            return;
+        }
+    }
+
+    QFontMetrics metrics(font());
+
+    _charWidth  = qMax(1, metrics.horizontalAdvance(QLatin1Char('9')));
+    _lineHeight = qMax(1, metrics.height());
+    _ascent     = metrics.ascent();
+
+    viewport()->setFont(font());
+
+    updateScrollBars();
+}
+
+void SeerLogView::flush () {
+
+    if (_pending.isEmpty() && _partialChanged == false) {
+        return;
+    }
+
+    // Stay at the end, if that's where we are.
+    bool follow = verticalScrollBar()->value() >= verticalScrollBar()->maximum();
+
+    // Take back the line that wasn't ended. It's added again, as it is now.
+    if (_lastLineOpen) {
+
+        _nextLine--;
+
+        if (rowCount() > 0 && _rows.last() == _nextLine) {
+            _rows.removeLast();
+        }
+
+        _lastLineOpen = false;
+    }
+
+    QByteArray spilled;
+
+    for (const Line& l : _pending) {
+        addLine(l, spilled);
+    }
+
+    _pending.clear();
+
+    if (_partial.isEmpty() == false) {
+
+        Line l;
+        l.text = expandTabs(_partial);
+
+        addLine(l, spilled);
+
+        _lastLineOpen = true;
+    }
+
+    _partialChanged = false;
+
+    if (spilled.isEmpty() == false) {
+        _history->write(spilled);
+    }
+
+    // Forget the rows of the dropped lines. Keep what's on the screen where it is.
+    int dropped = 0;
+
+    while (_rowsStart < _rows.size() && _rows[_rowsStart] < _firstLine) {
+        _rowsStart++;
+        dropped++;
+    }
+
+    if (_rowsStart > 4096 && _rowsStart > _rows.size() / 2) {
+        _rows.remove(0, _rowsStart);
+        _rowsStart = 0;
+    }
+
+    if (_currentLine >= 0 && qMax(_anchorLine, _currentLine) < _firstLine) {
+        _currentLine = -1;
+        _anchorLine  = -1;
+    }
+
+    int value = verticalScrollBar()->value();
+
+    updateScrollBars();
+
+    if (follow) {
+        scrollToEnd();
+    }else{
+        verticalScrollBar()->setValue(value - dropped);
+    }
+
+    viewport()->update();
+}
+
+void SeerLogView::addPending (const Line& l) {
+
+    _pending.append(l);
+
+    //
+    // No more than the ring holds is kept waiting. At that point every line in the ring
+    // would be dropped by the next flush anyway, so do it now. The dropped lines are
+    // counted, and go to the history if there is one, in order.
+    //
+    if (_pending.size() >= _maxLines) {
+        flush();
+    }
+}
+
+void SeerLogView::addLine (const Line& l, QByteArray& spilled) {
+
+    // Full. Drop the oldest line, into the history if there is one.
+    if (_nextLine - _firstLine == _maxLines) {
+
+        if (_history) {
+            spilled += line(_firstLine).text.toUtf8();
+            spilled += '\n';
+        }
+
+        _firstLine++;
+        _dropped++;
+    }
+
+    // Until it's full, the ring grows by a line at a time.
+    int index = int(_nextLine % _maxLines);
+
+    if (index < _ring.size()) {
+        _ring[index] = l;
+    }else{
+        _ring.append(l);
+    }
+
+    _maxLength = qMax(_maxLength, l.text.size());
+
+    if (isClassVisible(l.recordClass)) {
+        _rows.append(_nextLine);
+    }
+
+    _nextLine++;
+}
+
+const SeerLogView::Line& SeerLogView::line (qint64 number) const {
+
+    return _ring[int(number % _maxLines)];
+}
+
+qint64 SeerLogView::rowLine (int row) const {
+
+    return _rows[_rowsStart + row];
+}
+
+int SeerLogView::rowCount () const {
+
+    return _rows.size() - _rowsStart;
+}
+
+int SeerLogView::lineRows (const Line& line) const {
+
+    if (_wrap == false) {
+        return 1;
+    }
+
+    int cols = columns();
+
+    return qMax(1, (line.text.size() + cols - 1) / cols);
+}
+
+int SeerLogView::columns () const {
+
+    return qMax(1, viewport()->width() / _charWidth);
+}
+
+int SeerLogView::lastTopRow () const {
+
+    //
+    // The top row when the last line is at the bottom. Wrapped lines take more
+    // than one row on the screen, so count back from the end.
+    //
+    int rows   = rowCount();
+    int height = qMax(1, viewport()->height() / _lineHeight);
+
+    if (_wrap == false) {
+        return qMax(0, rows - height);
+    }
+
+    int used = 0;
+    int row  = rows;
+
+    while (row > 0) {
+
+        int n = lineRows(line(rowLine(row - 1)));
+
+        if (used + n > height) {
+            break;
+        }
+
+        used += n;
+        row--;
+    }
+
+    // The last line alone is taller than the view.
+    if (row == rows && rows > 0) {
+        return rows - 1;
+    }
+
+    return row;
+}
+
+qint64 SeerLogView::lineAt (const QPoint& pos) const {
+
+    int rows = rowCount();
+    int y    = 0;
+
+    for (int row=verticalScrollBar()->value(); row<rows && y<viewport()->height(); row++) {
+
+        qint64 number = rowLine(row);
+
+        y += lineRows(line(number)) * _lineHeight;
+
+        if (pos.y() < y) {
+            return number;
+        }
+    }
+
+    return -1;
+}
+
+void SeerLogView::setCurrentLine (qint64 number, bool extendSelection) {
+
+    if (extendSelection == false || _anchorLine < 0) {
+        _anchorLine = number;
+    }
+
+    _currentLine = number;
+
+    if (_currentLine < 0) {
+        _anchorLine = -1;
+    }
+
+    viewport()->update();
+}
+
+void SeerLogView::scrollToRow (int row) {
+
+    int visibleRows = qMax(1, viewport()->height() / _lineHeight);
+    int value       = verticalScrollBar()->value();
+
+    if (row < value || row >= value + visibleRows) {
+        verticalScrollBar()->setValue(row - visibleRows / 2);
+    }
+}
+
+void SeerLogView::rebuildRows () {
+
+    // Keep the line at the top, at the top.
+    qint64 topLine = rowCount() > 0 ? rowLine(qMin(verticalScrollBar()->value(), rowCount() - 1)) : -1;
+    bool   follow  = verticalScrollBar()->value() >= verticalScrollBar()->maximum();
+
+    _rows.clear();
+    _rowsStart = 0;
+
+    for (qint64 number=_firstLine; number<_nextLine; number++) {
+        if (isClassVisible(line(number).recordClass)) {
+            _rows.append(number);
+        }
+    }
+
+    updateScrollBars();
+
+    if (follow || topLine < 0) {
+        scrollToEnd();
+    }else{
+        verticalScrollBar()->setValue(std::lower_bound(_rows.begin(), _rows.end(), topLine) - _rows.begin());
+    }
+
+    viewport()->update();
+}
+
+void SeerLogView::updateScrollBars () {
+
+    int visibleRows = qMax(1, viewport()->height() / _lineHeight);
+
+    verticalScrollBar()->setRange(0, lastTopRow());
+    verticalScrollBar()->setPageStep(visibleRows);
+    verticalScrollBar()->setSingleStep(1);
+
+    int width = _wrap ? 0 : _maxLength * _charWidth;
+
+    horizontalScrollBar()->setRange(0, qMax(0, width - viewport()->width()));
+    horizontalScrollBar()->setPageStep(viewport()->width());
+    horizontalScrollBar()->setSingleStep(_charWidth);
+}
+
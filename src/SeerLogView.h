@@ -0,0 +1,134 @@
+#pragma once
+
+#include <QtWidgets/QAbstractScrollArea>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <QtCore/QByteArray>
+#include <QtCore/QTimer>
+
+class QIODevice;
+class QTemporaryFile;
+
+//
+// Custom painted, line based view of a log.
+//
+// Lines are kept in a ring of a fixed number of lines. Once it's full, each new line
+// drops the oldest one. If the history is on, the dropped lines are written to a
+// temporary file, so the whole log can still be saved. Only the lines that can be
+// seen are drawn, so the size of the log doesn't matter.
+//
+// Appended lines are held until control gets back to the event loop. Then they're
+// added in one go, with one scroll and one repaint, however many there were. No more
+// lines than the ring holds are held. Past that, they're added straight away.
+//
+// appendText() is for a terminal's output. It takes text as it comes, '\n' ends a
+// line and '\r' goes back to the start of it. The line that isn't ended yet is shown
+// as the last line. A line that gets very long without a '\n' is broken in two.
+// Don't mix it with appendLine().
+//
+// Each line can have a class. For gdb records, that's the record's first character
+// ('~', '&', '@', '^', '*', '='). Hiding a class just changes which lines are counted
+// as rows. Nothing is reformatted.
+//
+// The ring only grows as lines come in, so a large maximum costs nothing until it's
+// used. find() looks through the lines themselves, not a laid out document.
+//
+
+class SeerLogView : public QAbstractScrollArea {
+
+    Q_OBJECT
+
+    public:
+        explicit SeerLogView (QWidget* parent = 0);
+       ~SeerLogView ();
+
+        void                        appendLine                          (const QString& text, QChar recordClass = QChar());
+        void                        appendText                          (const QString& text);
+        void                        clear                               ();
+
+        QString                     toPlainText                         () const;
+        bool                        write                               (QIODevice* device);
+
+        void                        setMaximumLineCount                 (int count);
+        int                         maximumLineCount                    () const;
+        int                         lineCount                           () const;
+        quint64                     droppedLineCount                    () const;
+
+        void                        setFlushInterval                    (int msec);
+        int                         flushInterval                       () const;
+
+        bool                        find                                (const QString& text, bool backward, Qt::CaseSensitivity cs = Qt::CaseInsensitive);
+
+        void                        setHistoryEnabled                   (bool flag);
+        bool                        isHistoryEnabled                    () const;
+
+        void                        setClassVisible                     (QChar recordClass, bool flag);
+        bool                        isClassVisible                      (QChar recordClass) const;
+
+        void                        setWrapEnabled                      (bool flag);
+        bool                        isWrapEnabled                       () const;
+
+        void                        setPlaceholderText                  (const QString& text);
+        const QString&              placeholderText                     () const;
+
+    public slots:
+        void                        scrollToEnd                         ();
+        void                        copy                                ();
+        void                        selectAll                           ();
+
+    protected:
+        void                        paintEvent                          (QPaintEvent* event);
+        void                        resizeEvent                         (QResizeEvent* event);
+        void                        mousePressEvent                     (QMouseEvent* event);
+        void                        mouseMoveEvent                      (QMouseEvent* event);
+        void                        keyPressEvent                       (QKeyEvent* event);
+        void                        changeEvent                         (QEvent* event);
+
+    private slots:
+        void                        flush                               ();
+
+    private:
+        struct Line {
+            QString                 text;
+            QChar                   recordClass;
+        };
+
+        void                        addPending                          (const Line& line);
+        void                        addLine                             (const Line& line, QByteArray& spilled);
+        const Line&                 line                                (qint64 number) const;
+        qint64                      rowLine                             (int row) const;
+        int                         rowCount                            () const;
+        int                         lineRows                            (const Line& line) const;
+        int                         columns                             () const;
+        int                         lastTopRow                          () const;
+        qint64                      lineAt                              (const QPoint& pos) const;
+        void                        setCurrentLine                      (qint64 number, bool extendSelection);
+        void                        scrollToRow                         (int row);
+        void                        rebuildRows                         ();
+        void                        updateScrollBars                    ();
+
+        QVector<Line>               _ring;          // Line 'n' is at n % '_maxLines'.
+        int                         _maxLines;
+        qint64                      _firstLine;     // The oldest line in the ring.
+        qint64                      _nextLine;      // The number the next line gets.
+        quint64                     _dropped;
+        QVector<Line>               _pending;       // Appended, not added yet.
+        QString                     _partial;       // appendText()'s line that isn't ended yet.
+        int                         _partialColumn;
+        bool                        _partialChanged;
+        bool                        _lastLineOpen;  // The last line in the ring is '_partial'.
+        QTimer                      _flushTimer;
+        QVector<qint64>             _rows;          // The lines that are shown, from '_rowsStart' on.
+        int                         _rowsStart;
+        QString                     _hiddenClasses;
+        QTemporaryFile*             _history;
+        bool                        _wrap;
+        int                         _maxLength;
+        QString                     _placeholderText;
+        qint64                      _currentLine;
+        qint64                      _anchorLine;
+        int                         _charWidth;
+        int                         _lineHeight;
+        int                         _ascent;
+};
+
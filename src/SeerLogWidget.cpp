@@ -1,13 +1,15 @@
 #include "SeerLogWidget.h"
-#include <QtWidgets/QTextEdit>
 #include <QtWidgets/QCheckBox>
+#include <QtWidgets/QMenu>
+#include <QAction>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QScrollBar>
 #include <QtPrintSupport/QPrinter>
 #include <QtPrintSupport/QPrintDialog>
 #include <QtGui/QFont>
-#include <QtCore/QTextStream>
+#include <QtGui/QTextDocument>
+#include <QtCore/QFile>
 #include <QtCore/QDebug>
 
 SeerLogWidget::SeerLogWidget (QWidget* parent) : QWidget(parent) {
@@ -20,17 +22,24 @@ SeerLogWidget::SeerLogWidget (QWidget* parent) : QWidget(parent) {
     font.setFixedPitch(true);
     font.setStyleHint(QFont::TypeWriter);
 
-    textEdit->setReadOnly(true);
-    textEdit->setFont(font);
-    textEdit->setLineWrapMode(QTextEdit::NoWrap);   // No wrap
+    logView->setFont(font);
+    logView->setWrapEnabled(false);                 // No wrap
     wrapTextCheckBox->setCheckState(Qt::Unchecked); // No wrap
 
+    // The record classes to filter on are added by the kind of log it is.
+    _filterMenu = new QMenu(this);
+
+    filterButton->setMenu(_filterMenu);
+    filterButton->hide();
+
     // Connect things.
     QObject::connect(clearButton,       &QPushButton::clicked,      this,  &SeerLogWidget::handleClearButton);
     QObject::connect(printButton,       &QPushButton::clicked,      this,  &SeerLogWidget::handlePrintButton);
     QObject::connect(saveButton,        &QPushButton::clicked,      this,  &SeerLogWidget::handleSaveButton);
     QObject::connect(wrapTextCheckBox,  &QCheckBox::clicked,        this,  &SeerLogWidget::handleWrapTextCheckBox);
     QObject::connect(enableCheckBox,    &QCheckBox::clicked,        this,  &SeerLogWidget::handleEnableCheckBox);
+    QObject::connect(historyCheckBox,   &QCheckBox::clicked,        this,  &SeerLogWidget::handleHistoryCheckBox);
+    QObject::connect(_filterMenu,       &QMenu::triggered,          this,  &SeerLogWidget::handleFilterMenu);
 }
 
 SeerLogWidget::~SeerLogWidget () {
@@ -38,8 +47,8 @@ SeerLogWidget::~SeerLogWidget () {
 
 void SeerLogWidget::processText (const QString& text) {
 
-    // Add text to the end of the document.
-    textEdit->append(text);
+    // Add text to the end of the log.
+    logView->appendLine(text);
 }
 
 bool SeerLogWidget::isLogEnabled () const {
@@ -54,17 +63,24 @@ void SeerLogWidget::setLogEnabled (bool flag) {
 
 void SeerLogWidget::moveToEnd () {
 
-    // Move to the end and then to the beginning of that line.
-    QTextCursor cursor = textEdit->textCursor();
-    textEdit->moveCursor(QTextCursor::End,          QTextCursor::MoveAnchor);
-    textEdit->moveCursor(QTextCursor::StartOfBlock, QTextCursor::MoveAnchor);
-
-    textEdit->verticalScrollBar()->setValue(textEdit->verticalScrollBar()->maximum());
+    logView->scrollToEnd();
 }
 
 void SeerLogWidget::setPlaceholderText (const QString& text) {
 
-    textEdit->setPlaceholderText(text);
+    logView->setPlaceholderText(text);
+}
+
+void SeerLogWidget::addRecordClass (QChar recordClass, const QString& name) {
+
+    QAction* action = _filterMenu->addAction(QString("%1 %2").arg(recordClass).arg(name));
+
+    action->setCheckable(true);
+    action->setChecked(logView->isClassVisible(recordClass));
+    action->setData(QVariant(recordClass));
+
+    // Nothing to filter with just one.
+    filterButton->setVisible(_filterMenu->actions().size() > 1);
 }
 
 void SeerLogWidget::handleText (const QString& text) {
@@ -74,15 +90,12 @@ void SeerLogWidget::handleText (const QString& text) {
         return;
     }
 
-    // Process the text.
+    // Process the text. The log stays at the end, if it's there, once the lines are added.
     processText(text);
-
-    // Move to the end of the document.
-    moveToEnd();
 }
 
 void SeerLogWidget::handleClearButton () {
-    textEdit->clear();
+    logView->clear();
 }
 
 void SeerLogWidget::handlePrintButton () {
@@ -95,9 +108,12 @@ void SeerLogWidget::handlePrintButton () {
         return;
     }
 
-    QTextDocument* document = textEdit->document();
+    // The lines that are shown.
+    QTextDocument document;
+    document.setDefaultFont(logView->font());
+    document.setPlainText(logView->toPlainText());
 
-    document->print(&printer);
+    document.print(&printer);
 }
 
 void SeerLogWidget::handleSaveButton () {
@@ -126,10 +142,8 @@ void SeerLogWidget::handleSaveButton () {
 
     QFile file(files[0]);
 
-    if (file.open(QIODevice::ReadWrite)) {
-        QTextStream stream(&file);
-        stream << textEdit->toPlainText();
-        file.flush();
+    // All of it, with the history, if it's kept.
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate) && logView->write(&file)) {
         file.close();
 
     }else{
@@ -141,9 +155,9 @@ void SeerLogWidget::handleSaveButton () {
 void SeerLogWidget::handleWrapTextCheckBox () {
 
     if (wrapTextCheckBox->checkState() == Qt::Unchecked) {
-        textEdit->setLineWrapMode(QTextEdit::NoWrap);       // No wrap
+        logView->setWrapEnabled(false);     // No wrap
     }else{
-        textEdit->setLineWrapMode(QTextEdit::WidgetWidth);  // Wrap at end of widget
+        logView->setWrapEnabled(true);      // Wrap at end of widget
     }
 }
 
@@ -154,3 +168,19 @@ void SeerLogWidget::handleEnableCheckBox () {
     emit logEnabledChanged(enableCheckBox->isChecked());
 }
 
+void SeerLogWidget::handleHistoryCheckBox () {
+
+    logView->setHistoryEnabled(historyCheckBox->isChecked());
+
+    // No file for it.
+    if (logView->isHistoryEnabled() != historyCheckBox->isChecked()) {
+        historyCheckBox->setChecked(logView->isHistoryEnabled());
+        QMessageBox::critical(this, tr("Error"), tr("Cannot create a file for the log's history."));
+    }
+}
+
+void SeerLogWidget::handleFilterMenu (QAction* action) {
+
+    logView->setClassVisible(action->data().toChar(), action->isChecked());
+}
+
@@ -4,6 +4,9 @@
 #include <QtCore/QString>
 #include "ui_SeerLogWidget.h"
 
+class QMenu;
+class QAction;
+
 class SeerLogWidget : public QWidget, protected Ui::SeerLogWidgetForm {
 
     Q_OBJECT
@@ -18,6 +21,7 @@ class SeerLogWidget : public QWidget, protected Ui::SeerLogWidgetForm {
         void                setLogEnabled               (bool flag);
         void                moveToEnd                   ();
         void                setPlaceholderText          (const QString& text);
+        void                addRecordClass              (QChar recordClass, const QString& name);
 
     signals:
         void                logEnabledChanged           (bool flag);
@@ -29,7 +33,12 @@ class SeerLogWidget : public QWidget, protected Ui::SeerLogWidgetForm {
         void                handleSaveButton            ();
         void                handleWrapTextCheckBox      ();
         void                handleEnableCheckBox        ();
+        void                handleHistoryCheckBox       ();
+        void                handleFilterMenu            (QAction* action);
 
     protected:
+
+    private:
+        QMenu*              _filterMenu;
 };
 
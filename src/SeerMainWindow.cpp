@@ -789,7 +789,7 @@ void SeerMainWindow::handleShowMessage (QString message, int time) {
 
 void SeerMainWindow::handleText (const QString& text) {
 
-    if (text.startsWith("^error,msg=") || text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
+    if (text.startsWith("^error,msg=") || Seer::matchRecord(text, "^error,msg=")) {
 
         // ^error,msg="The program is not being run."
         // ^error,msg="ptrace: No such process."
@@ -924,16 +924,16 @@ void SeerMainWindow::handleText (const QString& text) {
     }else if (text.startsWith("^done,ada-exceptions={") && text.endsWith("}")) {
         return;
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done"))) {
+    }else if (Seer::matchRecord(text, "^done")) {
         return;
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,value="))) {
+    }else if (Seer::matchRecord(text, "^done,value=")) {
         return;
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
+    }else if (Seer::matchRecord(text, "^error,msg=")) {
         return;
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,memory="))) {
+    }else if (Seer::matchRecord(text, "^done,memory=")) {
         return;
 
     }else if (text == "^exit") {
@@ -1230,6 +1230,8 @@ void SeerMainWindow::writeConfigSettings () {
         settings.setValue("handleterminatingexception", gdbWidget->gdbHandleTerminatingException());
         settings.setValue("randomizestartaddress",      gdbWidget->gdbRandomizeStartAddress());
         settings.setValue("enableprettyprinting",       gdbWidget->gdbEnablePrettyPrinting());
+        settings.setValue("commanddepth",               gdbWidget->gdbCommandDepth());
+        settings.setValue("commandtimeout",             gdbWidget->gdbCommandTimeout());
     } settings.endGroup();
 
     settings.beginGroup("rr"); {
@@ -1311,6 +1313,8 @@ void SeerMainWindow::readConfigSettings () {
         gdbWidget->setGdbHandleTerminatingException(settings.value("handleterminatingexception", true).toBool());
         gdbWidget->setGdbRandomizeStartAddress(settings.value("randomizestartaddress", false).toBool());
         gdbWidget->setGdbEnablePrettyPrinting(settings.value("enableprettyprinting", true).toBool());
+        gdbWidget->setGdbCommandDepth(settings.value("commanddepth", 0).toInt());
+        gdbWidget->setGdbCommandTimeout(settings.value("commandtimeout", 30000).toInt());
     } settings.endGroup();
 
     settings.beginGroup("rr"); {
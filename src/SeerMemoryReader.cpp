@@ -0,0 +1,423 @@
+#include "SeerMemoryReader.h"
+#include "GdbMiParser.h"
+#include "SeerUtl.h"
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QDebug>
+#include <cstring>
+
+static QLoggingCategory LC("seer.memoryreader");
+
+SeerMemoryReader::SeerMemoryReader (QObject* parent) : QObject(parent) {
+
+    _id             = 0;
+    _start          = 0;
+    _startOk        = false;
+    _count          = 0;
+    _chunkSize      = 256 * 1024;
+    _pipelineDepth  = 4;
+    _updateInterval = 250;
+    _bytesDone      = 0;
+    _reading        = false;
+    _refreshing     = false;
+
+    _refreshTimer = new QTimer(this);
+
+    QObject::connect(_refreshTimer, &QTimer::timeout,    this, &SeerMemoryReader::refresh);
+}
+
+SeerMemoryReader::~SeerMemoryReader () {
+}
+
+void SeerMemoryReader::setChunkSize (int bytes) {
+
+    _chunkSize = qMax(1, bytes);
+}
+
+int SeerMemoryReader::chunkSize () const {
+
+    return _chunkSize;
+}
+
+void SeerMemoryReader::setPipelineDepth (int depth) {
+
+    _pipelineDepth = qMax(1, depth);
+}
+
+int SeerMemoryReader::pipelineDepth () const {
+
+    return _pipelineDepth;
+}
+
+void SeerMemoryReader::setUpdateInterval (int milliseconds) {
+
+    _updateInterval = qMax(0, milliseconds);
+}
+
+int SeerMemoryReader::updateInterval () const {
+
+    return _updateInterval;
+}
+
+void SeerMemoryReader::setBufferFunction (BufferFunction function) {
+
+    _bufferFunction = function;
+}
+
+void SeerMemoryReader::setRefreshInterval (int milliseconds) {
+
+    // 0 turns it off.
+    if (milliseconds <= 0) {
+        _refreshTimer->stop();
+        return;
+    }
+
+    _refreshTimer->start(milliseconds);
+}
+
+int SeerMemoryReader::refreshInterval () const {
+
+    return _refreshTimer->isActive() ? _refreshTimer->interval() : 0;
+}
+
+void SeerMemoryReader::read (const QString& address, int count) {
+
+    cancel();
+
+    _address    = address;
+    _start      = address.toULongLong(&_startOk, 0);
+    _count      = qMax(0, count);
+    _refreshing = false;
+
+    // Without a buffer function, decode into our own buffer.
+    if (_bufferFunction) {
+        _data = QByteArray();
+    }else{
+        _data = QByteArray(_count, 0);
+    }
+
+    start();
+}
+
+void SeerMemoryReader::refresh () {
+
+    // Nothing to refresh. Or the last read is still going. Don't pile them up.
+    if (_address == "" || _reading) {
+        return;
+    }
+
+    _refreshing = true;
+
+    emit refreshStarted();
+
+    start();
+}
+
+void SeerMemoryReader::start () {
+
+    // A new id, so replies to an older read are ignored.
+    _id        = Seer::createID();
+    _bytesDone = 0;
+    _reading   = true;
+
+    _queued.clear();
+    _inFlight.clear();
+
+    // An address that isn't a number (an expression) can't be split. Read it in one go.
+    int chunkSize = _startOk ? _chunkSize : qMax(1, _count);
+
+    for (int position=0; position<_count; position+=chunkSize) {
+        _queued.append(position);
+    }
+
+    qCDebug(LC) << (_refreshing ? "Refreshing" : "Reading") << _count << "bytes at" << _address << "in" << _queued.size() << "chunks";
+
+    _readTimer.start();
+    _updateTimer.start();
+
+    if (_queued.isEmpty()) {
+        _reading = false;
+        emit finished();
+        return;
+    }
+
+    sendChunks();
+}
+
+void SeerMemoryReader::fetch (int position, int length) {
+
+    // Nothing read, or canceled.
+    if (_id == 0 || length <= 0) {
+        return;
+    }
+
+    // Move the chunks of the range to the front of the queue. They're being looked at.
+    // Ones that are done already (they failed, say) are read again.
+    int chunkSize = _startOk ? _chunkSize : qMax(1, _count);
+    int end       = qMin(position + length, _count);
+
+    QList<int> wanted;
+
+    for (int chunk=(qMax(0, position) / chunkSize) * chunkSize; chunk<end; chunk+=chunkSize) {
+
+        if (_inFlight.contains(chunk)) {
+            continue;
+        }
+
+        if (_queued.removeOne(chunk) == false) {
+            _bytesDone -= chunkLength(chunk);
+        }
+
+        wanted.append(chunk);
+    }
+
+    if (wanted.isEmpty()) {
+        return;
+    }
+
+    _queued = wanted + _queued;
+
+    // The read is over. Read just these chunks, as a read, not a refresh.
+    if (_reading == false) {
+
+        _reading    = true;
+        _refreshing = false;
+
+        _readTimer.start();
+        _updateTimer.start();
+    }
+
+    sendChunks();
+}
+
+bool SeerMemoryReader::isReading () const {
+
+    return _reading;
+}
+
+bool SeerMemoryReader::isRefreshing () const {
+
+    return _reading && _refreshing;
+}
+
+QString SeerMemoryReader::address () const {
+
+    return _address;
+}
+
+int SeerMemoryReader::count () const {
+
+    return _count;
+}
+
+int SeerMemoryReader::bytesDone () const {
+
+    return _bytesDone;
+}
+
+const QByteArray& SeerMemoryReader::data () const {
+
+    return _data;
+}
+
+void SeerMemoryReader::cancel () {
+
+    if (_reading) {
+        qCDebug(LC) << "Canceled" << _address << "with" << _bytesDone << "of" << _count << "bytes done";
+    }
+
+    // Replies for chunks in flight are ignored when they come in.
+    _id      = 0;
+    _reading = false;
+
+    _queued.clear();
+    _inFlight.clear();
+}
+
+bool SeerMemoryReader::handleRecord (int expressionid, const GdbMiRecord& record) {
+
+    // A reply for a read that was canceled, or replaced by a newer one. It's still ours.
+    if (_id == 0 || expressionid != _id || _inFlight.isEmpty()) {
+        return true;
+    }
+
+    int  id       = _id;
+    int  position = _inFlight.takeFirst();
+    int  length   = chunkLength(position);
+    bool done     = record.isRecordClass("done");
+
+    if (done) {
+
+        // 3^done,memory=[{begin="0x0000000000613e70",offset="0x0000000000000000",end="0x0000000000613ed4",contents="000000000000000000000000"}]
+
+        char* buffer = 0;
+
+        if (_bufferFunction) {
+            buffer = _bufferFunction(position, length);
+        }else{
+            buffer = _data.data() + position;
+        }
+
+        if (buffer && _refreshing) {
+
+            // Decode next to the old bytes. Then copy over just the blocks that changed.
+            _scratch.resize(length);
+
+            memcpy(_scratch.data(), buffer, length);
+
+            decodeChunk(record, position, length, _scratch.data());
+            diffChunk(position, length, buffer, _scratch.constData());
+
+            // A slot may have canceled, or started a new read.
+            if (_id != id) {
+                return true;
+            }
+
+        }else{
+            decodeChunk(record, position, length, buffer);
+        }
+
+        emit chunkRead(position, length);
+
+    }else{
+
+        // 3^error,msg="Unable to read memory."
+        // An invalid record is a command that timed out.
+        QString message = record.isValid() ? Seer::filterEscapes(record["msg"].toString()) : QString("Timed out.");
+
+        emit chunkFailed(position, length, message);
+    }
+
+    // Canceled, or a new read, by one of the slots?
+    if (_id != id) {
+        return true;
+    }
+
+    chunkDone(position, length);
+
+    return true;
+}
+
+void SeerMemoryReader::decodeChunk (const GdbMiRecord& record, int position, int length, char* buffer) {
+
+    if (buffer == 0) {
+        return;
+    }
+
+    // Decode each range into its place in the chunk. Parts that couldn't be read stay as they were.
+    for (const GdbMiValue& range : record["memory"]) {
+
+        GdbMiValue contents = range["contents"];
+
+        int offset = 0;
+
+        if (_startOk) {
+            offset = (int)(range["begin"].toULongLong(0, 16) - (_start + position));
+        }
+
+        int n = qMin(contents.rawLength() / 2, length - offset);
+
+        if (offset < 0 || n <= 0) {
+            continue;
+        }
+
+        Seer::hexToBytes(contents.rawData(), n * 2, buffer + offset);
+    }
+}
+
+void SeerMemoryReader::diffChunk (int position, int length, char* buffer, const char* bytes) {
+
+    int runStart = -1;
+
+    for (int offset=0; offset<length; offset+=DiffBlockSize) {
+
+        int n = qMin((int)DiffBlockSize, length - offset);
+
+        if (memcmp(buffer + offset, bytes + offset, n) != 0) {
+
+            memcpy(buffer + offset, bytes + offset, n);
+
+            if (runStart < 0) {
+                runStart = offset;
+            }
+
+        }else if (runStart >= 0) {
+
+            emit changed(position + runStart, offset - runStart);
+
+            runStart = -1;
+        }
+    }
+
+    if (runStart >= 0) {
+        emit changed(position + runStart, length - runStart);
+    }
+}
+
+void SeerMemoryReader::sendChunks () {
+
+    while (_reading && _inFlight.size() < _pipelineDepth && _queued.isEmpty() == false) {
+
+        int position = _queued.takeFirst();
+        int length   = chunkLength(position);
+
+        _inFlight.append(position);
+
+        if (_startOk) {
+            emit readMemory(this, _id, QString("0x%1").arg(_start + position, 0, 16), length);
+        }else{
+            emit readMemory(this, _id, _address, length);
+        }
+    }
+}
+
+void SeerMemoryReader::chunkDone (int position, int length) {
+
+    Q_UNUSED(position);
+
+    int id = _id;
+
+    _bytesDone += length;
+
+    emit progress(_bytesDone, _count);
+
+    if (_id != id) {
+        return;
+    }
+
+    // All done?
+    if (_queued.isEmpty() && _inFlight.isEmpty()) {
+
+        qCDebug(LC) << "Read" << _count << "bytes at" << _address << "in" << _readTimer.elapsed() << "ms";
+
+        _reading = false;
+
+        emit updated();
+        emit finished();
+
+        return;
+    }
+
+    // Let the owner show what's in so far, but not too often.
+    if (_updateTimer.elapsed() >= _updateInterval) {
+
+        _updateTimer.restart();
+
+        emit updated();
+
+        if (_id != id) {
+            return;
+        }
+    }
+
+    sendChunks();
+}
+
+int SeerMemoryReader::chunkLength (int position) const {
+
+    if (_startOk == false) {
+        return _count - position;
+    }
+
+    return qMin(_chunkSize, _count - position);
+}
+
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTimer>
+#include <functional>
+
+class GdbMiRecord;
+
+//
+// Reads a range of memory from gdb in chunks.
+//
+// The range is split into chunks of 'chunkSize' bytes. Up to 'pipelineDepth'
+// -data-read-memory-bytes commands are in flight at a time. Each reply is decoded
+// as it comes in, so the GUI stays responsive and partial results can be shown.
+//
+//     reader->read("0x7fffffffd530", 64*1024*1024);
+//
+//     chunkRead(position, length)    A chunk is in data() (or the buffer function's buffer).
+//     chunkFailed(...)               A chunk couldn't be read.
+//     progress(done, count)          Bytes done so far.
+//     updated()                      Some chunks are in. At most every 'updateInterval' ms.
+//     finished()                     All chunks are done.
+//     refreshStarted()               A refresh() is starting.
+//
+// refresh() reads the same range again. Each chunk is compared to what was read
+// before, 'DiffBlockSize' bytes at a time. Only the blocks that differ are copied
+// over, and each run of them is told with changed(position, length).
+// setRefreshInterval() calls refresh() every so often.
+//
+// fetch() reads the chunks of a range next, because they're being looked at. Chunks
+// that are done already are read again, even after the read is over. That's how a
+// chunk that failed is tried again.
+//
+// The owner connects 'readMemory' to gdb. Each command is sent with a completion
+// that hands the parsed result record to handleRecord(), so the (large) replies
+// aren't turned into text and broadcast.
+//
+
+class SeerMemoryReader : public QObject {
+
+    Q_OBJECT
+
+    public:
+        // Where to decode a chunk to. The default is data().
+        typedef std::function<char* (int position, int length)> BufferFunction;
+
+        enum { DiffBlockSize = 64 };
+
+        explicit SeerMemoryReader (QObject* parent = 0);
+       ~SeerMemoryReader ();
+
+        void                        setChunkSize                (int bytes);
+        int                         chunkSize                   () const;
+        void                        setPipelineDepth            (int depth);
+        int                         pipelineDepth               () const;
+        void                        setUpdateInterval           (int milliseconds);
+        int                         updateInterval              () const;
+        void                        setBufferFunction           (BufferFunction function);
+        void                        setRefreshInterval          (int milliseconds);
+        int                         refreshInterval             () const;
+
+        void                        read                        (const QString& address, int count);
+        void                        fetch                       (int position, int length);
+        bool                        isReading                   () const;
+        bool                        isRefreshing                () const;
+        QString                     address                     () const;
+        int                         count                       () const;
+        int                         bytesDone                   () const;
+        const QByteArray&           data                        () const;
+
+        bool                        handleRecord                (int expressionid, const GdbMiRecord& record);
+
+    signals:
+        void                        readMemory                  (SeerMemoryReader* reader, int expressionid, QString address, int count);
+        void                        chunkRead                   (int position, int length);
+        void                        chunkFailed                 (int position, int length, QString message);
+        void                        changed                     (int position, int length);
+        void                        refreshStarted              ();
+        void                        progress                    (int done, int count);
+        void                        updated                     ();
+        void                        finished                    ();
+
+    public slots:
+        void                        refresh                     ();
+        void                        cancel                      ();
+
+    private:
+        void                        start                       ();
+        void                        decodeChunk                 (const GdbMiRecord& record, int position, int length, char* buffer);
+        void                        diffChunk                   (int position, int length, char* buffer, const char* bytes);
+        void                        sendChunks                  ();
+        void                        chunkDone                   (int position, int length);
+        int                         chunkLength                 (int position) const;
+
+        int                         _id;
+        QString                     _address;
+        quint64                     _start;
+        bool                        _startOk;
+        int                         _count;
+        int                         _chunkSize;
+        int                         _pipelineDepth;
+        int                         _updateInterval;
+        int                         _bytesDone;
+        bool                        _reading;
+        bool                        _refreshing;
+        QByteArray                  _data;
+        QByteArray                  _scratch;
+        BufferFunction              _bufferFunction;
+        QList<int>                  _queued;
+        QList<int>                  _inFlight;
+        QElapsedTimer               _readTimer;
+        QElapsedTimer               _updateTimer;
+        QTimer*                     _refreshTimer;
+};
+
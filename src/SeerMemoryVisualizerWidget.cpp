@@ -5,6 +5,9 @@
 #include <QtWidgets/QFileDialog>
 #include <QtGui/QIntValidator>
 #include <QtGui/QIcon>
+#include <QtGui/QFontDatabase>
+#include <QtGui/QTextDocument>
+#include <QtGui/QTextCursor>
 #include <QtPrintSupport/QPrinter>
 #include <QtPrintSupport/QPrintDialog>
 #include <QtCore/QRegularExpression>
@@ -12,12 +15,23 @@
 #include <QtCore/QFile>
 #include <QtCore/QDebug>
 
+//
+// Memory is read a page at a time. The pages being looked at are read first.
+//
+static const int MemoryPageSize = 64 * 1024;
+
 SeerMemoryVisualizerWidget::SeerMemoryVisualizerWidget (QWidget* parent) : QWidget(parent) {
 
     // Init variables.
     _variableId = Seer::createID(); // Create two id's for queries.
-    _memoryId   = Seer::createID();
     _asmId      = Seer::createID();
+    _readFailed = false;
+    _pagedData  = 0;
+
+    // The reader decodes each page straight into the hex widget's paged data.
+    _memoryReader = new SeerMemoryReader(this);
+    _memoryReader->setChunkSize(MemoryPageSize);
+    _memoryReader->setBufferFunction([this](int position, int length) -> char* { Q_UNUSED(length); return _pagedData ? _pagedData->pageBuffer(position) : 0; });
 
     // Set up UI.
     setupUi(this);
@@ -29,6 +43,8 @@ SeerMemoryVisualizerWidget::SeerMemoryVisualizerWidget (QWidget* parent) : QWidg
 
     memoryLengthLineEdit->setValidator(new QRegularExpressionValidator(QRegularExpression("\\s*([1-9]\\d*\\s*)+"), this));
     columnCountSpinBox->setValue(memoryHexEditor->bytesPerLine());
+    readProgressBar->hide();
+    cancelToolButton->hide();
 
     if (memoryHexEditor->memoryMode() == SeerHexWidget::HexMemoryMode) {
         memoryDisplayFormatComboBox->setCurrentIndex(0);
@@ -66,6 +82,17 @@ SeerMemoryVisualizerWidget::SeerMemoryVisualizerWidget (QWidget* parent) : QWidg
     QObject::connect(columnCountSpinBox,            QOverload<int>::of(&QSpinBox::valueChanged),               this,  &SeerMemoryVisualizerWidget::handleColumnCountSpinBox);
     QObject::connect(printToolButton,               &QToolButton::clicked,                                     this,  &SeerMemoryVisualizerWidget::handlePrintButton);
     QObject::connect(saveToolButton,                &QToolButton::clicked,                                     this,  &SeerMemoryVisualizerWidget::handleSaveButton);
+    QObject::connect(autoRefreshCheckBox,           &QCheckBox::toggled,                                       this,  &SeerMemoryVisualizerWidget::handleAutoRefreshChanged);
+    QObject::connect(refreshIntervalSpinBox,        QOverload<int>::of(&QSpinBox::valueChanged),               this,  &SeerMemoryVisualizerWidget::handleAutoRefreshChanged);
+    QObject::connect(cancelToolButton,              &QToolButton::clicked,                                     _memoryReader,  &SeerMemoryReader::cancel);
+    QObject::connect(cancelToolButton,              &QToolButton::clicked,                                     this,  &SeerMemoryVisualizerWidget::handleReadFinished);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::readMemory,                             this,  &SeerMemoryVisualizerWidget::evaluateMemoryExpression);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::chunkRead,                              this,  &SeerMemoryVisualizerWidget::handleChunkRead);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::changed,                                memoryHexEditor,  &SeerHexWidget::markChanged);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::refreshStarted,                         memoryHexEditor,  &SeerHexWidget::clearChanged);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::chunkFailed,                            this,  &SeerMemoryVisualizerWidget::handleChunkFailed);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::progress,                               this,  &SeerMemoryVisualizerWidget::handleReadProgress);
+    QObject::connect(_memoryReader,                 &SeerMemoryReader::finished,                               this,  &SeerMemoryVisualizerWidget::handleReadFinished);
 
     // Restore window settings.
     readSettings();
@@ -88,7 +115,7 @@ void SeerMemoryVisualizerWidget::setVariableName (const QString& name) {
     // Clear old contents.
     QByteArray array;
 
-    memoryHexEditor->setData(new SeerHexWidget::DataStorageArray(array));
+    setMemory(new SeerHexWidget::DataStorageArray(array));
     memoryAsmEditor->setData("");
 
     // Send signal to get variable address.
@@ -155,7 +182,7 @@ void SeerMemoryVisualizerWidget::handleText (const QString& text) {
 
     //qDebug() << text;
 
-    if (text.contains(QRegularExpression("^([0-9]+)\\^done,value="))) {
+    if (Seer::matchRecord(text, "^done,value=")) {
 
         // 11^done,value="1"
         // 11^done,value="0x7fffffffd538"
@@ -169,7 +196,7 @@ void SeerMemoryVisualizerWidget::handleText (const QString& text) {
 
             // Look for an address in the value.
             if (address == "") {
-                QRegularExpression      re("0[xX][0-9a-fA-F]+");
+                QRegularExpression      re = Seer::regex("0[xX][0-9a-fA-F]+");
                 QRegularExpressionMatch match = re.match(value_text);
 
                 if (match.hasMatch()) {
@@ -179,7 +206,7 @@ void SeerMemoryVisualizerWidget::handleText (const QString& text) {
 
             // Look for a number in the value.
             if (address == "") {
-                QRegularExpression      re("[0-9]+");
+                QRegularExpression      re = Seer::regex("[0-9]+");
                 QRegularExpressionMatch match = re.match(value_text);
 
                 if (match.hasMatch()) {
@@ -191,44 +218,7 @@ void SeerMemoryVisualizerWidget::handleText (const QString& text) {
             setVariableAddress(address);
         }
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,memory="))) {
-
-        // 3^done,memory=[{begin="0x0000000000613e70",offset="0x0000000000000000",end="0x0000000000613e71",contents="00"}]
-        // 4^done,memory=[{begin="0x0000000000613e70",offset="0x0000000000000000",end="0x0000000000613ed4",contents="000000000000000000000000"}]
-
-        QString id_text = text.section('^', 0,0);
-
-        if (id_text.toInt() == _memoryId) {
-
-            //qDebug() << text;
-
-            QString memory_text = Seer::parseFirst(text, "memory=", '[', ']', false);
-
-            QStringList range_list = Seer::parse(memory_text, "", '{', '}', false);
-
-            // Loop through the memory ranges.
-            for ( const auto& range_text : range_list  ) {
-
-                QString contents_text = Seer::parseFirst(range_text, "contents=", '"', '"', false);
-
-                // Convert hex string to byte array.
-                QByteArray array;
-
-                for (int i = 0; i<contents_text.size(); i += 2) {
-                    QString num = contents_text.mid(i, 2);
-                    bool ok = false;
-                    array.push_back(num.toInt(&ok, 16));
-                    Q_ASSERT(ok);
-                }
-
-                // Give the byte array to the hex widget.
-                memoryHexEditor->setData(new SeerHexWidget::DataStorageArray(array));
-
-                break; // Take just the first range for now.
-            }
-        }
-
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,asm_insns="))) {
+    }else if (Seer::matchRecord(text, "^done,asm_insns=")) {
 
         QString id_text = text.section('^', 0,0);
 
@@ -237,7 +227,7 @@ void SeerMemoryVisualizerWidget::handleText (const QString& text) {
             memoryAsmEditor->setData(text);
         }
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
+    }else if (Seer::matchRecord(text, "^error,msg=")) {
 
         // 12^error,msg="No symbol \"return\" in current context."
         // 13^error,msg="No symbol \"cout\" in current context."
@@ -249,20 +239,11 @@ void SeerMemoryVisualizerWidget::handleText (const QString& text) {
             variableAddressLineEdit->setText( Seer::filterEscapes(Seer::parseFirst(text, "msg=", '"', '"', false)) );
         }
 
-        if (id_text.toInt() == _memoryId) {
-            // Display the error message.
-            QString msg_text = Seer::parseFirst(text, "msg=", false);
-
-            if (msg_text != "") {
-                QMessageBox::warning(this, "Error.", Seer::filterEscapes(msg_text));
-            }
-        }
-
     // At a stopping point, refresh.
     }else if (text.startsWith("*stopped,reason=\"")) {
 
         if (autoRefreshCheckBox->isChecked()) {
-            handleRefreshButton();
+            autoRefresh();
         }
 
     }else{
@@ -292,10 +273,117 @@ void SeerMemoryVisualizerWidget::handleRefreshButton () {
         nbytes = memoryLengthLineEdit->text().toInt();
     }
 
-    emit evaluateMemoryExpression(_memoryId, variableAddressLineEdit->text(), nbytes);
+    // Read the memory in pages. Each one shows up as it comes in.
+    SeerHexWidget::DataStoragePaged* paged = new SeerHexWidget::DataStoragePaged(nbytes, _memoryReader->chunkSize(), [this](int position, int length) { _memoryReader->fetch(position, length); });
+
+    setMemory(paged);
+
+    _pagedData  = paged;
+    _readFailed = false;
+
+    _memoryReader->read(variableAddressLineEdit->text(), nbytes);
+
+    emit evaluateAsmExpression(_asmId,       variableAddressLineEdit->text(), nbytes, 2);
+}
+
+void SeerMemoryVisualizerWidget::autoRefresh () {
+
+    int nbytes = 256;
+
+    if (memoryLengthLineEdit->text() != "") {
+        nbytes = memoryLengthLineEdit->text().toInt();
+    }
+
+    // Something else is being looked at now. Read it fresh.
+    if (_pagedData == 0 || _memoryReader->address() != variableAddressLineEdit->text() || _memoryReader->count() != nbytes) {
+        handleRefreshButton();
+        return;
+    }
+
+    // Same memory. Read it again and show just what changed.
+    _memoryReader->refresh();
+
     emit evaluateAsmExpression(_asmId,       variableAddressLineEdit->text(), nbytes, 2);
 }
 
+void SeerMemoryVisualizerWidget::setMemory (SeerHexWidget::DataStorage* data) {
+
+    // The hex widget owns the data. Stop reading into any paged data it had.
+    _memoryReader->cancel();
+    _pagedData = 0;
+
+    handleReadFinished();
+
+    memoryHexEditor->setData(data);
+}
+
+void SeerMemoryVisualizerWidget::handleChunkRead (int position, int length) {
+
+    Q_UNUSED(position);
+    Q_UNUSED(length);
+
+    // A refresh tells just the bytes that changed.
+    if (_memoryReader->isRefreshing()) {
+        return;
+    }
+
+    memoryHexEditor->dataChanged();
+}
+
+void SeerMemoryVisualizerWidget::handleChunkFailed (int position, int length, QString message) {
+
+    Q_UNUSED(length);
+
+    // So the page is asked for again later. One that was read before is kept.
+    if (_pagedData) {
+        _pagedData->setPageFailed(position);
+    }
+
+    // Keep what was read before. The program may be running.
+    if (_memoryReader->isRefreshing()) {
+        return;
+    }
+
+    if (_pagedData) {
+        memoryHexEditor->dataChanged();
+    }
+
+    // Just one message per read. The failed parts show as "??".
+    if (_readFailed == false && message != "") {
+        _readFailed = true;
+        QMessageBox::warning(this, "Error.", message);
+    }
+}
+
+void SeerMemoryVisualizerWidget::handleReadProgress (int done, int count) {
+
+    // Small reads come in at once. Don't flash the progress bar for them.
+    if (done >= count) {
+        return;
+    }
+
+    readProgressBar->setMaximum(count);
+    readProgressBar->setValue(done);
+    readProgressBar->show();
+    cancelToolButton->show();
+}
+
+void SeerMemoryVisualizerWidget::handleReadFinished () {
+
+    readProgressBar->hide();
+    cancelToolButton->hide();
+}
+
+void SeerMemoryVisualizerWidget::handleAutoRefreshChanged () {
+
+    // Besides each stop, refresh every so often if there's an interval.
+    if (autoRefreshCheckBox->isChecked()) {
+        _memoryReader->setRefreshInterval(refreshIntervalSpinBox->value());
+    }else{
+        _memoryReader->setRefreshInterval(0);
+    }
+}
+
 void SeerMemoryVisualizerWidget::handleHelpButton () {
 
     SeerHelpPageDialog* help = new SeerHelpPageDialog;
@@ -370,7 +458,8 @@ void SeerMemoryVisualizerWidget::handlePrintButton () {
     QTextDocument* clone = 0;
 
     if (tabWidget->currentWidget()->objectName() == "hex_tab") {
-        clone = memoryHexEditor->document()->clone(this);
+        clone = new QTextDocument(memoryHexEditor->toPlainText(), this);
+        clone->setDefaultFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
     }else if (tabWidget->currentWidget()->objectName() == "asm_tab") {
         clone = memoryAsmEditor->document()->clone(this);
     }else{
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QtWidgets/QWidget>
+#include "SeerMemoryReader.h"
 #include "ui_SeerMemoryVisualizerWidget.h"
 
 class SeerMemoryVisualizerWidget : public QWidget, protected Ui::SeerMemoryVisualizerWidgetForm {
@@ -18,7 +19,7 @@ class SeerMemoryVisualizerWidget : public QWidget, protected Ui::SeerMemoryVisua
 
     signals:
         void                evaluateVariableExpression          (int expressionid, QString expression);
-        void                evaluateMemoryExpression            (int expressionid, QString address, int count);
+        void                evaluateMemoryExpression            (SeerMemoryReader* reader, int expressionid, QString address, int count);
         void                evaluateAsmExpression               (int expressionid, QString address, int count, int mode);
 
     public slots:
@@ -33,15 +34,24 @@ class SeerMemoryVisualizerWidget : public QWidget, protected Ui::SeerMemoryVisua
         void                handleColumnCountSpinBox            (int value);
         void                handlePrintButton                   ();
         void                handleSaveButton                    ();
+        void                handleChunkRead                     (int position, int length);
+        void                handleChunkFailed                   (int position, int length, QString message);
+        void                handleReadProgress                  (int done, int count);
+        void                handleReadFinished                  ();
+        void                handleAutoRefreshChanged            ();
 
     protected:
+        void                autoRefresh                         ();
+        void                setMemory                           (SeerHexWidget::DataStorage* data);
         void                writeSettings                       ();
         void                readSettings                        ();
         void                resizeEvent                         (QResizeEvent* event);
 
     private:
         int                 _variableId;
-        int                 _memoryId;
         int                 _asmId;
+        bool                _readFailed;
+        SeerMemoryReader*   _memoryReader;
+        SeerHexWidget::DataStoragePaged*    _pagedData;
 };
 
@@ -0,0 +1,208 @@
+#include "SeerRefreshScheduler.h"
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QDebug>
+
+static QLoggingCategory LC("seer.refreshscheduler");
+
+SeerRefreshScheduler::SeerRefreshScheduler (GdbMonitor* monitor, QObject* parent) : QObject(parent) {
+
+    _monitor             = monitor;
+    _state               = Idle;
+    _refreshCommandCount = 0;
+    _queued              = 0;
+    _coalesced           = 0;
+    _stopCount           = 0;
+    _refreshCount        = 0;
+    _droppedCount        = 0;
+
+    // Don't wait forever on a command that never gets its reply.
+    _timeoutTimer.setSingleShot(true);
+    _timeoutTimer.setInterval(2000);
+
+    // Queued, so the views have handled the last reply before the next pass.
+    QObject::connect(_monitor,        &GdbMonitor::commandsFinished,     this, &SeerRefreshScheduler::handleCommandsFinished, Qt::QueuedConnection);
+    QObject::connect(&_timeoutTimer,  &QTimer::timeout,                  this, &SeerRefreshScheduler::handleTimeout);
+}
+
+SeerRefreshScheduler::~SeerRefreshScheduler () {
+}
+
+void SeerRefreshScheduler::addView (QWidget* view, std::function<void ()> refresh) {
+
+    View v;
+
+    v.view    = view;
+    v.refresh = refresh;
+
+    _views.append(v);
+}
+
+void SeerRefreshScheduler::setTimeout (int milliseconds) {
+
+    _timeoutTimer.setInterval(milliseconds);
+}
+
+int SeerRefreshScheduler::timeout () const {
+
+    return _timeoutTimer.interval();
+}
+
+int SeerRefreshScheduler::queueDepth () const {
+
+    return _queued;
+}
+
+bool SeerRefreshScheduler::isRefreshing () const {
+
+    return _state != Idle;
+}
+
+quint64 SeerRefreshScheduler::stopCount () const {
+
+    return _stopCount;
+}
+
+quint64 SeerRefreshScheduler::refreshCount () const {
+
+    return _refreshCount;
+}
+
+quint64 SeerRefreshScheduler::droppedCount () const {
+
+    return _droppedCount;
+}
+
+void SeerRefreshScheduler::handleStoppingPointReached () {
+
+    _stopCount++;
+    _queued++;
+
+    // The round trip is timed from the latest stop. That's the one the views will show.
+    _stopTimer.start();
+
+    if (_state != Idle) {
+
+        qCDebug(LC) << "Stop queued. Queue depth" << _queued << "pending commands" << _monitor->pendingCommands();
+
+        emit logText(QString("=seer-refresh-queued,queued=\"%1\",pending=\"%2\"").arg(_queued).arg(_monitor->pendingCommands()));
+
+        return;
+    }
+
+    startRefresh();
+}
+
+void SeerRefreshScheduler::handleCommandsFinished () {
+
+    if (_state == Idle) {
+        return;
+    }
+
+    // A view may have sent more commands in reply to the last one.
+    if (_monitor->pendingCommands() > 0) {
+        return;
+    }
+
+    advance();
+}
+
+void SeerRefreshScheduler::handleTimeout () {
+
+    if (_state == Idle) {
+        return;
+    }
+
+    qCWarning(LC) << "Timed out waiting for" << _monitor->pendingCommands() << "commands. Carrying on.";
+
+    // Don't keep waiting on them for every refresh after this. Their results, if
+    // they come, aren't counted against the commands of the next pass.
+    _monitor->cancelPendingCommands();
+
+    advance();
+}
+
+void SeerRefreshScheduler::startRefresh () {
+
+    // Everything queued up to now is covered by this refresh.
+    _droppedCount       += _queued - 1;
+    _coalesced           = _queued;
+    _queued              = 0;
+    _refreshTimer        = _stopTimer;
+    _refreshCommandCount = _monitor->commandCount();
+    _state               = VisiblePass;
+
+    refreshViews(true);
+
+    waitForReplies();
+}
+
+void SeerRefreshScheduler::refreshViews (bool visible) {
+
+    for (const View& v : _views) {
+
+        if (v.view.isNull()) {
+            continue;
+        }
+
+        if (v.view->isVisible() != visible) {
+            continue;
+        }
+
+        v.refresh();
+    }
+}
+
+void SeerRefreshScheduler::waitForReplies () {
+
+    _timeoutTimer.start();
+
+    // Nothing was sent, or it's all answered already. Carry on from the event loop.
+    if (_monitor->pendingCommands() == 0) {
+        QTimer::singleShot(0, this, &SeerRefreshScheduler::handleCommandsFinished);
+    }
+}
+
+void SeerRefreshScheduler::advance () {
+
+    _timeoutTimer.stop();
+
+    if (_state == VisiblePass) {
+
+        // A newer stop came in. What the hidden views would fetch is already stale.
+        if (_queued > 0) {
+
+            qCDebug(LC) << "Dropping the hidden pass. Queue depth" << _queued;
+
+            _droppedCount++;
+
+            startRefresh();
+
+            return;
+        }
+
+        _state = HiddenPass;
+
+        refreshViews(false);
+
+        waitForReplies();
+
+        return;
+    }
+
+    // Both passes are done.
+    _state = Idle;
+    _refreshCount++;
+
+    double  ms       = _refreshTimer.nsecsElapsed() / 1000000.0;
+    quint64 commands = _monitor->commandCount() - _refreshCommandCount;
+
+    qCInfo(LC) << "Stop latency:" << ms << "ms" << commands << "commands" << _coalesced << "stops";
+
+    emit logText(QString("=seer-refresh-done,rtt=\"%1\",commands=\"%2\",stops=\"%3\",dropped=\"%4\"").arg(ms, 0, 'f', 1).arg(commands).arg(_coalesced).arg(_droppedCount));
+
+    // Stops that came in during the hidden pass.
+    if (_queued > 0) {
+        startRefresh();
+    }
+}
+
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "GdbMonitor.h"
+#include <QtWidgets/QWidget>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QVector>
+#include <QtCore/QTimer>
+#include <QtCore/QElapsedTimer>
+#include <functional>
+
+//
+// Refreshes the views when the program stops.
+//
+// A refresh is done in two passes. Views that are visible go first, in the order
+// they were added. Once gdb has answered every command they sent, the hidden views
+// get their turn. Most of those won't send anything until they are shown.
+//
+// Only one refresh is in flight at a time. Stops that arrive while one is running
+// are queued and coalesced into a single refresh for the latest stop. If the latest
+// stop arrives during the first pass, the second pass of the old refresh is dropped.
+//
+// The queue depth and the round trip time (stop to last reply) of each refresh
+// go to the Seer log as '=seer-refresh-xxx' records.
+//
+
+class SeerRefreshScheduler : public QObject {
+
+    Q_OBJECT
+
+    public:
+        explicit SeerRefreshScheduler (GdbMonitor* monitor, QObject* parent = 0);
+       ~SeerRefreshScheduler ();
+
+        void                            addView                         (QWidget* view, std::function<void ()> refresh);
+
+        template <typename T>
+        void                            addView                         (T* view, void (T::*method)()) {
+            addView(view, [view, method]() { (view->*method)(); });
+        }
+
+        void                            setTimeout                      (int milliseconds);
+        int                             timeout                         () const;
+
+        // Stops waiting for a refresh. Refreshes (or hidden passes) dropped for a newer stop.
+        int                             queueDepth                      () const;
+        bool                            isRefreshing                    () const;
+        quint64                         stopCount                       () const;
+        quint64                         refreshCount                    () const;
+        quint64                         droppedCount                    () const;
+
+    signals:
+        void                            logText                         (const QString& text);
+
+    public slots:
+        void                            handleStoppingPointReached      ();
+
+    private slots:
+        void                            handleCommandsFinished          ();
+        void                            handleTimeout                   ();
+
+    private:
+        enum State {
+            Idle,
+            VisiblePass,
+            HiddenPass
+        };
+
+        struct View {
+            QPointer<QWidget>           view;
+            std::function<void ()>      refresh;
+        };
+
+        void                            startRefresh                    ();
+        void                            refreshViews                    (bool visible);
+        void                            waitForReplies                  ();
+        void                            advance                         ();
+
+        GdbMonitor*                     _monitor;
+        QVector<View>                   _views;
+        State                           _state;
+        QTimer                          _timeoutTimer;
+        QElapsedTimer                   _stopTimer;
+        QElapsedTimer                   _refreshTimer;
+        quint64                         _refreshCommandCount;
+        int                             _queued;
+        int                             _coalesced;
+        quint64                         _stopCount;
+        quint64                         _refreshCount;
+        quint64                         _droppedCount;
+};
+
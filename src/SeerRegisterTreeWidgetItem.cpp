@@ -1,11 +1,19 @@
 #include "SeerRegisterTreeWidgetItem.h"
 #include <QtWidgets/QTreeWidget>
 #include <QtWidgets/QTreeWidgetItem>
+#include <QtGui/QBrush>
+#include <QtGui/QFont>
 #include <QtCore/QDebug>
 
 //
 // SeerRegisterTreeWidgetItem
 //
+SeerRegisterTreeWidgetItem::SeerRegisterTreeWidgetItem () : QTreeWidgetItem() {
+
+    _changed = false;
+    _stale   = false;
+}
+
 bool SeerRegisterTreeWidgetItem::operator< (const QTreeWidgetItem& other) const {
 
     int column = treeWidget()->sortColumn();
@@ -24,3 +32,63 @@ bool SeerRegisterTreeWidgetItem::operator< (const QTreeWidgetItem& other) const
     return text(column) < other.text(column);
 }
 
+bool SeerRegisterTreeWidgetItem::setValue (const QString& value) {
+
+    setStale(false);
+
+    if (text(2) == value) {
+        return false;
+    }
+
+    // Flag it as different if the old one isn't "" (like after a refresh).
+    setChanged(text(2) != "");
+
+    setText(2, value);
+
+    return true;
+}
+
+void SeerRegisterTreeWidgetItem::setChanged (bool flag) {
+
+    if (_changed == flag) {
+        return;
+    }
+
+    _changed = flag;
+
+    QFont f1 = font(1);
+    QFont f2 = font(2);
+
+    f1.setBold(flag);
+    f2.setBold(flag);
+
+    setFont(1, f1);
+    setFont(2, f2);
+}
+
+bool SeerRegisterTreeWidgetItem::isChanged () const {
+
+    return _changed;
+}
+
+void SeerRegisterTreeWidgetItem::setStale (bool flag) {
+
+    if (_stale == flag) {
+        return;
+    }
+
+    _stale = flag;
+
+    // Grey out the old value until the new one is in.
+    if (flag) {
+        setForeground(2, QBrush(Qt::gray));
+    }else{
+        setForeground(2, QBrush());
+    }
+}
+
+bool SeerRegisterTreeWidgetItem::isStale () const {
+
+    return _stale;
+}
+
@@ -2,6 +2,7 @@
 
 #include <QtWidgets/QTreeWidget>
 #include <QtWidgets/QTreeWidgetItem>
+#include <QtCore/QString>
 
 class SeerRegisterTreeWidgetItem : public QTreeWidgetItem {
 
@@ -17,7 +18,23 @@ class SeerRegisterTreeWidgetItem : public QTreeWidgetItem {
         QTreeWidgetItem(const QStringList &strings, int type = Type)
         QTreeWidgetItem(int type = Type)
         */
+        SeerRegisterTreeWidgetItem ();
 
         virtual bool operator< (const QTreeWidgetItem& other) const;
+
+        // Set the value (column 2). Returns true if it is different than the one before.
+        // A different value is shown in bold, unless there wasn't one before.
+        bool                setValue                (const QString& value);
+
+        void                setChanged              (bool flag);
+        bool                isChanged               () const;
+
+        // The value is out of date. gdb said the register changed but it hasn't been fetched.
+        void                setStale                (bool flag);
+        bool                isStale                 () const;
+
+    private:
+        bool                _changed;
+        bool                _stale;
 };
 
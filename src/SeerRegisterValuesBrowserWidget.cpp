@@ -9,6 +9,7 @@
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QMenu>
 #include <QtWidgets/QMessageBox>
+#include <QtWidgets/QScrollBar>
 #include <QtGui/QFontDatabase>
 #include <QtGui/QClipboard>
 #include <QtCore/QSettings>
@@ -21,6 +22,7 @@ SeerRegisterValuesBrowserWidget::SeerRegisterValuesBrowserWidget (QWidget* paren
 
     _newProfileAction    = 0;
     _deleteProfileAction = 0;
+    _fetchTimer          = 0;
 
     // Construct the UI.
     setupUi(this);
@@ -48,6 +50,11 @@ SeerRegisterValuesBrowserWidget::SeerRegisterValuesBrowserWidget (QWidget* paren
 
     _needsRegisterNames = true;
 
+    // Scrolling around can happen a lot. Fetch the registers that came into view once things settle.
+    _fetchTimer = new QTimer(this);
+    _fetchTimer->setSingleShot(true);
+    _fetchTimer->setInterval(0);
+
     // Create edit delegate.
     QAllowEditDelegate* editDelegate = new QAllowEditDelegate(this);
 
@@ -76,6 +83,10 @@ SeerRegisterValuesBrowserWidget::SeerRegisterValuesBrowserWidget (QWidget* paren
     QObject::connect(_modifyProfileAction,              &QAction::triggered,                                       this, &SeerRegisterValuesBrowserWidget::handleModifyProfile);
     QObject::connect(_deleteProfileAction,              &QAction::triggered,                                       this, &SeerRegisterValuesBrowserWidget::handleDeleteProfile);
     QObject::connect(registerProfileComboBox,           QOverload<int>::of(&QComboBox::currentIndexChanged),       this, &SeerRegisterValuesBrowserWidget::handleProfileChanged);
+    QObject::connect(registersTreeWidget->verticalScrollBar(), &QScrollBar::valueChanged,                          _fetchTimer, QOverload<>::of(&QTimer::start));
+    QObject::connect(registersTreeWidget->verticalScrollBar(), &QScrollBar::rangeChanged,                          _fetchTimer, QOverload<>::of(&QTimer::start));
+    QObject::connect(registersTreeWidget->header(),     &QHeaderView::sortIndicatorChanged,                        _fetchTimer, QOverload<>::of(&QTimer::start));
+    QObject::connect(_fetchTimer,                       &QTimer::timeout,                                          this, &SeerRegisterValuesBrowserWidget::fetchVisibleRegisters);
 
     // Restore settings.
     readSettings();
@@ -106,6 +117,9 @@ void SeerRegisterValuesBrowserWidget::handleText (const QString& text) {
 
         // This recreates the tree.
         registersTreeWidget->clear();
+        _registerItems.clear();
+        _changedItems.clear();
+        _requestedRegisters.clear();
 
         QString newtext = Seer::filterEscapes(text); // Filter escaped characters.
 
@@ -122,7 +136,7 @@ void SeerRegisterValuesBrowserWidget::handleText (const QString& text) {
                 continue;
             }
 
-            QTreeWidgetItem* topItem = new SeerRegisterTreeWidgetItem;
+            SeerRegisterTreeWidgetItem* topItem = new SeerRegisterTreeWidgetItem;
             topItem->setFlags(topItem->flags() | Qt::ItemIsEditable);
             topItem->setText(0, QString::number(i));
             topItem->setText(1, name_text);
@@ -133,6 +147,8 @@ void SeerRegisterValuesBrowserWidget::handleText (const QString& text) {
 
             registersTreeWidget->addTopLevelItem(topItem);
 
+            _registerItems.insert(i, topItem);
+
             i++;
         }
 
@@ -151,6 +167,10 @@ void SeerRegisterValuesBrowserWidget::handleText (const QString& text) {
             ++it;
         }
 
+        // All values are coming. Start over with what's been changed.
+        clearChangedRegisters();
+        _requestedRegisters.clear();
+
         // "^done,register-values=[{number=\"0\",value=\"0x4005e7\"},{number=\"1\",value=\"0x0\"},{number=\"2\",value=\"0x100\"},
         //                    {number=\"3\",value=\"0x7fffffffd548\"},{number=\"4\",value=\"0x7fffffffd538\"},{number=\"5\",value=\"0x1\"},...
         //                    {number=\"205\",value=\"0x0\"},{number=\"206\",value=\"0x0\"}]"
@@ -168,33 +188,16 @@ void SeerRegisterValuesBrowserWidget::handleText (const QString& text) {
 
             // Instead of creating a new tree each time, we will reuse existing items, if they are there.
             // This allows the expanded items to remain expanded.
-            QList<QTreeWidgetItem*> matches = registersTreeWidget->findItems(number_text, Qt::MatchExactly, 0);
-
-            // Found a match. Reuse it. Set the value.
             // If no matches, do not add this entry.
-            if (matches.size() > 0) {
+            SeerRegisterTreeWidgetItem* item = _registerItems.value(number_text.toInt(), 0);
 
-                QTreeWidgetItem* item = matches.takeFirst();
+            if (item) {
 
-                bool isDifferent = false;
-
-                // Flag it as different of the new value is different than the old version _AND_
-                // the old one isn't "" (like after a refresh).
-                if (item->text(2) != "" && item->text(2) != value_text) {
-                    isDifferent = true;
+                if (item->setValue(value_text) && item->isChanged()) {
+                    _changedItems.append(item);
                 }
 
-                item->setText(2, value_text);
                 item->setText(3, "reused");
-
-                QFont f1 = item->font(1);
-                QFont f2 = item->font(2);
-
-                f1.setBold(isDifferent);
-                f2.setBold(isDifferent);
-
-                item->setFont(1, f1);
-                item->setFont(2, f2);
             }
         }
 
@@ -202,10 +205,14 @@ void SeerRegisterValuesBrowserWidget::handleText (const QString& text) {
         // Delete the unused ones. They are obsolete.
         QList<QTreeWidgetItem*> matches = registersTreeWidget->findItems("unused", Qt::MatchExactly, 3);
 
-        qDeleteAll(matches);
+        if (matches.size() > 0) {
+            qDeleteAll(matches);
+            rebuildRegisterIndex();
+        }
 
     }else if (text.startsWith("^error,msg=\"No registers.\"")) {
         registersTreeWidget->clear();
+        rebuildRegisterIndex();
 
         _needsRegisterNames = true;
 
@@ -228,20 +235,34 @@ void SeerRegisterValuesBrowserWidget::handleStoppingPointReached () {
         return;
     }
 
+    bool needsAllValues = _registerItems.isEmpty();
+
     if (_needsRegisterNames) {
 
         emit refreshRegisterNames();
 
         _needsRegisterNames = false;
+
+        needsAllValues = true;
     }
 
     // Get the format.
     QString fmt = registerFormatComboBox->currentData().toString();
 
-    // refresh();
-    // If a stopping point is reached, just refresh the values.
-    // The register names should already be there.
-    emit refreshRegisterValues(fmt);
+    // New names, or a new format, needs all the values.
+    if (needsAllValues || fmt != _valuesFormat) {
+
+        _valuesFormat = fmt;
+
+        emit refreshRegisterValues(fmt);
+
+        return;
+    }
+
+    // If a stopping point is reached, just refresh the values that changed.
+    // The register names should already be there. Ask gdb which ones changed
+    // and fetch those that can be seen.
+    emit refreshChangedRegisters();
 }
 
 void SeerRegisterValuesBrowserWidget::refresh () {
@@ -252,10 +273,130 @@ void SeerRegisterValuesBrowserWidget::refresh () {
     // Get the format.
     QString fmt = registerFormatComboBox->currentData().toString();
 
+    _valuesFormat = fmt;
+
     emit refreshRegisterNames();
     emit refreshRegisterValues(fmt);
 }
 
+bool SeerRegisterValuesBrowserWidget::handleChangedRegistersRecord (const GdbMiRecord& record) {
+
+    // Timed out. The next stop will ask again.
+    if (record.isValid() == false) {
+        return true;
+    }
+
+    if (record.isRecordClass("error")) {
+
+        if (record["msg"].toString() == "No registers.") {
+            registersTreeWidget->clear();
+            rebuildRegisterIndex();
+
+            _needsRegisterNames = true;
+        }
+
+        return true;
+    }
+
+    // ^done,changed-registers=["0","1","2","4","5","6","7","16","17", ...]
+    if (record.isRecordClass("done") == false) {
+        return true;
+    }
+
+    // Last stop's changes are no longer news.
+    clearChangedRegisters();
+
+    for (const GdbMiValue& number : record["changed-registers"]) {
+
+        SeerRegisterTreeWidgetItem* item = _registerItems.value(number.toInt(), 0);
+
+        if (item) {
+            item->setStale(true);
+        }
+    }
+
+    fetchVisibleRegisters();
+
+    return true;
+}
+
+bool SeerRegisterValuesBrowserWidget::handleRegisterValuesRecord (const GdbMiRecord& record) {
+
+    // Timed out or failed. Ask again for what's still stale.
+    if (record.isValid() == false || record.isRecordClass("done") == false) {
+        _requestedRegisters.clear();
+        return true;
+    }
+
+    // ^done,register-values=[{number="0",value="0x4005e7"},{number="16",value="0x401136"}]
+    bool changed = false;
+
+    for (const GdbMiValue& reg : record["register-values"]) {
+
+        int number = reg["number"].toInt();
+
+        _requestedRegisters.remove(number);
+
+        SeerRegisterTreeWidgetItem* item = _registerItems.value(number, 0);
+
+        if (item == 0) {
+            continue;
+        }
+
+        if (item->setValue(reg["value"].toString())) {
+
+            if (item->isChanged()) {
+                _changedItems.append(item);
+            }
+
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        registersTreeWidget->resizeColumnToContents(2);
+    }
+
+    return true;
+}
+
+void SeerRegisterValuesBrowserWidget::fetchVisibleRegisters () {
+
+    // Don't do any work if the widget is hidden.
+    if (isHidden()) {
+        return;
+    }
+
+    // Walk the rows that can be seen. Hidden rows (profiles) are skipped by itemBelow().
+    QStringList numbers;
+    int         height = registersTreeWidget->viewport()->height();
+
+    QTreeWidgetItem* item = registersTreeWidget->itemAt(0, 0);
+
+    while (item && registersTreeWidget->visualItemRect(item).top() < height) {
+
+        SeerRegisterTreeWidgetItem* reg = static_cast<SeerRegisterTreeWidgetItem*>(item);
+
+        if (reg->isStale()) {
+
+            int number = reg->text(0).toInt();
+
+            if (_requestedRegisters.contains(number) == false) {
+                _requestedRegisters.insert(number);
+                numbers.append(reg->text(0));
+            }
+        }
+
+        item = registersTreeWidget->itemBelow(item);
+    }
+
+    if (numbers.isEmpty()) {
+        return;
+    }
+
+    emit refreshSelectedRegisterValues(_valuesFormat, numbers.join(' '));
+}
+
 void SeerRegisterValuesBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int column) {
 
     Q_UNUSED(column);
@@ -384,6 +525,8 @@ void SeerRegisterValuesBrowserWidget::handleFormatChanged (int index) {
     // Get the format.
     QString fmt = registerFormatComboBox->itemData(index).toString();
 
+    _valuesFormat = fmt;
+
     // Refresh the register values.
     emit refreshRegisterValues(fmt);
 }
@@ -572,6 +715,11 @@ void SeerRegisterValuesBrowserWidget::handleShowHideRegisters () {
             matches[i]->setHidden(false);
         }
     }
+
+    // Some stale ones may be showing now.
+    if (_fetchTimer) {
+        _fetchTimer->start();
+    }
 }
 
 void SeerRegisterValuesBrowserWidget::handleProfileChanged (int index) {
@@ -699,6 +847,34 @@ void SeerRegisterValuesBrowserWidget::deleteProfileSettings (const QString& prof
     } settings.endGroup();
 }
 
+void SeerRegisterValuesBrowserWidget::rebuildRegisterIndex () {
+
+    // Items have been deleted. Rebuild the number to item index from the tree.
+    _registerItems.clear();
+    _changedItems.clear();
+    _requestedRegisters.clear();
+
+    for (int i=0; i<registersTreeWidget->topLevelItemCount(); i++) {
+
+        SeerRegisterTreeWidgetItem* item = static_cast<SeerRegisterTreeWidgetItem*>(registersTreeWidget->topLevelItem(i));
+
+        _registerItems.insert(item->text(0).toInt(), item);
+
+        if (item->isChanged()) {
+            _changedItems.append(item);
+        }
+    }
+}
+
+void SeerRegisterValuesBrowserWidget::clearChangedRegisters () {
+
+    for (SeerRegisterTreeWidgetItem* item : _changedItems) {
+        item->setChanged(false);
+    }
+
+    _changedItems.clear();
+}
+
 void SeerRegisterValuesBrowserWidget::showEvent (QShowEvent* event) {
 
     QWidget::showEvent(event);
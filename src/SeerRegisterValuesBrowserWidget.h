@@ -1,13 +1,19 @@
 #pragma once
 
 #include "ui_SeerRegisterValuesBrowserWidget.h"
+#include "GdbMiParser.h"
 #include <QtWidgets/QWidget>
 #include <QtWidgets/QMenu>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QVector>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
 #include <QtCore/QDebug>
 
+class SeerRegisterTreeWidgetItem;
+
 class SeerRegisterValuesBrowserWidget : public QWidget, protected Ui::SeerRegisterValuesBrowserWidgetForm {
 
     Q_OBJECT
@@ -19,6 +25,10 @@ class SeerRegisterValuesBrowserWidget : public QWidget, protected Ui::SeerRegist
     public:
         void                        setRegisterFormat                       (QString fmt);
 
+        // Replies to -data-list-changed-registers and to -data-list-register-values for a set of registers.
+        bool                        handleChangedRegistersRecord            (const GdbMiRecord& record);
+        bool                        handleRegisterValuesRecord              (const GdbMiRecord& record);
+
     public slots:
         void                        handleText                              (const QString& text);
         void                        handleStoppingPointReached              ();
@@ -35,10 +45,13 @@ class SeerRegisterValuesBrowserWidget : public QWidget, protected Ui::SeerRegist
         void                        handleDeleteProfile                     ();
         void                        handleShowHideRegisters                 ();
         void                        handleProfileChanged                    (int index);
+        void                        fetchVisibleRegisters                   ();
 
     signals:
         void                        refreshRegisterNames                    ();
         void                        refreshRegisterValues                   (QString fmt);
+        void                        refreshChangedRegisters                 ();
+        void                        refreshSelectedRegisterValues           (QString fmt, QString numbers);
         void                        setRegisterValue                        (QString fmt, QString name, QString value);
 
     protected:
@@ -48,6 +61,8 @@ class SeerRegisterValuesBrowserWidget : public QWidget, protected Ui::SeerRegist
         bool                        readProfileSettings                     (const QString& profileName, QStringList& registerNames, QVector<bool>& registerEnabled);
         void                        writeProfileSettings                    (const QString& profileName, const QStringList& registerNames, const QVector<bool>& registerEnabled);
         void                        deleteProfileSettings                   (const QString& profileName);
+        void                        rebuildRegisterIndex                    ();
+        void                        clearChangedRegisters                   ();
 
     private:
         bool                        _needsRegisterNames;
@@ -56,6 +71,11 @@ class SeerRegisterValuesBrowserWidget : public QWidget, protected Ui::SeerRegist
         QAction*                    _newProfileAction;
         QAction*                    _modifyProfileAction;
         QAction*                    _deleteProfileAction;
+        QString                     _valuesFormat;
+        QHash<int,SeerRegisterTreeWidgetItem*>  _registerItems;
+        QList<SeerRegisterTreeWidgetItem*>      _changedItems;
+        QSet<int>                   _requestedRegisters;
+        QTimer*                     _fetchTimer;
 
 };
 
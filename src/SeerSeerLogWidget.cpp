@@ -5,6 +5,10 @@
 #include <QtCore/QDebug>
 
 SeerSeerLogWidget::SeerSeerLogWidget (QWidget* parent) : SeerLogWidget(parent) {
+
+    addRecordClass('^', "Result records");
+    addRecordClass('*', "Exec async records");
+    addRecordClass('=', "Notify async records");
 }
 
 SeerSeerLogWidget::~SeerSeerLogWidget () {
@@ -27,15 +31,15 @@ void SeerSeerLogWidget::processText (const QString& text) {
         selected = true;
     }
 
-    if (selected == false && text.contains(QRegularExpression("^([0-9]+)\\^")) == true) {
+    if (selected == false && Seer::matchRecord(text, "^") == true) {
         selected = true;
     }
 
-    if (selected == false && text.contains(QRegularExpression("^([0-9]+)\\*")) == true) {
+    if (selected == false && Seer::matchRecord(text, "*") == true) {
         selected = true;
     }
 
-    if (selected == false && text.contains(QRegularExpression("^([0-9]+)\\=")) == true) {
+    if (selected == false && Seer::matchRecord(text, "=") == true) {
         selected = true;
     }
 
@@ -46,7 +50,13 @@ void SeerSeerLogWidget::processText (const QString& text) {
     // Filter escape characters.
     QString str = Seer::filterEscapes(text);
 
-    // Write the string to the log.
-    textEdit->append(str);
+    // Write the string to the log. Its class is the character after the token, if there is one.
+    int i = 0;
+
+    while (i < text.size() && text[i].isDigit()) {
+        i++;
+    }
+
+    logView->appendLine(str, i < text.size() ? text[i] : QChar());
 }
 
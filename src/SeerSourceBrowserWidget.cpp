@@ -11,6 +11,8 @@
 
 SeerSourceBrowserWidget::SeerSourceBrowserWidget (QWidget* parent) : QWidget(parent) {
 
+    _sourceResolver = 0;
+
     // Construct the UI.
     setupUi(this);
 
@@ -87,6 +89,16 @@ const QStringList& SeerSourceBrowserWidget::ignoreFilePatterns () const {
     return _ignoreFilePatterns;
 }
 
+void SeerSourceBrowserWidget::setSourceResolver (SeerSourceResolver* resolver) {
+
+    _sourceResolver = resolver;
+}
+
+SeerSourceResolver* SeerSourceBrowserWidget::sourceResolver () const {
+
+    return _sourceResolver;
+}
+
 void SeerSourceBrowserWidget::handleText (const QString& text) {
 
     QApplication::setOverrideCursor(Qt::BusyCursor);
@@ -189,7 +201,21 @@ void SeerSourceBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int colu
         }
 
     }else{
-        item->setToolTip(0, item->text(0) + " : " + item->text(1));
+        QString tooltip = item->text(0) + " : " + item->text(1);
+
+        // Say where the editor will load it from, if not from 'fullname'.
+        if (_sourceResolver) {
+
+            QString filename = _sourceResolver->findFile(item->text(0), item->text(1));
+
+            if (filename == "") {
+                tooltip += "\nNot found. Add an alternate directory for it.";
+            }else if (filename != item->text(1)) {
+                tooltip += "\nFound at : " + filename;
+            }
+        }
+
+        item->setToolTip(0, tooltip);
 
         for (int i=1; i<sourceTreeWidget->columnCount(); i++) { // Copy tooltip to the other columns.
             item->setToolTip(i, item->toolTip(0));
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "SeerSourceResolver.h"
 #include <QtWidgets/QWidget>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
@@ -25,6 +26,9 @@ class SeerSourceBrowserWidget : public QWidget, protected Ui::SeerSourceBrowserW
         void                        setIgnoreFilePatterns       (const QStringList& patterns);
         const QStringList&          ignoreFilePatterns          () const;
 
+        void                        setSourceResolver           (SeerSourceResolver* resolver);
+        SeerSourceResolver*         sourceResolver              () const;
+
     public slots:
         void                        handleText                  (const QString& text);
         void                        refresh                     ();
@@ -47,5 +51,6 @@ class SeerSourceBrowserWidget : public QWidget, protected Ui::SeerSourceBrowserW
         QStringList                 _headerFilePatterns;
         QStringList                 _miscFilePatterns;
         QStringList                 _ignoreFilePatterns;
+        SeerSourceResolver*         _sourceResolver;
 };
 
@@ -0,0 +1,509 @@
+#include "SeerSourceCache.h"
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QDateTime>
+#include <QtCore/QTextStream>
+#include <QtCore/QCache>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QDebug>
+#include <algorithm>
+#include <cstring>
+#include <climits>
+
+//
+// SSE2 is used to copy runs of plain ASCII. SSE2 is always there on x86-64.
+//
+#if defined(__SSE2__) || defined(_M_X64)
+#define SEER_SOURCE_SSE2
+#include <emmintrin.h>
+#endif
+
+static QLoggingCategory LC("seer.sourcecache");
+
+namespace {
+
+    struct Entry {
+        QString     text;
+        QDateTime   modified;
+        qint64      size;
+    };
+
+    struct Cache {
+        Cache () : entries(64 * 1024 * 1024), lines(256 * 1024 * 1024), hits(0), misses(0) {
+        }
+
+        QCache<QString,Entry>               entries;    // Cost is the bytes of the text.
+        QCache<QString,SeerSourceLinesPtr>  lines;      // Cost is the bytes mapped, plus the index.
+        quint64                             hits;
+        quint64                             misses;
+    };
+
+    Cache& cache () {
+
+        static Cache c;
+
+        return c;
+    }
+
+    //
+    // Each file in the lines cache holds a file handle. Count every file as at least
+    // this much of the cache, so only so many are open.
+    //
+    const int MaxOpenFiles = 128;
+
+    SeerSourceLinesPtr linesFor (const QFileInfo& info) {
+
+        Cache& c = cache();
+
+        QString key = info.absoluteFilePath();
+
+        SeerSourceLinesPtr* entry = c.lines.object(key);
+
+        if (entry && (*entry)->modified() == info.lastModified() && (*entry)->size() == info.size()) {
+            return *entry;
+        }
+
+        QSharedPointer<SeerSourceLines> lines(new SeerSourceLines);
+
+        if (lines->open(info.filePath()) == false) {
+            c.lines.remove(key);
+            return SeerSourceLinesPtr();
+        }
+
+        qint64 cost = lines->size() + (qint64)lines->lineCount() * (qint64)sizeof(qint64);
+
+        cost = qBound((qint64)(c.lines.maxCost() / MaxOpenFiles), cost, (qint64)INT_MAX);
+
+        c.lines.insert(key, new SeerSourceLinesPtr(lines), (int)cost);
+
+        return lines;
+    }
+
+    //
+    // One UTF-8 sequence, starting with a byte >= 0x80. Returns its length, or 0 if it
+    // isn't valid (overlong, a surrogate, too big, or cut short).
+    //
+    int utf8Sequence (const uchar* p, const uchar* end, uint* codePoint) {
+
+        uchar c = p[0];
+        int   length;
+        uint  cp;
+        uint  minimum;
+
+        if (c >= 0xC2 && c <= 0xDF) {
+            length = 2; cp = c & 0x1F; minimum = 0x80;
+        }else if (c >= 0xE0 && c <= 0xEF) {
+            length = 3; cp = c & 0x0F; minimum = 0x800;
+        }else if (c >= 0xF0 && c <= 0xF4) {
+            length = 4; cp = c & 0x07; minimum = 0x10000;
+        }else{
+            return 0;
+        }
+
+        if (end - p < length) {
+            return 0;
+        }
+
+        for (int i=1; i<length; i++) {
+
+            if ((p[i] & 0xC0) != 0x80) {
+                return 0;
+            }
+
+            cp = (cp << 6) | (p[i] & 0x3F);
+        }
+
+        if (cp < minimum || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+            return 0;
+        }
+
+        *codePoint = cp;
+
+        return length;
+    }
+
+    inline ushort* expandTab (ushort* out, int tabSize, int* column) {
+
+        int n = tabSize - *column % tabSize;
+
+        for (int i=0; i<n; i++) {
+            *out++ = ' ';
+        }
+
+        *column = 0;
+
+        return out;
+    }
+
+    //
+    // Decodes [p,end) into 'out', expanding tabs and dropping the '\r' of "\r\n".
+    // 'out' needs room for (end - p) + tabs * (tabSize - 1) characters.
+    // Columns are counted in UTF-16 units, as Seer::expandTabs() does.
+    //
+    ushort* expandUtf8 (const uchar* p, const uchar* end, int tabSize, ushort* out) {
+
+        int column = 0;
+
+        while (p < end) {
+
+#if defined(SEER_SOURCE_SSE2)
+            // 16 bytes with nothing but printable ASCII are widened as they are.
+            while (end - p >= 16) {
+
+                __m128i bytes   = _mm_loadu_si128((const __m128i*)p);
+                __m128i control = _mm_cmplt_epi8(bytes, _mm_set1_epi8(0x20));   // Also catches >= 0x80 (signed).
+
+                if (_mm_movemask_epi8(control) != 0) {
+                    break;
+                }
+
+                __m128i zero = _mm_setzero_si128();
+
+                _mm_storeu_si128((__m128i*)out,       _mm_unpacklo_epi8(bytes, zero));
+                _mm_storeu_si128((__m128i*)(out + 8), _mm_unpackhi_epi8(bytes, zero));
+
+                p      += 16;
+                out    += 16;
+                column += 16;
+            }
+
+            if (p >= end) {
+                break;
+            }
+#endif
+
+            uchar c = *p;
+
+            if (c < 0x80) {
+
+                p++;
+
+                if (c == '\t') {
+                    out = expandTab(out, tabSize, &column);
+                    continue;
+                }
+
+                if (c == '\r' && p < end && *p == '\n') {
+                    continue;
+                }
+
+                *out++ = c;
+                column = (c == '\n') ? 0 : column + 1;
+
+                continue;
+            }
+
+            uint cp     = 0xFFFD;
+            int  length = utf8Sequence(p, end, &cp);
+
+            p += (length > 0) ? length : 1;
+
+            if (cp >= 0x10000) {
+                *out++  = QChar::highSurrogate(cp);
+                *out++  = QChar::lowSurrogate(cp);
+                column += 2;
+            }else{
+                *out++  = (ushort)cp;
+                column += 1;
+            }
+        }
+
+        return out;
+    }
+
+    //
+    // The same, for text that has already been decoded (a UTF-16 file).
+    //
+    QString expandText (const QString& str, int tabSize) {
+
+        qsizetype tabs = str.count('\t');
+
+        QString text(str.size() + tabs * (tabSize - 1) + 1, Qt::Uninitialized);
+
+        ushort* start  = (ushort*)text.data();
+        ushort* out    = start;
+        int     column = 0;
+
+        for (qsizetype i=0; i<str.size(); i++) {
+
+            ushort c = str.at(i).unicode();
+
+            if (c == '\t') {
+                out = expandTab(out, tabSize, &column);
+                continue;
+            }
+
+            if (c == '\r' && i + 1 < str.size() && str.at(i+1) == '\n') {
+                continue;
+            }
+
+            *out++ = c;
+            column = (c == '\n') ? 0 : column + 1;
+        }
+
+        if (out != start && out[-1] != '\n') {
+            *out++ = '\n';
+        }
+
+        text.resize(out - start);
+
+        return text;
+    }
+}
+
+SeerSourceLines::SeerSourceLines () {
+
+    _map  = 0;
+    _data = 0;
+    _size = 0;
+}
+
+SeerSourceLines::~SeerSourceLines () {
+
+    if (_map) {
+        _file.unmap(_map);
+    }
+}
+
+bool SeerSourceLines::open (const QString& filename) {
+
+    _file.setFileName(filename);
+
+    if (_file.open(QIODevice::ReadOnly) == false) {
+        return false;
+    }
+
+    _modified = QFileInfo(_file).lastModified();
+    _size     = _file.size();
+
+    // Map it. If that can't be done (a pipe, some odd file system), read it.
+    _map = (_size > 0) ? _file.map(0, _size) : 0;
+
+    if (_map) {
+        _data = (const char*)_map;
+    }else{
+        _bytes = _file.readAll();
+        _data  = _bytes.constData();
+        _size  = _bytes.size();
+        _file.close();
+    }
+
+    // Where each line starts.
+    const char* p   = _data;
+    const char* end = _data + _size;
+
+    while (p < end) {
+
+        _starts.append(p - _data);
+
+        const char* newline = (const char*)memchr(p, '\n', end - p);
+
+        if (newline == 0) {
+            break;
+        }
+
+        p = newline + 1;
+    }
+
+    return true;
+}
+
+int SeerSourceLines::lineCount () const {
+
+    return _starts.size();
+}
+
+QString SeerSourceLines::line (int lineno) const {
+
+    int i = lineno - 1;
+
+    if (i < 0 || i >= _starts.size()) {
+        return QString();
+    }
+
+    qint64 start = _starts[i];
+    qint64 end   = (i + 1 < _starts.size()) ? _starts[i+1] : _size;
+
+    // Without its "\n" or "\r\n".
+    if (end > start && _data[end-1] == '\n') {
+        end--;
+    }
+
+    if (end > start && _data[end-1] == '\r') {
+        end--;
+    }
+
+    return QString::fromUtf8(_data + start, (int)(end - start));
+}
+
+const char* SeerSourceLines::data () const {
+
+    return _data;
+}
+
+qint64 SeerSourceLines::size () const {
+
+    return _size;
+}
+
+const QDateTime& SeerSourceLines::modified () const {
+
+    return _modified;
+}
+
+QString SeerSourceCache::decode (const char* data, qint64 size, int tabSize) {
+
+    tabSize = qMax(1, tabSize);
+
+    const uchar* p   = (const uchar*)data;
+    const uchar* end = p + size;
+
+    // A UTF-16 file. Let QTextStream work out which one.
+    if (size >= 2 && ((p[0] == 0xFF && p[1] == 0xFE) || (p[0] == 0xFE && p[1] == 0xFF))) {
+
+        QByteArray  bytes = QByteArray::fromRawData(data, (int)size);
+        QTextStream stream(bytes);
+
+        return expandText(stream.readAll(), tabSize);
+    }
+
+    // Skip a UTF-8 byte order mark.
+    if (size >= 3 && p[0] == 0xEF && p[1] == 0xBB && p[2] == 0xBF) {
+        p += 3;
+    }
+
+    // Every byte is at most one character. Every tab is tabSize. Plus a last '\n'.
+    qint64 tabs   = std::count(p, end, '\t');
+    qint64 length = (end - p) + tabs * (tabSize - 1) + 1;
+
+    if (length > INT_MAX / 2) {
+        qCWarning(LC) << "Source is too big:" << size << "bytes";
+        return QString();
+    }
+
+    QString text((int)length, Qt::Uninitialized);
+
+    ushort* start = (ushort*)text.data();
+    ushort* out   = expandUtf8(p, end, tabSize, start);
+
+    if (out != start && out[-1] != '\n') {
+        *out++ = '\n';
+    }
+
+    text.resize((int)(out - start));
+
+    return text;
+}
+
+bool SeerSourceCache::readSource (const QString& filename, int tabSize, QString& text) {
+
+    Cache& c = cache();
+
+    QFileInfo info(filename);
+
+    if (info.exists() == false) {
+        return false;
+    }
+
+    QString   key      = QString::number(tabSize) + ":" + info.absoluteFilePath();
+    QDateTime modified = info.lastModified();
+    qint64    size     = info.size();
+
+    // Still the same file?
+    Entry* entry = c.entries.object(key);
+
+    if (entry && entry->modified == modified && entry->size == size) {
+
+        c.hits++;
+
+        text = entry->text;
+
+        return true;
+    }
+
+    c.misses++;
+
+    // Map it. Or use the mapping the line index already has.
+    SeerSourceLinesPtr lines = linesFor(info);
+
+    if (lines.isNull()) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    text = decode(lines->data(), lines->size(), tabSize);
+
+    qCDebug(LC) << "Decoded" << filename << lines->size() << "bytes in" << timer.elapsed() << "ms";
+
+    // Keep it for next time. The cache drops it right away if it's bigger than the whole cache.
+    Entry* e = new Entry;
+
+    e->text     = text;
+    e->modified = modified;
+    e->size     = size;
+
+    c.entries.insert(key, e, qMax(1, (int)qMin((qint64)INT_MAX, (qint64)text.size() * 2)));
+
+    return true;
+}
+
+SeerSourceLinesPtr SeerSourceCache::lines (const QString& filename) {
+
+    QFileInfo info(filename);
+
+    if (info.exists() == false) {
+        return SeerSourceLinesPtr();
+    }
+
+    return linesFor(info);
+}
+
+void SeerSourceCache::setMaximumSize (qint64 bytes) {
+
+    cache().entries.setMaxCost((int)qBound((qint64)0, bytes, (qint64)INT_MAX));
+}
+
+qint64 SeerSourceCache::maximumSize () {
+
+    return cache().entries.maxCost();
+}
+
+qint64 SeerSourceCache::size () {
+
+    return cache().entries.totalCost();
+}
+
+void SeerSourceCache::setMaximumLinesSize (qint64 bytes) {
+
+    cache().lines.setMaxCost((int)qBound((qint64)0, bytes, (qint64)INT_MAX));
+}
+
+qint64 SeerSourceCache::maximumLinesSize () {
+
+    return cache().lines.maxCost();
+}
+
+qint64 SeerSourceCache::linesSize () {
+
+    return cache().lines.totalCost();
+}
+
+void SeerSourceCache::clear () {
+
+    cache().entries.clear();
+    cache().lines.clear();
+}
+
+quint64 SeerSourceCache::hits () {
+
+    return cache().hits;
+}
+
+quint64 SeerSourceCache::misses () {
+
+    return cache().misses;
+}
+
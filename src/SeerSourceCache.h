@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QFile>
+#include <QtCore/QDateTime>
+#include <QtCore/QByteArray>
+#include <QtCore/QVector>
+#include <QtCore/QSharedPointer>
+
+//
+// The lines of a source file. The start of each line is found once, and a line is
+// decoded when it's asked for. The file stays mapped for as long as this is around.
+//
+
+class SeerSourceLines {
+
+    public:
+        SeerSourceLines ();
+       ~SeerSourceLines ();
+
+        bool                        open                        (const QString& filename);
+
+        int                         lineCount                   () const;
+        QString                     line                        (int lineno) const;     // 1 based.
+        const char*                 data                        () const;
+        qint64                      size                        () const;
+        const QDateTime&            modified                    () const;
+
+    private:
+        QFile                       _file;
+        uchar*                      _map;
+        QByteArray                  _bytes;         // If the file can't be mapped.
+        const char*                 _data;
+        qint64                      _size;
+        QDateTime                   _modified;
+        QVector<qint64>             _starts;
+};
+
+typedef QSharedPointer<const SeerSourceLines> SeerSourceLinesPtr;
+
+//
+// Loads source files for the editors.
+//
+// The file is mapped, not read. It's decoded (UTF-8) and its tabs expanded in one
+// pass into a buffer that's sized up front. Line endings become '\n' and the text
+// always ends with one, like the old QTextStream::readLine() loop did.
+//
+// The decoded text is kept in a cache, least recently used first out, so going back
+// to a file is free. An entry is good as long as the file's size and modification
+// time don't change. The cache is shared by everything in Seer and is only used
+// from the GUI thread.
+//
+// lines() gives the line index of a file (for the assembly view's source lines, say).
+// Those are cached too, with their mapping, in a cache of their own. readSource()
+// decodes from the same mapping, so a file is only mapped once.
+//
+//     QString text;
+//
+//     if (SeerSourceCache::readSource(filename, 4, text)) {
+//         setPlainText(text);
+//     }
+//
+
+class SeerSourceCache {
+
+    public:
+        static bool                 readSource                  (const QString& filename, int tabSize, QString& text);
+        static QString              decode                      (const char* data, qint64 size, int tabSize);
+        static SeerSourceLinesPtr   lines                       (const QString& filename);
+
+        static void                 setMaximumSize              (qint64 bytes);
+        static qint64               maximumSize                 ();
+        static qint64               size                        ();
+        static void                 setMaximumLinesSize         (qint64 bytes);
+        static qint64               maximumLinesSize            ();
+        static qint64               linesSize                   ();
+        static void                 clear                       ();
+
+        static quint64              hits                        ();
+        static quint64              misses                      ();
+};
+
@@ -0,0 +1,461 @@
+#include "SeerSourceResolver.h"
+#include <QtCore/QThread>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QDebug>
+#include <functional>
+
+static QLoggingCategory LC("seer.sourceresolver");
+
+namespace {
+
+    // Bigger directories aren't indexed. They're looked in the old way.
+    const int MaxIndexedFiles      = 200000;
+
+    // Watches are a limited resource (inotify). Don't use them all.
+    const int MaxWatchedDirectories = 4096;
+
+    class IndexThread : public QThread {
+
+        public:
+            explicit IndexThread (std::function<void ()> job) : _job(job) {
+            }
+
+        protected:
+            void run () override {
+                _job();
+            }
+
+        private:
+            std::function<void ()> _job;
+    };
+
+    //
+    // The path with a trailing '/', to see if other paths are under it.
+    //
+    QString directoryPrefix (const QString& directory) {
+
+        QString prefix = QDir::cleanPath(directory);
+
+        if (prefix.endsWith('/') == false) {
+            prefix += '/';
+        }
+
+        return prefix;
+    }
+}
+
+SeerSourceResolver::SeerSourceResolver (QObject* parent) : QObject(parent) {
+
+    _generation   = 0;
+    _watchRefused = false;
+    _hits         = 0;
+    _misses       = 0;
+    _stats        = 0;
+
+    // Changes come in bunches (a checkout, a build). Index again once they settle.
+    _reindexTimer.setSingleShot(true);
+    _reindexTimer.setInterval(1000);
+
+    QObject::connect(&_watcher,       &QFileSystemWatcher::directoryChanged,  this, &SeerSourceResolver::handleDirectoryChanged);
+    QObject::connect(&_reindexTimer,  &QTimer::timeout,                       this, &SeerSourceResolver::handleReindexTimer);
+}
+
+SeerSourceResolver::~SeerSourceResolver () {
+
+    for (QThread* thread : _threads) {
+        thread->requestInterruption();
+        thread->wait();
+        delete thread;
+    }
+}
+
+void SeerSourceResolver::setAlternateDirectories (const QStringList& alternateDirectories) {
+
+    if (alternateDirectories == _alternateDirectories) {
+        return;
+    }
+
+    _alternateDirectories = alternateDirectories;
+
+    // The answers depend on the list, and its order.
+    _answers.clear();
+
+    // Forget the directories that aren't in the list anymore.
+    for (const QString& directory : _indexes.keys()) {
+        if (_alternateDirectories.contains(directory) == false) {
+            _indexes.remove(directory);
+        }
+    }
+
+    for (const QString& directory : _pending.keys()) {
+        if (_alternateDirectories.contains(directory) == false) {
+            _pending.remove(directory);
+        }
+    }
+
+    // Index the new ones.
+    QStringList directories;
+
+    for (const QString& directory : _alternateDirectories) {
+        if (_indexes.contains(directory) == false && _pending.contains(directory) == false) {
+            directories.append(directory);
+        }
+    }
+
+    startIndex(directories);
+}
+
+const QStringList& SeerSourceResolver::alternateDirectories () const {
+
+    return _alternateDirectories;
+}
+
+QString SeerSourceResolver::findFile (const QString& file, const QString& fullname, const QString& alternateDirectory, const QStringList& alternateDirectories) {
+
+    //
+    // This function returns the filename to use to load the source file.
+    //
+    // 'file' is the short version of the filename. eg: 'source.cpp'
+    // 'fullname' is the long version. eg: '/path/to/locate/source.cpp'
+    // 'alternateDirectory' is the alternate directory to use if 'fullname' is not found.
+    // 'alternateDirectories' is a list of alternate directories if 'fullname' is not found
+    // and if 'file' is not in 'alternateDirectory'.
+    //
+    // 'alternateDirectory' can be blank ("") and usually is. If it isn't blank, then it
+    // takes presedence over 'fullname' and 'alternateDirectories'.
+    //
+    // 'alternateDirectories' is a list of directory locations. It defines the search order.
+    // Once a location has the 'file', the search stops and that directory is used.
+    //
+    // If the 'file' can't be found in any of the locations, a "" is returned.
+    //
+    // One note about 'fullname'. This is the path that gdb knows of. Gdb extracts the path
+    // from the debug information in the executable when it was compiled and linked.
+    //
+
+    setAlternateDirectories(alternateDirectories);
+
+    QString key = alternateDirectory + '\n' + fullname + '\n' + file;
+
+    QHash<QString,QString>::const_iterator i = _answers.constFind(key);
+
+    if (i != _answers.constEnd()) {
+        _hits++;
+        return i.value();
+    }
+
+    _misses++;
+
+    // Only keep the answer if a change to it would be seen.
+    bool    watched  = true;
+    QString filename = search(file, fullname, alternateDirectory, &watched);
+
+    if (watched) {
+        _answers.insert(key, filename);
+    }
+
+    return filename;
+}
+
+QString SeerSourceResolver::findFile (const QString& file, const QString& fullname) {
+
+    return findFile(file, fullname, "", _alternateDirectories);
+}
+
+bool SeerSourceResolver::isIndexing () const {
+
+    return _pending.isEmpty() == false;
+}
+
+void SeerSourceResolver::invalidate () {
+
+    _answers.clear();
+
+    startIndex(_alternateDirectories);
+}
+
+quint64 SeerSourceResolver::hits () const {
+
+    return _hits;
+}
+
+quint64 SeerSourceResolver::misses () const {
+
+    return _misses;
+}
+
+quint64 SeerSourceResolver::stats () const {
+
+    return _stats;
+}
+
+void SeerSourceResolver::handleDirectoryChanged (const QString& path) {
+
+    // A directory that's gone is no longer watched.
+    if (_watcher.directories().contains(path) == false) {
+        _watched.remove(path);
+    }
+
+    _answers.clear();
+
+    // Under an alternate directory? Its index may be wrong now. Don't use it until it's redone.
+    QString directory = alternateDirectoryOf(path);
+
+    if (directory == "") {
+        return;
+    }
+
+    QHash<QString,Index>::iterator i = _indexes.find(directory);
+
+    if (i != _indexes.end()) {
+        i->complete = false;
+    }
+
+    _reindex.insert(directory);
+    _reindexTimer.start();
+}
+
+void SeerSourceResolver::handleReindexTimer () {
+
+    QStringList directories = _reindex.values();
+
+    _reindex.clear();
+
+    startIndex(directories);
+}
+
+QString SeerSourceResolver::search (const QString& file, const QString& fullname, const QString& alternateDirectory, bool* watched) {
+
+    // Use 'alternateDirectory', if provided.
+    if (alternateDirectory != "") {
+
+        QString filename = alternateDirectory + "/" + file;
+
+        if (exists(filename, watched) == false) {
+            return "";
+        }
+
+        return filename;
+    }
+
+    // Handle 'fullname'.
+    if (fullname != "" && exists(fullname, watched) == true) {
+        return fullname;
+    }
+
+    // Handle 'alternateDirectories'. From the index, if there's one, and the file would be in it.
+    QString basename = QFileInfo(file).fileName();
+
+    for (const QString& directory : _alternateDirectories) {
+
+        QString filename = directory + "/" + file;
+
+        QHash<QString,Index>::const_iterator i = _indexes.constFind(directory);
+
+        if (i != _indexes.constEnd() && i->complete) {
+
+            QString path = QDir::cleanPath(filename);
+
+            if (path.startsWith(directoryPrefix(directory))) {
+
+                if (i->files.value(basename).contains(path)) {
+                    return filename;
+                }
+
+                // Not in the index. That's only seen to change if all of its directories are watched.
+                if (_watchRefused) {
+                    *watched = false;
+                }
+
+                continue;
+            }
+        }
+
+        if (exists(filename, watched) == true) {
+            return filename;
+        }
+    }
+
+    // Not found anywhere.
+    return "";
+}
+
+bool SeerSourceResolver::exists (const QString& filename, bool* watched) {
+
+    _stats++;
+
+    QFileInfo info(filename);
+
+    if (info.exists()) {
+        watch(info.absolutePath());
+        return true;
+    }
+
+    //
+    // Watch where it should be, so we see it turn up. If its directory isn't there
+    // (yet), watch the nearest one up that is. Making the missing directory changes that
+    // one, which drops the answer, and the next look watches further down.
+    //
+    QString directory = info.absolutePath();
+
+    while (_watched.contains(directory) == false) {
+
+        _stats++;
+
+        if (QFileInfo(directory).isDir()) {
+            break;
+        }
+
+        QString parent = QFileInfo(directory).path();
+
+        if (parent == directory) {
+            break;
+        }
+
+        directory = parent;
+    }
+
+    if (watch(directory) == false) {
+        *watched = false;
+    }
+
+    return false;
+}
+
+bool SeerSourceResolver::watch (const QString& directory) {
+
+    if (_watched.contains(directory)) {
+        return true;
+    }
+
+    if (_watched.size() >= MaxWatchedDirectories) {
+        _watchRefused = true;
+        return false;
+    }
+
+    if (_watcher.addPath(directory) == false) {
+        return false;
+    }
+
+    _watched.insert(directory);
+
+    return true;
+}
+
+void SeerSourceResolver::startIndex (const QStringList& directories) {
+
+    for (const QString& directory : directories) {
+
+        int generation = ++_generation;
+
+        _pending.insert(directory, generation);
+
+        QSharedPointer<Index> index(new Index);
+
+        IndexThread* thread = new IndexThread([directory, index]() { indexDirectory(directory, index.data()); });
+
+        QObject::connect(thread, &QThread::finished, this, [this, thread, directory, index, generation]() {
+
+            _threads.removeOne(thread);
+
+            thread->deleteLater();
+
+            indexFinished(directory, *index, generation);
+        });
+
+        _threads.append(thread);
+
+        thread->start(QThread::LowPriority);
+    }
+}
+
+void SeerSourceResolver::indexFinished (const QString& directory, const Index& index, int generation) {
+
+    // A newer index of it was started. Or it's no longer an alternate directory.
+    if (_pending.value(directory) != generation) {
+        return;
+    }
+
+    _pending.remove(directory);
+
+    qCDebug(LC) << "Indexed" << directory << ":" << index.files.size() << "names," << index.directories.size() << "directories" << (index.complete ? "" : "(incomplete)");
+
+    _indexes.insert(directory, index);
+
+    watch(directory);
+
+    for (const QString& subdirectory : index.directories) {
+        watch(subdirectory);
+    }
+
+    if (_pending.isEmpty()) {
+        emit indexed();
+    }
+}
+
+QString SeerSourceResolver::alternateDirectoryOf (const QString& path) const {
+
+    QString cleanPath = QDir::cleanPath(path);
+
+    for (const QString& directory : _alternateDirectories) {
+
+        if (cleanPath == QDir::cleanPath(directory) || cleanPath.startsWith(directoryPrefix(directory))) {
+            return directory;
+        }
+    }
+
+    return "";
+}
+
+void SeerSourceResolver::indexDirectory (const QString& directory, Index* index) {
+
+    //
+    // Runs in its own thread. Don't touch anything but 'index'.
+    //
+
+    QElapsedTimer timer;
+    timer.start();
+
+    index->complete = false;
+
+    if (QFileInfo(directory).isDir() == false) {
+        return;
+    }
+
+    int count = 0;
+
+    QDirIterator it(directory, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System, QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+
+    while (it.hasNext()) {
+
+        if (QThread::currentThread()->isInterruptionRequested()) {
+            return;
+        }
+
+        QString   path = it.next();
+        QFileInfo info = it.fileInfo();
+
+        if (info.isDir()) {
+            index->directories.append(path);
+            continue;
+        }
+
+        index->files[info.fileName()].append(QDir::cleanPath(path));
+
+        if (++count > MaxIndexedFiles) {
+            index->files.clear();
+            index->directories.clear();
+            return;
+        }
+    }
+
+    index->complete = true;
+
+    qCDebug(LC) << "Indexed" << count << "files in" << directory << "in" << timer.elapsed() << "ms";
+}
+
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QList>
+#include <QtCore/QTimer>
+#include <QtCore/QFileSystemWatcher>
+
+class QThread;
+
+//
+// Finds the file to load for a source file gdb tells us about. See findFile() for
+// the search order.
+//
+// The alternate directories are indexed in the background (basename to paths), so
+// looking for a file in them doesn't stat() each one. Until a directory's index is
+// done, it's looked in the old way.
+//
+// Answers, found or not, are cached. The alternate directories, and the directories
+// of the files looked up, are watched. A change in any of them drops the cached
+// answers and has the directory indexed again. Where a file wasn't found, the nearest
+// directory that's there is watched, so a directory made later is seen too. An answer
+// that depends on a place that couldn't be watched isn't cached.
+//
+// One of these is shared by the source editors, the assembly view, and the source
+// browser.
+//
+
+class SeerSourceResolver : public QObject {
+
+    Q_OBJECT
+
+    public:
+        explicit SeerSourceResolver (QObject* parent = 0);
+       ~SeerSourceResolver ();
+
+        void                            setAlternateDirectories         (const QStringList& alternateDirectories);
+        const QStringList&              alternateDirectories            () const;
+
+        QString                         findFile                        (const QString& file, const QString& fullname, const QString& alternateDirectory, const QStringList& alternateDirectories);
+        QString                         findFile                        (const QString& file, const QString& fullname);
+
+        bool                            isIndexing                      () const;
+        void                            invalidate                      ();
+
+        quint64                         hits                            () const;
+        quint64                         misses                          () const;
+        quint64                         stats                           () const;
+
+    signals:
+        void                            indexed                         ();
+
+    private slots:
+        void                            handleDirectoryChanged          (const QString& path);
+        void                            handleReindexTimer              ();
+
+    private:
+        struct Index {
+            QHash<QString,QStringList>  files;          // Basename to paths.
+            QStringList                 directories;    // Subdirectories, to watch.
+            bool                        complete;       // False if it was too big, or stopped.
+        };
+
+        QString                         search                          (const QString& file, const QString& fullname, const QString& alternateDirectory, bool* watched);
+        bool                            exists                          (const QString& filename, bool* watched);
+        bool                            watch                           (const QString& directory);
+        void                            startIndex                      (const QStringList& directories);
+        void                            indexFinished                   (const QString& directory, const Index& index, int generation);
+        QString                         alternateDirectoryOf            (const QString& path) const;
+
+        static void                     indexDirectory                  (const QString& directory, Index* index);
+
+        QStringList                     _alternateDirectories;
+        QHash<QString,Index>            _indexes;
+        QHash<QString,QString>          _answers;       // "" if it wasn't found.
+        QFileSystemWatcher              _watcher;
+        QSet<QString>                   _watched;
+        bool                            _watchRefused;  // A directory wasn't watched, there were too many.
+        QSet<QString>                   _reindex;
+        QTimer                          _reindexTimer;
+        QList<QThread*>                 _threads;
+        QHash<QString,int>              _pending;       // The latest index started for each directory.
+        int                             _generation;
+        quint64                         _hits;
+        quint64                         _misses;
+        quint64                         _stats;
+};
+
@@ -6,8 +6,136 @@
 #include <QtWidgets/QMenu>
 #include <QtGui/QFontDatabase>
 #include <QAction>
+#include <QtCore/QHash>
 #include <QtCore/QDebug>
 
+namespace {
+
+    //
+    // The key of the n'th item with a name, at one level of the tree.
+    //
+    QString itemKey (const QString& name, QHash<QString,int>& counts) {
+
+        int n = counts[name]++;
+
+        if (n == 0) {
+            return name;
+        }
+
+        return name + '\n' + QString::number(n);
+    }
+
+    //
+    // The items that are expanded, from 'item' down.
+    //
+    void expandedItems (QTreeWidgetItem* item, QVector<QTreeWidgetItem*>& expanded) {
+
+        if (item->isExpanded()) {
+            expanded.append(item);
+        }
+
+        for (int i=0; i<item->childCount(); i++) {
+            expandedItems(item->child(i), expanded);
+        }
+    }
+
+    //
+    // Which of 'positions' make the longest run that's already in order. A position
+    // of -1 is never part of it.
+    //
+    QVector<bool> inOrder (const QVector<int>& positions) {
+
+        QVector<int> tails;                                 // The smallest last entry of a run of each length.
+        QVector<int> previous(positions.size(), -1);
+
+        for (int i=0; i<positions.size(); i++) {
+
+            if (positions[i] < 0) {
+                continue;
+            }
+
+            int lo = 0;
+            int hi = tails.size();
+
+            while (lo < hi) {
+
+                int mid = (lo + hi) / 2;
+
+                if (positions[tails[mid]] < positions[i]) {
+                    lo = mid + 1;
+                }else{
+                    hi = mid;
+                }
+            }
+
+            if (lo > 0) {
+                previous[i] = tails[lo-1];
+            }
+
+            if (lo == tails.size()) {
+                tails.append(i);
+            }else{
+                tails[lo] = i;
+            }
+        }
+
+        QVector<bool> keep(positions.size(), false);
+
+        for (int i = tails.isEmpty() ? -1 : tails.last(); i >= 0; i = previous[i]) {
+            keep[i] = true;
+        }
+
+        return keep;
+    }
+
+    //
+    // Put the children of 'parentItem' in the order of 'items'. The children must all be
+    // in 'items'. The ones that aren't children yet are inserted. Only the ones that are
+    // out of order are moved, and they keep what was expanded under them.
+    //
+    void placeItems (QTreeWidgetItem* parentItem, const QVector<QTreeWidgetItem*>& items) {
+
+        QHash<QTreeWidgetItem*,int> indexes;
+
+        for (int i=0; i<parentItem->childCount(); i++) {
+            indexes.insert(parentItem->child(i), i);
+        }
+
+        QVector<int> positions;
+
+        for (QTreeWidgetItem* item : items) {
+            positions.append(indexes.value(item, -1));
+        }
+
+        QVector<bool> keep = inOrder(positions);
+
+        // Take out the ones that moved.
+        QVector<QTreeWidgetItem*> expanded;
+
+        for (int i=0; i<items.size(); i++) {
+
+            if (positions[i] >= 0 && keep[i] == false) {
+
+                expandedItems(items[i], expanded);
+
+                parentItem->takeChild(parentItem->indexOfChild(items[i]));
+            }
+        }
+
+        // What's left is in order. Put the others in around them.
+        for (int i=0; i<items.size(); i++) {
+
+            if (keep[i] == false) {
+                parentItem->insertChild(i, items[i]);
+            }
+        }
+
+        for (QTreeWidgetItem* item : expanded) {
+            item->setExpanded(true);
+        }
+    }
+}
+
 SeerStackArgumentsBrowserWidget::SeerStackArgumentsBrowserWidget (QWidget* parent) : QWidget(parent) {
 
     // Construct the UI.
@@ -20,8 +148,6 @@ SeerStackArgumentsBrowserWidget::SeerStackArgumentsBrowserWidget (QWidget* paren
     argumentsTreeWidget->resizeColumnToContents(0); // level
     argumentsTreeWidget->resizeColumnToContents(1); // Name
     argumentsTreeWidget->resizeColumnToContents(2); // Value
-    argumentsTreeWidget->resizeColumnToContents(3); // used
-    argumentsTreeWidget->setColumnHidden(3, true);  // Hide the 'used' column.
     argumentsTreeWidget->clear();
 
     // Connect things.
@@ -62,15 +188,22 @@ void SeerStackArgumentsBrowserWidget::handleText (const QString& text) {
 
         QStringList frame_list = Seer::parse(text, "frame=", '{', '}', false);
 
-        // Mark each entry initially as "unused".
-        // Later, some will be marked as "reused" or "new". Then the "unused" ones will
-        // be deleted.
-        QTreeWidgetItemIterator it(argumentsTreeWidget);
-        while (*it) {
-            (*it)->setText(3, "unused");
-            ++it;
+        // Populate the tree. The changes are worked out level by level and applied in one go.
+        argumentsTreeWidget->setUpdatesEnabled(false);
+
+        QTreeWidgetItem* rootItem = argumentsTreeWidget->invisibleRootItem();
+
+        // The frame levels there now.
+        QHash<QString,QTreeWidgetItem*> levelItems;
+
+        for (int i=0; i<rootItem->childCount(); i++) {
+            levelItems.insert(rootItem->child(i)->text(0), rootItem->child(i));
         }
 
+        // Match each level to its item. Reuse it, or create a new one.
+        QVector<QTreeWidgetItem*>  topItems;
+        QVector<QVector<Argument>> levelArguments;
+
         for ( const auto& frame_text : frame_list  ) {
 
             QString level_text = Seer::parseFirst(frame_text, "level=", '"', '"', false);
@@ -78,62 +211,49 @@ void SeerStackArgumentsBrowserWidget::handleText (const QString& text) {
 
             QStringList namevalue_list  = Seer::parse(args_text, "",  '{', '}', false);
 
-            QList<QTreeWidgetItem*> matches = argumentsTreeWidget->findItems(level_text, Qt::MatchExactly, 0);
-
-            QTreeWidgetItem* topItem = 0;
-
-            // Use an existing level.
-            if (matches.count() > 0) {
-                topItem = matches[0];
-                topItem->setText(3, "reused");
+            QTreeWidgetItem* topItem = levelItems.take(level_text);
 
             // Add the new level to the tree.
-            }else{
+            if (topItem == 0) {
                 topItem = new QTreeWidgetItem;
                 topItem->setText(0, level_text);
-                topItem->setText(3, "new");
-
-                argumentsTreeWidget->addTopLevelItem(topItem);
             }
 
+            topItems.append(topItem);
+
             // Get the argument names and values for the level.
+            QVector<Argument> arguments;
+
             for ( const auto& namevalue_text : namevalue_list  ) {
 
-                QString name_text  = Seer::parseFirst(namevalue_text, "name=",  '"', '"', false);
-                QString value_text = Seer::parseFirst(namevalue_text, "value=", '"', '"', false);
+                Argument argument;
+
+                argument.name  = Seer::parseFirst(namevalue_text, "name=",  '"', '"', false);
+                argument.value = Seer::parseFirst(namevalue_text, "value=", '"', '"', false);
 
-                // Populate the tree.
-                handleItemCreate(topItem, "", name_text, value_text);
+                arguments.append(argument);
             }
 
-            // Expand all items for the level.
-            argumentsTreeWidget->expandItem(topItem);
+            levelArguments.append(arguments);
         }
 
-        // At this point, there are some new entries, some reused entries, and some unused ones.
-        // Delete the unused ones. They are obsolete.
-        // Don't use qDeleteAll() here. It doesn't work as expected for items that are "found".
-        // Instead, get a list of matches and delete them from the bottom up.
-        QList<QTreeWidgetItem*> matches = argumentsTreeWidget->findItems("unused", Qt::MatchExactly|Qt::MatchRecursive, 3);
+        // The levels that are left are obsolete. Delete them first, so they don't push the others out of place.
+        for (QTreeWidgetItem* topItem : levelItems) {
+            delete topItem;
+        }
 
-        while (matches.isEmpty() == false) {
-            foreach (QTreeWidgetItem* item, matches) {
-                if (item->childCount() == 0) {
-                    QTreeWidgetItem* parent = item->parent();
-                    if (parent) {
-                        parent->removeChild(item);
-                    }
+        placeItems(rootItem, topItems);
 
-                    bool f = matches.removeOne(item);
-                    Q_ASSERT(f != false);
+        for (int i=0; i<topItems.size(); i++) {
 
-                    delete item;
+            handleItemsUpdate(topItems[i], levelArguments[i]);
 
-                    break;
-                }
-            }
+            // Expand all items for the level.
+            argumentsTreeWidget->expandItem(topItems[i]);
         }
 
+        argumentsTreeWidget->setUpdatesEnabled(true);
+
     }else if (text.startsWith("^error,msg=\"No registers.\"")) {
         argumentsTreeWidget->clear();
 
@@ -144,7 +264,6 @@ void SeerStackArgumentsBrowserWidget::handleText (const QString& text) {
     argumentsTreeWidget->resizeColumnToContents(0);
     argumentsTreeWidget->resizeColumnToContents(1);
     argumentsTreeWidget->resizeColumnToContents(2);
-    argumentsTreeWidget->resizeColumnToContents(3);
 
     QApplication::restoreOverrideCursor();
 }
@@ -454,7 +573,6 @@ void SeerStackArgumentsBrowserWidget::handleItemExpanded (QTreeWidgetItem* item)
     argumentsTreeWidget->resizeColumnToContents(0);
     argumentsTreeWidget->resizeColumnToContents(1);
     argumentsTreeWidget->resizeColumnToContents(2);
-    argumentsTreeWidget->resizeColumnToContents(3);
 }
 
 void SeerStackArgumentsBrowserWidget::handleItemCollapsed (QTreeWidgetItem* item) {
@@ -464,7 +582,6 @@ void SeerStackArgumentsBrowserWidget::handleItemCollapsed (QTreeWidgetItem* item
     argumentsTreeWidget->resizeColumnToContents(0);
     argumentsTreeWidget->resizeColumnToContents(1);
     argumentsTreeWidget->resizeColumnToContents(2);
-    argumentsTreeWidget->resizeColumnToContents(3);
 }
 
 void SeerStackArgumentsBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int column) {
@@ -487,40 +604,67 @@ void SeerStackArgumentsBrowserWidget::handleItemEntered (QTreeWidgetItem* item,
     }
 }
 
-void SeerStackArgumentsBrowserWidget::handleItemCreate (QTreeWidgetItem* parentItem, const QString& level_text, const QString& name_text, const QString& value_text) {
+void SeerStackArgumentsBrowserWidget::handleItemsUpdate (QTreeWidgetItem* parentItem, const QVector<Argument>& arguments) {
 
     // Instead of creating a new tree each time, we will reuse existing items, if they are there.
-    // This allows the expanded items to remain expanded. We start by looking for matches that
-    // may already be there. If there are matches, the code will reuse it.  If not, a new item
-    // is created by the code. Note, when searching, we only look at the current level. Not any
-    // children.
-    QList<QTreeWidgetItem*> matches;
-
-    if (parentItem == 0) {
-        Q_ASSERT(parentItem != NULL);
-        return;
-    }else{
-        for (int i=0; i<parentItem->childCount(); i++) {
-            if (parentItem->child(i)->text(1) == name_text) {
-                matches.append(parentItem->child(i));
-            }
+    // This allows the expanded items to remain expanded. The items of the level are looked up
+    // by name. If a name is there more than once, the second one in the list gets the second
+    // one in the tree. Note, we only look at the current level. Not any children.
+    QHash<QString,QTreeWidgetItem*> items;
+    QHash<QString,int>              counts;
+
+    for (int i=0; i<parentItem->childCount(); i++) {
+        items.insert(itemKey(parentItem->child(i)->text(1), counts), parentItem->child(i));
+    }
+
+    counts.clear();
+
+    // Match each argument to its item. Reuse it, or create a new one.
+    QVector<QTreeWidgetItem*> placed;
+    QVector<bool>             created;
+
+    for (const Argument& argument : arguments) {
+
+        QTreeWidgetItem* item = items.take(itemKey(argument.name, counts));
+
+        created.append(item == 0);
+
+        if (item == 0) {
+            item = new QTreeWidgetItem;
+            item->setText(1, argument.name);
         }
+
+        placed.append(item);
+    }
+
+    // What's left is obsolete. Delete it first, so it doesn't push the others out of place.
+    for (QTreeWidgetItem* item : items) {
+        delete item;
     }
 
+    placeItems(parentItem, placed);
+
+    for (int i=0; i<placed.size(); i++) {
+        handleItemUpdate(placed[i], arguments[i], created[i]);
+    }
+}
+
+void SeerStackArgumentsBrowserWidget::handleItemUpdate (QTreeWidgetItem* item, const Argument& argument, bool created) {
+
     // Parse bookmarks.
     QString capture0; // With const address.
     QString capture1; // Without.
 
-    QRegularExpression withaddress_re("^@0[xX][0-9a-fA-F]+: \\{(.*?)\\}$");
-    QRegularExpressionMatch withaddress_match = withaddress_re.match(value_text, 0, QRegularExpression::PartialPreferCompleteMatch);
+    QRegularExpression withaddress_re = Seer::regex("^@0[xX][0-9a-fA-F]+: \\{(.*?)\\}$");
+    QRegularExpressionMatch withaddress_match = withaddress_re.match(argument.value, 0, QRegularExpression::PartialPreferCompleteMatch);
 
     if (withaddress_match.hasMatch()) {
         capture0 = withaddress_match.captured(0);
         capture1 = withaddress_match.captured(1);
 
     }else{
-        QRegularExpression noaddress_re("^\\{(.*?)\\}$");
-        QRegularExpressionMatch noaddress_match   = noaddress_re.match(value_text, 0, QRegularExpression::PartialPreferCompleteMatch);
+        QRegularExpression noaddress_re = Seer::regex("^\\{(.*?)\\}$");
+        QRegularExpressionMatch noaddress_match   = noaddress_re.match(argument.value, 0, QRegularExpression::PartialPreferCompleteMatch);
 
         if (noaddress_match.hasMatch()) {
             capture0 = noaddress_match.captured(0);
@@ -528,82 +672,43 @@ void SeerStackArgumentsBrowserWidget::handleItemCreate (QTreeWidgetItem* parentI
         }
     }
 
-    // Add the complex entry to the tree. Reuse, if possible.
-    if (capture0 != "" && capture1 != "") {
+    bool    complex = (capture0 != "" && capture1 != "");
+    QString value   = Seer::filterEscapes(complex ? capture1 : argument.value); // Remove bookends, if complex.
 
-        // Remove bookends
-        QString text = capture1;
+    // Show the values that changed since the last time in bold.
+    QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    font.setBold(created == false && item->text(2) != value);
 
-        QTreeWidgetItem* item = 0;
+    // Populate the item.
+    item->setText(0, "");
+    item->setText(1, argument.name);
+    item->setText(2, value);
+    item->setFont(2, font);
 
-        // Use the privously created item. Or create a new one.
-        if (matches.size() > 0) {
-            item = matches[0];
-            item->setText(3, "reused");
+    // Add the complex entry's name/value pairs to the tree.
+    if (complex) {
 
-        }else{
-            item = new QTreeWidgetItem;
-            item->setText(3, "new");
+        QStringList nv_pairs = Seer::parseCommaList(capture1, '{', '}');
 
-            // If we're dealing with a top-level item, attach it to the tree.
-            // Otherwise, attach it to the parent.
-            if (parentItem) {
-                parentItem->addChild(item);
-            }else{
-                argumentsTreeWidget->addTopLevelItem(item);
-            }
-        }
-
-        // Set the flatvalue text.
-        item->setText(0, level_text);
-        item->setText(1, name_text);
-        item->setText(2, Seer::filterEscapes(text));
-        item->setFont(2, QFontDatabase::systemFont(QFontDatabase::FixedFont));
-
-        // Convert to a list of name/value pairs.
-        QStringList nv_pairs = Seer::parseCommaList(text, '{', '}');
+        QVector<Argument> children;
 
-        // Go through each pair and add the name and its value to the tree.
         for (const auto& nv : nv_pairs) {
 
             QStringPair pair = Seer::parseNameValue(nv, '=');
 
-            handleItemCreate(item, level_text, pair.first, pair.second);
-        }
-
-    // Add the simple entry to the tree. Reuse, if possible.
-    }else{
-        QTreeWidgetItem* item = 0;
+            Argument child;
 
-        // Use the privously created item. Or create a new one.
-        if (matches.size() > 0) {
-            item = matches[0];
-            item->setText(3, "reused");
+            child.name  = pair.first;
+            child.value = pair.second;
 
-        }else{
-            item = new QTreeWidgetItem;
-            item->setText(3, "new");
-
-            // If we're dealing with a top-level item, attach it to the tree.
-            // Otherwise, attach it to the parent.
-            if (parentItem) {
-                parentItem->addChild(item);
-            }else{
-                argumentsTreeWidget->addTopLevelItem(item);
-            }
+            children.append(child);
         }
 
-        // Simple entries don't have children. Delete them.
-        QList<QTreeWidgetItem*> children = item->takeChildren();
-        if (matches.size() > 0) {
-            qDeleteAll(children);
-        }
+        handleItemsUpdate(item, children);
 
-        // Populate the item.
-        item->setText(0, level_text);
-        item->setText(1, name_text);
-        item->setText(2, Seer::filterEscapes(value_text));
-        item->setFont(2, QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    // Simple entries don't have children. Delete them.
+    }else{
+        qDeleteAll(item->takeChildren());
     }
 }
 
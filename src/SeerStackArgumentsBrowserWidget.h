@@ -2,6 +2,7 @@
 
 #include <QtWidgets/QWidget>
 #include <QtCore/QString>
+#include <QtCore/QVector>
 #include "ui_SeerStackArgumentsBrowserWidget.h"
 
 class SeerStackArgumentsBrowserWidget : public QWidget, protected Ui::SeerStackArgumentsBrowserWidgetForm {
@@ -33,7 +34,13 @@ class SeerStackArgumentsBrowserWidget : public QWidget, protected Ui::SeerStackA
         void                addStructVisualize                  (QString expression);
 
     protected:
-        void                handleItemCreate                    (QTreeWidgetItem* parentItem, const QString& level_text, const QString& name_text, const QString& value_text);
+        struct Argument {
+            QString         name;
+            QString         value;
+        };
+
+        void                handleItemsUpdate                   (QTreeWidgetItem* parentItem, const QVector<Argument>& arguments);
+        void                handleItemUpdate                    (QTreeWidgetItem* item, const Argument& argument, bool created);
         void                showEvent                           (QShowEvent* event);
 
     private:
@@ -1,5 +1,6 @@
 #include "SeerStackFramesBrowserWidget.h"
 #include "SeerUtl.h"
+#include "GdbMiParser.h"
 #include <QtWidgets/QTreeWidget>
 #include <QtWidgets/QTreeWidgetItemIterator>
 #include <QtWidgets/QApplication>
@@ -60,27 +61,26 @@ void SeerStackFramesBrowserWidget::handleText (const QString& text) {
 
             stackTreeWidget->clear();
 
-            QString stack_text = Seer::parseFirst(text, "stack=", '[', ']', false);
+            GdbMiRecord record = GdbMiParser::parse(text);
+            GdbMiValue  stack  = record["stack"];
 
-            if (stack_text != "") {
-
-                // Parse through the frame list and set the current lines that are in the frame list.
-                QStringList frame_list = Seer::parse(text, "frame=", '{', '}', false);
+            if (stack.isEmpty() == false) {
 
                 QString firstLiveFrameLevel     = "";
                 QString firstLiveFrameFile      = "";
                 QString firstLiveFrameFullname  = "";
                 QString firstLiveFrameLine      = "";
 
-                for ( const auto& frame_text : frame_list  ) {
-
-                    QString level_text    = Seer::parseFirst(frame_text, "level=",    '"', '"', false);
-                    QString addr_text     = Seer::parseFirst(frame_text, "addr=",     '"', '"', false);
-                    QString func_text     = Seer::parseFirst(frame_text, "func=",     '"', '"', false);
-                    QString file_text     = Seer::parseFirst(frame_text, "file=",     '"', '"', false);
-                    QString fullname_text = Seer::parseFirst(frame_text, "fullname=", '"', '"', false);
-                    QString line_text     = Seer::parseFirst(frame_text, "line=",     '"', '"', false);
-                    QString arch_text     = Seer::parseFirst(frame_text, "arch=",     '"', '"', false);
+                // Parse through the frame list and set the current lines that are in the frame list.
+                for (const GdbMiValue& frame : stack) {
+
+                    QString level_text    = frame["level"].toString();
+                    QString addr_text     = frame["addr"].toString();
+                    QString func_text     = frame["func"].toString();
+                    QString file_text     = frame["file"].toString();
+                    QString fullname_text = frame["fullname"].toString();
+                    QString line_text     = frame["line"].toString();
+                    QString arch_text     = frame["arch"].toString();
 
                     // Create the item.
                     QTreeWidgetItem* item = new QTreeWidgetItem;
@@ -6,10 +6,138 @@
 #include <QtWidgets/QMenu>
 #include <QtGui/QFontDatabase>
 #include <QtCore/QRegularExpressionMatch>
+#include <QtCore/QHash>
 #include <QAction>
 #include <QtCore/QDebug>
 #include <QtGlobal>
 
+namespace {
+
+    //
+    // The key of the n'th item with a name, at one level of the tree.
+    //
+    QString itemKey (const QString& name, QHash<QString,int>& counts) {
+
+        int n = counts[name]++;
+
+        if (n == 0) {
+            return name;
+        }
+
+        return name + '\n' + QString::number(n);
+    }
+
+    //
+    // The items that are expanded, from 'item' down.
+    //
+    void expandedItems (QTreeWidgetItem* item, QVector<QTreeWidgetItem*>& expanded) {
+
+        if (item->isExpanded()) {
+            expanded.append(item);
+        }
+
+        for (int i=0; i<item->childCount(); i++) {
+            expandedItems(item->child(i), expanded);
+        }
+    }
+
+    //
+    // Which of 'positions' make the longest run that's already in order. A position
+    // of -1 is never part of it.
+    //
+    QVector<bool> inOrder (const QVector<int>& positions) {
+
+        QVector<int> tails;                                 // The smallest last entry of a run of each length.
+        QVector<int> previous(positions.size(), -1);
+
+        for (int i=0; i<positions.size(); i++) {
+
+            if (positions[i] < 0) {
+                continue;
+            }
+
+            int lo = 0;
+            int hi = tails.size();
+
+            while (lo < hi) {
+
+                int mid = (lo + hi) / 2;
+
+                if (positions[tails[mid]] < positions[i]) {
+                    lo = mid + 1;
+                }else{
+                    hi = mid;
+                }
+            }
+
+            if (lo > 0) {
+                previous[i] = tails[lo-1];
+            }
+
+            if (lo == tails.size()) {
+                tails.append(i);
+            }else{
+                tails[lo] = i;
+            }
+        }
+
+        QVector<bool> keep(positions.size(), false);
+
+        for (int i = tails.isEmpty() ? -1 : tails.last(); i >= 0; i = previous[i]) {
+            keep[i] = true;
+        }
+
+        return keep;
+    }
+
+    //
+    // Put the children of 'parentItem' in the order of 'items'. The children must all be
+    // in 'items'. The ones that aren't children yet are inserted. Only the ones that are
+    // out of order are moved, and they keep what was expanded under them.
+    //
+    void placeItems (QTreeWidgetItem* parentItem, const QVector<QTreeWidgetItem*>& items) {
+
+        QHash<QTreeWidgetItem*,int> indexes;
+
+        for (int i=0; i<parentItem->childCount(); i++) {
+            indexes.insert(parentItem->child(i), i);
+        }
+
+        QVector<int> positions;
+
+        for (QTreeWidgetItem* item : items) {
+            positions.append(indexes.value(item, -1));
+        }
+
+        QVector<bool> keep = inOrder(positions);
+
+        // Take out the ones that moved.
+        QVector<QTreeWidgetItem*> expanded;
+
+        for (int i=0; i<items.size(); i++) {
+
+            if (positions[i] >= 0 && keep[i] == false) {
+
+                expandedItems(items[i], expanded);
+
+                parentItem->takeChild(parentItem->indexOfChild(items[i]));
+            }
+        }
+
+        // What's left is in order. Put the others in around them.
+        for (int i=0; i<items.size(); i++) {
+
+            if (keep[i] == false) {
+                parentItem->insertChild(i, items[i]);
+            }
+        }
+
+        for (QTreeWidgetItem* item : expanded) {
+            item->setExpanded(true);
+        }
+    }
+}
+
 SeerStackLocalsBrowserWidget::SeerStackLocalsBrowserWidget (QWidget* parent) : QWidget(parent) {
 
     // Construct the UI.
@@ -22,8 +150,6 @@ SeerStackLocalsBrowserWidget::SeerStackLocalsBrowserWidget (QWidget* parent) : Q
     localsTreeWidget->resizeColumnToContents(0); // name
     localsTreeWidget->resizeColumnToContents(1); // arg
     localsTreeWidget->resizeColumnToContents(2); // value
-    localsTreeWidget->resizeColumnToContents(3); // used
-    localsTreeWidget->setColumnHidden(3, true);  // Hide the 'used' column.
     localsTreeWidget->clear();
 
     _frameNumber = 0;
@@ -59,52 +185,28 @@ void SeerStackLocalsBrowserWidget::handleText (const QString& text) {
 
         QStringList variable_list = Seer::parse(frame_text, "", '{', '}', false);
 
-        // Mark each entry initially as "unused".
-        // Later, some will be marked as "reused" or "new". Then the "unused" ones will
-        // be deleted.
-        QTreeWidgetItemIterator it(localsTreeWidget);
-        while (*it) {
-            (*it)->setText(3, "unused");
-            ++it;
-        }
+        QVector<Variable> variables;
 
-        // Loop through each variable.
         for (const auto& variable_text : variable_list) {
 
-            QString name_text  = Seer::parseFirst(variable_text, "name=",  '"', '"', false);
-            QString arg_text   = Seer::parseFirst(variable_text, "arg=",   '"', '"', false);
-            QString value_text = Seer::parseFirst(variable_text, "value=", '"', '"', false);
+            Variable variable;
+
+            variable.name  = Seer::parseFirst(variable_text, "name=",  '"', '"', false);
+            variable.arg   = Seer::parseFirst(variable_text, "arg=",   '"', '"', false);
+            variable.value = Seer::parseFirst(variable_text, "value=", '"', '"', false);
 
             // Morph 'is function argument' from a '1' to 'yes'.
-            arg_text = (arg_text == "1" ? "yes" : "");
+            variable.arg = (variable.arg == "1" ? "yes" : "");
 
-            // Populate the tree.
-            handleItemCreate(0, name_text, arg_text, value_text);
+            variables.append(variable);
         }
 
-        // At this point, there are some new entries, some reused entries, and some unused ones.
-        // Delete the unused ones. They are obsolete.
-        // Don't use qDeleteAll() here. It doesn't work as expected for items that are "found".
-        // Instead, get a list of matches and delete them from the bottom up.
-        QList<QTreeWidgetItem*> matches = localsTreeWidget->findItems("unused", Qt::MatchExactly|Qt::MatchRecursive, 3);
-
-        while (matches.isEmpty() == false) {
-            foreach (QTreeWidgetItem* item, matches) {
-                if (item->childCount() == 0) {
-                    QTreeWidgetItem* parent = item->parent();
-                    if (parent) {
-                        parent->removeChild(item);
-                    }
+        // Populate the tree. The changes are worked out level by level and applied in one go.
+        localsTreeWidget->setUpdatesEnabled(false);
 
-                    bool f = matches.removeOne(item);
-                    Q_ASSERT(f != false);
+        handleItemsUpdate(localsTreeWidget->invisibleRootItem(), variables);
 
-                    delete item;
-
-                    break;
-                }
-            }
-        }
+        localsTreeWidget->setUpdatesEnabled(true);
 
     }else if (text.startsWith("^error,msg=\"No registers.\"")) {
         localsTreeWidget->clear();
@@ -116,7 +218,6 @@ void SeerStackLocalsBrowserWidget::handleText (const QString& text) {
     localsTreeWidget->resizeColumnToContents(0);
     localsTreeWidget->resizeColumnToContents(1);
     localsTreeWidget->resizeColumnToContents(2);
-    localsTreeWidget->resizeColumnToContents(3);
 
     QApplication::restoreOverrideCursor();
 }
@@ -430,7 +531,6 @@ void SeerStackLocalsBrowserWidget::handleItemExpanded (QTreeWidgetItem* item) {
     localsTreeWidget->resizeColumnToContents(0);
     localsTreeWidget->resizeColumnToContents(1);
     localsTreeWidget->resizeColumnToContents(2);
-    localsTreeWidget->resizeColumnToContents(3);
 }
 
 void SeerStackLocalsBrowserWidget::handleItemCollapsed (QTreeWidgetItem* item) {
@@ -440,7 +540,6 @@ void SeerStackLocalsBrowserWidget::handleItemCollapsed (QTreeWidgetItem* item) {
     localsTreeWidget->resizeColumnToContents(0);
     localsTreeWidget->resizeColumnToContents(1);
     localsTreeWidget->resizeColumnToContents(2);
-    localsTreeWidget->resizeColumnToContents(3);
 }
 
 void SeerStackLocalsBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int column) {
@@ -454,39 +553,68 @@ void SeerStackLocalsBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int
     }
 }
 
-void SeerStackLocalsBrowserWidget::handleItemCreate (QTreeWidgetItem* parentItem, const QString& name_text, const QString& arg_text, const QString& value_text) {
+void SeerStackLocalsBrowserWidget::handleItemsUpdate (QTreeWidgetItem* parentItem, const QVector<Variable>& variables) {
 
     // Instead of creating a new tree each time, we will reuse existing items, if they are there.
-    // This allows the expanded items to remain expanded. We start by looking for matches that
-    // may already be there. If there are matches, the code will reuse it.  If not, a new item
-    // is created by the code. Note, when searching, we only look at the current level. Not any
+    // This allows the expanded items to remain expanded. The items of the level are looked up
+    // by name. A name can be there more than once (a shadowed local), so the second 'i' in the
+    // list gets the second 'i' in the tree. Note, we only look at the current level. Not any
     // children.
-    QList<QTreeWidgetItem*> matches;
+    QHash<QString,QTreeWidgetItem*> items;
+    QHash<QString,int>              counts;
 
-    if (parentItem == 0) {
-        matches = localsTreeWidget->findItems(name_text, Qt::MatchExactly, 0);
-    }else{
-        for (int i=0; i<parentItem->childCount(); i++) {
-            if (parentItem->child(i)->text(0) == name_text) {
-                matches.append(parentItem->child(i));
-            }
+    for (int i=0; i<parentItem->childCount(); i++) {
+        items.insert(itemKey(parentItem->child(i)->text(0), counts), parentItem->child(i));
+    }
+
+    counts.clear();
+
+    // Match each variable to its item. Reuse it, or create a new one.
+    QVector<QTreeWidgetItem*> placed;
+    QVector<bool>             created;
+
+    for (const Variable& variable : variables) {
+
+        QTreeWidgetItem* item = items.take(itemKey(variable.name, counts));
+
+        created.append(item == 0);
+
+        if (item == 0) {
+            item = new QTreeWidgetItem;
+            item->setText(0, variable.name);
         }
+
+        placed.append(item);
     }
 
+    // What's left is obsolete. Delete it first, so it doesn't push the others out of place.
+    for (QTreeWidgetItem* item : items) {
+        delete item;
+    }
+
+    placeItems(parentItem, placed);
+
+    for (int i=0; i<placed.size(); i++) {
+        handleItemUpdate(placed[i], variables[i], created[i]);
+    }
+}
+
+void SeerStackLocalsBrowserWidget::handleItemUpdate (QTreeWidgetItem* item, const Variable& variable, bool created) {
+
     // Parse bookmarks.
     QString capture0; // With bookends.
     QString capture1; // Without.
 
-    QRegularExpression withaddress_re("^@0[xX][0-9a-fA-F]+: \\{(.*?)\\}$");
-    QRegularExpressionMatch withaddress_match = withaddress_re.match(value_text, 0, QRegularExpression::PartialPreferCompleteMatch);
+    QRegularExpression withaddress_re = Seer::regex("^@0[xX][0-9a-fA-F]+: \\{(.*?)\\}$");
+    QRegularExpressionMatch withaddress_match = withaddress_re.match(variable.value, 0, QRegularExpression::PartialPreferCompleteMatch);
 
     if (withaddress_match.hasMatch()) {
         capture0 = withaddress_match.captured(0);
         capture1 = withaddress_match.captured(1);
 
     }else{
-        QRegularExpression noaddress_re("^\\{(.*?)\\}$");
-        QRegularExpressionMatch noaddress_match   = noaddress_re.match(value_text, 0, QRegularExpression::PartialPreferCompleteMatch);
+        QRegularExpression noaddress_re = Seer::regex("^\\{(.*?)\\}$");
+        QRegularExpressionMatch noaddress_match   = noaddress_re.match(variable.value, 0, QRegularExpression::PartialPreferCompleteMatch);
 
         if (noaddress_match.hasMatch()) {
             capture0 = noaddress_match.captured(0);
@@ -494,82 +622,44 @@ void SeerStackLocalsBrowserWidget::handleItemCreate (QTreeWidgetItem* parentItem
         }
     }
 
-    // Add the complex entry to the tree. Reuse, if possible.
-    if (capture0 != "" && capture1 != "") {
+    bool    complex = (capture0 != "" && capture1 != "");
+    QString value   = Seer::filterEscapes(complex ? capture1 : variable.value); // Remove bookends, if complex.
 
-        // Remove bookends
-        QString text = capture1;
+    // Show the values that changed since the last time in bold.
+    QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    font.setBold(created == false && item->text(2) != value);
 
-        QTreeWidgetItem* item = 0;
+    // Populate the item.
+    item->setText(0, variable.name);
+    item->setText(1, variable.arg);
+    item->setText(2, value);
+    item->setFont(2, font);
 
-        // Use the privously created item. Or create a new one.
-        if (matches.size() > 0) {
-            item = matches[0];
-            item->setText(3, "reused");
+    // Add the complex entry's name/value pairs to the tree.
+    if (complex) {
 
-        }else{
-            item = new QTreeWidgetItem;
-            item->setText(3, "new");
+        QStringList nv_pairs = Seer::parseCommaList(capture1, '{', '}');
 
-            // If we're dealing with a top-level item, attach it to the tree.
-            // Otherwise, attach it to the parent.
-            if (parentItem) {
-                parentItem->addChild(item);
-            }else{
-                localsTreeWidget->addTopLevelItem(item);
-            }
-        }
-
-        // Set the flatvalue text.
-        item->setText(0, name_text);
-        item->setText(1, arg_text);
-        item->setText(2, Seer::filterEscapes(text));
-        item->setFont(2, QFontDatabase::systemFont(QFontDatabase::FixedFont));
-
-        // Convert to a list of name/value pairs.
-        QStringList nv_pairs = Seer::parseCommaList(text, '{', '}');
+        QVector<Variable> children;
 
-        // Go through each pair and add the name and its value to the tree.
         for (const auto& nv : nv_pairs) {
 
             QStringPair pair = Seer::parseNameValue(nv, '=');
 
-            handleItemCreate(item, pair.first, arg_text, pair.second);
-        }
-
-    // Add the simple entry to the tree. Reuse, if possible.
-    }else{
-        QTreeWidgetItem* item = 0;
-
-        // Use the privously created item. Or create a new one.
-        if (matches.size() > 0) {
-            item = matches[0];
-            item->setText(3, "reused");
+            Variable child;
 
-        }else{
-            item = new QTreeWidgetItem;
-            item->setText(3, "new");
+            child.name  = pair.first;
+            child.arg   = variable.arg;
+            child.value = pair.second;
 
-            // If we're dealing with a top-level item, attach it to the tree.
-            // Otherwise, attach it to the parent.
-            if (parentItem) {
-                parentItem->addChild(item);
-            }else{
-                localsTreeWidget->addTopLevelItem(item);
-            }
+            children.append(child);
         }
 
-        // Simple entries don't have children. Delete them.
-        QList<QTreeWidgetItem*> children = item->takeChildren();
-        if (matches.size() > 0) {
-            qDeleteAll(children);
-        }
+        handleItemsUpdate(item, children);
 
-        // Populate the item.
-        item->setText(0, name_text);
-        item->setText(1, arg_text);
-        item->setText(2, Seer::filterEscapes(value_text));
-        item->setFont(2, QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    // Simple entries don't have children. Delete them.
+    }else{
+        qDeleteAll(item->takeChildren());
     }
 }
 
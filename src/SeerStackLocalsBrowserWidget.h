@@ -2,6 +2,7 @@
 
 #include <QtWidgets/QWidget>
 #include <QtCore/QString>
+#include <QtCore/QVector>
 #include "ui_SeerStackLocalsBrowserWidget.h"
 
 class SeerStackLocalsBrowserWidget : public QWidget, protected Ui::SeerStackLocalsBrowserWidgetForm {
@@ -33,7 +34,14 @@ class SeerStackLocalsBrowserWidget : public QWidget, protected Ui::SeerStackLoca
         void                addStructVisualize                  (QString expression);
 
     protected:
-        void                handleItemCreate                    (QTreeWidgetItem* parentItem, const QString& name_text, const QString& arg_text, const QString& value_text);
+        struct Variable {
+            QString         name;
+            QString         arg;
+            QString         value;
+        };
+
+        void                handleItemsUpdate                   (QTreeWidgetItem* parentItem, const QVector<Variable>& variables);
+        void                handleItemUpdate                    (QTreeWidgetItem* item, const Variable& variable, bool created);
         void                showEvent                           (QShowEvent* event);
 
     private:
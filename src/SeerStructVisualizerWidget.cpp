@@ -11,10 +11,24 @@
 #include <QtCore/QSettings>
 #include <QtCore/QDebug>
 
+namespace {
+
+    //
+    // Values longer than this are cut short. A big container's value can be megabytes.
+    //
+    const int MaxValueLength = 1024;
+
+    enum ItemRole {
+        VarObjNameRole      = Qt::UserRole,
+        ChildrenListedRole  = Qt::UserRole + 1
+    };
+}
+
 SeerStructVisualizerWidget::SeerStructVisualizerWidget (QWidget* parent) : QWidget(parent) {
 
     // Init variables.
-    _variableId = Seer::createID(); // Create id for queries.
+    _variableId    = Seer::createID(); // Create id for queries.
+    _varObjCreated = false;
 
     // Set up UI.
     setupUi(this);
@@ -38,6 +52,7 @@ SeerStructVisualizerWidget::SeerStructVisualizerWidget (QWidget* parent) : QWidg
     QObject::connect(refreshToolButton,      &QToolButton::clicked,                       this,  &SeerStructVisualizerWidget::handleRefreshButton);
     QObject::connect(helpToolButton,         &QToolButton::clicked,                       this,  &SeerStructVisualizerWidget::handleHelpButton);
     QObject::connect(variableNameLineEdit,   &QLineEdit::returnPressed,                   this,  &SeerStructVisualizerWidget::handleVariableNameLineEdit);
+    QObject::connect(lazyCheckBox,           &QCheckBox::clicked,                         this,  &SeerStructVisualizerWidget::handleLazyCheckBox);
     QObject::connect(variableTreeWidget,     &QTreeWidget::customContextMenuRequested,    this,  &SeerStructVisualizerWidget::handleContextMenu);
     QObject::connect(variableTreeWidget,     &QTreeWidget::itemEntered,                   this,  &SeerStructVisualizerWidget::handleItemEntered);
     QObject::connect(variableTreeWidget,     &QTreeWidget::itemExpanded,                  this,  &SeerStructVisualizerWidget::handleItemExpanded);
@@ -48,6 +63,8 @@ SeerStructVisualizerWidget::SeerStructVisualizerWidget (QWidget* parent) : QWidg
 }
 
 SeerStructVisualizerWidget::~SeerStructVisualizerWidget () {
+
+    deleteVarObj();
 }
 
 void SeerStructVisualizerWidget::setVariableName (const QString& name) {
@@ -57,6 +74,8 @@ void SeerStructVisualizerWidget::setVariableName (const QString& name) {
     variableNameLineEdit->setText(name);
 
     // Create the initial variable in the tree.
+    deleteVarObj();
+
     variableTreeWidget->clear();
 
     if (variableNameLineEdit->text() != "") {
@@ -73,7 +92,12 @@ void SeerStructVisualizerWidget::setVariableName (const QString& name) {
 
     // Send signal to get variable result.
     if (variableNameLineEdit->text() != "") {
-        emit evaluateVariableExpression(_variableId, variableNameLineEdit->text());
+
+        if (isLazy()) {
+            createVarObj();
+        }else{
+            emit evaluateVariableExpression(_variableId, variableNameLineEdit->text());
+        }
     }
 }
 
@@ -85,7 +109,35 @@ void SeerStructVisualizerWidget::handleText (const QString& text) {
 
     QApplication::setOverrideCursor(Qt::BusyCursor);
 
-    if (text.contains(QRegularExpression("^([0-9]+)\\^done,value="))) {
+    int token = 0;
+
+    if (Seer::matchRecord(text, "^done,name=", &token) && token == _variableId) {
+
+        // ^done,name="seer12",numchild="3",value="{...}",type="struct Person",thread-id="1",has_more="0"
+        handleVarObjCreated(GdbMiParser::parse(text));
+
+    }else if (Seer::matchRecord(text, "^done,numchild=", &token) && _varObjChildrenIds.contains(token)) {
+
+        // ^done,numchild="2",children=[child={name="seer12.age",exp="age",numchild="0",value="42",type="int"},...],has_more="0"
+        handleVarObjChildren(token, GdbMiParser::parse(text));
+
+    }else if (Seer::matchRecord(text, "^done,changelist=", &token) && token == _variableId) {
+
+        // ^done,changelist=[{name="seer12.age",value="43",in_scope="true",type_changed="false",has_more="0"}]
+        handleVarObjChanges(GdbMiParser::parse(text));
+
+    }else if (Seer::matchRecord(text, "^error,msg=", &token) && _varObjChildrenIds.contains(token)) {
+
+        QString msg_text = Seer::parseFirst(text, "msg=", '"', '"', false);
+
+        QTreeWidgetItem* item = _varObjItems.value(_varObjChildrenIds.take(token));
+
+        if (item) {
+            item->setData(0, ChildrenListedRole, false);
+            item->setText(1, Seer::filterEscapes(msg_text));
+        }
+
+    }else if (Seer::matchRecord(text, "^done,value=")) {
 
         QString id_text    = text.section('^', 0,0);
         QString value_text = Seer::parseFirst(text, "value=", '"', '"', false);
@@ -108,13 +160,20 @@ void SeerStructVisualizerWidget::handleText (const QString& text) {
         }
 
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
+    }else if (Seer::matchRecord(text, "^error,msg=")) {
 
         QString id_text  = text.section('^', 0,0);
         QString msg_text = Seer::parseFirst(text, "msg=", '"', '"', false);
 
         if (id_text.toInt() == _variableId) {
 
+            // The variable object couldn't be made (not in scope, say), or couldn't be updated
+            // (the program is running, say). Start again on the next refresh. If gdb has the
+            // variable object, delete it there too, or the next create would be a duplicate.
+            if (_varObjName != "") {
+                deleteVarObj();
+            }
+
             QTreeWidgetItem* topItem = variableTreeWidget->topLevelItem(0);
             if (topItem == 0) {
                 return;
@@ -206,6 +265,217 @@ void SeerStructVisualizerWidget::handleItemCreate (QTreeWidgetItem* parentItem,
     }
 }
 
+void SeerStructVisualizerWidget::handleVarObjCreated (const GdbMiRecord& record) {
+
+    QTreeWidgetItem* topItem = variableTreeWidget->topLevelItem(0);
+
+    if (topItem == 0 || _varObjName == "") {
+        return;
+    }
+
+    _varObjCreated = true;
+
+    deleteChildItems(topItem);
+
+    setVarObjItem(topItem, record.results());
+
+    // Show the first level. Deeper levels are listed when they're expanded.
+    listChildren(topItem);
+
+    topItem->setExpanded(true);
+}
+
+void SeerStructVisualizerWidget::handleVarObjChildren (int id, const GdbMiRecord& record) {
+
+    QTreeWidgetItem* parentItem = _varObjItems.value(_varObjChildrenIds.take(id));
+
+    if (parentItem == 0) {
+        return;
+    }
+
+    deleteChildItems(parentItem);
+
+    // Add them in one go.
+    QList<QTreeWidgetItem*> items;
+
+    for (const GdbMiValue& child : record["children"]) {
+
+        QTreeWidgetItem* item = new QTreeWidgetItem;
+        item->setText(0, child["exp"].toString());
+
+        setVarObjItem(item, child);
+
+        items.append(item);
+    }
+
+    if (record["has_more"].toInt() > 0) {
+
+        QTreeWidgetItem* item = new QTreeWidgetItem;
+        item->setText(0, "...");
+        item->setText(1, "More not shown.");
+
+        items.append(item);
+    }
+
+    parentItem->addChildren(items);
+}
+
+void SeerStructVisualizerWidget::handleVarObjChanges (const GdbMiRecord& record) {
+
+    //
+    // Only what changed, and only of the levels that were listed, is in the list.
+    //
+    for (const GdbMiValue& change : record["changelist"]) {
+
+        QTreeWidgetItem* item = _varObjItems.value(change["name"].toString());
+
+        if (item == 0) {
+            continue;
+        }
+
+        QString inScope = change["in_scope"].toString();
+
+        // Gone for good (the frame it was made in is gone, say). Make it again.
+        if (inScope == "invalid") {
+            setVariableName(variableNameLineEdit->text());
+            return;
+        }
+
+        if (inScope == "false") {
+
+            setItemValue(item, "<not in scope>");
+
+            // The expression itself. It's floating, so this shouldn't happen, but if it does,
+            // make it again at the next refresh, in whatever frame is current then.
+            if (item == variableTreeWidget->topLevelItem(0)) {
+                deleteVarObj();
+                return;
+            }
+
+            continue;
+        }
+
+        // With --simple-values, structs, unions, and arrays have no value. Theirs is unchanged.
+        if (change.contains("value")) {
+            setItemValue(item, change["value"].toString());
+        }
+
+        // A new type, or a container with a new number of children. List them again.
+        if (change["type_changed"].toString() == "true" || change.contains("new_num_children")) {
+
+            deleteChildItems(item);
+
+            int numchild = change.contains("new_num_children") ? change["new_num_children"].toInt() : change["numchild"].toInt();
+
+            item->setData(0, ChildrenListedRole, false);
+            item->setChildIndicatorPolicy(numchild > 0 || change["has_more"].toInt() > 0 || change["type_changed"].toString() == "true" ? QTreeWidgetItem::ShowIndicator : QTreeWidgetItem::DontShowIndicator);
+
+            if (item->isExpanded()) {
+                listChildren(item);
+            }
+        }
+    }
+}
+
+bool SeerStructVisualizerWidget::isLazy () const {
+
+    return lazyCheckBox->isChecked();
+}
+
+void SeerStructVisualizerWidget::createVarObj () {
+
+    QTreeWidgetItem* topItem = variableTreeWidget->topLevelItem(0);
+
+    if (topItem == 0) {
+        return;
+    }
+
+    // SeerGdbWidget names it after the id.
+    _varObjName    = QString("seer%1").arg(_variableId);
+    _varObjCreated = false;
+
+    topItem->setData(0, VarObjNameRole, _varObjName);
+
+    _varObjItems.insert(_varObjName, topItem);
+
+    emit varObjCreate(_variableId, variableNameLineEdit->text());
+}
+
+void SeerStructVisualizerWidget::deleteVarObj () {
+
+    if (_varObjCreated) {
+        emit varObjDelete(_variableId, _varObjName);
+    }
+
+    _varObjName    = "";
+    _varObjCreated = false;
+
+    _varObjItems.clear();
+    _varObjChildrenIds.clear();
+}
+
+void SeerStructVisualizerWidget::setVarObjItem (QTreeWidgetItem* item, const GdbMiValue& value) {
+
+    QString name = value["name"].toString();
+
+    item->setData(0, VarObjNameRole, name);
+    item->setData(0, ChildrenListedRole, false);
+
+    _varObjItems.insert(name, item);
+
+    setItemValue(item, value["value"].toString());
+
+    // Members aren't listed until it's expanded. Until then, just show it can be.
+    if (value["numchild"].toInt() > 0 || value["has_more"].toInt() > 0 || value["dynamic"].toInt() > 0) {
+        item->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+    }else{
+        item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicator);
+    }
+}
+
+void SeerStructVisualizerWidget::setItemValue (QTreeWidgetItem* item, const QString& value) {
+
+    if (value.size() > MaxValueLength) {
+        item->setText(1, value.left(MaxValueLength) + "...");
+    }else{
+        item->setText(1, value);
+    }
+}
+
+void SeerStructVisualizerWidget::deleteChildItems (QTreeWidgetItem* item) {
+
+    // gdb deletes the children's variable objects with the parent's. Just forget them.
+    foreach (auto child, item->takeChildren()) {
+
+        deleteChildItems(child);
+
+        _varObjItems.remove(child->data(0, VarObjNameRole).toString());
+
+        delete child;
+    }
+}
+
+void SeerStructVisualizerWidget::listChildren (QTreeWidgetItem* item) {
+
+    if (_varObjCreated == false || item->data(0, ChildrenListedRole).toBool() == true) {
+        return;
+    }
+
+    QString name = item->data(0, VarObjNameRole).toString();
+
+    if (name == "" || item->childIndicatorPolicy() != QTreeWidgetItem::ShowIndicator) {
+        return;
+    }
+
+    item->setData(0, ChildrenListedRole, true);
+
+    int id = Seer::createID();
+
+    _varObjChildrenIds.insert(id, name);
+
+    emit varObjListChildren(id, name);
+}
+
 void SeerStructVisualizerWidget::handleContextMenu (const QPoint& pos) {
 
     QTreeWidgetItem* item = variableTreeWidget->itemAt(pos);
@@ -216,16 +486,34 @@ void SeerStructVisualizerWidget::handleContextMenu (const QPoint& pos) {
 
     // Create the variable name.
     // It's a struct so include its parent names.
-    QString variable;
+    QStringList names;
 
     while (item) {
+        names.prepend(item->text(0));
+        item = item->parent();
+    }
+
+    QString variable;
+
+    for (const QString& name : names) {
+
+        // Variable objects have levels for C++ access specifiers, and array elements are numbers.
+        if (isLazy() && (name == "public" || name == "private" || name == "protected")) {
+            continue;
+        }
+
+        bool isIndex = false;
+        name.toInt(&isIndex);
+
         if (variable == "") {
-            variable = item->text(0);
+            variable = name;
+        }else if (isLazy() && isIndex) {
+            variable += "[" + name + "]";
+        }else if (name.startsWith('[')) {
+            variable += name;
         }else{
-            variable = item->text(0) + "." + variable;
+            variable += "." + name;
         }
-
-        item = item->parent();
     }
 
     // Create the menus.
@@ -409,7 +697,10 @@ void SeerStructVisualizerWidget::handleItemEntered (QTreeWidgetItem* item, int c
 
 void SeerStructVisualizerWidget::handleItemExpanded (QTreeWidgetItem* item) {
 
-    Q_UNUSED(item);
+    // Get the members of a level the first time it's expanded.
+    if (isLazy() && item->isExpanded()) {
+        listChildren(item);
+    }
 
     // Resize columns.
     variableTreeWidget->resizeColumnToContents(0);
@@ -422,6 +713,18 @@ void SeerStructVisualizerWidget::handleRefreshButton () {
         return;
     }
 
+    // Just what changed, for the levels that have been listed.
+    if (isLazy()) {
+
+        if (_varObjCreated) {
+            emit varObjUpdate(_variableId, _varObjName);
+        }else if (_varObjName == "") {
+            createVarObj();
+        }
+
+        return;
+    }
+
     // Send signal to get variable result.
     emit evaluateVariableExpression(_variableId, variableNameLineEdit->text());
 }
@@ -443,12 +746,25 @@ void SeerStructVisualizerWidget::handleVariableNameLineEdit () {
     setVariableName (variableNameLineEdit->text());
 }
 
+void SeerStructVisualizerWidget::handleLazyCheckBox () {
+
+    writeSettings();
+
+    // Start over the other way.
+    if (variableNameLineEdit->text() == "") {
+        return;
+    }
+
+    setVariableName(variableNameLineEdit->text());
+}
+
 void SeerStructVisualizerWidget::writeSettings () {
 
     QSettings settings;
 
     settings.beginGroup("structvisualizerwindow");
     settings.setValue("size", size());
+    settings.setValue("lazy", lazyCheckBox->isChecked());
     settings.endGroup();
 }
 
@@ -458,6 +774,7 @@ void SeerStructVisualizerWidget::readSettings () {
 
     settings.beginGroup("structvisualizerwindow");
     resize(settings.value("size", QSize(800, 400)).toSize());
+    lazyCheckBox->setChecked(settings.value("lazy", true).toBool());
     settings.endGroup();
 }
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "GdbMiParser.h"
 #include <QtWidgets/QWidget>
+#include <QtCore/QHash>
 #include "ui_SeerStructVisualizerWidget.h"
 
 class SeerStructVisualizerWidget : public QWidget, protected Ui::SeerStructVisualizerWidgetForm {
@@ -19,6 +21,10 @@ class SeerStructVisualizerWidget : public QWidget, protected Ui::SeerStructVisua
         void                addMemoryVisualize                  (QString expression);
         void                addArrayVisualize                   (QString expression);
         void                addStructVisualize                  (QString expression);
+        void                varObjCreate                        (int expressionid, QString expression);
+        void                varObjListChildren                  (int expressionid, QString objname);
+        void                varObjUpdate                        (int expressionid, QString objname);
+        void                varObjDelete                        (int expressionid, QString objname);
 
     public slots:
         void                handleText                          (const QString& text);
@@ -27,17 +33,33 @@ class SeerStructVisualizerWidget : public QWidget, protected Ui::SeerStructVisua
         void                handleRefreshButton                 ();
         void                handleHelpButton                    ();
         void                handleVariableNameLineEdit          ();
+        void                handleLazyCheckBox                  ();
         void                handleContextMenu                   (const QPoint&    pos);
         void                handleItemEntered                   (QTreeWidgetItem* item, int column);
         void                handleItemExpanded                  (QTreeWidgetItem* item);
 
     protected:
         void                handleItemCreate                    (QTreeWidgetItem* parentItem, const QString& value_text);
+        void                handleVarObjCreated                 (const GdbMiRecord& record);
+        void                handleVarObjChildren                (int id, const GdbMiRecord& record);
+        void                handleVarObjChanges                 (const GdbMiRecord& record);
         void                writeSettings                       ();
         void                readSettings                        ();
         void                resizeEvent                         (QResizeEvent* event);
 
     private:
+        bool                isLazy                              () const;
+        void                createVarObj                        ();
+        void                deleteVarObj                        ();
+        void                setVarObjItem                       (QTreeWidgetItem* item, const GdbMiValue& value);
+        void                setItemValue                        (QTreeWidgetItem* item, const QString& value);
+        void                deleteChildItems                    (QTreeWidgetItem* item);
+        void                listChildren                        (QTreeWidgetItem* item);
+
         int                 _variableId;
+        QString             _varObjName;            // Set when it's asked for.
+        bool                _varObjCreated;         // Set when gdb says it's there.
+        QHash<QString,QTreeWidgetItem*> _varObjItems;
+        QHash<int,QString>  _varObjChildrenIds;     // -var-list-children requests still out.
 };
 
@@ -1,5 +1,6 @@
 #include "SeerThreadFramesBrowserWidget.h"
 #include "SeerUtl.h"
+#include "GdbMiParser.h"
 #include <QtWidgets/QTreeWidget>
 #include <QtWidgets/QTreeWidgetItemIterator>
 #include <QtWidgets/QApplication>
@@ -98,33 +99,36 @@ void SeerThreadFramesBrowserWidget::handleText (const QString& text) {
 
         threadTreeWidget->clear();
 
-        QString threads_text         = Seer::parseFirst(text, "threads=", '[', ']', false);
-        QString currentthreadid_text = Seer::parseFirst(text, "current-thread-id=", '"', '"', false);
+        // Parse the reply once and walk the tree. Rescanning the text for every
+        // field is too slow with thousands of threads.
+        GdbMiRecord record               = GdbMiParser::parse(text);
+        GdbMiValue  threads              = record["threads"];
+        QString     currentthreadid_text = record["current-thread-id"].toString();
 
-        //qDebug() << threads_text;
+        if (threads.isEmpty() == false) {
 
-        if (threads_text != "") {
+            QList<QTreeWidgetItem*> items;
+            items.reserve(threads.size());
 
-            QStringList threads_list = Seer::parse(threads_text, "", '{', '}', false);
+            for (const GdbMiValue& thread : threads) {
 
-            for ( const auto& thread_text : threads_list ) {
+                GdbMiValue frame = thread["frame"];
 
-                QString id_text       = Seer::parseFirst(thread_text, "id=",        '"', '"', false);
-                QString targetid_text = Seer::parseFirst(thread_text, "target-id=", '"', '"', false);
-                QString name_text     = Seer::parseFirst(thread_text, "name=",      '"', '"', false);
+                QString id_text       = thread["id"].toString();
+                QString targetid_text = thread["target-id"].toString();
+                QString name_text     = thread["name"].toString();
 
-                QString frame_text    = Seer::parseFirst(thread_text, "frame=",     '{', '}', false);
-                QString level_text    = Seer::parseFirst(frame_text,  "level=",     '"', '"', false);
-                QString addr_text     = Seer::parseFirst(frame_text,  "addr=",      '"', '"', false);
-                QString func_text     = Seer::parseFirst(frame_text,  "func=",      '"', '"', false);
-                QString args_text     = Seer::parseFirst(frame_text,  "args=",      '[', ']', false);
-                QString file_text     = Seer::parseFirst(frame_text,  "file=",      '"', '"', false);
-                QString fullname_text = Seer::parseFirst(frame_text,  "fullname=",  '"', '"', false);
-                QString line_text     = Seer::parseFirst(frame_text,  "line=",      '"', '"', false);
-                QString arch_text     = Seer::parseFirst(frame_text,  "arch=",      '"', '"', false);
+                QString level_text    = frame["level"].toString();
+                QString addr_text     = frame["addr"].toString();
+                QString func_text     = frame["func"].toString();
+                QString args_text     = frame["args"].rawText();
+                QString file_text     = frame["file"].toString();
+                QString fullname_text = frame["fullname"].toString();
+                QString line_text     = frame["line"].toString();
+                QString arch_text     = frame["arch"].toString();
 
-                QString state_text    = Seer::parseFirst(thread_text, "state=",     '"', '"', false);
-                QString core_text     = Seer::parseFirst(thread_text, "core=",      '"', '"', false);
+                QString state_text    = thread["state"].toString();
+                QString core_text     = thread["core"].toString();
 
                 //qDebug() << file_text << fullname_text;
 
@@ -144,10 +148,12 @@ void SeerThreadFramesBrowserWidget::handleText (const QString& text) {
                 item->setText(11, arch_text);
                 item->setText(12, core_text);
 
-                // Add the frame to the tree.
-                threadTreeWidget->addTopLevelItem(item);
+                items.append(item);
             }
 
+            // Add the frames to the tree in one go.
+            threadTreeWidget->addTopLevelItems(items);
+
             // Select the current thread id.
             threadTreeWidget->clearSelection();
 
@@ -31,16 +31,27 @@ SeerThreadIdsBrowserWidget::~SeerThreadIdsBrowserWidget () {
 
 void SeerThreadIdsBrowserWidget::handleText (const QString& text) {
 
+    // The reply to a -thread-list-ids that wasn't ours. From the manual command line, say.
+    if (text.startsWith("^done,thread-ids={") || text.startsWith("^error,msg=\"No registers.\"")) {
+        handleRecord(GdbMiParser::parse(text));
+    }
+}
+
+bool SeerThreadIdsBrowserWidget::handleRecord (const GdbMiRecord& record) {
+
+    // Timed out. The next refresh will ask again.
+    if (record.isValid() == false) {
+        return true;
+    }
+
     // Don't do any work if the widget is hidden.
     if (isHidden()) {
-        return;
+        return true;
     }
 
     QApplication::setOverrideCursor(Qt::BusyCursor);
 
-    if (text.startsWith("^done,thread-ids={")) {
-
-        QString newtext = Seer::filterEscapes(text); // Filter escaped characters.
+    if (record.isRecordClass("done")) {
 
         // ^done,thread-ids={
         //        thread-id=\"1\",
@@ -51,14 +62,12 @@ void SeerThreadIdsBrowserWidget::handleText (const QString& text) {
 
         idsTreeWidget->clear();
 
-        QString threadids_text       = Seer::parseFirst(newtext,   "thread-ids=",        '{', '}', false);
-        QStringList threadids_list   = Seer::parse(threadids_text, "thread-id=",         '"', '"', false);
-        QString currentthreadid_text = Seer::parseFirst(newtext,   "current-thread-id=", '"', '"', false);
+        QString currentthreadid_text = record["current-thread-id"].toString();
 
         // Add the thread-ids.
-        for ( const auto& threadid_text : threadids_list  ) {
+        for (const GdbMiValue& threadid : record["thread-ids"]) {
 
-            //qDebug() << threadid_text;
+            QString threadid_text = threadid.toString();
 
             // Construct the item
             QTreeWidgetItem* item = new QTreeWidgetItem;
@@ -86,7 +95,7 @@ void SeerThreadIdsBrowserWidget::handleText (const QString& text) {
             idsTreeWidget->setCurrentItem(matches.first());
         }
 
-    }else if (text.startsWith("^error,msg=\"No registers.\"")) {
+    }else if (record.isRecordClass("error") && record["msg"].equals("No registers.")) {
         idsTreeWidget->clear();
 
     }else{
@@ -96,6 +105,8 @@ void SeerThreadIdsBrowserWidget::handleText (const QString& text) {
     idsTreeWidget->resizeColumnToContents(0);
 
     QApplication::restoreOverrideCursor();
+
+    return true;
 }
 
 void SeerThreadIdsBrowserWidget::handleStoppingPointReached () {
@@ -2,6 +2,7 @@
 
 #include <QtWidgets/QWidget>
 #include <QtCore/QString>
+#include "GdbMiParser.h"
 #include "ui_SeerThreadIdsBrowserWidget.h"
 
 class SeerThreadIdsBrowserWidget : public QWidget, protected Ui::SeerThreadIdsBrowserWidgetForm {
@@ -12,6 +13,8 @@ class SeerThreadIdsBrowserWidget : public QWidget, protected Ui::SeerThreadIdsBr
         explicit SeerThreadIdsBrowserWidget (QWidget* parent = 0);
        ~SeerThreadIdsBrowserWidget ();
 
+        bool                handleRecord                    (const GdbMiRecord& record);
+
     public slots:
         void                handleText                      (const QString& text);
         void                handleStoppingPointReached      ();
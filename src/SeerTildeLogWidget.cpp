@@ -26,6 +26,6 @@ void SeerTildeLogWidget::processText (const QString& text) {
         str.chop(1);
     }
 
-    textEdit->append(str);
+    logView->appendLine(str, '~');
 }
 
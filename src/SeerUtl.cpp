@@ -2,8 +2,24 @@
 #include <QtCore/QFile>
 #include <QtCore/QString>
 #include <QtCore/QDebug>
+#include <QtCore/QHash>
 #include <QRegularExpression>
 #include <mutex>
+#include <climits>
+
+//
+// Vector versions of hexToBytes(). SSE2 is always there on x86-64.
+// AVX2 is compiled in with gcc/clang and used if the cpu has it.
+//
+#if defined(__SSE2__) || defined(_M_X64)
+#define SEER_HEX_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(SEER_HEX_SSE2) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SEER_HEX_AVX2
+#include <immintrin.h>
+#endif
 
 //
 // Increment this with every release on GitHub.
@@ -746,6 +762,78 @@ namespace Seer {
         return str;
     }
 
+    //
+    // Does 'str' look like a token prefixed record. ie: "12^done,value=..."
+    //
+    // Hand written version of QRegularExpression("^([0-9]+)\\^done,value=").
+    // There must be at least one digit, and the token must fit an int.
+    // If 'token' is given, the token number is returned in it.
+    //
+    bool matchRecord (const QString& str, const char* record, int* token) {
+
+        const QChar* s   = str.constData();
+        int          len = str.size();
+        int          i   = 0;
+        qint64       t   = 0;
+
+        while (i < len && s[i].unicode() >= '0' && s[i].unicode() <= '9') {
+            t = t * 10 + (s[i].unicode() - '0');
+            i++;
+
+            if (t > INT_MAX) {
+                return false;
+            }
+        }
+
+        if (i == 0) {
+            return false;
+        }
+
+        for (const char* r = record; *r != '\0'; r++, i++) {
+            if (i >= len || s[i].unicode() != (ushort)(uchar)*r) {
+                return false;
+            }
+        }
+
+        if (token) {
+            *token = int(t);
+        }
+
+        return true;
+    }
+
+    //
+    // Shared registry of compiled regular expressions.
+    //
+    // The first call for a pattern compiles (and JIT optimizes) it. Later calls
+    // return a copy that shares the compiled pattern.
+    //
+    static QHash<QString,QRegularExpression> Regex_registry;
+    static std::mutex                        Regex_mutex;
+
+    QRegularExpression regex (const QString& pattern) {
+
+        std::lock_guard<std::mutex> guard(Regex_mutex);
+
+        auto it = Regex_registry.constFind(pattern);
+
+        if (it != Regex_registry.constEnd()) {
+            return it.value();
+        }
+
+        QRegularExpression re(pattern);
+
+        if (re.isValid() == false) {
+            qWarning() << "Bad regular expression:" << pattern << re.errorString();
+        }
+
+        re.optimize();
+
+        Regex_registry.insert(pattern, re);
+
+        return re;
+    }
+
     //
     //
     //
@@ -844,6 +932,242 @@ namespace Seer {
         return ucharToAsciiTable[byte];
     }
 
+    //
+    // Value of each hex digit. 0xff for anything else.
+    //
+    static const unsigned char hexTable[256] = {
+        0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 0
+        0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 16
+        0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 32
+           0,   1,   2,   3,   4,   5,   6,   7,   8,   9,0xff,0xff,0xff,0xff,0xff,0xff, // 48  '0'
+        0xff,  10,  11,  12,  13,  14,  15,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 64  'A'
+        0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 80
+        0xff,  10,  11,  12,  13,  14,  15,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 96  'a'
+        0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 112
+        0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 128
+        0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 144
+        0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 160
+        0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 176
+        0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 192
+        0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 208
+        0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff, // 224
+        0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff  // 240
+    };
+
+    //
+    // A byte at a time, with the table. Works everywhere.
+    // Also does the tail (and finds the bad pair) for the vector versions.
+    //
+    static int hexToBytesScalar (const char* hex, int length, char* bytes) {
+
+        const unsigned char* in = (const unsigned char*)hex;
+        int                  n  = length / 2;
+
+        for (int i=0; i<n; i++) {
+
+            unsigned char hi = hexTable[in[0]];
+            unsigned char lo = hexTable[in[1]];
+
+            if ((hi | lo) & 0xf0) {
+                return i;
+            }
+
+            bytes[i] = (char)((hi << 4) | lo);
+
+            in += 2;
+        }
+
+        return n;
+    }
+
+#if defined(SEER_HEX_SSE2)
+    //
+    // Turn 16 hex digits into 16 nibbles. 'valid' gets a 0xff byte for each digit that is hex.
+    // Bytes over 127 are negative for the signed compares, so they fail both ranges.
+    //
+    static inline __m128i hexNibblesSse2 (__m128i chars, __m128i& valid) {
+
+        __m128i lower   = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+
+        __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+        __m128i isAlpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+
+        __m128i digits  = _mm_and_si128(isDigit, _mm_sub_epi8(chars, _mm_set1_epi8('0')));
+        __m128i alphas  = _mm_and_si128(isAlpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)));
+
+        valid = _mm_or_si128(isDigit, isAlpha);
+
+        return _mm_or_si128(digits, alphas);
+    }
+
+    //
+    // Join pairs of nibbles ("hi,lo" in each 16 bit lane) into 8 bytes, still in 16 bit lanes.
+    //
+    static inline __m128i hexPairsSse2 (__m128i nibbles) {
+
+        __m128i hi = _mm_and_si128(nibbles, _mm_set1_epi16(0x00ff));
+        __m128i lo = _mm_srli_epi16(nibbles, 8);
+
+        return _mm_or_si128(_mm_slli_epi16(hi, 4), lo);
+    }
+
+    //
+    // 32 hex digits into 16 bytes at a time.
+    //
+    static int hexToBytesSse2 (const char* hex, int length, char* bytes) {
+
+        int n = length / 2;
+        int i = 0;
+
+        for (; i + 16 <= n; i += 16) {
+
+            __m128i valid0, valid1;
+
+            __m128i nibbles0 = hexNibblesSse2(_mm_loadu_si128((const __m128i*)(hex + i*2)),      valid0);
+            __m128i nibbles1 = hexNibblesSse2(_mm_loadu_si128((const __m128i*)(hex + i*2 + 16)), valid1);
+
+            // A bad digit somewhere. Let the scalar version find where.
+            if (_mm_movemask_epi8(_mm_and_si128(valid0, valid1)) != 0xffff) {
+                break;
+            }
+
+            _mm_storeu_si128((__m128i*)(bytes + i), _mm_packus_epi16(hexPairsSse2(nibbles0), hexPairsSse2(nibbles1)));
+        }
+
+        return i + hexToBytesScalar(hex + i*2, length - i*2, bytes + i);
+    }
+#endif
+
+#if defined(SEER_HEX_AVX2)
+    //
+    // Same as the SSE2 version, 64 hex digits into 32 bytes at a time.
+    // Only called if the cpu has AVX2.
+    //
+    __attribute__((target("avx2")))
+    static int hexToBytesAvx2 (const char* hex, int length, char* bytes) {
+
+        int n = length / 2;
+        int i = 0;
+
+        const __m256i zero9  = _mm256_set1_epi8('0' - 1);
+        const __m256i nine1  = _mm256_set1_epi8('9' + 1);
+        const __m256i a1     = _mm256_set1_epi8('a' - 1);
+        const __m256i f1     = _mm256_set1_epi8('f' + 1);
+        const __m256i zero   = _mm256_set1_epi8('0');
+        const __m256i a10    = _mm256_set1_epi8('a' - 10);
+        const __m256i lcase  = _mm256_set1_epi8(0x20);
+        const __m256i lobyte = _mm256_set1_epi16(0x00ff);
+
+        for (; i + 32 <= n; i += 32) {
+
+            __m256i pairs[2];
+            __m256i valid = _mm256_set1_epi8(-1);
+
+            for (int k=0; k<2; k++) {
+
+                __m256i chars   = _mm256_loadu_si256((const __m256i*)(hex + i*2 + k*32));
+                __m256i lower   = _mm256_or_si256(chars, lcase);
+
+                __m256i isDigit = _mm256_and_si256(_mm256_cmpgt_epi8(chars, zero9), _mm256_cmpgt_epi8(nine1, chars));
+                __m256i isAlpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, a1),    _mm256_cmpgt_epi8(f1, lower));
+
+                __m256i nibbles = _mm256_or_si256(_mm256_and_si256(isDigit, _mm256_sub_epi8(chars, zero)),
+                                                  _mm256_and_si256(isAlpha, _mm256_sub_epi8(lower, a10)));
+
+                valid    = _mm256_and_si256(valid, _mm256_or_si256(isDigit, isAlpha));
+                pairs[k] = _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(nibbles, lobyte), 4), _mm256_srli_epi16(nibbles, 8));
+            }
+
+            if (_mm256_movemask_epi8(valid) != -1) {
+                break;
+            }
+
+            // The pack works within each 128 bit half. Put the quarters back in order.
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(pairs[0], pairs[1]), 0xd8);
+
+            _mm256_storeu_si256((__m256i*)(bytes + i), packed);
+        }
+
+        return i + hexToBytesSse2(hex + i*2, length - i*2, bytes + i);
+    }
+#endif
+
+    typedef int (*HexToBytesFunction)(const char* hex, int length, char* bytes);
+
+    //
+    // Pick the fastest version the cpu can run. Done once.
+    //
+    static HexToBytesFunction hexToBytesFunction (const char** name) {
+
+        static const char*        functionName = 0;
+        static HexToBytesFunction function     = 0;
+        static std::once_flag     flag;
+
+        std::call_once(flag, []() {
+
+            functionName = "scalar";
+            function     = hexToBytesScalar;
+
+#if defined(SEER_HEX_SSE2)
+            functionName = "sse2";
+            function     = hexToBytesSse2;
+#endif
+
+#if defined(SEER_HEX_AVX2)
+            if (__builtin_cpu_supports("avx2")) {
+                functionName = "avx2";
+                function     = hexToBytesAvx2;
+            }
+#endif
+
+            if (qEnvironmentVariableIsSet("SEER_HEX_SCALAR")) {
+                functionName = "scalar";
+                function     = hexToBytesScalar;
+            }
+        });
+
+        if (name) {
+            *name = functionName;
+        }
+
+        return function;
+    }
+
+    //
+    // Decode 'length' hex digits ("00ff7f...") into 'bytes', which must hold length/2 bytes.
+    // Returns the number of bytes written. Decoding stops at the first pair that isn't hex.
+    //
+    // Uses AVX2 or SSE2 when the cpu has them. Set SEER_HEX_SCALAR to use the plain version.
+    //
+    int hexToBytes (const char* hex, int length, char* bytes) {
+
+        return hexToBytesFunction(0)(hex, length, bytes);
+    }
+
+    //
+    // Same, into a new QByteArray. It's allocated once, at its full size.
+    //
+    QByteArray hexToByteArray (const char* hex, int length) {
+
+        QByteArray array(length / 2, Qt::Uninitialized);
+
+        array.truncate(hexToBytes(hex, length, array.data()));
+
+        return array;
+    }
+
+    //
+    // Which version of hexToBytes() is used. "avx2", "sse2", or "scalar".
+    //
+    const char* hexToBytesMethod () {
+
+        const char* name = 0;
+
+        hexToBytesFunction(&name);
+
+        return name;
+    }
+
     int typeBytes (const QString& type) {
 
         if (type == "int8" || type == "uint8") {
@@ -1,8 +1,10 @@
 #pragma once
 #include "QStringPair.h"
 #include <QtCore/QString>
+#include <QtCore/QByteArray>
 #include <QtCore/QStringList>
 #include <QtCore/QMap>
+#include <QtCore/QRegularExpression>
 #include <QtCore/Qt>
 
 namespace Seer {
@@ -28,11 +30,16 @@ namespace Seer {
     QString                     varObjParent        (const QString& str);
     bool                        matchesWildcard     (const QStringList& regexpatterns, const QString& string);
     QString                     elideText           (const QString& str, Qt::TextElideMode mode, int length);
+    bool                        matchRecord         (const QString& str, const char* record, int* token = nullptr);
+    QRegularExpression          regex               (const QString& pattern);
 
     int                         createID            ();
 
     unsigned char               ebcdicToAscii       (unsigned char byte);
     unsigned char               ucharToAscii        (unsigned char byte);
+    int                         hexToBytes          (const char* hex, int length, char* bytes);
+    QByteArray                  hexToByteArray      (const char* hex, int length);
+    const char*                 hexToBytesMethod    ();
 
     int                         typeBytes           (const QString& type);
 
@@ -13,10 +13,19 @@
 #include <QtCore/QSettings>
 #include <QtCore/QDebug>
 
+namespace {
+
+    enum ItemRole {
+        ChildrenListedRole  = Qt::UserRole     // On column 0. Set once -var-list-children is sent.
+    };
+}
+
 SeerVarVisualizerWidget::SeerVarVisualizerWidget (QWidget* parent) : QWidget(parent) {
 
     // Init variables.
-    _variableId = Seer::createID(); // Create id for queries.
+    _variableId    = Seer::createID(); // Create id for queries.
+    _updatePending = false;
+    _updateQueued  = false;
 
     // Set up UI.
     setupUi(this);
@@ -79,6 +88,11 @@ SeerVarVisualizerWidget::SeerVarVisualizerWidget (QWidget* parent) : QWidget(par
     QObject::connect(collapseSelectedToolButton,    &QToolButton::clicked,                       this,  &SeerVarVisualizerWidget::handleCollapseSelected);
     QObject::connect(editDelegate,                  &QAllowEditDelegate::editingStarted,         this,  &SeerVarVisualizerWidget::handleIndexEditingStarted);
     QObject::connect(editDelegate,                  &QAllowEditDelegate::editingFinished,        this,  &SeerVarVisualizerWidget::handleIndexEditingFinished);
+    QObject::connect(&_resizeTimer,                 &QTimer::timeout,                            this,  &SeerVarVisualizerWidget::handleResizeColumns);
+
+    // Resize the columns once the changes settle, not for each one.
+    _resizeTimer.setSingleShot(true);
+    _resizeTimer.setInterval(100);
 
     // Show/hide columns.
     handleDebugCheckBox();
@@ -112,6 +126,8 @@ void SeerVarVisualizerWidget::setVariableName (const QString& name) {
     // Create the initial variable in the tree.
     variableTreeWidget->clear();
 
+    clearVarObjs();
+
     if (variableNameLineEdit->text() != "") {
 
         QTreeWidgetItem* item = new QTreeWidgetItem;
@@ -145,7 +161,9 @@ QString SeerVarVisualizerWidget::variableName () const {
 
 void SeerVarVisualizerWidget::handleText (const QString& text) {
 
-    if (text.contains(QRegularExpression("^([0-9]+)\\^done,name="))) {
+    int token = 0;
+
+    if (Seer::matchRecord(text, "^done,name=", &token) && token == _variableId) {
 
         //
         // "-var-create x2112 "*" me"
@@ -154,76 +172,9 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
         //         --------------
         //
 
-        QString id_text = text.section('^', 0,0);
-
-        if (id_text.toInt() == _variableId) {
-
-            //qDebug() << "var-create" << text;
-
-            QString name_text     = Seer::parseFirst(text, "name=",       '"', '"', false);
-            QString exp_text      = Seer::parseFirst(text, "exp=",        '"', '"', false);
-            QString numchild_text = Seer::parseFirst(text, "numchild=",   '"', '"', false);
-            QString value_text    = Seer::parseFirst(text, "value=",      '"', '"', false);
-            QString type_text     = Seer::parseFirst(text, "type=",       '"', '"', false);
-            QString threadid_text = Seer::parseFirst(text, "thread-id=",  '"', '"', false);
-            QString hasmore_text  = Seer::parseFirst(text, "has_more=",   '"', '"', false);
-
-            QTreeWidgetItem* topItem = variableTreeWidget->topLevelItem(0);
-            if (topItem == 0) {
-                return;
-            }
-
-            int varObjID = Seer::createID(); // Create id for queries.
-
-            topItem->setText(1, Seer::filterEscapes(value_text));
-            topItem->setText(2, type_text);
-            topItem->setText(3, name_text);
-            topItem->setText(4, QString::number(varObjID));
-            topItem->setText(5, exp_text);
-            topItem->setText(6, numchild_text);
-            topItem->setText(7, threadid_text);
-            topItem->setText(8, hasmore_text);
-            topItem->setText(9, "");
-
-            if (exp_text != "") {
-                topItem->setText(0, exp_text);
-            }
-
-            //XXX Ask for its editable attributes.
-            //XXX emit varObjAttributes (varObjID, name_text);
-
-            // If there are children, add a placeholder.
-            if (numchild_text != "0") {
-                if (type_text.endsWith('*')) {
-                    if (Seer::filterEscapes(value_text) != "0x0") {
-                        // If it is a pointer that is not null, add a placeholder.  How universal is this for other languages?
-                        QTreeWidgetItem* child = new QTreeWidgetItem;
-                        child->setText(0, "{...}");
-                        child->setText(3, name_text);
-
-                        topItem->addChild(child);
+        handleVarObjCreated(GdbMiParser::parse(text));
 
-                    }else{
-                        deleteItems(topItem->takeChildren());
-                    }
-
-                }else{
-                    // A non-pointer child, add a placeholder.
-                    QTreeWidgetItem* child = new QTreeWidgetItem;
-                    child->setText(0, "{...}");
-                    child->setText(3, name_text);
-
-                    topItem->addChild(child);
-                }
-
-            }
-
-            // Save the VarObj name.
-            _variableName = name_text;
-        }
-
-
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,numchild="))) {
+    }else if (Seer::matchRecord(text, "^done,numchild=", &token) && _varObjChildrenIds.contains(token)) {
 
         //
         // "-var-list-children --all-values x2112.public"
@@ -235,111 +186,9 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
         //                       has_more="0"
         //
 
-        QString id_text = text.section('^', 0,0);
-
-        if (id_text.toInt() == _variableId) {
-
-            //qDebug() << "var-list-children" << text;
-
-            QString     children_text = Seer::parseFirst(text,     "children=", '[', ']', false);
-            QStringList child_list    = Seer::parse(children_text, "child=",    '{', '}', false);
-            QString     hasmore_text  = Seer::parseFirst(text,     "has_more=", '"', '"', false);
-
-            for (const auto& child_text : child_list) {
-
-                QString name_text     = Seer::parseFirst(child_text, "name=",      '"', '"', false);
-                QString exp_text      = Seer::parseFirst(child_text, "exp=",       '"', '"', false);
-                QString numchild_text = Seer::parseFirst(child_text, "numchild=",  '"', '"', false);
-                QString value_text    = Seer::parseFirst(child_text, "value=",     '"', '"', false);
-                QString type_text     = Seer::parseFirst(child_text, "type=",      '"', '"', false);
-                QString threadid_text = Seer::parseFirst(child_text, "thread-id=", '"', '"', false);
-
-                // Do we have an existing item to add to?
-                QTreeWidgetItem* matchItem = findItem(Seer::varObjParent(name_text), Qt::MatchExactly|Qt::MatchRecursive, 3);
-
-                // No, just add to the top level.
-                if (matchItem == 0) {
-
-                    // This shouldn't really happen.
-                    qDebug() << name_text << "from the listchildren does not exist in the tree.";
-
-                // Yes, add to it.
-                }else{
-
-                    // See if item has a "{...}" child. If so, remove it and any other siblings.
-                    if (matchItem->childCount() > 0) {
-                        QTreeWidgetItem* childItem = matchItem->child(0);
-                        if (childItem->text(0) == "{...}") {
-                            deleteItems(matchItem->takeChildren());
-                        }
-                    }
-
-                    // Create the item.
-                    QTreeWidgetItem* item = new QTreeWidgetItem;
-
-                    int varObjID = Seer::createID(); // Create id for queries.
-
-                    item->setText(0, "");
-                    item->setText(1, Seer::filterEscapes(value_text));
-                    item->setText(2, type_text);
-                    item->setText(3, name_text);
-                    item->setText(4, QString::number(varObjID));
-                    item->setText(5, exp_text);
-                    item->setText(6, numchild_text);
-                    item->setText(7, threadid_text);
-                    item->setText(8, hasmore_text);
-                    item->setText(9, "");
-                    item->setFlags(item->flags() | Qt::ItemIsEditable); //XXX Set item editable if it can.
-
-                    if (exp_text != "") {
-                        item->setText(0, exp_text);
-                    }
-
-                    //XXX Ask for its editable attributes.
-                    //XXX emit varObjAttributes (varObjID, name_text);
-
-                    // If there are children, add a placeholder.
-                    bool expandItem = false;
-
-                    if (numchild_text != "0") {
-                        if (type_text.endsWith('*')) {
-                            if (Seer::filterEscapes(value_text) != "0x0") {
-                                // If it is a pointer that is not null, add a placeholder.  How universal is this for other languages?
-                                QTreeWidgetItem* child = new QTreeWidgetItem;
-                                child->setText(0, "{...}");
-                                child->setText(3, name_text);
-
-                                item->addChild(child);
-
-                            }else{
-                                deleteItems(item->takeChildren());
-                            }
-
-                        }else{
-                            // A non-pointer child, add a placeholder.
-                            QTreeWidgetItem* child = new QTreeWidgetItem;
-                            child->setText(0, "{...}");
-                            child->setText(3, name_text);
-
-                            item->addChild(child);
-
-                            expandItem = true;
-                        }
-                    }
-
-                    matchItem->addChild(item);
-
-                    if (expandItem == true && expandRecursiveCheckBox->isChecked()) {
-                        item->setExpanded(true);
-                    }
-                }
-            }
-        }
-
+        handleVarObjChildren(token, GdbMiParser::parse(text));
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,changelist="))) {
-
-        //qDebug() << "var-update-children" << text;
+    }else if (Seer::matchRecord(text, "^done,changelist=", &token) && token == _variableId) {
 
         //
         // "4^done,changelist=[
@@ -349,73 +198,11 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
         //                     {name=\"seer4.public.location.public.state\", value=\"\\\"Texas\\\"\",   in_scope=\"true\", type_changed=\"false\", displayhint=\"string\", dynamic=\"1\", has_more=\"0\"},
         //                     {name=\"seer4.public.location.public.zip\",   value=\"77063\",           in_scope=\"true\", type_changed=\"false\",                                        has_more=\"0\"}
         //                    ]"
+        //
 
-        QString id_text = text.section('^', 0,0);
-
-        if (id_text.toInt() == _variableId) {
-
-            QString     changelist_text = Seer::parseFirst(text,       "changelist=", '[', ']', false);
-            QStringList child_list      = Seer::parse(changelist_text, "",            '{', '}', false);
-
-            for (const auto& child_text : child_list) {
-
-                QString name_text         = Seer::parseFirst(child_text, "name=",          '"', '"', false);
-                QString value_text        = Seer::parseFirst(child_text, "value=",         '"', '"', false);
-                QString inscope_text      = Seer::parseFirst(child_text, "in_scope=",      '"', '"', false);
-                QString typechanged_text  = Seer::parseFirst(child_text, "type_changed=",  '"', '"', false);
-                QString displayhint_text  = Seer::parseFirst(child_text, "displayhint=",   '"', '"', false);
-                QString dynamic_text      = Seer::parseFirst(child_text, "dynamic=",       '"', '"', false);
-                QString hasmore_text      = Seer::parseFirst(child_text, "has_more=",      '"', '"', false);
-
-                // Do we have an existing item to add to?
-                QTreeWidgetItem* matchItem = findItem(name_text, Qt::MatchExactly|Qt::MatchRecursive, 3);
-
-                // No, just add to the top level.
-                if (matchItem == 0) {
-
-                    qDebug() << name_text << "from the changelist does not exist in the tree.";
-
-                // Yes, add to it.
-                }else{
-
-                    matchItem->setText(1, Seer::filterEscapes(value_text));
-                    matchItem->setText(7, hasmore_text);
-
-                    // If there are children, add a placeholder.
-                    if (matchItem->text(5) != "0") {
-                        if (matchItem->text(2).endsWith('*')) {
-                            if (Seer::filterEscapes(matchItem->text(1)) != "0x0") {
-                                // If it is a pointer that is not null, add a placeholder.  How universal is this for other languages?
-                                QTreeWidgetItem* child = new QTreeWidgetItem;
-                                child->setText(0, "{...}");
-                                child->setText(3, matchItem->text(3));
-
-                                matchItem->addChild(child);
-
-                            }else{
-                                deleteItems(matchItem->takeChildren());
-                            }
-
-                        }else{
-                            // A non-pointer child, add a placeholder.
-                            QTreeWidgetItem* child = new QTreeWidgetItem;
-                            child->setText(0, "{...}");
-                            child->setText(3, matchItem->text(3));
-
-                            matchItem->addChild(child);
-                        }
-                    }
-
-                    // Need to refresh?
-                    if (typechanged_text == "true") {
-                        handleRefreshButton();
-                    }
-                }
-            }
-        }
-
+        handleVarObjChanges(GdbMiParser::parse(text));
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,attr="))) {
+    }else if (Seer::matchRecord(text, "^done,attr=")) {
 
         //qDebug() << "var-show-attributes" << text;
 
@@ -439,13 +226,33 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
         }
 
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
+    }else if (Seer::matchRecord(text, "^error,msg=", &token) && _varObjChildrenIds.contains(token)) {
+
+        // The children couldn't be listed. Let them be asked for again.
+        QTreeWidgetItem* item = _varObjItems.value(_varObjChildrenIds.take(token));
+
+        if (item) {
+            item->setData(0, ChildrenListedRole, false);
+        }
+
+    }else if (Seer::matchRecord(text, "^error,msg=")) {
 
         QString id_text  = text.section('^', 0,0);
         QString msg_text = Seer::parseFirst(text, "msg=", '"', '"', false);
 
         if (id_text.toInt() == _variableId) {
 
+            // It may have been the update. Don't wait on it.
+            if (_updatePending) {
+
+                _updatePending = false;
+
+                if (_updateQueued) {
+                    _updateQueued = false;
+                    requestUpdate();
+                }
+            }
+
             QMessageBox::warning(this, "Seer",
                                  QString("Visualizer Error: '%1'\n").arg(Seer::filterEscapes(msg_text)),
                                  QMessageBox::Ok);
@@ -456,7 +263,7 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
 
             if (_previousEditName != "") {
 
-                QTreeWidgetItem* matchItem = findItem(_previousEditName, Qt::MatchExactly|Qt::MatchRecursive, 3);
+                QTreeWidgetItem* matchItem = _varObjItems.value(_previousEditName);
                 if (matchItem) {
                     matchItem->setText(1, _previousEditValue);
                 }
@@ -466,20 +273,185 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
 
     }else if (text.startsWith("^error,msg=\"No registers.\"")) {
         variableTreeWidget->clear();
+        clearVarObjs();
 
     // At a stopping point, refresh.
     }else if (text.startsWith("*stopped,reason=\"")) {
 
         if (autoRefreshCheckBox->isChecked()) {
-            handleRefreshButton();
+            requestUpdate();
         }
 
     }else{
         // Ignore anything else.
     }
+}
 
-    // Resize columns.
-    handleResizeColumns();
+void SeerVarVisualizerWidget::handleVarObjCreated (const GdbMiRecord& record) {
+
+    QTreeWidgetItem* topItem = variableTreeWidget->topLevelItem(0);
+
+    if (topItem == 0) {
+        return;
+    }
+
+    deleteChildItems(topItem);
+
+    setItem(topItem, record.results());
+
+    // Save the VarObj name.
+    _variableName = topItem->text(3);
+
+    _resizeTimer.start();
+}
+
+void SeerVarVisualizerWidget::handleVarObjChildren (int id, const GdbMiRecord& record) {
+
+    QTreeWidgetItem* parentItem = _varObjItems.value(_varObjChildrenIds.take(id));
+
+    if (parentItem == 0) {
+        return;
+    }
+
+    variableTreeWidget->setUpdatesEnabled(false);
+
+    // Replace the "{...}" placeholder with the children, in one go.
+    deleteChildItems(parentItem);
+
+    QList<QTreeWidgetItem*> items;
+
+    for (const GdbMiValue& child : record["children"]) {
+        items.append(createItem(child));
+    }
+
+    parentItem->addChildren(items);
+
+    // Expanding them lists their children in turn. Pointers aren't followed.
+    if (expandRecursiveCheckBox->isChecked()) {
+        for (QTreeWidgetItem* item : items) {
+            if (item->childCount() > 0 && item->text(2).endsWith('*') == false) {
+                item->setExpanded(true);
+            }
+        }
+    }
+
+    variableTreeWidget->setUpdatesEnabled(true);
+
+    _resizeTimer.start();
+}
+
+void SeerVarVisualizerWidget::handleVarObjChanges (const GdbMiRecord& record) {
+
+    //
+    // Only what changed is in the list. Each change is patched into its item, found
+    // by its varobj name. Nothing else in the tree is looked at.
+    //
+
+    _updatePending = false;
+
+    variableTreeWidget->setUpdatesEnabled(false);
+
+    for (const GdbMiValue& change : record["changelist"]) {
+
+        QTreeWidgetItem* item = _varObjItems.value(change["name"].toString());
+
+        // Not listed, or dropped since.
+        if (item == 0) {
+            continue;
+        }
+
+        QString inScope = change["in_scope"].toString();
+
+        // Gone for good (the frame it was made in is gone, say). Make it again.
+        if (inScope == "invalid") {
+
+            variableTreeWidget->setUpdatesEnabled(true);
+
+            setVariableName(variableNameLineEdit->text());
+
+            return;
+        }
+
+        if (inScope == "false") {
+            item->setText(1, "<not in scope>");
+            continue;
+        }
+
+        // With --simple-values, structs, unions, and arrays have no value. Theirs is unchanged.
+        if (change.contains("value")) {
+            item->setText(1, change["value"].toString());
+        }
+
+        if (change.contains("has_more")) {
+            item->setText(8, change["has_more"].toString());
+        }
+
+        // gdb dropped its children. Drop ours, and list them again if they're showing.
+        if (change["type_changed"].toString() == "true") {
+
+            item->setText(2, change["new_type"].toString());
+            item->setText(6, change["new_num_children"].toString());
+
+            deleteChildItems(item);
+
+            item->setData(0, ChildrenListedRole, false);
+
+            setPlaceholder(item);
+
+            if (item->isExpanded()) {
+                listChildren(item);
+            }
+
+            continue;
+        }
+
+        // A pretty printed container grew or shrank. Trim the ones past the end and add the new ones.
+        if (change.contains("new_num_children")) {
+
+            int numchild = change["new_num_children"].toInt();
+
+            item->setText(6, QString::number(numchild));
+
+            if (item->data(0, ChildrenListedRole).toBool() == true) {
+
+                while (item->childCount() > numchild) {
+
+                    QTreeWidgetItem* child = item->takeChild(item->childCount() - 1);
+
+                    deleteChildItems(child);
+
+                    _varObjItems.remove(child->text(3));
+
+                    delete child;
+                }
+
+                QList<QTreeWidgetItem*> items;
+
+                for (const GdbMiValue& child : change["new_children"]) {
+                    items.append(createItem(child));
+                }
+
+                item->addChildren(items);
+            }
+        }
+
+        // A pointer that went to, or from, null.
+        setPlaceholder(item);
+
+        if (item->isExpanded()) {
+            listChildren(item);
+        }
+    }
+
+    variableTreeWidget->setUpdatesEnabled(true);
+
+    _resizeTimer.start();
+
+    // Stops that came while this was out.
+    if (_updateQueued) {
+        _updateQueued = false;
+        requestUpdate();
+    }
 }
 
 void SeerVarVisualizerWidget::handleContextMenu (const QPoint& pos) {
@@ -712,46 +684,24 @@ void SeerVarVisualizerWidget::handleItemEntered (QTreeWidgetItem* item, int colu
 
 void SeerVarVisualizerWidget::handleItemExpanded (QTreeWidgetItem* item) {
 
-    // Ask for the children.
-    emit varObjListChildren(_variableId, item->text(3));
+    // Ask for the children, the first time.
+    listChildren(item);
 
     // Resize columns in a sec.
     // Have to schedule the resize later. Doing it immediatedly messes up the
     // tree display. Must be a Qt bug.
-    QTimer::singleShot(100, this, &SeerVarVisualizerWidget::handleResizeColumns);
+    _resizeTimer.start();
 }
 
 void SeerVarVisualizerWidget::handleItemCollapsed (QTreeWidgetItem* item) {
 
-    // Delete all children items.
-    deleteItems(item->takeChildren());
+    Q_UNUSED(item);
 
-    // If there are children, add a placeholder.
-    if (item->text(5) != "0") {
-        if (item->text(2).endsWith('*')) {
-            if (Seer::filterEscapes(item->text(1)) != "0x0") {
-                // If it is a pointer that is not null, add a placeholder.  How universal is this for other languages?
-                QTreeWidgetItem* child = new QTreeWidgetItem;
-                child->setText(0, "{...}");
-                child->setText(3, item->text(3));
-
-                item->addChild(child);
-            }
-
-        }else{
-            // A non-pointer child, add a placeholder.
-            QTreeWidgetItem* child = new QTreeWidgetItem;
-            child->setText(0, "{...}");
-            child->setText(3, item->text(3));
-
-            item->addChild(child);
-        }
-    }
+    // The children are kept. gdb keeps (and updates) their varobjs anyway, so
+    // expanding it again costs nothing.
 
     // Resize columns in a sec.
-    // Have to schedule the resize later. Doing it immediatedly messes up the
-    // tree display. Must be a Qt bug.
-    QTimer::singleShot(100, this, &SeerVarVisualizerWidget::handleResizeColumns);
+    _resizeTimer.start();
 }
 
 void SeerVarVisualizerWidget::handleExpandSelected () {
@@ -815,10 +765,11 @@ void SeerVarVisualizerWidget::handleHideDebugColumns (bool flag) {
 
 void SeerVarVisualizerWidget::handleRefreshButton () {
 
-    // Send signal to get variable result.
-    if (_variableName != "") {
-        emit varObjUpdate(_variableId, _variableName);
-    }
+    // Asked for. Don't wait on one that may never come back.
+    _updatePending = false;
+    _updateQueued  = false;
+
+    requestUpdate();
 }
 
 void SeerVarVisualizerWidget::handleHelpButton () {
@@ -1027,10 +978,140 @@ void SeerVarVisualizerWidget::debug (QString message,  QTreeWidgetItem* item) {
     }
 }
 
-void SeerVarVisualizerWidget::deleteItems (QList<QTreeWidgetItem*> items) {
+void SeerVarVisualizerWidget::requestUpdate () {
+
+    if (_variableName == "") {
+        return;
+    }
+
+    // One at a time. The stops that come while one is out are folded into one more.
+    if (_updatePending) {
+        _updateQueued = true;
+        return;
+    }
+
+    _updatePending = true;
+
+    // Send signal to get variable result.
+    emit varObjUpdate(_variableId, _variableName);
+}
+
+QTreeWidgetItem* SeerVarVisualizerWidget::createItem (const GdbMiValue& value) {
+
+    QTreeWidgetItem* item = new QTreeWidgetItem;
+
+    item->setFlags(item->flags() | Qt::ItemIsEditable); //XXX Set item editable if it can.
+
+    setItem(item, value);
+
+    return item;
+}
+
+void SeerVarVisualizerWidget::setItem (QTreeWidgetItem* item, const GdbMiValue& value) {
+
+    QString name = value["name"].toString();
+
+    int varObjID = Seer::createID(); // Create id for queries.
+
+    if (value.contains("exp")) {
+        item->setText(0, value["exp"].toString());
+    }
+
+    item->setText(1, value["value"].toString());
+    item->setText(2, value["type"].toString());
+    item->setText(3, name);
+    item->setText(4, QString::number(varObjID));
+    item->setText(5, value["exp"].toString());
+    item->setText(6, value["numchild"].toString());
+    item->setText(7, value["thread-id"].toString());
+    item->setText(8, value["has_more"].toString());
+    item->setText(9, "");
+
+    item->setData(0, ChildrenListedRole, false);
+
+    //XXX Ask for its editable attributes.
+    //XXX emit varObjAttributes (varObjID, name);
+
+    _varObjItems.insert(name, item);
+
+    setPlaceholder(item);
+}
+
+void SeerVarVisualizerWidget::setPlaceholder (QTreeWidgetItem* item) {
+
+    bool hasChildren = item->text(6).toInt() > 0 || item->text(8).toInt() > 0;
+
+    // A null pointer has nothing to show. How universal is this for other languages?
+    if (item->text(2).endsWith('*') && item->text(1) == "0x0") {
+        hasChildren = false;
+    }
+
+    if (hasChildren == false) {
+
+        deleteChildItems(item);
+
+        item->setData(0, ChildrenListedRole, false);
+
+        return;
+    }
+
+    // It has its children, or a placeholder for them, already.
+    if (item->childCount() > 0) {
+        return;
+    }
+
+    // If there are children, add a placeholder. They're listed when it's expanded.
+    QTreeWidgetItem* child = new QTreeWidgetItem;
+    child->setText(0, "{...}");
+
+    item->addChild(child);
+
+    item->setData(0, ChildrenListedRole, false);
+}
+
+void SeerVarVisualizerWidget::deleteChildItems (QTreeWidgetItem* item) {
+
+    // gdb deletes the children's varobjs with the parent's. Just forget them.
+    foreach (auto child, item->takeChildren()) {
+
+        deleteChildItems(child);
+
+        if (child->text(3) != "") {
+            _varObjItems.remove(child->text(3));
+        }
+
+        delete child;
+    }
+}
+
+void SeerVarVisualizerWidget::listChildren (QTreeWidgetItem* item) {
+
+    if (item->data(0, ChildrenListedRole).toBool() == true) {
+        return;
+    }
+
+    QString name = item->text(3);
+
+    // Only items with a placeholder have children to list.
+    if (name == "" || item->childCount() == 0) {
+        return;
+    }
+
+    item->setData(0, ChildrenListedRole, true);
+
+    int id = Seer::createID(); // Create id for queries.
+
+    _varObjChildrenIds.insert(id, name);
+
+    emit varObjListChildren(id, name);
+}
+
+void SeerVarVisualizerWidget::clearVarObjs () {
+
+    _varObjItems.clear();
+    _varObjChildrenIds.clear();
 
-    // Loop through the list and delete the items.
-    // Note, the list will still contain pointers, but they will be invalid.
-    foreach (auto item, items) delete item;
+    _updatePending = false;
+    _updateQueued  = false;
 }
 
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "GdbMiParser.h"
 #include <QtWidgets/QWidget>
 #include <QtGui/QKeyEvent>
+#include <QtCore/QHash>
+#include <QtCore/QTimer>
 #include "ui_SeerVarVisualizerWidget.h"
 
 class SeerVarVisualizerWidget : public QWidget, protected Ui::SeerVarVisualizerWidgetForm {
@@ -57,11 +60,25 @@ class SeerVarVisualizerWidget : public QWidget, protected Ui::SeerVarVisualizerW
         QString             fullVariableName                    (QTreeWidgetItem* item);
         QString             toolTipText                         (QTreeWidgetItem* item);
         void                debug                               (QString message,  QTreeWidgetItem* item);
-        void                deleteItems                         (QList<QTreeWidgetItem*> items);
+        void                handleVarObjCreated                 (const GdbMiRecord& record);
+        void                handleVarObjChildren                (int id, const GdbMiRecord& record);
+        void                handleVarObjChanges                 (const GdbMiRecord& record);
+        QTreeWidgetItem*    createItem                          (const GdbMiValue& value);
+        void                setItem                             (QTreeWidgetItem* item, const GdbMiValue& value);
+        void                setPlaceholder                      (QTreeWidgetItem* item);
+        void                deleteChildItems                    (QTreeWidgetItem* item);
+        void                listChildren                        (QTreeWidgetItem* item);
+        void                clearVarObjs                        ();
+        void                requestUpdate                       ();
 
         int                 _variableId;
         QString             _variableName;
         QString             _previousEditName;
         QString             _previousEditValue;
+        QHash<QString,QTreeWidgetItem*> _varObjItems;       // Varobj name to its item.
+        QHash<int,QString>  _varObjChildrenIds;     // -var-list-children requests still out.
+        bool                _updatePending;         // A -var-update is out.
+        bool                _updateQueued;          // Another stop came while it was.
+        QTimer              _resizeTimer;
 };
 
@@ -45,7 +45,7 @@ void SeerVariableLoggerBrowserWidget::handleText (const QString& text) {
 
     QApplication::setOverrideCursor(Qt::BusyCursor);
 
-    if (text.contains(QRegularExpression("^([0-9]+)\\^done,value="))) {
+    if (Seer::matchRecord(text, "^done,value=")) {
 
         // "6^done,value=\"\\\"abc\\\"\""
 
@@ -72,7 +72,7 @@ void SeerVariableLoggerBrowserWidget::handleText (const QString& text) {
             handleItemCreate(match, id_text, timestamp_text, name_text, value_text);
         }
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
+    }else if (Seer::matchRecord(text, "^error,msg=")) {
 
         // "1^error,msg=\"No symbol \\\"j\\\" in current context.\""
 
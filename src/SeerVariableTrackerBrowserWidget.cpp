@@ -1,5 +1,6 @@
 #include "SeerVariableTrackerBrowserWidget.h"
 #include "SeerUtl.h"
+#include "GdbMiParser.h"
 #include <QtWidgets/QTreeWidget>
 #include <QtWidgets/QTreeWidgetItemIterator>
 #include <QtWidgets/QApplication>
@@ -7,6 +8,7 @@
 #include <QtGui/QFontDatabase>
 #include <QtGui/QClipboard>
 #include <QtCore/QTimer>
+#include <QtCore/QHash>
 #include <QtCore/QDebug>
 #include <iostream>
 
@@ -131,77 +133,128 @@ void SeerVariableTrackerBrowserWidget::handleText (const QString& text) {
             qDeleteAll(matches);
         }
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,value="))) {
+    }else if (text.startsWith("^error,msg=\"No registers.\"")) {
+        variablesTreeWidget->clear();
 
-        // "6^done,value=\"\\\"abc\\\"\""
+    }else{
+        // Ignore others.
+    }
 
-        QString id_text    = text.section('^', 0,0);
-        QString value_text = Seer::parseFirst(text, "value=", '"', '"', false);
+    variablesTreeWidget->resizeColumnToContents(0);
+    variablesTreeWidget->resizeColumnToContents(1);
+    variablesTreeWidget->resizeColumnToContents(2);
+    variablesTreeWidget->resizeColumnToContents(3);
 
-        // Find the ones that match our 'id'.
-        QList<QTreeWidgetItem*> matches = variablesTreeWidget->findItems(id_text, Qt::MatchExactly, 2);
+    QApplication::restoreOverrideCursor();
+}
 
-        if (matches.count() == 1) {
+void SeerVariableTrackerBrowserWidget::handleRecords (const QVector<GdbMiRecord>& records) {
 
-            Q_ASSERT(matches.count() == 1);
+    // The results of one -data-evaluate-expression per tracked expression.
+    double ms = _evaluationTimer.isValid() ? _evaluationTimer.nsecsElapsed() / 1000000.0 : 0.0;
 
-            // There should be only one.
-            QTreeWidgetItem* item = matches[0];
+    // Don't do any work if the widget is hidden.
+    if (isHidden()) {
+        return;
+    }
 
-            // Mark each entry initially as "unused".
-            // Later, some will be marked as "reused" or "new". Then the "unused" ones will
-            // be deleted.
-            QTreeWidgetItemIterator itmark(item);
-            while (*itmark) {
-                (*itmark)->setText(3, "unused");
-                ++itmark;
-            }
+    QApplication::setOverrideCursor(Qt::BusyCursor);
+
+    // Apply them all before the tree is drawn or sized again.
+    variablesTreeWidget->setUpdatesEnabled(false);
+
+    // The expressions by id. Each record is looked up by its token.
+    QHash<int,QTreeWidgetItem*> items;
+
+    for (int i=0; i<variablesTreeWidget->topLevelItemCount(); i++) {
 
-            // Set the value.
-            handleItemCreate (item, value_text);
+        QTreeWidgetItem* item = variablesTreeWidget->topLevelItem(i);
+        int              id   = item->text(2).toInt();
 
-            // At this point, there are some new entries, some reused entries, and some unused ones.
-            // For now, don't bother deleting 'unused' ones.
+        // There should be only one. If not, leave them be.
+        items.insert(id, items.contains(id) ? 0 : item);
+    }
+
+    int changed = 0;
+
+    for (const auto& record : records) {
+
+        QTreeWidgetItem* item = items.value(record.token());
+
+        if (item && applyRecord(item, record)) {
+            changed++;
         }
+    }
+
+    if (changed > 0) {
+        variablesTreeWidget->resizeColumnToContents(0);
+        variablesTreeWidget->resizeColumnToContents(1);
+        variablesTreeWidget->resizeColumnToContents(2);
+        variablesTreeWidget->resizeColumnToContents(3);
+    }
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
+    variablesTreeWidget->setUpdatesEnabled(true);
 
-        // "1^error,msg=\"No symbol \\\"j\\\" in current context.\""
+    evaluationTimeLabel->setText(QString("%1 ms").arg(ms, 0, 'f', 1));
+    evaluationTimeLabel->setToolTip(QString("%1 expressions evaluated in %2 ms. %3 changed.").arg(records.size()).arg(ms, 0, 'f', 1).arg(changed));
+
+    QApplication::restoreOverrideCursor();
+}
 
-        QString id_text  = text.section('^', 0,0);
-        QString msg_text = Seer::parseFirst(text, "msg=", '"', '"', false);
+bool SeerVariableTrackerBrowserWidget::applyRecord (QTreeWidgetItem* item, const GdbMiRecord& record) {
 
-        // Find the ones that match our 'id'.
-        QList<QTreeWidgetItem*> matches = variablesTreeWidget->findItems(id_text, Qt::MatchExactly, 2);
+    // Timed out. Leave the old value.
+    if (record.isValid() == false) {
+        return false;
+    }
 
-        if (matches.count() == 1) {
+    // Same reply as last time. Nothing to do.
+    QString result_text = QString::fromUtf8(record.buffer());
 
-            // There should be only one.
-            QTreeWidgetItem* item = matches[0];
+    if (item->text(3) != "new" && item->data(1, Qt::UserRole).toString() == result_text) {
+        return false;
+    }
 
-            // Remove any children.
-            QList<QTreeWidgetItem*> children = item->takeChildren();
+    item->setData(1, Qt::UserRole, result_text);
 
-            qDeleteAll(children);
+    if (record.isRecordClass("done")) {
 
-            // Set the text with the error message.
-            item->setText(1, Seer::filterEscapes(msg_text));
-            item->setText(3, "used");
+        // "6^done,value=\"\\\"abc\\\"\""
+
+        QString value_text = record["value"].rawText();
+
+        // Mark each entry initially as "unused".
+        // Later, some will be marked as "reused" or "new". Then the "unused" ones will
+        // be deleted.
+        QTreeWidgetItemIterator itmark(item);
+        while (*itmark) {
+            (*itmark)->setText(3, "unused");
+            ++itmark;
         }
 
-    }else if (text.startsWith("^error,msg=\"No registers.\"")) {
-        variablesTreeWidget->clear();
+        // Set the value.
+        handleItemCreate (item, value_text);
 
-    }else{
-        // Ignore others.
-    }
+        // At this point, there are some new entries, some reused entries, and some unused ones.
+        // For now, don't bother deleting 'unused' ones.
 
-    variablesTreeWidget->resizeColumnToContents(0);
-    variablesTreeWidget->resizeColumnToContents(1);
-    variablesTreeWidget->resizeColumnToContents(2);
-    variablesTreeWidget->resizeColumnToContents(3);
+    }else if (record.isRecordClass("error")) {
 
-    QApplication::restoreOverrideCursor();
+        // "1^error,msg=\"No symbol \\\"j\\\" in current context.\""
+
+        QString msg_text = record["msg"].rawText();
+
+        // Remove any children.
+        QList<QTreeWidgetItem*> children = item->takeChildren();
+
+        qDeleteAll(children);
+
+        // Set the text with the error message.
+        item->setText(1, Seer::filterEscapes(msg_text));
+        item->setText(3, "used");
+    }
+
+    return true;
 }
 
 void SeerVariableTrackerBrowserWidget::handleStoppingPointReached () {
@@ -216,10 +269,13 @@ void SeerVariableTrackerBrowserWidget::handleStoppingPointReached () {
 
 void SeerVariableTrackerBrowserWidget::refresh () {
     emit refreshVariableTrackerNames();
+
+    _evaluationTimer.start();
     emit refreshVariableTrackerValues();
 }
 
 void SeerVariableTrackerBrowserWidget::refreshValues () {
+    _evaluationTimer.start();
     emit refreshVariableTrackerValues();
 }
 
@@ -327,7 +383,7 @@ void SeerVariableTrackerBrowserWidget::handleItemCreate (QTreeWidgetItem* parent
     QString capture0; // With bookends.
     QString capture1; // Without.
 
-    QRegularExpression withaddress_re("^@0[xX][0-9a-fA-F]+: \\{(.*?)\\}$");
+    QRegularExpression withaddress_re = Seer::regex("^@0[xX][0-9a-fA-F]+: \\{(.*?)\\}$");
     QRegularExpressionMatch withaddress_match = withaddress_re.match(value_text, 0, QRegularExpression::PartialPreferCompleteMatch);
 
     if (withaddress_match.hasMatch()) {
@@ -335,7 +391,7 @@ void SeerVariableTrackerBrowserWidget::handleItemCreate (QTreeWidgetItem* parent
         capture1 = withaddress_match.captured(1);
 
     }else{
-        QRegularExpression noaddress_re("^\\{(.*?)\\}$");
+        QRegularExpression noaddress_re = Seer::regex("^\\{(.*?)\\}$");
         QRegularExpressionMatch noaddress_match = noaddress_re.match(value_text, 0, QRegularExpression::PartialPreferCompleteMatch);
 
         if (noaddress_match.hasMatch()) {
@@ -2,6 +2,9 @@
 
 #include <QtWidgets/QWidget>
 #include <QtCore/QString>
+#include <QtCore/QVector>
+#include <QtCore/QElapsedTimer>
+#include "GdbMiParser.h"
 #include "ui_SeerVariableTrackerBrowserWidget.h"
 
 class SeerVariableTrackerBrowserWidget : public QWidget, protected Ui::SeerVariableTrackerBrowserWidgetForm {
@@ -18,6 +21,9 @@ class SeerVariableTrackerBrowserWidget : public QWidget, protected Ui::SeerVaria
         void                refresh                         ();
         void                refreshValues                   ();
 
+    public:
+        void                handleRecords                   (const QVector<GdbMiRecord>& records);
+
     private slots:
         void                handleAddLineEdit               ();
         void                handleDeleteToolButton          ();
@@ -42,6 +48,9 @@ class SeerVariableTrackerBrowserWidget : public QWidget, protected Ui::SeerVaria
         void                showEvent                       (QShowEvent* event);
 
     private:
+        bool                applyRecord                     (QTreeWidgetItem* item, const GdbMiRecord& record);
+
+        QElapsedTimer       _evaluationTimer;
 
 };
 
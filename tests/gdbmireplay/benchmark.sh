@@ -0,0 +1,37 @@
+#!/bin/bash
+#
+# Stopped -> views updated latency of seergdb against gdbmireplay.
+#
+# seergdb logs "Stop latency: N ms M commands" for each *stopped record once
+# every command the views sent because of it has had its result record.
+#
+
+SEERGDB=${SEERGDB:-../../src/build/seergdb}
+STOPS=${STOPS:-20}
+TIMEOUT=${TIMEOUT:-60}
+# Only what a stop asks for. Sources and symbols are only asked for by the source
+# browser and symbol searches, so they'd time replies that aren't on the path.
+SCENARIOS=${SCENARIOS:-"frames=1000 threads=5000"}
+
+if [ ! -x "$SEERGDB" ]; then
+    echo "Can't find seergdb at '$SEERGDB'. Set SEERGDB=/path/to/seergdb."
+    exit 1
+fi
+
+if [ ! -x ./gdbmireplay ]; then
+    make gdbmireplay || exit 1
+fi
+
+for s in $SCENARIOS; do
+
+    echo "Scenario: $s ($STOPS stops)"
+
+    QT_QPA_PLATFORM=${QT_QPA_PLATFORM:-offscreen} QT_LOGGING_RULES="seer.refreshscheduler.info=true" \
+        timeout $TIMEOUT "$SEERGDB" --gdb-program "$PWD/gdbmireplay" \
+            --gdb-arguments "--interpreter=mi --$s --stops=$STOPS --source=$PWD/gdbmireplay.cpp --log=gdbmireplay_$s.log" \
+            --run /bin/true 2>&1 | grep "Stop latency:" | \
+        awk '{ for (i=1; i<=NF; i++) if ($i == "latency:") { ms = $(i+1); cmds = $(i+3) }
+               n++; sum += ms; if (n == 1 || ms < min) min = ms; if (ms > max) max = ms; csum += cmds }
+             END { if (n == 0) { print "    no stops measured"; exit }
+                   printf "    %d stops, min %.1f ms, avg %.1f ms, max %.1f ms, %.1f commands/stop\n", n, min, sum/n, max, csum/n }'
+done
@@ -0,0 +1,462 @@
+//
+// gdbmireplay - A fake gdb that speaks MI on stdin/stdout.
+//
+// Replies come from recorded transcripts or are generated for a scenario
+// (lots of frames, threads, source files, symbols). Seer can be started
+// against it with --gdb-program. See README.
+//
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <poll.h>
+
+typedef std::vector<std::string> Lines;
+
+static Lines                        StartupLines;
+static std::map<std::string,Lines>  CommandReplies;     // Keyed by the full command.
+static std::map<std::string,Lines>  NameReplies;        // Keyed by the command name.
+
+static int                          Frames   = 10;
+static int                          Threads  = 4;
+static int                          Sources  = 20;
+static int                          Symbols  = 100;
+static int                          Stops    = 0;
+static int                          IdleMs   = 250;
+static std::string                  SourceFile;
+static std::string                  LogFile;
+static std::ofstream                Log;
+
+typedef std::chrono::steady_clock   Clock;
+
+static double msSince (Clock::time_point t) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t).count();
+}
+
+static void output (const std::string& text) {
+
+    fwrite(text.data(), 1, text.size(), stdout);
+    fflush(stdout);
+}
+
+//
+// Load a transcript.
+//
+//     =thread-group-added,id="i1"          Lines before the first command are sent at startup.
+//     > -stack-list-frames                 A command (without its token).
+//     ^done,stack=[frame={...}]            The reply, up to the next command.
+//
+static bool loadTranscript (const std::string& filename) {
+
+    std::ifstream file(filename);
+
+    if (file.good() == false) {
+        std::cerr << "gdbmireplay: can't open " << filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    Lines*      reply = &StartupLines;
+
+    while (std::getline(file, line)) {
+
+        if (line.size() > 0 && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        if (line.empty() || line[0] == '#' || line == "(gdb)") {
+            continue;
+        }
+
+        if (line.compare(0, 2, "> ") == 0) {
+
+            std::string command = line.substr(2);
+            std::string name    = command.substr(0, command.find(' '));
+
+            CommandReplies[command] = Lines();
+            reply = &CommandReplies[command];
+
+            if (NameReplies.count(name) == 0) {
+                NameReplies[name] = Lines();
+            }
+
+            continue;
+        }
+
+        // Drop any recorded token. The token of the replayed command is used.
+        size_t i = 0;
+
+        while (i < line.size() && isdigit((unsigned char)line[i])) {
+            i++;
+        }
+
+        reply->push_back(line.substr(i));
+    }
+
+    // Replies by name are the first reply recorded for a command of that name.
+    for (auto& c : CommandReplies) {
+
+        std::string name = c.first.substr(0, c.first.find(' '));
+
+        if (NameReplies[name].empty()) {
+            NameReplies[name] = c.second;
+        }
+    }
+
+    return true;
+}
+
+//
+// Generated replies.
+//
+static std::string frameTuple (int level) {
+
+    std::ostringstream s;
+
+    s << "{level=\"" << level << "\",addr=\"0x00000000004011" << std::hex << std::setw(2) << std::setfill('0') << (level % 256) << std::dec << "\",func=\"recurse" << level % 50 << "\"";
+
+    if (SourceFile.empty() == false) {
+        s << ",file=\"" << SourceFile.substr(SourceFile.rfind('/') + 1) << "\",fullname=\"" << SourceFile << "\",line=\"" << 10 + level % 100 << "\"";
+    }
+
+    s << ",arch=\"i386:x86-64\"}";
+
+    return s.str();
+}
+
+static std::string stackListFrames () {
+
+    std::string text = "^done,stack=[";
+
+    for (int i=0; i<Frames; i++) {
+        text += (i ? ",frame=" : "frame=") + frameTuple(i);
+    }
+
+    return text + "]";
+}
+
+static std::string stackListArguments () {
+
+    std::string text = "^done,stack-args=[";
+
+    for (int i=0; i<Frames; i++) {
+        text += (i ? "," : "");
+        text += "frame={level=\"" + std::to_string(i) + "\",args=[{name=\"n\",value=\"" + std::to_string(Frames - i) + "\"},{name=\"p\",value=\"0x7fffffffd6b0\"}]}";
+    }
+
+    return text + "]";
+}
+
+static std::string threadInfo () {
+
+    std::string text = "^done,threads=[";
+
+    for (int i=1; i<=Threads; i++) {
+        text += (i > 1 ? "," : "");
+        text += "{id=\"" + std::to_string(i) + "\",target-id=\"Thread 0x7ffff7" + std::to_string(100000 + i) + " (LWP " + std::to_string(20000 + i) + ")\",name=\"worker\",frame=" + frameTuple(0) + ",state=\"stopped\",core=\"" + std::to_string(i % 16) + "\"}";
+    }
+
+    return text + "],current-thread-id=\"1\"";
+}
+
+static std::string threadListIds () {
+
+    std::string text = "^done,thread-ids={";
+
+    for (int i=1; i<=Threads; i++) {
+        text += (i > 1 ? "," : "");
+        text += "thread-id=\"" + std::to_string(i) + "\"";
+    }
+
+    return text + "},current-thread-id=\"1\",number-of-threads=\"" + std::to_string(Threads) + "\"";
+}
+
+static std::string fileListExecSourceFiles () {
+
+    std::string text = "^done,files=[";
+
+    for (int i=0; i<Sources; i++) {
+        std::string file = "src/module" + std::to_string(i / 100) + "/file" + std::to_string(i) + ".cpp";
+        text += (i ? "," : "");
+        text += "{file=\"" + file + "\",fullname=\"/home/user/project/" + file + "\",debug-fully-read=\"false\"}";
+    }
+
+    return text + "]";
+}
+
+static std::string symbolInfo (const char* kind) {
+
+    std::string text = "^done,symbols={debug=[";
+
+    for (int f=0; f*100<Symbols; f++) {
+
+        std::string file = "src/module" + std::to_string(f / 100) + "/file" + std::to_string(f) + ".cpp";
+
+        text += (f ? "," : "");
+        text += "{filename=\"" + file + "\",fullname=\"/home/user/project/" + file + "\",symbols=[";
+
+        for (int i=f*100; i<Symbols && i<(f+1)*100; i++) {
+            std::string name = std::string(kind) + std::to_string(i);
+            text += (i > f*100 ? "," : "");
+            text += "{line=\"" + std::to_string(10 + i % 100) + "\",name=\"" + name + "\",type=\"int (int)\",description=\"int " + name + "(int);\"}";
+        }
+
+        text += "]}";
+    }
+
+    return text + "]}";
+}
+
+static std::string stopped (const char* reason) {
+    return std::string("*stopped,reason=\"") + reason + "\",frame=" + frameTuple(0) + ",thread-id=\"1\",stopped-threads=\"all\",core=\"1\"";
+}
+
+//
+// Reply to one command.
+//
+static bool reply (const std::string& line, bool& running) {
+
+    // Split off the token.
+    size_t i = 0;
+
+    while (i < line.size() && isdigit((unsigned char)line[i])) {
+        i++;
+    }
+
+    std::string token   = line.substr(0, i);
+    std::string command = line.substr(i);
+    std::string name    = command.substr(0, command.find(' '));
+    Lines       lines;
+    bool        exec    = false;
+
+    if (CommandReplies.count(command)) {
+        lines   = CommandReplies[command];
+        running = running || name.compare(0, 6, "-exec-") == 0;
+
+    }else if (NameReplies.count(name)) {
+        lines   = NameReplies[name];
+        running = running || name.compare(0, 6, "-exec-") == 0;
+
+    }else if (name == "-stack-list-frames") {
+        lines.push_back(stackListFrames());
+
+    }else if (name == "-stack-list-arguments") {
+        lines.push_back(stackListArguments());
+
+    }else if (name == "-stack-list-variables" || name == "-stack-list-locals") {
+        lines.push_back("^done,variables=[{name=\"i\",value=\"1\"},{name=\"total\",value=\"42\"},{name=\"name\",value=\"0x4020a0 \\\"replay\\\"\"}]");
+
+    }else if (name == "-thread-info") {
+        lines.push_back(threadInfo());
+
+    }else if (name == "-thread-list-ids") {
+        lines.push_back(threadListIds());
+
+    }else if (name == "-list-thread-groups") {
+        lines.push_back("^done,groups=[{id=\"i1\",type=\"process\",pid=\"4242\",executable=\"/home/user/project/replay\"}]");
+
+    }else if (name == "-file-list-exec-source-files") {
+        lines.push_back(fileListExecSourceFiles());
+
+    }else if (name == "-symbol-info-functions") {
+        lines.push_back(symbolInfo("function"));
+
+    }else if (name == "-symbol-info-variables") {
+        lines.push_back(symbolInfo("variable"));
+
+    }else if (name == "-symbol-info-types") {
+        lines.push_back(symbolInfo("type"));
+
+    }else if (name == "-break-list") {
+        lines.push_back("^done,BreakpointTable={nr_rows=\"0\",nr_cols=\"6\",hdr=[],body=[]}");
+
+    }else if (name == "-data-evaluate-expression") {
+        lines.push_back("^done,value=\"42\"");
+
+    }else if (name == "-gdb-exit") {
+        output(token + "^exit\n");
+        return false;
+
+    }else if (name.compare(0, 6, "-exec-") == 0 && name != "-exec-arguments" && name != "-exec-interrupt") {
+        lines.push_back("^running");
+        lines.push_back("*running,thread-id=\"all\"");
+        exec = true;
+
+    }else{
+        lines.push_back("^done");
+    }
+
+    std::string text;
+
+    for (const auto& l : lines) {
+        text += (l.size() > 0 && l[0] == '^' ? token : "") + l + "\n";
+    }
+
+    text += "(gdb)\n";
+
+    if (exec) {
+        text += stopped(name == "-exec-run" ? "breakpoint-hit" : "end-stepping-range") + "\n(gdb)\n";
+        running = true;
+    }
+
+    output(text);
+
+    return true;
+}
+
+static void usage () {
+
+    std::cerr << "usage: gdbmireplay [--transcript=file.mi] [--frames=N] [--threads=N] [--sources=N] [--symbols=N]" << std::endl;
+    std::cerr << "                   [--source=/path/to/file.cpp] [--stops=N] [--idle=ms] [--log=file]" << std::endl;
+    std::cerr << "Other arguments, like gdb's --interpreter=mi, are ignored." << std::endl;
+}
+
+int main (int argc, char** argv) {
+
+    for (int a=1; a<argc; a++) {
+
+        std::string arg   = argv[a];
+        std::string value = arg.find('=') != std::string::npos ? arg.substr(arg.find('=') + 1) : "";
+
+        if (arg.compare(0, 13, "--transcript=") == 0) {
+            if (loadTranscript(value) == false) {
+                return 1;
+            }
+        }else if (arg.compare(0, 9, "--frames=") == 0) {
+            Frames = atoi(value.c_str());
+        }else if (arg.compare(0, 10, "--threads=") == 0) {
+            Threads = atoi(value.c_str());
+        }else if (arg.compare(0, 10, "--sources=") == 0) {
+            Sources = atoi(value.c_str());
+        }else if (arg.compare(0, 10, "--symbols=") == 0) {
+            Symbols = atoi(value.c_str());
+        }else if (arg.compare(0, 9, "--source=") == 0) {
+            SourceFile = value;
+        }else if (arg.compare(0, 8, "--stops=") == 0) {
+            Stops = atoi(value.c_str());
+        }else if (arg.compare(0, 7, "--idle=") == 0) {
+            IdleMs = atoi(value.c_str());
+        }else if (arg.compare(0, 6, "--log=") == 0) {
+            LogFile = value;
+        }else if (arg == "--help" || arg == "-h") {
+            usage();
+            return 0;
+        }
+    }
+
+    if (LogFile.empty() == false) {
+        Log.open(LogFile);
+    }
+
+    // Startup.
+    std::string text;
+
+    if (StartupLines.empty()) {
+        text += "=thread-group-added,id=\"i1\"\n";
+        text += "~\"gdbmireplay - a fake gdb for measuring Seer.\\n\"\n";
+    }
+
+    for (const auto& l : StartupLines) {
+        text += l + "\n";
+    }
+
+    output(text + "(gdb)\n");
+
+    // Serve commands. When idle, make the program stop again, if asked to.
+    std::string        input;
+    bool               running       = false;
+    int                stopsDone     = 0;
+    int                stopCommands  = 0;
+    bool               measuring     = false;
+    Clock::time_point  stopTime      = Clock::now();
+    double             lastCommandMs = 0;
+
+    while (true) {
+
+        struct pollfd pfd;
+        pfd.fd     = 0;
+        pfd.events = POLLIN;
+
+        int r = poll(&pfd, 1, IdleMs);
+
+        if (r == 0) {
+
+            // Idle. Seer has asked for everything it wanted after the last stop.
+            if (measuring) {
+
+                if (Log.is_open()) {
+                    Log << "stop " << stopsDone << ": " << stopCommands << " commands, last command at " << lastCommandMs << " ms" << std::endl;
+                }
+
+                measuring = false;
+            }
+
+            if (running && stopsDone < Stops) {
+
+                stopsDone++;
+                stopCommands  = 0;
+                lastCommandMs = 0;
+                measuring     = true;
+                stopTime      = Clock::now();
+
+                output("*running,thread-id=\"all\"\n" + stopped("end-stepping-range") + "\n(gdb)\n");
+            }
+
+            continue;
+        }
+
+        if (r < 0) {
+            break;
+        }
+
+        char    buf[65536];
+        ssize_t n = read(0, buf, sizeof(buf));
+
+        if (n <= 0) {
+            break;
+        }
+
+        input.append(buf, n);
+
+        size_t nl;
+
+        while ((nl = input.find('\n')) != std::string::npos) {
+
+            std::string line = input.substr(0, nl);
+
+            input.erase(0, nl + 1);
+
+            if (line.size() > 0 && line.back() == '\r') {
+                line.pop_back();
+            }
+
+            if (line.empty()) {
+                continue;
+            }
+
+            if (measuring) {
+                stopCommands++;
+                lastCommandMs = msSince(stopTime);
+            }
+
+            if (Log.is_open()) {
+                Log << msSince(stopTime) << " " << line << std::endl;
+            }
+
+            if (reply(line, running) == false) {
+                return 0;
+            }
+        }
+    }
+
+    return 0;
+}
+
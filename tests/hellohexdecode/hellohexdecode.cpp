@@ -0,0 +1,129 @@
+#include "../../src/SeerUtl.h"
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QElapsedTimer>
+#include <iostream>
+#include <cstdlib>
+
+//
+// Decode the way the visualizers used to. A QString per byte.
+//
+static QByteArray qstringDecode (const QString& contents_text) {
+
+    QByteArray array;
+
+    for (int i = 0; i<contents_text.size(); i += 2) {
+        QString num = contents_text.mid(i, 2);
+        bool ok = false;
+        array.push_back(num.toInt(&ok, 16));
+    }
+
+    return array;
+}
+
+static void report (const char* name, qint64 hexBytes, qint64 nsecs) {
+
+    double seconds = nsecs / 1e9;
+
+    std::cout << name << ": " << hexBytes / (1024.0 * 1024.0) << " MB of hex in " << seconds * 1000.0 << " ms. "
+              << (hexBytes / seconds) / 1e9 << " GB/sec." << std::endl;
+}
+
+int main (int argc, char** argv) {
+
+    int megabytes = 64;
+    int count     = 10;
+
+    if (argc > 1) {
+        megabytes = atoi(argv[1]);
+    }
+
+    if (argc > 2) {
+        count = atoi(argv[2]);
+    }
+
+    if (megabytes < 1 || count < 1) {
+        std::cerr << "usage: " << argv[0] << " [megabytes] [count]" << std::endl;
+        return 1;
+    }
+
+    // Some memory, as gdb sends it. Mixed case, to cover both.
+    static const char digits[] = "0123456789abcdef0123456789ABCDEF";
+
+    qint64     bytes = (qint64)megabytes * 1024 * 1024;
+    QByteArray hex(bytes * 2, Qt::Uninitialized);
+
+    srand(1);
+
+    for (qint64 i=0; i<hex.size(); i++) {
+        hex[i] = digits[rand() % 32];
+    }
+
+    std::cout << "hexToBytes() uses '" << Seer::hexToBytesMethod() << "'." << std::endl;
+
+    // The old way is slow. Just do the first 4 MB, once.
+    {
+        QString       text = QString::fromLatin1(hex.constData(), qMin(hex.size(), 8 * 1024 * 1024));
+        QElapsedTimer timer;
+
+        timer.start();
+
+        QByteArray old = qstringDecode(text);
+
+        qint64 nsecs = timer.nsecsElapsed();
+
+        report("QString loop", text.size(), nsecs);
+
+        QByteArray now = Seer::hexToByteArray(hex.constData(), text.size());
+
+        if (old != now) {
+            std::cerr << "hexToBytes() doesn't match the QString loop." << std::endl;
+            return 1;
+        }
+    }
+
+    // The new way.
+    {
+        QByteArray    array(bytes, Qt::Uninitialized);
+        QElapsedTimer timer;
+        qint64        nsecs = 0;
+
+        for (int i=0; i<count; i++) {
+
+            timer.start();
+
+            int n = Seer::hexToBytes(hex.constData(), hex.size(), array.data());
+
+            nsecs += timer.nsecsElapsed();
+
+            if (n != bytes) {
+                std::cerr << "hexToBytes() decoded " << n << " bytes. Expected " << bytes << "." << std::endl;
+                return 1;
+            }
+        }
+
+        report("hexToBytes  ", hex.size() * count, nsecs);
+    }
+
+    // A bad digit stops it at its pair.
+    {
+        QByteArray bad  = hex.left(4096);
+        char       out[2048];
+
+        for (int pos=0; pos<bad.size(); pos += 37) {
+
+            QByteArray text = bad;
+
+            text[pos] = 'g';
+
+            if (Seer::hexToBytes(text.constData(), text.size(), out) != pos / 2) {
+                std::cerr << "hexToBytes() didn't stop at the bad digit at " << pos << "." << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    std::cout << "ok" << std::endl;
+
+    return 0;
+}
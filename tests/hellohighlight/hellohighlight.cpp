@@ -0,0 +1,188 @@
+#include "../../src/SeerCppSourceHighlighter.h"
+#include <QtGui/QGuiApplication>
+#include <QtGui/QSyntaxHighlighter>
+#include <QtGui/QTextDocument>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+#include <QtCore/QFile>
+#include <QtCore/QDir>
+#include <QtCore/QVector>
+#include <algorithm>
+#include <iostream>
+
+//
+// The regex rules SeerCppSourceHighlighter used to have.
+//
+class RegexHighlighter : public QSyntaxHighlighter {
+
+    public:
+        RegexHighlighter (QTextDocument* parent = 0) : QSyntaxHighlighter(parent) {
+
+            SeerHighlighterSettings settings = SeerHighlighterSettings::populateForCPP("");
+
+            const char* keywords[] = {
+                "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch",
+                "char", "char16_t", "char32_t", "class", "compl", "const", "const_cast", "constexpr", "continue", "decltype",
+                "default", "delete", "do", "double", "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false",
+                "float", "for", "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept",
+                "not", "not_eq", "nullptr", "operator", "or", "or_eq", "private", "protected", "public", "register",
+                "reinterpret_cast", "return", "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct",
+                "switch", "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename", "union",
+                "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq", "slots", "signals"
+            };
+
+            for (const char* keyword : keywords) {
+                _rules.append({ QRegularExpression(QString("\\b%1\\b").arg(keyword)), settings.get("Keyword") });
+            }
+
+            _rules.append({ QRegularExpression("\\bQ[A-Za-z]+\\b"),        settings.get("Class")     });
+            _rules.append({ QRegularExpression("\".*\""),                  settings.get("Quotation") });
+            _rules.append({ QRegularExpression("\\b[A-Za-z0-9_]+(?=\\()"), settings.get("Function")  });
+            _rules.append({ QRegularExpression("//[^\n]*"),                settings.get("Comment")   });
+
+            _commentFormat = settings.get("Multiline Comment");
+        }
+
+    protected:
+        void highlightBlock (const QString& text) override {
+
+            for (const Rule& rule : _rules) {
+
+                QRegularExpressionMatchIterator i = rule.pattern.globalMatch(text);
+
+                while (i.hasNext()) {
+                    QRegularExpressionMatch match = i.next();
+                    setFormat(match.capturedStart(), match.capturedLength(), rule.format);
+                }
+            }
+
+            setCurrentBlockState(0);
+
+            int start = 0;
+
+            if (previousBlockState() != 1) {
+                start = text.indexOf(_commentStart);
+            }
+
+            while (start >= 0) {
+
+                QRegularExpressionMatch match = _commentEnd.match(text, start);
+
+                int end    = match.capturedStart();
+                int length = 0;
+
+                if (end == -1) {
+                    setCurrentBlockState(1);
+                    length = text.length() - start;
+                }else{
+                    length = end - start + match.capturedLength();
+                }
+
+                setFormat(start, length, _commentFormat);
+                start = text.indexOf(_commentStart, start + length);
+            }
+        }
+
+    private:
+        struct Rule {
+            QRegularExpression  pattern;
+            QTextCharFormat     format;
+        };
+
+        QVector<Rule>           _rules;
+        QRegularExpression      _commentStart = QRegularExpression("/\\*");
+        QRegularExpression      _commentEnd   = QRegularExpression("\\*/");
+        QTextCharFormat         _commentFormat;
+};
+
+int main (int argc, char* argv[]) {
+
+    // No window is shown. Don't need a display.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication app(argc, argv);
+
+    QStringList files;
+
+    for (int i=1; i<argc; i++) {
+        files.append(argv[i]);
+    }
+
+    // The largest of Seer's own sources.
+    if (files.isEmpty()) {
+
+        QFileInfoList infos = QDir("../../src").entryInfoList(QStringList() << "*.cpp" << "*.h", QDir::Files);
+
+        std::sort(infos.begin(), infos.end(), [](const QFileInfo& a, const QFileInfo& b) { return a.size() > b.size(); });
+
+        for (int i=0; i<infos.size() && i<5; i++) {
+            files.append(infos[i].filePath());
+        }
+    }
+
+    std::cout << "file                                       lines   regex ms   lexer ms   visible ms   background ms" << std::endl;
+
+    for (const QString& file : files) {
+
+        QFile f(file);
+
+        if (f.open(QIODevice::ReadOnly) == false) {
+            std::cerr << "Can't open " << file.toStdString() << std::endl;
+            continue;
+        }
+
+        QString       text = QString::fromUtf8(f.readAll());
+        QElapsedTimer timer;
+
+        // The old regex rules.
+        QTextDocument regexDocument;
+        regexDocument.setPlainText(text);
+
+        RegexHighlighter regex;
+        regex.setDocument(&regexDocument);
+
+        timer.start();
+        regex.rehighlight();
+        qint64 regexMs = timer.elapsed();
+
+        // The lexer, all at once.
+        QTextDocument lexerDocument;
+        lexerDocument.setPlainText(text);
+
+        SeerCppSourceHighlighter lexer;
+        lexer.setDocument(&lexerDocument);
+
+        timer.start();
+        lexer.rehighlight();
+        qint64 lexerMs = timer.elapsed();
+
+        // The lexer, a screen first and the rest in the background.
+        QTextDocument visibleDocument;
+        visibleDocument.setPlainText(text);
+
+        SeerCppSourceHighlighter visible;
+        visible.setDocument(&visibleDocument);
+
+        timer.start();
+        visible.rehighlightVisibleFirst(0, 60);
+        qint64 visibleMs = timer.elapsed();
+
+        timer.start();
+        while (visible.hasPendingBlocks()) {
+            app.processEvents();
+        }
+        qint64 backgroundMs = timer.elapsed();
+
+        std::cout << QString("%1 %2 %3 %4 %5 %6").arg(QFileInfo(file).fileName(), -40)
+                                                 .arg(regexDocument.blockCount(), 8)
+                                                 .arg(regexMs,      10)
+                                                 .arg(lexerMs,      10)
+                                                 .arg(visibleMs,    12)
+                                                 .arg(backgroundMs, 15).toStdString() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include "../../src/SeerUtl.h"
+#include "../../src/GdbMiParser.h"
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QFile>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QDebug>
+#include <iostream>
+
+//
+// Build a -thread-info reply like gdb sends for a process with 'count' threads.
+//
+static QString makeThreadInfo (int count) {
+
+    QString text = "^done,threads=[";
+
+    for (int i=1; i<=count; i++) {
+        if (i != 1) {
+            text += ",";
+        }
+
+        text += QString("{id=\"%1\",target-id=\"Thread 0x7ffff%2 (LWP %3)\",name=\"worker\","
+                        "frame={level=\"0\",addr=\"0x00007ffff7e8b%4\",func=\"__futex_abstimed_wait_common\","
+                        "args=[{name=\"futex_word\",value=\"0x5555555592a0\"},{name=\"expected\",value=\"0\"}],"
+                        "file=\"./nptl/futex-internal.c\",fullname=\"/usr/src/glibc/nptl/futex-internal.c\",line=\"57\",arch=\"i386:x86-64\"},"
+                        "state=\"stopped\",core=\"%5\"}").arg(i, 6, 16, QChar('0')).arg(22356+i).arg(i%4096, 3, 16, QChar('0')).arg(i%64);
+    }
+
+    text += "],current-thread-id=\"1\"";
+
+    return text;
+}
+
+//
+// Build a -stack-list-frames reply with 'count' frames.
+//
+static QString makeStackFrames (int count) {
+
+    QString text = "^done,stack=[";
+
+    for (int i=0; i<count; i++) {
+        if (i != 0) {
+            text += ",";
+        }
+
+        text += QString("frame={level=\"%1\",addr=\"0x0000000000401%2\",func=\"fibonacci\",file=\"hellofibonacci.cpp\","
+                        "fullname=\"/home/user/seer/tests/hellofibonacci/hellofibonacci.cpp\",line=\"%3\",arch=\"i386:x86-64\"}").arg(i).arg(i%4096, 3, 16, QChar('0')).arg(10+i%50);
+    }
+
+    text += "]";
+
+    return text;
+}
+
+//
+// Extract the fields the way SeerThreadFramesBrowserWidget used to.
+//
+static int oldThreads (const QString& text) {
+
+    int fields = 0;
+
+    QString threads_text = Seer::parseFirst(text, "threads=", '[', ']', false);
+
+    QStringList threads_list = Seer::parse(threads_text, "", '{', '}', false);
+
+    for ( const auto& thread_text : threads_list ) {
+
+        QString id_text       = Seer::parseFirst(thread_text, "id=",        '"', '"', false);
+        QString targetid_text = Seer::parseFirst(thread_text, "target-id=", '"', '"', false);
+        QString name_text     = Seer::parseFirst(thread_text, "name=",      '"', '"', false);
+        QString frame_text    = Seer::parseFirst(thread_text, "frame=",     '{', '}', false);
+        QString level_text    = Seer::parseFirst(frame_text,  "level=",     '"', '"', false);
+        QString addr_text     = Seer::parseFirst(frame_text,  "addr=",      '"', '"', false);
+        QString func_text     = Seer::parseFirst(frame_text,  "func=",      '"', '"', false);
+        QString args_text     = Seer::parseFirst(frame_text,  "args=",      '[', ']', false);
+        QString file_text     = Seer::parseFirst(frame_text,  "file=",      '"', '"', false);
+        QString fullname_text = Seer::parseFirst(frame_text,  "fullname=",  '"', '"', false);
+        QString line_text     = Seer::parseFirst(frame_text,  "line=",      '"', '"', false);
+        QString arch_text     = Seer::parseFirst(frame_text,  "arch=",      '"', '"', false);
+        QString state_text    = Seer::parseFirst(thread_text, "state=",     '"', '"', false);
+        QString core_text     = Seer::parseFirst(thread_text, "core=",      '"', '"', false);
+
+        fields += 13;
+    }
+
+    return fields;
+}
+
+//
+// Extract the same fields with the MI parser.
+//
+static int newThreads (const QString& text) {
+
+    int fields = 0;
+
+    GdbMiRecord record = GdbMiParser::parse(text);
+
+    for (const GdbMiValue& thread : record["threads"]) {
+
+        GdbMiValue frame = thread["frame"];
+
+        QString id_text       = thread["id"].toString();
+        QString targetid_text = thread["target-id"].toString();
+        QString name_text     = thread["name"].toString();
+        QString level_text    = frame["level"].toString();
+        QString addr_text     = frame["addr"].toString();
+        QString func_text     = frame["func"].toString();
+        QString args_text     = frame["args"].rawText();
+        QString file_text     = frame["file"].toString();
+        QString fullname_text = frame["fullname"].toString();
+        QString line_text     = frame["line"].toString();
+        QString arch_text     = frame["arch"].toString();
+        QString state_text    = thread["state"].toString();
+        QString core_text     = thread["core"].toString();
+
+        fields += 13;
+    }
+
+    return fields;
+}
+
+static int oldFrames (const QString& text) {
+
+    int fields = 0;
+
+    QStringList frame_list = Seer::parse(text, "frame=", '{', '}', false);
+
+    for ( const auto& frame_text : frame_list  ) {
+
+        QString level_text    = Seer::parseFirst(frame_text, "level=",    '"', '"', false);
+        QString addr_text     = Seer::parseFirst(frame_text, "addr=",     '"', '"', false);
+        QString func_text     = Seer::parseFirst(frame_text, "func=",     '"', '"', false);
+        QString file_text     = Seer::parseFirst(frame_text, "file=",     '"', '"', false);
+        QString fullname_text = Seer::parseFirst(frame_text, "fullname=", '"', '"', false);
+        QString line_text     = Seer::parseFirst(frame_text, "line=",     '"', '"', false);
+        QString arch_text     = Seer::parseFirst(frame_text, "arch=",     '"', '"', false);
+
+        fields += 7;
+    }
+
+    return fields;
+}
+
+static int newFrames (const QString& text) {
+
+    int fields = 0;
+
+    GdbMiRecord record = GdbMiParser::parse(text);
+
+    for (const GdbMiValue& frame : record["stack"]) {
+
+        QString level_text    = frame["level"].toString();
+        QString addr_text     = frame["addr"].toString();
+        QString func_text     = frame["func"].toString();
+        QString file_text     = frame["file"].toString();
+        QString fullname_text = frame["fullname"].toString();
+        QString line_text     = frame["line"].toString();
+        QString arch_text     = frame["arch"].toString();
+
+        fields += 7;
+    }
+
+    return fields;
+}
+
+static void bench (const char* title, const QString& text, int (*oldfunc)(const QString&), int (*newfunc)(const QString&)) {
+
+    QElapsedTimer timer;
+
+    timer.start();
+    int oldFields = oldfunc(text);
+    qint64 oldNs  = timer.nsecsElapsed();
+
+    timer.start();
+    int newFields = newfunc(text);
+    qint64 newNs  = timer.nsecsElapsed();
+
+    std::cout << title << " (" << text.size() << " chars)" << std::endl;
+    std::cout << "    Seer::parse  : " << oldFields << " fields in " << oldNs / 1000 << " us" << std::endl;
+    std::cout << "    GdbMiParser  : " << newFields << " fields in " << newNs / 1000 << " us" << std::endl;
+
+    if (newNs > 0) {
+        std::cout << "    speedup      : " << (double)oldNs / (double)newNs << "x" << std::endl;
+    }
+
+    if (oldFields != newFields) {
+        std::cout << "    MISMATCH in number of fields!" << std::endl;
+    }
+}
+
+int main (int argc, char** argv) {
+
+    int count = 2000;
+
+    // A file of recorded replies, one per line.
+    if (argc > 1 && QFile::exists(argv[1])) {
+
+        QStringList lines;
+
+        if (Seer::readFile(argv[1], lines) == false) {
+            return 1;
+        }
+
+        for (const auto& line : lines) {
+            if (line.contains("^done,threads=[")) {
+                bench("-thread-info", line, oldThreads, newThreads);
+            }else if (line.contains("^done,stack=[")) {
+                bench("-stack-list-frames", line, oldFrames, newFrames);
+            }
+        }
+
+        return 0;
+    }
+
+    if (argc > 1) {
+        count = QString(argv[1]).toInt();
+    }
+
+    for (int n=qMax(1,count/8); n<=count; n*=2) {
+        bench(QString("-thread-info %1 threads").arg(n).toLatin1().data(),       makeThreadInfo(n),  oldThreads, newThreads);
+        bench(QString("-stack-list-frames %1 frames").arg(n).toLatin1().data(), makeStackFrames(n), oldFrames,  newFrames);
+    }
+
+    return 0;
+}
+
@@ -0,0 +1,153 @@
+#include "../../src/SeerUtl.h"
+#include "../../src/GdbMiParser.h"
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QDebug>
+#include <iostream>
+
+//
+// The token prefixed records the widgets look for in their handleText().
+//
+static const char* Records[] = {
+    "^done,value=",
+    "^error,msg=",
+    "^done,memory=",
+    "^done,asm_insns=",
+    "^done,name=",
+    "^done,numchild=",
+    "^done,changelist=",
+    "^done,attr=",
+    0
+};
+
+//
+// Classify a line the way GdbMonitor used to. A fresh regex for every token prefixed line.
+//
+static int oldClassify (const QString& text) {
+
+    if (text[0] == '~' || text[0] == '=' || text[0] == '*' || text[0] == '^' || text[0] == '&' || text[0] == '@') {
+        return text[0].unicode();
+    }else if (text.contains(QRegularExpression("^([0-9]+)\\~"))) {
+        return '~';
+    }else if (text.contains(QRegularExpression("^([0-9]+)\\="))) {
+        return '=';
+    }else if (text.contains(QRegularExpression("^([0-9]+)\\*"))) {
+        return '*';
+    }else if (text.contains(QRegularExpression("^([0-9]+)\\^"))) {
+        return '^';
+    }else if (text.contains(QRegularExpression("^([0-9]+)\\&"))) {
+        return '&';
+    }
+
+    return 0;
+}
+
+//
+// Classify a line the way GdbMonitor does now. The record is parsed once and
+// the record type comes from that.
+//
+static int newClassify (const QString& text) {
+
+    return GdbMiParser::parse(text).recordType();
+}
+
+//
+// Widget checks. Fresh regexes, the shared registry, and the hand written scanner.
+//
+static int oldWidgets (const QString& text) {
+
+    int matches = 0;
+
+    for (int i=0; Records[i]; i++) {
+        if (text.contains(QRegularExpression(QString("^([0-9]+)\\") + Records[i]))) {
+            matches++;
+        }
+    }
+
+    return matches;
+}
+
+static int registryWidgets (const QString& text) {
+
+    int matches = 0;
+
+    for (int i=0; Records[i]; i++) {
+        if (text.contains(Seer::regex(QString("^([0-9]+)\\") + Records[i]))) {
+            matches++;
+        }
+    }
+
+    return matches;
+}
+
+static int newWidgets (const QString& text) {
+
+    int matches = 0;
+
+    for (int i=0; Records[i]; i++) {
+        if (Seer::matchRecord(text, Records[i])) {
+            matches++;
+        }
+    }
+
+    return matches;
+}
+
+static void bench (const char* title, const QStringList& lines, int repeat, int (*func)(const QString&)) {
+
+    QElapsedTimer timer;
+    qint64        result = 0;
+
+    timer.start();
+
+    for (int r=0; r<repeat; r++) {
+        for (const auto& line : lines) {
+            result += func(line);
+        }
+    }
+
+    qint64 ns = timer.nsecsElapsed();
+
+    double seconds = (double)ns / 1e9;
+    double rate    = seconds > 0 ? (double)lines.size() * repeat / seconds : 0;
+
+    std::cout << "    " << title << ": " << ns / 1000 << " us, " << (qint64)rate << " lines/sec (" << result << ")" << std::endl;
+}
+
+int main (int argc, char** argv) {
+
+    QString transcript = "hellomiregex.mi";
+    int     repeat     = 200;
+
+    if (argc > 1) {
+        transcript = argv[1];
+    }
+
+    if (argc > 2) {
+        repeat = QString(argv[2]).toInt();
+    }
+
+    QStringList lines;
+
+    if (Seer::readFile(transcript, lines) == false) {
+        return 1;
+    }
+
+    lines.removeAll("");
+
+    std::cout << qPrintable(transcript) << ": " << lines.size() << " lines, repeated " << repeat << " times." << std::endl;
+
+    std::cout << "Record classification (GdbMonitor)" << std::endl;
+    bench("regex per line    ", lines, repeat, oldClassify);
+    bench("GdbMiParser::parse", lines, repeat, newClassify);
+
+    std::cout << "Token record checks (" << (sizeof(Records)/sizeof(Records[0])-1) << " per line, like the widgets)" << std::endl;
+    bench("regex per check   ", lines, repeat, oldWidgets);
+    bench("Seer::regex()     ", lines, repeat, registryWidgets);
+    bench("Seer::matchRecord ", lines, repeat, newWidgets);
+
+    return 0;
+}
+
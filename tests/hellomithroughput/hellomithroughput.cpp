@@ -0,0 +1,134 @@
+#include "../../src/GdbMiParser.h"
+#include "../../src/GdbMiReader.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QProcess>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QDebug>
+#include <iostream>
+
+//
+// Read the output of the replay process the way GdbMonitor used to.
+// A line at a time, converted to a QString.
+//
+static qint64 readLines (QProcess& p, qint64& records) {
+
+    qint64 bytes = 0;
+
+    while (p.waitForReadyRead(5000) || p.canReadLine()) {
+
+        while (p.canReadLine()) {
+
+            QByteArray buf = p.readLine();
+
+            bytes += buf.size();
+
+            if (buf[buf.size()-1] == '\n') {
+                buf.chop(1);
+            }
+
+            if (buf.size() == 0) {
+                continue;
+            }
+
+            QString text(buf);
+
+            GdbMiRecord record = GdbMiParser::parse(text);
+
+            if (record.recordType() != GdbMiRecord::UnknownRecord) {
+                records++;
+            }
+        }
+    }
+
+    return bytes;
+}
+
+//
+// Read it the way GdbMonitor does now. Big reads, records framed and parsed
+// in place, no QString.
+//
+static qint64 readChunks (QProcess& p, qint64& records) {
+
+    GdbMiReader reader;
+
+    while (p.waitForReadyRead(5000) || p.bytesAvailable() > 0) {
+
+        reader.read(&p);
+
+        int start  = 0;
+        int length = 0;
+
+        while (reader.next(&start, &length)) {
+
+            if (length == 0) {
+                continue;
+            }
+
+            GdbMiRecord record = GdbMiParser::parse(reader.chunk(), start, length);
+
+            if (record.recordType() != GdbMiRecord::UnknownRecord) {
+                records++;
+            }
+        }
+    }
+
+    return reader.bytesRead();
+}
+
+static void bench (const char* title, const QStringList& arguments, qint64 (*func)(QProcess&, qint64&)) {
+
+    QProcess p;
+
+    p.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    p.start("./mireplay", arguments);
+
+    if (p.waitForStarted() == false) {
+        std::cout << "Can't start ./mireplay" << std::endl;
+        return;
+    }
+
+    QElapsedTimer timer;
+    qint64        records = 0;
+
+    timer.start();
+
+    qint64 bytes = func(p, records);
+    qint64 ns    = timer.nsecsElapsed();
+
+    p.waitForFinished();
+
+    double mb      = (double)bytes / (1024.0 * 1024.0);
+    double seconds = (double)ns / 1e9;
+
+    std::cout << "    " << title << ": " << (qint64)mb << " MB, " << records << " records in " << ns / 1000000 << " ms, " << (seconds > 0 ? mb / seconds : 0) << " MB/sec" << std::endl;
+}
+
+int main (int argc, char** argv) {
+
+    QCoreApplication app(argc, argv);
+
+    QString transcript = "../hellomiregex/hellomiregex.mi";
+    QString count      = "2000";
+    QString megabytes  = "8";
+
+    if (argc > 1) {
+        transcript = argv[1];
+    }
+
+    if (argc > 2) {
+        count = argv[2];
+    }
+
+    std::cout << "Transcript " << qPrintable(transcript) << " x " << qPrintable(count) << std::endl;
+    bench("readLine + QString", QStringList() << transcript << count, readLines);
+    bench("GdbMiReader       ", QStringList() << transcript << count, readChunks);
+
+    std::cout << "-data-read-memory-bytes reply of " << qPrintable(megabytes) << " MB x 8" << std::endl;
+    bench("readLine + QString", QStringList() << "--memory" << megabytes << "8", readLines);
+    bench("GdbMiReader       ", QStringList() << "--memory" << megabytes << "8", readChunks);
+
+    return 0;
+}
+
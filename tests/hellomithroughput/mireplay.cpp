@@ -0,0 +1,73 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+
+//
+// Write MI records to stdout as fast as possible.
+//
+//     mireplay transcript.mi 100      # The transcript, 100 times.
+//     mireplay --memory 4 10          # A 4 MB -data-read-memory-bytes reply, 10 times.
+//
+int main (int argc, char** argv) {
+
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " transcript.mi count" << std::endl;
+        std::cerr << "       " << argv[0] << " --memory megabytes count" << std::endl;
+        return 1;
+    }
+
+    std::string text;
+    long        count = 0;
+
+    if (std::string(argv[1]) == "--memory") {
+
+        if (argc < 4) {
+            std::cerr << argv[0] << ": --memory needs a size and a count" << std::endl;
+            return 1;
+        }
+
+        count = atol(argv[3]);
+
+        long bytes = atol(argv[2]) * 1024 * 1024;
+
+        text  = "1^done,memory=[{begin=\"0x00007ffff7a00000\",offset=\"0x0000000000000000\",end=\"0x00007ffff7e00000\",contents=\"";
+        text.reserve(text.size() + bytes * 2 + 8);
+
+        static const char hex[] = "0123456789abcdef";
+
+        for (long i=0; i<bytes; i++) {
+            text += hex[(i >> 4) & 0xf];
+            text += hex[i & 0xf];
+        }
+
+        text += "\"}]\n";
+
+    }else{
+
+        count = atol(argv[2]);
+
+        std::ifstream file(argv[1]);
+
+        if (file.good() == false) {
+            std::cerr << argv[0] << ": can't open " << argv[1] << std::endl;
+            return 1;
+        }
+
+        std::string line;
+
+        while (std::getline(file, line)) {
+            text += line;
+            text += '\n';
+        }
+    }
+
+    for (long i=0; i<count; i++) {
+        fwrite(text.data(), 1, text.size(), stdout);
+    }
+
+    fflush(stdout);
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "../../src/SeerSourceCache.h"
+#include "../../src/SeerUtl.h"
+#include <QtCore/QCoreApplication>
+#include <QtCore/QTextStream>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+#include <QtCore/QFile>
+#include <QtCore/QDir>
+#include <algorithm>
+#include <iostream>
+
+//
+// How SeerEditorWidgetSourceArea::open() used to read a file.
+//
+static QString readOldWay (const QString& filename, int tabSize) {
+
+    QFile inputFile(filename);
+
+    inputFile.open(QIODevice::ReadOnly);
+
+    QTextStream stream(&inputFile);
+
+    QString line = stream.readLine();
+    QString text;
+
+    while (!line.isNull()) {
+
+        line = Seer::expandTabs(line, tabSize, false);
+
+        text += line + "\n";
+
+        line = stream.readLine();
+    };
+
+    return text;
+}
+
+int main (int argc, char* argv[]) {
+
+    QCoreApplication app(argc, argv);
+
+    const int tabSize = 4;
+    const int loops   = 10;
+
+    QStringList files;
+
+    for (int i=1; i<argc; i++) {
+        files.append(argv[i]);
+    }
+
+    // The largest of Seer's own sources.
+    if (files.isEmpty()) {
+
+        QFileInfoList infos = QDir("../../src").entryInfoList(QStringList() << "*.cpp" << "*.h", QDir::Files);
+
+        std::sort(infos.begin(), infos.end(), [](const QFileInfo& a, const QFileInfo& b) { return a.size() > b.size(); });
+
+        for (int i=0; i<infos.size() && i<5; i++) {
+            files.append(infos[i].filePath());
+        }
+    }
+
+    int failures = 0;
+
+    for (const QString& filename : files) {
+
+        QElapsedTimer timer;
+        QString       oldText;
+        QString       newText;
+
+        timer.start();
+        for (int i=0; i<loops; i++) {
+            oldText = readOldWay(filename, tabSize);
+        }
+        qint64 oldTime = timer.nsecsElapsed() / loops;
+
+        timer.start();
+        for (int i=0; i<loops; i++) {
+            SeerSourceCache::clear();
+            SeerSourceCache::readSource(filename, tabSize, newText);
+        }
+        qint64 newTime = timer.nsecsElapsed() / loops;
+
+        timer.start();
+        for (int i=0; i<loops; i++) {
+            SeerSourceCache::readSource(filename, tabSize, newText);
+        }
+        qint64 cachedTime = timer.nsecsElapsed() / loops;
+
+        bool same = (oldText == newText);
+
+        if (same == false) {
+            failures++;
+        }
+
+        std::cout << qPrintable(QFileInfo(filename).fileName()) << " (" << QFileInfo(filename).size() << " bytes)" << std::endl;
+        std::cout << "    QTextStream  " << oldTime    / 1000 << " us" << std::endl;
+        std::cout << "    Mapped       " << newTime    / 1000 << " us" << std::endl;
+        std::cout << "    Cached       " << cachedTime / 1000 << " us" << std::endl;
+        std::cout << "    Same text    " << (same ? "yes" : "NO") << std::endl;
+    }
+
+    return failures == 0 ? 0 : 1;
+}